@@ -69,7 +69,7 @@ end
 
 % Compile all the C-files into MEX functions
 cgnsfiles = ['cgnslib.c cgns_internals.c cgns_io.c cgns_error.c '...
-    'adf/ADF_interface.c adf/ADF_internals.c'];
+    'adf/ADF_interface.c adf/ADF_internals.c adfm/ADFM.c'];
 if ~isempty(hdfroot) && ~isoctave
     cgnsfiles = [cgnsfiles ' adfh/ADFH.c'];
     hdf5inc = ['-I' srcdir '/adfh -I' hdfroot '/include -DBUILD_HDF5'];
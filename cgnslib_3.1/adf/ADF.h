@@ -172,6 +172,19 @@ EXTERN	void	ADF_Get_Root_ID(
 			double *Root_ID,
 			int *error_return ) ;
 
+EXTERN	void	ADF_Get_Node_Location(
+			const double ID,
+			cgulong_t *block,
+			cgulong_t *offset,
+			int *error_return ) ;
+
+EXTERN	void	ADF_Get_Location_ID(
+			const double ID,
+			const cgulong_t block,
+			const cgulong_t offset,
+			double *Node_ID,
+			int *error_return ) ;
+
 EXTERN	void	ADF_Is_Link(
 			const double ID,
 			int *link_path_length,
@@ -224,6 +237,15 @@ EXTERN	void	ADF_Read_All_Data(
 			char *data,
 			int *error_return ) ;
 
+EXTERN	void	ADF_Read_Batch(
+			const int count,
+			const double IDs[],
+			const cgsize_t b_starts[],
+			const cgsize_t b_ends[],
+			char *data[],
+			int errors[],
+			int *error_return ) ;
+
 EXTERN	void	ADF_Read_Block_Data(
 			const double ID,
 			const cgsize_t b_start,
@@ -244,15 +266,50 @@ EXTERN	void	ADF_Read_Data(
 			char *data,
 			int *error_return ) ;
 
+EXTERN	void	ADF_Read_Indices(
+			const double ID,
+			const cgsize_t num,
+			const cgsize_t indices[],
+			char *data,
+			int *error_return ) ;
+
+EXTERN	void	ADF_Reserve_Data(
+			const double ID,
+			int *error_return ) ;
+
+EXTERN	void	ADF_Set_Compress(
+			const cglong_t compress_size,
+			int *error_return ) ;
+
+EXTERN	void	ADF_Set_Direct_IO(
+			const cglong_t direct_io_size,
+			int *error_return ) ;
+
 EXTERN	void	ADF_Set_Error_State(
 			const int error_state,
 			int *error_return ) ;
 
+EXTERN	void	ADF_Set_Header_Sync(
+			const int header_sync,
+			int *error_return ) ;
+
 EXTERN	void	ADF_Set_Label(
 			const double ID,
 			const char *label,
 			int *error_return ) ;
 
+EXTERN	void	ADF_Set_Merge_Chunks(
+			const int merge_chunks,
+			int *error_return ) ;
+
+EXTERN	void	ADF_Set_Preallocate(
+			const cglong_t preallocate_size,
+			int *error_return ) ;
+
+EXTERN	void	ADF_Set_Queue_Depth(
+			const int queue_depth,
+			int *error_return ) ;
+
 EXTERN	void	ADF_Write_All_Data(
 			const double ID,
 			const char *data,
@@ -278,6 +335,13 @@ EXTERN	void	ADF_Write_Data(
 			const char *data,
 			int *error_return ) ;
 
+EXTERN	void	ADF_Write_Indices(
+			const double ID,
+			const cgsize_t num,
+			const cgsize_t indices[],
+			const char *data,
+			int *error_return ) ;
+
 #if defined (__cplusplus)
     }
 #endif
@@ -355,4 +419,11 @@ EXTERN	void	ADF_Write_Data(
 #define NULL_NODEID_POINTER            62
 #define MAX_FILE_SIZE_EXCEEDED         63
 #define MAX_INT32_SIZE_EXCEEDED        64
+#define BAD_HEADER_SYNC                65
+#define BAD_MERGE_CHUNKS               66
+#define BAD_DIRECT_IO_SIZE             67
+#define BAD_PREALLOCATE_SIZE           68
+#define BAD_COMPRESS_SIZE              69
+#define BAD_COMPRESSED_DATA            70
+#define BAD_QUEUE_DEPTH                71
 #endif
@@ -92,6 +92,8 @@ Definitions:
 static char ADF_D_identification[] = "\300\250\243\251ADF Database Version B02012>" ;
                                  /*   0   1   2   3   4567890123456789012345678901 = 32 */
 static char ADF_A_identification[] = "\300\250\243\251ADF Database Version A02011>" ;
+/* version C is version B with the compact node header */
+static char ADF_C_identification[] = "\300\250\243\251ADF Database Version C02012>" ;
 
 /***********************************************************************
     Includes
@@ -194,6 +196,13 @@ const char  *ADF_error_string[] = {
    "ADF 62: The node ID pointer is NULL.",
    "ADF 63: The maximum size for a file exceeded.",
    "ADF 64: Dimensions exceed that for a 32-bit integer.",
+   "ADF 65: Header sync must be either a 0 (zero) or a 1 (one).",
+   "ADF 66: Merge chunks must be either a 0 (zero) or a 1 (one).",
+   "ADF 67: Direct I/O size must not be negative.",
+   "ADF 68: Preallocation size must not be negative.",
+   "ADF 69: Compression size must not be negative.",
+   "ADF 70: Compressed data is corrupt or not supported.",
+   "ADF 71: Queue depth must be from 0 to 256.",
    "ADF  x: Last error mesage"
    } ;
 
@@ -204,6 +213,11 @@ int ADF_sys_err = 0;
 static int  ADF_abort_on_error = FALSE ;
 
 extern char data_chunk_start_tag[];
+extern char compressed_chunk_start_tag[];
+
+    /** number of sub-node table entries read at a time when
+        returning the children of a node **/
+#define CHILDREN_PER_READ 64
 
 #define CHECK_ADF_ABORT( error_flag ) if( error_flag != NO_ERROR ) { \
                     if( ADF_abort_on_error == TRUE ) {    \
@@ -288,11 +302,11 @@ void    ADF_Children_Names(
         char *names,
         int *error_return )
 {
-int                         i ;
+int                         i, n, count, last ;
 unsigned int                file_index ;
 struct DISK_POINTER         block_offset ;
 struct NODE_HEADER          node ;
-struct SUB_NODE_TABLE_ENTRY sub_node_table_entry ;
+struct SUB_NODE_TABLE_ENTRY sub_node_table[CHILDREN_PER_READ] ;
 double                      LID ;
 
 *error_return = NO_ERROR ;
@@ -328,25 +342,28 @@ block_offset.offset = node.sub_node_table.offset +
                       (ADF_NAME_LENGTH + DISK_POINTER_SIZE) * (istart-1)) ;
 
    /** Return the data for the requested children **/
-for( i=(istart-1); i< MIN(istart-1+imax_num, (int) node.num_sub_nodes); i++ ) {
-   ADFI_adjust_disk_pointer( &block_offset, error_return ) ;
-   CHECK_ADF_ABORT( *error_return ) ;
-
-   /** Read the sun-node entry table **/
-   ADFI_read_sub_node_table_entry(  file_index, &block_offset,
-                &sub_node_table_entry, error_return ) ;
+last = MIN(istart-1+imax_num, (int) node.num_sub_nodes) ;
+for( i=(istart-1); i<last; i+=count ) {
+   /** Read the sub-node table entries **/
+   count = MIN(last-i, CHILDREN_PER_READ) ;
+   ADFI_read_sub_node_entries( file_index, &block_offset, count,
+                sub_node_table, error_return ) ;
    CHECK_ADF_ABORT( *error_return ) ;
 
-   /** Convert the child's name from blank-filled into a C string **/
-   ADFI_string_2_C_string( sub_node_table_entry.child_name,
+   for( n=0; n<count; n++ ) {
+      /** Convert the child's name from blank-filled into a C string **/
+      ADFI_string_2_C_string( sub_node_table[n].child_name,
                            MIN(imax_name_len,ADF_NAME_LENGTH),
-                           &names[(i-(istart-1))*(imax_name_len+1)],
+                           &names[(i+n-(istart-1))*(imax_name_len+1)],
                            error_return ) ;
-   CHECK_ADF_ABORT( *error_return ) ;
+      CHECK_ADF_ABORT( *error_return ) ;
+      *inum_ret = *inum_ret + 1 ;
+      } /* end for */
 
-   /** Increment the disk-pointer and the number of names returned **/
-   block_offset.offset += (ADF_NAME_LENGTH + DISK_POINTER_SIZE) ;
-   *inum_ret = *inum_ret + 1 ;
+   /** Increment the disk-pointer **/
+   block_offset.offset += count * (ADF_NAME_LENGTH + DISK_POINTER_SIZE) ;
+   ADFI_adjust_disk_pointer( &block_offset, error_return ) ;
+   CHECK_ADF_ABORT( *error_return ) ;
    } /* end for */
 } /* end of ADF_Children_Names */
 /* end of file ADF_Children_Names.c */
@@ -379,11 +396,11 @@ void    ADF_Children_IDs (
         double *IDs,
         int *error_return )
 {
-int                         i ;
+int                         i, n, count, last ;
 unsigned int                file_index ;
 struct DISK_POINTER         block_offset ;
 struct NODE_HEADER          node ;
-struct SUB_NODE_TABLE_ENTRY sub_node_table_entry ;
+struct SUB_NODE_TABLE_ENTRY sub_node_table[CHILDREN_PER_READ] ;
 double                      LID ;
 
 *error_return = NO_ERROR ;
@@ -419,25 +436,29 @@ block_offset.offset = node.sub_node_table.offset +
                       (ADF_NAME_LENGTH + DISK_POINTER_SIZE) * (istart-1)) ;
 
    /** Return the data for the requested children **/
-for( i=(istart-1); i< MIN(istart-1+imax_num, (int) node.num_sub_nodes); i++ ) {
-   ADFI_adjust_disk_pointer( &block_offset, error_return ) ;
-   CHECK_ADF_ABORT( *error_return ) ;
-
-   /** Read the sub-node entry table **/
-   ADFI_read_sub_node_table_entry(  file_index, &block_offset,
-                &sub_node_table_entry, error_return ) ;
+last = MIN(istart-1+imax_num, (int) node.num_sub_nodes) ;
+for( i=(istart-1); i<last; i+=count ) {
+   /** Read the sub-node table entries **/
+   count = MIN(last-i, CHILDREN_PER_READ) ;
+   ADFI_read_sub_node_entries( file_index, &block_offset, count,
+                sub_node_table, error_return ) ;
    CHECK_ADF_ABORT( *error_return ) ;
+   ADFI_prefetch_node_headers( file_index, count, sub_node_table ) ;
+
+   for( n=0; n<count; n++ ) {
+      /** Get the ID from the sub-node table **/
+      ADFI_file_block_offset_2_ID( file_index,
+                sub_node_table[n].child_location.block,
+                sub_node_table[n].child_location.offset,
+                &IDs[i+n-(istart-1)], error_return ) ;
+      CHECK_ADF_ABORT( *error_return ) ;
+      *inum_ret = *inum_ret + 1 ;
+      } /* end for */
 
-    /** Get the ID from the sub-node table **/
-   ADFI_file_block_offset_2_ID( file_index,
-                sub_node_table_entry.child_location.block,
-                sub_node_table_entry.child_location.offset,
-                &IDs[i-(istart-1)], error_return ) ;
+   /** Increment the disk-pointer **/
+   block_offset.offset += count * (ADF_NAME_LENGTH + DISK_POINTER_SIZE) ;
+   ADFI_adjust_disk_pointer( &block_offset, error_return ) ;
    CHECK_ADF_ABORT( *error_return ) ;
-
-   /** Increment the disk-pointer and the number of IDs returned **/
-   block_offset.offset += (ADF_NAME_LENGTH + DISK_POINTER_SIZE) ;
-   *inum_ret = *inum_ret + 1 ;
    } /* end for */
 } /* end of ADF_Children_IDs */
 /* end of file ADF_Children_IDs.c */
@@ -530,8 +551,8 @@ for ( i=0; i < name_length; i++ ) {
 strncpy( child_node.name, &name[ name_start ], name_length ) ;
 
 	/** Allocate disk space for the new node **/
-ADFI_file_malloc( file_index, NODE_HEADER_SIZE, &child_block_offset,
-	error_return ) ;
+ADFI_file_malloc( file_index, FILE_NODE_HEADER_SIZE( file_index ),
+	&child_block_offset, error_return ) ;
 CHECK_ADF_ABORT( *error_return ) ;
 
 	/** Write out the new node header **/
@@ -741,6 +762,12 @@ input:  const char *format	Specifies the numeric format for the
 	IEEE_BIG - Use the IEEE big ENDIAN format.
 	IEEE_LITTLE - Use the IEEE little ENDIAN format.
 	CRAY - Use the native Cray format.
+	LEGACY - Create a version A file (ASCII pointers, 32-bit
+		dimensions) in the machine's native format.
+	COMPACT - Create a version C file in the machine's native
+		format.  Node headers are 212 bytes of binary integers
+		instead of 246 bytes of mostly ASCII-Hex, and data-types
+		are limited to 8 characters.
 
 output:  double *root_ID	Root-ID of the opened ADF database.
 output:  int *error_return	Error return.
@@ -759,7 +786,7 @@ void	ADF_Database_Open(
 		double *Root_ID,
 		int *error_return )
 {
-int                 iret, legacy = 0 ;
+int                 iret, legacy = 0, compact = 0 ;
 int                 error_dummy ;
 char                machine_format, format_to_use, os_to_use ;
 char                *status ;
@@ -837,11 +864,13 @@ else if( (ADFI_stridx_c( status, "NEW" ) == 0) ||
       } /* end if */
    } /* end if */
 
-   if (ADFI_stridx_c(format, "LEGACY") == 0) legacy = 1;
+   if (ADFI_stridx_c(format, LEGACY_FORMAT_STRING) == 0) legacy = 1;
+   else if (ADFI_stridx_c(format, COMPACT_FORMAT_STRING) == 0) compact = 1;
 
 		/** Compose the file header **/
    ADFI_fill_initial_file_header( format_to_use, os_to_use, legacy ?
-				  ADF_A_identification :
+				  ADF_A_identification : compact ?
+				  ADF_C_identification :
 				  ADF_D_identification,
 				  &file_header, error_return ) ;
    CHECK_ADF_ABORT( *error_return ) ;
@@ -852,6 +881,7 @@ else if( (ADFI_stridx_c( status, "NEW" ) == 0) ||
 
    /* need this to write header */
    ADF_file[file_index].old_version = (char)legacy;
+   ADF_file[file_index].compact = (char)compact;
    ADF_file[file_index].format  = format_to_use;
    ADF_file[file_index].os_size = os_to_use;
 
@@ -897,6 +927,8 @@ if( file_header.tag0[0] == '\0' ) {
    support both versions. */
       if (file_header.what[25] == 'A')
          ADF_file[file_index].old_version = 1 ;
+      else if (file_header.what[25] == 'C')
+         ADF_file[file_index].compact = 1 ;
       else {
          *error_return = INVALID_VERSION ;
          goto Open_Error ;
@@ -1311,6 +1343,8 @@ to be flushed to the physical disk.  This ensures that data will not
 be lost if a program aborts.  This control of when to flush all data
 to disk is provided to the user rather than to flush the data every
 time it is modified, which would result in reduced performance.
+If ADF_Set_Merge_Chunks is on, data written in several data-chunks
+is first merged into one chunk per node.
 
 ADF_Flush_to_Disk( ID, error_return )
 input:  const double ID		The ID of a node in the ADF file to flush.
@@ -1329,6 +1363,12 @@ struct NODE_HEADER   node ;
                     error_return ) ;
    CHECK_ADF_ABORT( *error_return ) ;
 
+   ADFI_merge_data_chunks( file_index, error_return ) ;
+   CHECK_ADF_ABORT( *error_return ) ;
+
+   ADFI_flush_modification_date( file_index, error_return ) ;
+   CHECK_ADF_ABORT( *error_return ) ;
+
    ADFI_fflush_file( file_index, error_return ) ;
    CHECK_ADF_ABORT( *error_return ) ;
 } /* end of ADF_Flush_to_Disk */
@@ -1973,6 +2013,79 @@ CHECK_ADF_ABORT( *error_return ) ;
 
 } /* end of ADF_Get_Root_ID */
 /* end of file ADF_Get_Root_ID.c */
+/* file ADF_Get_Node_Location.c */
+/***********************************************************************
+ADF_Get_Node_Location:
+	Get the location (block and offset) of a node within its file.
+	Unlike the ID, the location does not depend on the order in
+	which the files were opened, so it may be saved across sessions.
+
+input:  const double ID		The ID of the node to use.
+output: cgulong_t *block	The block within the file.
+output: cgulong_t *offset	The offset within the block.
+output: int *error_return	Error return.
+***********************************************************************/
+void	ADF_Get_Node_Location(
+		const double ID,
+		cgulong_t *block,
+		cgulong_t *offset,
+		int *error_return )
+{
+unsigned int		file_index ;
+
+if( (block == NULL) || (offset == NULL) ) {
+   *error_return = NULL_POINTER ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+
+*error_return = NO_ERROR ;
+
+ADFI_ID_2_file_block_offset( ID, &file_index, block, offset,
+		error_return ) ;
+CHECK_ADF_ABORT( *error_return ) ;
+
+} /* end of ADF_Get_Node_Location */
+/* end of file ADF_Get_Node_Location.c */
+/* file ADF_Get_Location_ID.c */
+/***********************************************************************
+ADF_Get_Location_ID:
+	Get the ID of the node at a given location (block and offset)
+	in the same file as ID. This is the inverse of
+	ADF_Get_Node_Location; the location is not checked to hold a node.
+
+input:  const double ID		The ID of any node in the file.
+input:  const cgulong_t block	The block within the file.
+input:  const cgulong_t offset	The offset within the block.
+output: double *Node_ID		The ID of the node at the location.
+output: int *error_return	Error return.
+***********************************************************************/
+void	ADF_Get_Location_ID(
+		const double ID,
+		const cgulong_t block,
+		const cgulong_t offset,
+		double *Node_ID,
+		int *error_return )
+{
+unsigned int		file_index ;
+struct DISK_POINTER	block_offset ;
+
+if( Node_ID == NULL ) {
+   *error_return = NULL_POINTER ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+
+*error_return = NO_ERROR ;
+
+ADFI_ID_2_file_block_offset( ID, &file_index, &block_offset.block,
+		&block_offset.offset, error_return ) ;
+CHECK_ADF_ABORT( *error_return ) ;
+
+ADFI_file_block_offset_2_ID( file_index, block, offset, Node_ID,
+		error_return ) ;
+CHECK_ADF_ABORT( *error_return ) ;
+
+} /* end of ADF_Get_Location_ID */
+/* end of file ADF_Get_Location_ID.c */
 /* file ADF_Is_Link.c */
 /***********************************************************************
 ADF Is Link:
@@ -2365,6 +2478,15 @@ if( dim_vals == NULL && dims > 0 ) {
 ADFI_chase_link( ID, &LID, &file_index,  &block_offset, &node, error_return ) ;
 CHECK_ADF_ABORT( *error_return ) ;
 
+	/** Version C node headers only have room for a short data-type **/
+if( ADF_file[file_index].compact ) {
+   for( i=(int)strlen( data_type ); i>0 && data_type[i-1] == ' '; i-- ) ;
+   if( i > COMPACT_DATA_TYPE_LENGTH ) {
+      *error_return = DATA_TYPE_TOO_LONG ;
+      CHECK_ADF_ABORT( *error_return ) ;
+      } /* end if */
+   } /* end if */
+
 	/** Check new datatype **/
 ADFI_evaluate_datatype( file_index, data_type,
 	&file_bytes[0], &machine_bytes[0],
@@ -2577,6 +2699,9 @@ ADFI_write_sub_node_table_entry( file_index, &sub_node_entry_location,
 	&sub_node_entry, error_return ) ;
 CHECK_ADF_ABORT( *error_return ) ;
 
+	/** Links through this node now resolve differently **/
+ADFI_clear_link_cache( -1 ) ;
+
 	/** Finally, update modification date **/
 ADFI_write_modification_date( file_index, error_return ) ;
 CHECK_ADF_ABORT( *error_return ) ;
@@ -2706,6 +2831,161 @@ else {
 
 } /* end of ADF_Read_All_Data */
 /* end of file ADF_Read_All_Data.c */
+/* file ADF_Read_Batch.c */
+/***********************************************************************
+ADF Read Batch:
+
+Read the data of many Nodes in one call.  Each request is a node and
+either all of its data (a b_start less than 1) or a block of it, as for
+ADF_Read_Block_Data.  The node headers are read in file order, nearby
+headers together, and then the requests are sorted by where their data
+is in the file.  The data of nodes held in a single data-chunk is read a
+run of nearby chunks at a time, so a run of small nodes costs one read.
+The other requests are read on their own, in the same file order.
+
+ADF_Read_Batch( count, IDs, b_starts, b_ends, data, errors, error_return )
+input:  const int count		The number of requests.
+input:  const double IDs[]	The ID of the node of each request.
+input:  const cgsize_t b_starts[] The start of each block, < 1 for all data.
+input:  const cgsize_t b_ends[]	The end of each block.
+output: char *data[]		The buffer of each request.
+output: int errors[]		The error of each request.
+output: int *error_return	Error return, the first error of a request.
+***********************************************************************/
+void	ADF_Read_Batch(
+		const int count,
+		const double IDs[],
+		const cgsize_t b_starts[],
+		const cgsize_t b_ends[],
+		char *data[],
+		int errors[],
+		int *error_return )
+{
+unsigned int            file_index ;
+struct DISK_POINTER	block_offset ;
+struct NODE_HEADER	node ;
+struct TOKENIZED_DATA_TYPE
+		tokenized_data_type[ 1 + (ADF_DATA_TYPE_LENGTH + 1)/3 ] ;
+struct	BATCH_ENTRY	*entries ;
+
+char			file_format, machine_format ;
+int			file_bytes, memory_bytes, format_compare ;
+cglong_t		total_bytes ;
+int			i, j, k, n, err ;
+double			LID ;
+
+if( IDs == NULL || b_starts == NULL || b_ends == NULL || data == NULL ||
+    errors == NULL ) {
+   *error_return = NULL_POINTER ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+
+*error_return = NO_ERROR ;
+if( count <= 0 ) return ;
+
+entries = (struct BATCH_ENTRY *) malloc( count * sizeof( *entries ) ) ;
+if( entries == NULL ) {
+   *error_return = MEMORY_ALLOCATION_FAILED ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+
+	/** Read the node headers in file order, runs of nearby headers
+	    at a time **/
+for( i=0; i<count; i++ ) {
+   errors[i] = NO_ERROR ;
+   entries[i].request = i ;
+   entries[i].file_index = 0 ;
+   entries[i].start.block = 0 ;
+   entries[i].start.offset = 0 ;
+   entries[i].bytes = 0 ;
+   entries[i].batched = 0 ;
+   ADFI_ID_2_file_block_offset( IDs[i], &entries[i].file_index,
+	&entries[i].start.block, &entries[i].start.offset, &err ) ;
+   if( err == NO_ERROR && (int)entries[i].file_index < maximum_files &&
+       ADF_file[entries[i].file_index].in_use ) {
+      entries[i].bytes = FILE_NODE_HEADER_SIZE( entries[i].file_index ) ;
+      entries[i].batched = 1 ;
+      } /* end if */
+   } /* end for */
+ADFI_sort_batch( count, entries ) ;
+
+	/** Find the data of each request.  Only whole reads of data in one
+	    chunk, as it is in memory, are batched; the errors of the rest
+	    are left to the read of each on its own **/
+for( n=0; n<count; n=k ) {
+   k = n + ADFI_batch_run_length( count - n, &entries[n], 0 ) ;
+   if( k - n > BATCH_HEADER_MAXIMUM ) k = n + BATCH_HEADER_MAXIMUM ;
+   if( k - n > 1 )
+      ADFI_stack_batch_headers( k - n, &entries[n], &err ) ;
+
+   for( ; n<k; n++ ) {
+      i = entries[n].request ;
+      entries[n].bytes = 0 ;
+      entries[n].batched = 0 ;
+      ADFI_chase_link( IDs[i], &LID, &file_index, &block_offset, &node,
+		       &err ) ;
+      if( err != NO_ERROR ) continue ;
+      entries[n].file_index = file_index ;
+      entries[n].start = node.data_chunks ;
+      if( b_starts[i] > 0 || data[i] == NULL ||
+          node.number_of_data_chunks != 1 ) continue ;
+
+      ADFI_evaluate_datatype( file_index, node.data_type, &file_bytes,
+	   &memory_bytes, tokenized_data_type, &file_format, &machine_format,
+	   &err ) ;
+      if( err != NO_ERROR || file_bytes == 0 ||
+          node.number_of_dimensions == 0 ) continue ;
+      total_bytes = file_bytes ;
+      for( j=0; j<(int)node.number_of_dimensions; j++ )
+         total_bytes *= node.dimension_values[j] ;
+      if( total_bytes <= 0 ) continue ;
+
+      ADFI_file_and_machine_compare( file_index, tokenized_data_type,
+			             &format_compare, &err );
+      if( err != NO_ERROR || format_compare != 1 ) continue ;
+
+      entries[n].bytes = total_bytes ;
+      entries[n].batched = 1 ;
+      } /* end for */
+   } /* end for */
+
+	/** Then read the data in file order, with runs of nearby chunks
+	    read as one **/
+ADFI_sort_batch( count, entries ) ;
+for( n=0; n<count; n=k ) {
+   k = n + ADFI_batch_run_length( count - n, &entries[n],
+				  2 * TAG_SIZE + DISK_POINTER_SIZE ) ;
+   if( entries[n].batched ) {
+      ADFI_read_batch_run( k - n, &entries[n], data, &err ) ;
+      if( err != NO_ERROR ) {
+         for( j=n; j<k; j++ )
+            entries[j].batched = 0 ;
+         } /* end if */
+      } /* end if */
+
+	/** What was not batched, or did not read as a plain chunk **/
+   for( j=n; j<k; j++ ) {
+      if( entries[j].batched ) continue ;
+      i = entries[j].request ;
+      if( b_starts[i] > 0 )
+         ADF_Read_Block_Data( IDs[i], b_starts[i], b_ends[i], data[i],
+			      &errors[i] ) ;
+      else
+         ADF_Read_All_Data( IDs[i], data[i], &errors[i] ) ;
+      } /* end for */
+   } /* end for */
+
+free( entries ) ;
+
+for( i=0; i<count; i++ ) {
+   if( errors[i] != NO_ERROR ) {
+      *error_return = errors[i] ;
+      break ;
+      } /* end if */
+   } /* end for */
+
+} /* end of ADF_Read_Batch */
+/* end of file ADF_Read_Batch.c */
 /* file ADF_Read_Block_Data.c */
 /***********************************************************************
 ADF Read Block Data:
@@ -2931,10 +3211,13 @@ int           i ;
 int	      file_bytes = 0 ;
 int	      memory_bytes = 0 ;
 int	      no_data = FALSE ;
+int	      compressed = FALSE ;
+char	      tag[TAG_SIZE+1] ;
 double        LID ;
 cgulong_t relative_offset = 0, current_chunk_size = 0,
               past_chunk_sizes = 0, current_chunk = 0, disk_elem ;
 struct DATA_CHUNK_TABLE_ENTRY   *data_chunk_table = NULL;
+cgulong_t     *chunk_offsets = NULL;
 
 if( (s_start == NULL) || (s_end == NULL) || (s_stride == NULL) ||
     (m_dims == NULL) || (m_start == NULL) || (m_end == NULL) ||
@@ -2990,6 +3273,14 @@ if( node.number_of_data_chunks == 0  ) {
    } /* end if */
 	/** Check for multiple data-chunks **/
 else if( node.number_of_data_chunks == 1 ) { /** A single data chunk **/
+	/** Compressed data is read a block at a time, by data offset **/
+   ADFI_read_file( file_index, node.data_chunks.block,
+		   node.data_chunks.offset, TAG_SIZE, tag, error_return ) ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   tag[TAG_SIZE] = '\0' ;
+   compressed = ADFI_stridx_c( tag, compressed_chunk_start_tag ) == 0 ;
+   relative_offset = disk_offset * file_bytes ;
+
 	/** Point to the start of the data **/
    block_offset.block = node.data_chunks.block ;
    block_offset.offset = node.data_chunks.offset + TAG_SIZE +
@@ -3014,11 +3305,17 @@ else if( node.number_of_data_chunks > 1 ) {	/** Multiple data chunks **/
                 data_chunk_table, error_return ) ;
    CHECK_ADF_ABORT( *error_return ) ;
 
-   current_chunk_size = (data_chunk_table[ current_chunk ].end.block -
-	data_chunk_table[ current_chunk ].start.block) * DISK_BLOCK_SIZE +
-	(data_chunk_table[ current_chunk ].end.offset -
-		data_chunk_table[ current_chunk ].start.offset) -
-	(TAG_SIZE + DISK_POINTER_SIZE) ;
+	/** Offsets of the chunks in the data, for finding the chunk of
+	    an element by binary search **/
+   chunk_offsets = (cgulong_t *)
+	malloc( (node.number_of_data_chunks + 1) * sizeof( *chunk_offsets ) ) ;
+   if( chunk_offsets == NULL ) {
+      *error_return = MEMORY_ALLOCATION_FAILED ;
+      CHECK_ADF_ABORT( *error_return ) ;
+      } /* end if */
+   ADFI_data_chunk_offsets( node.number_of_data_chunks, data_chunk_table,
+		chunk_offsets, error_return ) ;
+   CHECK_ADF_ABORT( *error_return ) ;
 
    } /* end else if */
 
@@ -3043,7 +3340,14 @@ for( disk_elem=0; disk_elem<total_disk_elements; disk_elem++ ) {
         CHECK_ADF_ABORT( *error_return ) ;
         } /* end if */
 
-      if( formats_compare ) {
+      if( compressed ) {
+      /** Expand the block holding the data, or use the last one **/
+         ADFI_read_compressed_chunk( file_index, &node.data_chunks,
+            tokenized_data_type, file_bytes, relative_offset, file_bytes,
+            data, error_return ) ;
+         CHECK_ADF_ABORT( *error_return ) ;
+      } /* end if */
+      else if( formats_compare ) {
       /** Read the data off of disk directly **/
          ADFI_read_file( file_index, block_offset.block, block_offset.offset,
             file_bytes, (char *)data, error_return ) ;
@@ -3075,6 +3379,7 @@ for( disk_elem=0; disk_elem<total_disk_elements; disk_elem++ ) {
 	}  /* end else */
 
          block_offset.offset += disk_offset * file_bytes ;
+         relative_offset += disk_offset * file_bytes ;
          if ( block_offset.offset > DISK_BLOCK_SIZE ) {
            ADFI_adjust_disk_pointer( &block_offset, error_return ) ;
            CHECK_ADF_ABORT( *error_return ) ;
@@ -3082,20 +3387,18 @@ for( disk_elem=0; disk_elem<total_disk_elements; disk_elem++ ) {
          } /* end if */
       } /* end else if */
    else if( node.number_of_data_chunks > 1 ) {	/** Multiple data chunks **/
-      while( relative_offset >= past_chunk_sizes + current_chunk_size ) {
-	 if( ++current_chunk >= node.number_of_data_chunks ) {
+	/** Find the data-chunk holding this element **/
+      if( relative_offset >= past_chunk_sizes + current_chunk_size ) {
+	 current_chunk = ADFI_find_data_chunk( node.number_of_data_chunks,
+			chunk_offsets, relative_offset ) ;
+	 if( current_chunk >= node.number_of_data_chunks ) {
 	    *error_return = INCOMPLETE_DATA ;
             CHECK_ADF_ABORT( *error_return ) ;
 	    } /* end if */
-	 else {
-	    past_chunk_sizes += current_chunk_size ;
-   	    current_chunk_size = (data_chunk_table[ current_chunk ].end.block -
-	      data_chunk_table[ current_chunk ].start.block) * DISK_BLOCK_SIZE +
-		(data_chunk_table[ current_chunk ].end.offset -
-		data_chunk_table[ current_chunk ].start.offset) -
-		(TAG_SIZE + DISK_POINTER_SIZE) ;
-	    } /* end else */
-	 } /* end while */
+	 past_chunk_sizes = chunk_offsets[ current_chunk ] ;
+	 current_chunk_size = chunk_offsets[ current_chunk + 1 ] -
+			      past_chunk_sizes ;
+	 } /* end if */
 
 	/** Get the data off of disk **/
       relative_block.block = data_chunk_table[ current_chunk ].start.block ;
@@ -3159,11 +3462,337 @@ for( disk_elem=0; disk_elem<total_disk_elements; disk_elem++ ) {
       } /* end if */
    } /* end for */
 
-if( node.number_of_data_chunks > 1 ) /** Multiple data chunks **/
+if( node.number_of_data_chunks > 1 ) { /** Multiple data chunks **/
    free( data_chunk_table ) ;
+   free( chunk_offsets ) ;
+   } /* end if */
 
 } /* end of ADF_Read_Data */
 /* end of file ADF_Read_Data.c */
+/* file ADF_Read_Indices.c */
+/***********************************************************************
+ADF Read Indices:
+
+Read a list of points from a Node.  Each index is a 1-based position in
+the node's data, counted as for ADF_Read_Block_Data, and the points are
+returned in the order of the list.  The indices are sorted and points
+close to each other are read as one run, so the cost depends on the
+number of points and not on the size of the data.
+
+ADF_Read_Indices( ID, num, indices, data, error_return )
+input:  const double ID		The ID of the node to use.
+input:  const cgsize_t num	The number of points to read.
+input:  const cgsize_t indices[]  The 1-based indices of the points.
+output: char *data		The start of the data in memory.
+output: int *error_return	Error return.
+***********************************************************************/
+void	ADF_Read_Indices(
+		const double ID,
+		const cgsize_t num,
+		const cgsize_t indices[],
+		char *data,
+		int *error_return )
+{
+unsigned int            file_index ;
+struct DISK_POINTER	block_offset ;
+struct NODE_HEADER	node ;
+struct TOKENIZED_DATA_TYPE
+		tokenized_data_type[ 1 + (ADF_DATA_TYPE_LENGTH + 1)/3 ] ;
+struct	DATA_CHUNK_TABLE_ENTRY	*data_chunk_table = NULL ;
+struct	DATA_EXTENT	*extents ;
+struct	INDEX_ENTRY	*entries ;
+char	*run_data ;
+
+char			file_format, machine_format ;
+int			file_bytes, memory_bytes ;
+cglong_t		total_bytes, max_points ;
+cgsize_t		n, k, first, last, run_points ;
+int			j, incomplete = 0 ;
+double			LID ;
+
+if( data == NULL || indices == NULL ) {
+   *error_return = NULL_POINTER ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+
+if( num < 0 ) {
+   *error_return = NUMBER_LESS_THAN_MINIMUM ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+
+*error_return = NO_ERROR ;
+if( num == 0 ) return ;
+
+ADFI_chase_link( ID, &LID, &file_index,  &block_offset, &node, error_return ) ;
+CHECK_ADF_ABORT( *error_return ) ;
+
+	/** Get datatype size **/
+ADFI_evaluate_datatype( file_index, node.data_type, &file_bytes, &memory_bytes,
+	tokenized_data_type, &file_format, &machine_format, error_return ) ;
+CHECK_ADF_ABORT( *error_return ) ;
+
+if( (file_bytes == 0) || (node.number_of_dimensions == 0) ) {
+   *error_return = NO_DATA ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+
+	/** Calculate total number of bytes in the data **/
+total_bytes = file_bytes ;
+for( j=0; j<(int)node.number_of_dimensions; j++ )
+   total_bytes *= node.dimension_values[j] ;
+if( total_bytes == 0 ) {
+   *error_return = ZERO_DIMENSIONS ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+
+	/** Sort the indices into file order, checking the range **/
+entries = (struct INDEX_ENTRY *) malloc( (size_t)num * sizeof( *entries ) ) ;
+if( entries == NULL ) {
+   *error_return = MEMORY_ALLOCATION_FAILED ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+ADFI_sort_indices( num, indices, (cgsize_t)(total_bytes / file_bytes),
+		   entries, error_return ) ;
+if( *error_return != NO_ERROR )
+   free( entries ) ;
+CHECK_ADF_ABORT( *error_return ) ;
+
+	/** If there is NO DATA, fill data space with zeros, return error **/
+if( node.number_of_data_chunks == 0  ) {
+   free( entries ) ;
+   memset( data, 0, (size_t)num * memory_bytes ) ;
+   *error_return = NO_DATA ;
+   return ;	/** NO_DATA is really a warning, so don't check & abort... **/
+   } /* end if */
+
+	/** Find the data of each chunk once for all the runs **/
+extents = (struct DATA_EXTENT *)
+   malloc( node.number_of_data_chunks * sizeof( *extents ) ) ;
+if( extents == NULL ) {
+   free( entries ) ;
+   *error_return = MEMORY_ALLOCATION_FAILED ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+if( node.number_of_data_chunks > 1 ) {
+   data_chunk_table = (struct  DATA_CHUNK_TABLE_ENTRY *)
+   malloc( node.number_of_data_chunks * sizeof( *data_chunk_table ) ) ;
+   if( data_chunk_table == NULL ) {
+      *error_return = MEMORY_ALLOCATION_FAILED ;
+      } /* end if */
+   else {
+      ADFI_read_data_chunk_table( file_index, &node.data_chunks,
+   				data_chunk_table, error_return ) ;
+      } /* end else */
+   } /* end if */
+if( *error_return == NO_ERROR ) {
+   ADFI_map_data_chunks( file_index, &node, data_chunk_table, extents,
+			 error_return ) ;
+   } /* end if */
+if( data_chunk_table != NULL ) free( data_chunk_table ) ;
+if( *error_return != NO_ERROR ) {
+   free( extents ) ;
+   free( entries ) ;
+   } /* end if */
+CHECK_ADF_ABORT( *error_return ) ;
+
+max_points = INDEX_RUN_MAXIMUM / file_bytes ;
+if( max_points < 1 ) max_points = 1 ;
+run_data = (char *) malloc( (size_t)(max_points * memory_bytes) ) ;
+if( run_data == NULL ) {
+   *error_return = MEMORY_ALLOCATION_FAILED ;
+   } /* end if */
+
+	/** Read each run of nearby points and scatter it into place **/
+for( n=0; n<num && *error_return == NO_ERROR; n=k ) {
+   first = last = entries[n].index ;
+   for( k=n+1; k<num; k++ ) {
+      if( (cglong_t)(entries[k].index - last) * file_bytes > INDEX_RUN_GAP ||
+	  entries[k].index - first >= max_points )
+	 break ;
+      last = entries[k].index ;
+      } /* end for */
+   run_points = last - first + 1 ;
+
+   ADFI_read_data_extents( file_index, (int)node.number_of_data_chunks,
+		extents, tokenized_data_type, file_bytes, memory_bytes,
+		(cglong_t)file_bytes * (first - 1),
+		(cglong_t)file_bytes * run_points, run_data, error_return ) ;
+   if( *error_return == INCOMPLETE_DATA ) {
+      incomplete = 1 ;
+      *error_return = NO_ERROR ;
+      } /* end if */
+   if( *error_return != NO_ERROR )
+      break ;
+
+   for( ; n<k; n++ )
+      memcpy( data + (size_t)entries[n].position * memory_bytes,
+	      run_data + (size_t)(entries[n].index - first) * memory_bytes,
+	      memory_bytes ) ;
+   } /* end for */
+
+if( run_data != NULL ) free( run_data ) ;
+free( extents ) ;
+free( entries ) ;
+CHECK_ADF_ABORT( *error_return ) ;
+if( incomplete )
+   *error_return = INCOMPLETE_DATA ;
+
+} /* end of ADF_Read_Indices */
+/* end of file ADF_Read_Indices.c */
+/* file ADF_Reserve_Data.c */
+/***********************************************************************
+ADF Reserve Data:
+
+Reserve the disk space for a Node's data before it is written.  The
+size comes from the node's data-type and dimensions, so those must be
+set first (ADF_Put_Dimension_Information).  The data-chunk is allocated
+and its disk space reserved at once, where the system supports it; the
+data may then be written in pieces with ADF_Write_Data or
+ADF_Write_Block_Data without the file growing as it goes.  If the node
+already has data, nothing is done.
+
+ADF_Reserve_Data( ID, error_return )
+input:  const double ID		The ID of the node to use.
+output: int *error_return	Error return.
+***********************************************************************/
+void	ADF_Reserve_Data(
+		const double ID,
+		int *error_return )
+{
+unsigned int            file_index ;
+struct DISK_POINTER	block_offset ;
+struct NODE_HEADER	node ;
+struct TOKENIZED_DATA_TYPE
+		tokenized_data_type[ 1 + (ADF_DATA_TYPE_LENGTH + 1)/3 ] ;
+int			file_bytes, memory_bytes ;
+cglong_t		total_bytes, start_offset, head_bytes, tail_start ;
+int			j ;
+char			file_format, machine_format ;
+double			LID ;
+
+*error_return = NO_ERROR ;
+
+ADFI_chase_link( ID, &LID, &file_index,  &block_offset, &node, error_return ) ;
+CHECK_ADF_ABORT( *error_return ) ;
+
+	/** Nothing to do if the data already has disk space **/
+if( node.number_of_data_chunks != 0 )
+   return ;
+
+	/** Get the datatype length **/
+ADFI_evaluate_datatype( file_index, node.data_type, &file_bytes, &memory_bytes,
+	tokenized_data_type, &file_format, &machine_format, error_return ) ;
+CHECK_ADF_ABORT( *error_return ) ;
+
+	/** Calculate the total number of data bytes **/
+total_bytes = file_bytes ;
+for( j=0; j<(int)node.number_of_dimensions; j++ )
+   total_bytes *= node.dimension_values[j] ;
+if( total_bytes == 0 ) {
+   *error_return = ZERO_DIMENSIONS ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+
+	/** Allocate and reserve the disk space **/
+ADFI_file_malloc( file_index,
+		total_bytes + TAG_SIZE + TAG_SIZE + DISK_POINTER_SIZE,
+		&node.data_chunks, error_return ) ;
+CHECK_ADF_ABORT( *error_return ) ;
+
+ADFI_file_reserve( file_index, &node.data_chunks,
+		total_bytes + TAG_SIZE + TAG_SIZE + DISK_POINTER_SIZE,
+		error_return ) ;
+CHECK_ADF_ABORT( *error_return ) ;
+
+	/** Write the tags of the data-chunk.  The data in the first and
+	    last disk blocks is zeroed, since partly used blocks are
+	    otherwise padded with blanks; the blocks in between read as
+	    zeros until they are written. **/
+start_offset = (node.data_chunks.offset + TAG_SIZE + DISK_POINTER_SIZE) %
+		DISK_BLOCK_SIZE ;
+head_bytes = MIN( total_bytes, DISK_BLOCK_SIZE - start_offset ) ;
+ADFI_write_data_chunk( file_index, &node.data_chunks, tokenized_data_type,
+		file_bytes, total_bytes, 0, head_bytes, NULL, error_return ) ;
+CHECK_ADF_ABORT( *error_return ) ;
+
+tail_start = total_bytes - (start_offset + total_bytes) % DISK_BLOCK_SIZE ;
+if( tail_start > head_bytes ) {
+   ADFI_write_data_chunk( file_index, &node.data_chunks, tokenized_data_type,
+		file_bytes, total_bytes, tail_start, total_bytes - tail_start,
+		NULL, error_return ) ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+
+	/** Record the modified the node-header **/
+node.number_of_data_chunks = 1 ;
+ADFI_write_node_header( file_index, &block_offset, &node, error_return ) ;
+CHECK_ADF_ABORT( *error_return ) ;
+
+	/** Finally, update modification date **/
+ADFI_write_modification_date( file_index, error_return ) ;
+CHECK_ADF_ABORT( *error_return ) ;
+
+} /* end of ADF_Reserve_Data */
+/* end of file ADF_Reserve_Data.c */
+/* file ADF_Set_Compress.c */
+/***********************************************************************
+ADF Set Compress:
+
+Set Compress.  Data of at least compress_size bytes written to a node
+in one piece (ADF_Write_All_Data) is stored compressed, in blocks of
+about 64K, so that partial reads only expand the blocks they need.
+Data which doesn't compress, or which is not in the format of this
+machine, is stored as usual.  Partial writes to compressed data first
+expand it again.  Set to 0 (the default) to never compress.  Files
+with compressed data can't be read by older versions of the library.
+
+ADF_Set_Compress( compress_size, error_return )
+input:  const cglong_t compress_size	Smallest data, in bytes, to
+				compress, or 0 for none.
+output: int *error_return	Error return.
+***********************************************************************/
+void	ADF_Set_Compress(
+		const cglong_t compress_size,
+		int *error_return )
+{
+*error_return = NO_ERROR ;
+if( compress_size < 0 ) {
+   *error_return = BAD_COMPRESS_SIZE ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+ADF_compress_size = compress_size ;
+
+} /* end of ADF_Set_Compress */
+/* end of file ADF_Set_Compress.c */
+/* file ADF_Set_Direct_IO.c */
+/***********************************************************************
+ADF Set Direct IO:
+
+Set Direct IO.  Reads and writes of at least direct_io_size bytes,
+such as those of large data arrays, bypass the system file cache
+(O_DIRECT), so that they don't push everything else out of it.  Node
+headers and other small pieces of the file are still cached.  Set to
+0 (the default) to cache everything.  Has no effect on systems
+without O_DIRECT, or on file systems which don't support it.
+
+ADF_Set_Direct_IO( direct_io_size, error_return )
+input:  const cglong_t direct_io_size	Smallest transfer, in bytes, to
+				do with direct I/O, or 0 for none.
+output: int *error_return	Error return.
+***********************************************************************/
+void	ADF_Set_Direct_IO(
+		const cglong_t direct_io_size,
+		int *error_return )
+{
+*error_return = NO_ERROR ;
+if( direct_io_size < 0 ) {
+   *error_return = BAD_DIRECT_IO_SIZE ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+ADF_direct_io_size = direct_io_size ;
+
+} /* end of ADF_Set_Direct_IO */
+/* end of file ADF_Set_Direct_IO.c */
 /* file ADF_Set_Error_State.c */
 /***********************************************************************
 ADF Set Error State:
@@ -3193,6 +3822,37 @@ else {
 
 } /* end of ADF_Set_Error_State */
 /* end of file ADF_Set_Error_State.c */
+/* file ADF_Set_Header_Sync.c */
+/***********************************************************************
+ADF Set Header Sync:
+
+Set Header Sync.  Set when the modification date and file version in
+the header of a modified file are written.  By default (0) they are
+only written when the file is flushed (ADF_Flush_to_Disk) or closed;
+otherwise (1) they are written, and the write buffer flushed, after
+every change to the file.
+
+ADF_Set_Header_Sync( header_sync, error_return )
+input:  const int header_sync	Flag for writing the header after every
+				change (1) or at flush and close (0).
+output: int *error_return	Error return.
+***********************************************************************/
+void	ADF_Set_Header_Sync(
+		const int header_sync,
+		int *error_return )
+{
+*error_return = NO_ERROR ;
+if( header_sync == 0 )
+   ADF_sync_header = FALSE ;
+else if( header_sync == 1 )
+   ADF_sync_header = TRUE ;
+else {
+   *error_return = BAD_HEADER_SYNC ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end else */
+
+} /* end of ADF_Set_Header_Sync */
+/* end of file ADF_Set_Header_Sync.c */
 /* file ADF_Set_Label.c */
 /***********************************************************************
 ADF Set Label:
@@ -3246,6 +3906,98 @@ CHECK_ADF_ABORT( *error_return ) ;
 
 } /* end of ADF_Set_Label */
 /* end of file ADF_Set_Label.c */
+/* file ADF_Set_Merge_Chunks.c */
+/***********************************************************************
+ADF Set Merge Chunks:
+
+Set Merge Chunks.  Data which grows after it is first written, or is
+written in pieces, is stored in several data-chunks scattered through
+the file.  When set (1), the data-chunks of every node written that
+way are merged into a single chunk when the file is flushed
+(ADF_Flush_to_Disk) or closed.  By default (0) they are left as is.
+
+ADF_Set_Merge_Chunks( merge_chunks, error_return )
+input:  const int merge_chunks	Flag for merging data-chunks at flush
+				and close (1) or not (0).
+output: int *error_return	Error return.
+***********************************************************************/
+void	ADF_Set_Merge_Chunks(
+		const int merge_chunks,
+		int *error_return )
+{
+*error_return = NO_ERROR ;
+if( merge_chunks == 0 )
+   ADF_merge_chunks = FALSE ;
+else if( merge_chunks == 1 )
+   ADF_merge_chunks = TRUE ;
+else {
+   *error_return = BAD_MERGE_CHUNKS ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end else */
+
+} /* end of ADF_Set_Merge_Chunks */
+/* end of file ADF_Set_Merge_Chunks.c */
+/* file ADF_Set_Preallocate.c */
+/***********************************************************************
+ADF Set Preallocate:
+
+Set Preallocate.  When a data-chunk of at least preallocate_size bytes
+is allocated, its disk space is reserved at once (posix_fallocate), so
+large arrays get contiguous extents instead of the file growing as
+they are written.  Set to 0 (the default) to never reserve space,
+except with ADF_Reserve_Data.  Has no effect on systems without
+posix_fallocate.
+
+ADF_Set_Preallocate( preallocate_size, error_return )
+input:  const cglong_t preallocate_size	Smallest data-chunk, in bytes,
+				to reserve disk space for, or 0 for none.
+output: int *error_return	Error return.
+***********************************************************************/
+void	ADF_Set_Preallocate(
+		const cglong_t preallocate_size,
+		int *error_return )
+{
+*error_return = NO_ERROR ;
+if( preallocate_size < 0 ) {
+   *error_return = BAD_PREALLOCATE_SIZE ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+ADF_preallocate_size = preallocate_size ;
+
+} /* end of ADF_Set_Preallocate */
+/* end of file ADF_Set_Preallocate.c */
+/* file ADF_Set_Queue_Depth.c */
+/***********************************************************************
+ADF Set Queue Depth:
+
+Set Queue Depth.  Reads and writes of large pieces of data are split
+into smaller requests, up to queue_depth of which are kept in flight at
+once, so that fast disks are kept busy.  The node headers of children
+are also read ahead when their IDs are returned.  Set to 0 or 1 (the
+default) to do one request at a time.  Only used on Linux, through
+io_uring; elsewhere, or where io_uring can't be used, reads and writes
+are done one at a time as usual.
+
+ADF_Set_Queue_Depth( queue_depth, error_return )
+input:  const int queue_depth	Most requests in flight at once,
+				from 0 to QUEUE_DEPTH_MAXIMUM.
+output: int *error_return	Error return.
+***********************************************************************/
+void	ADF_Set_Queue_Depth(
+		const int queue_depth,
+		int *error_return )
+{
+*error_return = NO_ERROR ;
+if( queue_depth < 0 || queue_depth > QUEUE_DEPTH_MAXIMUM ) {
+   *error_return = BAD_QUEUE_DEPTH ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+if( queue_depth != ADF_queue_depth )
+   ADFI_queue_close() ;
+ADF_queue_depth = queue_depth ;
+
+} /* end of ADF_Set_Queue_Depth */
+/* end of file ADF_Set_Queue_Depth.c */
 /* file ADF_Write_All_Data.c */
 /* file ADF_Write_All_Data.c */
 /***********************************************************************
@@ -3277,6 +4029,7 @@ char    		tag[TAG_SIZE+1] ;
 struct DISK_POINTER     data_start, chunk_start, end_of_chunk_tag ;
 cglong_t                    chunk_total_bytes ;
 char			file_format, machine_format ;
+int			compressed ;
 double			LID ;
 
 if( data == NULL ) {
@@ -3303,18 +4056,41 @@ if( total_bytes == 0 ) {
    CHECK_ADF_ABORT( *error_return ) ;
    } /* end if */
 
+	/** Compressed data is always rewritten as a whole **/
+if( node.number_of_data_chunks == 1 ) {
+   ADFI_read_file( file_index, node.data_chunks.block,
+		node.data_chunks.offset, TAG_SIZE, tag, error_return ) ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   tag[TAG_SIZE] = '\0' ;
+   if( ADFI_stridx_c( tag, compressed_chunk_start_tag ) == 0 ) {
+      ADFI_file_free( file_index, &node.data_chunks, 0, error_return ) ;
+      CHECK_ADF_ABORT( *error_return ) ;
+      node.number_of_data_chunks = 0 ;
+      } /* end if */
+   } /* end if */
+
 	/** If there currently is NO data, allocate disk space for it **/
 if( node.number_of_data_chunks == 0  ) {
-   ADFI_file_malloc( file_index,
+   compressed = FALSE ;
+   if( ADF_compress_size > 0 && total_bytes >= ADF_compress_size ) {
+      ADFI_write_compressed_chunk( file_index, tokenized_data_type,
+		file_bytes, total_bytes, data, &node.data_chunks,
+		&compressed, error_return ) ;
+      CHECK_ADF_ABORT( *error_return ) ;
+      } /* end if */
+
+   if( ! compressed ) {
+      ADFI_file_malloc( file_index,
 		total_bytes + TAG_SIZE + TAG_SIZE + DISK_POINTER_SIZE,
 		&node.data_chunks, error_return ) ;
-   CHECK_ADF_ABORT( *error_return ) ;
+      CHECK_ADF_ABORT( *error_return ) ;
 
 	/** Write the new data **/
-   ADFI_write_data_chunk( file_index, &node.data_chunks, tokenized_data_type,
-		file_bytes, total_bytes, 0, total_bytes, data,
-		error_return ) ;
-   CHECK_ADF_ABORT( *error_return ) ;
+      ADFI_write_data_chunk( file_index, &node.data_chunks,
+		tokenized_data_type, file_bytes, total_bytes, 0, total_bytes,
+		data, error_return ) ;
+      CHECK_ADF_ABORT( *error_return ) ;
+      } /* end if */
 
 	/** Record the modified the node-header **/
    node.number_of_data_chunks = 1 ;
@@ -3515,6 +4291,12 @@ else { /** Multiple data chunks **/
 	 free( data_chunk_table ) ;
    } /* end else */
 
+	/** Remember fragmented data, to be merged at flush or close **/
+if( node.number_of_data_chunks > 1 ) {
+   ADFI_remember_data_chunks( file_index, &block_offset, error_return ) ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+
 	/** Finally, update modification date **/
 ADFI_write_modification_date( file_index, error_return ) ;
 CHECK_ADF_ABORT( *error_return ) ;
@@ -3619,6 +4401,19 @@ else if( node.number_of_data_chunks == 1 ) {
    CHECK_ADF_ABORT( *error_return ) ;
    tag[TAG_SIZE] = '\0' ;
 
+	/** Compressed data is expanded before part of it is rewritten **/
+   if( ADFI_stridx_c( tag, compressed_chunk_start_tag ) == 0 ) {
+      ADFI_expand_compressed_chunk( file_index, &node.data_chunks,
+		error_return ) ;
+      CHECK_ADF_ABORT( *error_return ) ;
+      ADFI_write_node_header( file_index, &block_offset, &node, error_return ) ;
+      CHECK_ADF_ABORT( *error_return ) ;
+      ADFI_read_chunk_length( file_index, &node.data_chunks, tag,
+		&end_of_chunk_tag, error_return ) ;
+      CHECK_ADF_ABORT( *error_return ) ;
+      tag[TAG_SIZE] = '\0' ;
+      } /* end if */
+
         /** Check start-of-chunk tag **/
    if( ADFI_stridx_c( tag, data_chunk_start_tag ) != 0 ) {
       *error_return = ADF_DISK_TAG_ERROR ;
@@ -3854,6 +4649,12 @@ else { /** Multiple data chunks **/
 	 free( data_chunk_table ) ;
    } /* end else */
 
+	/** Remember fragmented data, to be merged at flush or close **/
+if( node.number_of_data_chunks > 1 ) {
+   ADFI_remember_data_chunks( file_index, &block_offset, error_return ) ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+
     /** Finally, update modification date **/
 ADFI_write_modification_date( file_index, error_return ) ;
 CHECK_ADF_ABORT( *error_return ) ;
@@ -3897,7 +4698,7 @@ void	ADF_Write_Data(
 		int *error_return )
 {
 unsigned int        file_index ;
-struct DISK_POINTER block_offset, dct_block_offset, relative_block ;
+struct DISK_POINTER block_offset, dct_block_offset ;
 struct DISK_POINTER data_start, new_block_offset ;
 struct DISK_POINTER chunk_start, end_of_chunk_tag ;
 struct NODE_HEADER  node ;
@@ -3920,6 +4721,10 @@ cglong_t      current_bytes, chunk_total_bytes ;
 double        LID ;
 cgulong_t     relative_offset, current_chunk, current_chunk_size,
               past_chunk_sizes ;
+cgulong_t     *chunk_offsets = NULL ;
+cgulong_t     run_elements ;
+struct DISK_POINTER run_block ;
+const char    *run_data ;
 
 if( (s_start == NULL) || (s_end == NULL) || (s_stride == NULL) ||
     (m_dims == NULL) || (m_start == NULL) || (m_end == NULL) ||
@@ -4007,6 +4812,19 @@ else if( node.number_of_data_chunks == 1 ) {
    CHECK_ADF_ABORT( *error_return ) ;
    tag[TAG_SIZE] = '\0' ;
 
+	/** Compressed data is expanded before part of it is rewritten **/
+   if( ADFI_stridx_c( tag, compressed_chunk_start_tag ) == 0 ) {
+      ADFI_expand_compressed_chunk( file_index, &node.data_chunks,
+		error_return ) ;
+      CHECK_ADF_ABORT( *error_return ) ;
+      ADFI_write_node_header( file_index, &block_offset, &node, error_return ) ;
+      CHECK_ADF_ABORT( *error_return ) ;
+      ADFI_read_chunk_length( file_index, &node.data_chunks, tag,
+		&end_of_chunk_tag, error_return ) ;
+      CHECK_ADF_ABORT( *error_return ) ;
+      tag[TAG_SIZE] = '\0' ;
+      } /* end if */
+
         /** Check start-of-chunk tag **/
    if( ADFI_stridx_c( tag, data_chunk_start_tag ) != 0 ) {
       *error_return = ADF_DISK_TAG_ERROR ;
@@ -4167,6 +4985,12 @@ else { /** Multiple data chunks, check to see if we need to add one mode **/
       } /* end if */
    } /* end else */
 
+	/** Remember fragmented data, to be merged at flush or close **/
+if( node.number_of_data_chunks > 1 ) {
+   ADFI_remember_data_chunks( file_index, &block_offset, error_return ) ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+
 	/** Do single data-chunks here... **/
 if( node.number_of_data_chunks == 1 ) {
 	/** Point to the start of the data **/
@@ -4186,27 +5010,21 @@ if( node.number_of_data_chunks == 1 ) {
    if( memory_offset != 0 )
       data += memory_offset * memory_bytes ;
 
+	/** Elements which are contiguous both on disk and in memory are
+	    collected into runs, and each run is put to disk at once **/
+   run_elements = 0 ;
    for( disk_elem=0; disk_elem<total_disk_elements; disk_elem++ ) {
-	/** Put the data to disk **/
       if ( block_offset.offset > DISK_BLOCK_SIZE ) {
         ADFI_adjust_disk_pointer( &block_offset, error_return ) ;
         CHECK_ADF_ABORT( *error_return ) ;
       }
 
-   /** Here is where we need to check for spanning multiple data-chunks **/
-
-			/** Put the data out to disk **/
-      if( formats_compare ) {  /* directly */
-         ADFI_write_file( file_index, block_offset.block, block_offset.offset,
-               file_bytes, (char *)data, error_return ) ;
-         CHECK_ADF_ABORT( *error_return ) ;
+	/** Start a new run at this element **/
+      if( run_elements == 0 ) {
+         run_block = block_offset ;
+         run_data = data ;
       } /* end if */
-      else {                   /* translated */
-         ADFI_write_data_translated( file_index, block_offset.block,
-               block_offset.offset, tokenized_data_type, file_bytes,
-               file_bytes, (char *)data, error_return ) ;
-         CHECK_ADF_ABORT( *error_return ) ;
-      } /* end else */
+      run_elements++ ;
 
    /** Increment disk/memory pointers, for the special case of one dimensional
        data we will a simple increment to maximize the throught. Thus for
@@ -4248,18 +5066,43 @@ if( node.number_of_data_chunks == 1 ) {
 		/** Adjust data pointer **/
          data += memory_offset * memory_bytes ;
          } /* end if */
+
+	/** Put the run out to disk at a gap on disk or in memory **/
+      if( disk_elem == total_disk_elements - 1 ||
+          disk_offset != 1 || memory_offset != 1 ) {
+         if( formats_compare ) {  /* directly */
+            ADFI_write_file( file_index, run_block.block, run_block.offset,
+                  run_elements * file_bytes, run_data, error_return ) ;
+            CHECK_ADF_ABORT( *error_return ) ;
+         } /* end if */
+         else {                   /* translated */
+            ADFI_write_data_translated( file_index, run_block.block,
+                  run_block.offset, tokenized_data_type, file_bytes,
+                  run_elements * file_bytes, run_data, error_return ) ;
+            CHECK_ADF_ABORT( *error_return ) ;
+         } /* end else */
+         run_elements = 0 ;
+         } /* end if */
       } /* end for */
    } /* end if */
 else {
 	/** Point to the start of the data **/
    current_chunk = 0 ;
    past_chunk_sizes = 0 ;
+   current_chunk_size = 0 ;
    relative_offset = disk_offset * file_bytes ;
-   current_chunk_size = (data_chunk_table[ current_chunk ].end.block -
-	data_chunk_table[ current_chunk ].start.block) * DISK_BLOCK_SIZE +
-	(data_chunk_table[ current_chunk ].end.offset -
-	data_chunk_table[ current_chunk ].start.offset) -
-	(TAG_SIZE + DISK_POINTER_SIZE) ;
+
+	/** Offsets of the chunks in the data, for finding the chunk of
+	    an element by binary search **/
+   chunk_offsets = (cgulong_t *)
+	malloc( (node.number_of_data_chunks + 1) * sizeof( *chunk_offsets ) ) ;
+   if( chunk_offsets == NULL ) {
+      *error_return = MEMORY_ALLOCATION_FAILED ;
+      CHECK_ADF_ABORT( *error_return ) ;
+      } /* end if */
+   ADFI_data_chunk_offsets( node.number_of_data_chunks, data_chunk_table,
+		chunk_offsets, error_return ) ;
+   CHECK_ADF_ABORT( *error_return ) ;
 
 	/** Setup initial indexing **/
    for( i=0; i<(int)node.number_of_dimensions; i++ )
@@ -4271,45 +5114,34 @@ else {
    if( memory_offset != 0 )
       data += memory_offset * memory_bytes ;
 
+   run_elements = 0 ;
    for( disk_elem=0; disk_elem<total_disk_elements; disk_elem++ ) {
-      while( relative_offset >= past_chunk_sizes + current_chunk_size ) {
-	 if( ++current_chunk >= node.number_of_data_chunks ) {
+	/** Find the data-chunk holding this element **/
+      if( relative_offset >= past_chunk_sizes + current_chunk_size ) {
+	 current_chunk = ADFI_find_data_chunk( node.number_of_data_chunks,
+			chunk_offsets, relative_offset ) ;
+	 if( current_chunk >= node.number_of_data_chunks ) {
 	    *error_return = INCOMPLETE_DATA ;
             CHECK_ADF_ABORT( *error_return ) ;
 	    } /* end if */
-	 else {
-	    past_chunk_sizes += current_chunk_size ;
-   	    current_chunk_size = (data_chunk_table[ current_chunk ].end.block -
-	      data_chunk_table[ current_chunk ].start.block) * DISK_BLOCK_SIZE +
-		(data_chunk_table[ current_chunk ].end.offset -
-		data_chunk_table[ current_chunk ].start.offset) -
-		(TAG_SIZE + DISK_POINTER_SIZE) ;
-	    } /* end else */
-	 } /* end while */
+	 past_chunk_sizes = chunk_offsets[ current_chunk ] ;
+	 current_chunk_size = chunk_offsets[ current_chunk + 1 ] -
+			      past_chunk_sizes ;
+	 } /* end if */
 
-	/** Put the data to disk **/
-      relative_block.block = data_chunk_table[ current_chunk ].start.block ;
-      relative_block.offset = data_chunk_table[ current_chunk ].start.offset +
+	/** Start a new run at this element **/
+      if( run_elements == 0 ) {
+         run_block.block = data_chunk_table[ current_chunk ].start.block ;
+         run_block.offset = data_chunk_table[ current_chunk ].start.offset +
 		(TAG_SIZE + DISK_POINTER_SIZE) +
 		(relative_offset - past_chunk_sizes) ;
-      if ( relative_block.offset > DISK_BLOCK_SIZE ) {
-        ADFI_adjust_disk_pointer( &relative_block, error_return ) ;
-        CHECK_ADF_ABORT( *error_return ) ;
-        } /* end if */
-
-			/** Put the data out to disk **/
-      if( formats_compare ) {  /* directly */
-         ADFI_write_file( file_index,
-               relative_block.block, relative_block.offset,
-               file_bytes, (char *)data, error_return ) ;
-         CHECK_ADF_ABORT( *error_return ) ;
-      } /* end if */
-      else {                   /* translated */
-         ADFI_write_data_translated( file_index, relative_block.block,
-               relative_block.offset, tokenized_data_type, file_bytes,
-               file_bytes, (char *)data, error_return ) ;
-         CHECK_ADF_ABORT( *error_return ) ;
+         if ( run_block.offset > DISK_BLOCK_SIZE ) {
+           ADFI_adjust_disk_pointer( &run_block, error_return ) ;
+           CHECK_ADF_ABORT( *error_return ) ;
+           } /* end if */
+         run_data = data ;
       } /* end if */
+      run_elements++ ;
 
 	/** Increment disk and memory pointers **/
       if( disk_elem < total_disk_elements - 1 ) {
@@ -4344,11 +5176,32 @@ else {
 		/** Adjust data pointer **/
          data += memory_offset * memory_bytes ;
          } /* end if */
+
+	/** Put the run out to disk at a gap on disk or in memory, or
+	    when the next element is in another data-chunk **/
+      if( disk_elem == total_disk_elements - 1 ||
+          disk_offset != 1 || memory_offset != 1 ||
+          relative_offset >= past_chunk_sizes + current_chunk_size ) {
+         if( formats_compare ) {  /* directly */
+            ADFI_write_file( file_index, run_block.block, run_block.offset,
+                  run_elements * file_bytes, run_data, error_return ) ;
+            CHECK_ADF_ABORT( *error_return ) ;
+         } /* end if */
+         else {                   /* translated */
+            ADFI_write_data_translated( file_index, run_block.block,
+                  run_block.offset, tokenized_data_type, file_bytes,
+                  run_elements * file_bytes, run_data, error_return ) ;
+            CHECK_ADF_ABORT( *error_return ) ;
+         } /* end else */
+         run_elements = 0 ;
+         } /* end if */
       } /* end for */
    } /* end else */
 
 if( data_chunk_table != 0L )
    free( data_chunk_table ) ;
+if( chunk_offsets != 0L )
+   free( chunk_offsets ) ;
 
 	/** Finally, update modification date **/
 ADFI_write_modification_date( file_index, error_return ) ;
@@ -4356,4 +5209,135 @@ CHECK_ADF_ABORT( *error_return ) ;
 
 } /* end of ADF_Write_Data */
 /* end of file ADF_Write_Data.c */
+/* file ADF_Write_Indices.c */
+/***********************************************************************
+ADF Write Indices:
+
+Write a list of points to a Node.  Each index is a 1-based position in
+the node's data, as for ADF_Read_Indices, and the values are taken from
+memory in the order of the list.  If an index is given more than once,
+the last value is the one written.  Points close to each other are
+written as one block; the points in between are read first, so they
+are left as they were.
+
+ADF_Write_Indices( ID, num, indices, data, error_return )
+input:  const double ID		The ID of the node to use.
+input:  const cgsize_t num	The number of points to write.
+input:  const cgsize_t indices[]  The 1-based indices of the points.
+input:  const char *data	The start of the data in memory.
+output: int *error_return	Error return.
+***********************************************************************/
+void	ADF_Write_Indices(
+		const double ID,
+		const cgsize_t num,
+		const cgsize_t indices[],
+		const char *data,
+		int *error_return )
+{
+unsigned int            file_index ;
+struct DISK_POINTER	block_offset ;
+struct NODE_HEADER	node ;
+struct TOKENIZED_DATA_TYPE
+		tokenized_data_type[ 1 + (ADF_DATA_TYPE_LENGTH + 1)/3 ] ;
+struct	INDEX_ENTRY	*entries ;
+char	*run_data ;
+
+char			file_format, machine_format ;
+int			file_bytes, memory_bytes ;
+cglong_t		total_bytes, max_points ;
+cgsize_t		n, k, first, last, run_points, distinct ;
+int			j ;
+double			LID ;
+
+if( data == NULL || indices == NULL ) {
+   *error_return = NULL_POINTER ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+
+if( num < 0 ) {
+   *error_return = NUMBER_LESS_THAN_MINIMUM ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+
+*error_return = NO_ERROR ;
+if( num == 0 ) return ;
+
+ADFI_chase_link( ID, &LID, &file_index,  &block_offset, &node, error_return ) ;
+CHECK_ADF_ABORT( *error_return ) ;
+
+	/** Get datatype size **/
+ADFI_evaluate_datatype( file_index, node.data_type, &file_bytes, &memory_bytes,
+	tokenized_data_type, &file_format, &machine_format, error_return ) ;
+CHECK_ADF_ABORT( *error_return ) ;
+
+if( (file_bytes == 0) || (node.number_of_dimensions == 0) ) {
+   *error_return = NO_DATA ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+
+	/** Calculate total number of bytes in the data **/
+total_bytes = file_bytes ;
+for( j=0; j<(int)node.number_of_dimensions; j++ )
+   total_bytes *= node.dimension_values[j] ;
+if( total_bytes == 0 ) {
+   *error_return = ZERO_DIMENSIONS ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+
+	/** Sort the indices into file order, checking the range **/
+entries = (struct INDEX_ENTRY *) malloc( (size_t)num * sizeof( *entries ) ) ;
+if( entries == NULL ) {
+   *error_return = MEMORY_ALLOCATION_FAILED ;
+   CHECK_ADF_ABORT( *error_return ) ;
+   } /* end if */
+ADFI_sort_indices( num, indices, (cgsize_t)(total_bytes / file_bytes),
+		   entries, error_return ) ;
+if( *error_return != NO_ERROR )
+   free( entries ) ;
+CHECK_ADF_ABORT( *error_return ) ;
+
+max_points = INDEX_RUN_MAXIMUM / file_bytes ;
+if( max_points < 1 ) max_points = 1 ;
+run_data = (char *) malloc( (size_t)(max_points * memory_bytes) ) ;
+if( run_data == NULL ) {
+   *error_return = MEMORY_ALLOCATION_FAILED ;
+   } /* end if */
+
+	/** Gather each run of nearby points and write it as a block **/
+for( n=0; n<num && *error_return == NO_ERROR; n=k ) {
+   first = last = entries[n].index ;
+   distinct = 1 ;
+   for( k=n+1; k<num; k++ ) {
+      if( (cglong_t)(entries[k].index - last) * file_bytes > INDEX_RUN_GAP ||
+	  entries[k].index - first >= max_points )
+	 break ;
+      if( entries[k].index != last ) distinct++ ;
+      last = entries[k].index ;
+      } /* end for */
+   run_points = last - first + 1 ;
+
+	/** Keep the points in the gaps of the run **/
+   if( distinct < run_points ) {
+      ADF_Read_Block_Data( LID, first, last, run_data, error_return ) ;
+      if( *error_return == NO_DATA )
+	 memset( run_data, 0, (size_t)(run_points * memory_bytes) ) ;
+      else if( *error_return != NO_ERROR )
+	 break ;
+      *error_return = NO_ERROR ;
+      } /* end if */
+
+   for( ; n<k; n++ )
+      memcpy( run_data + (size_t)(entries[n].index - first) * memory_bytes,
+	      data + (size_t)entries[n].position * memory_bytes,
+	      memory_bytes ) ;
+
+   ADF_Write_Block_Data( LID, first, last, run_data, error_return ) ;
+   } /* end for */
+
+if( run_data != NULL ) free( run_data ) ;
+free( entries ) ;
+CHECK_ADF_ABORT( *error_return ) ;
+
+} /* end of ADF_Write_Indices */
+/* end of file ADF_Write_Indices.c */
 /* end of combine 2.0 */
@@ -120,6 +120,25 @@ bytes   start   end   description      range / format
   4  242  245   "TaiL" boundary tag      Tag
 
 
+      212   Node header (version C files)
+The counts and dimensions are binary integers in the file's byte order,
+and the data-type is limited to 8 characters.
+bytes   start   end   description      range / format
+  4    0    3   "NoDe" boundary tag      Tag
+ 32    4   35   Name                     Text:  Blank filled
+ 32   36   67   Label                    Text:  Blank filled
+  8   68   75   Data-type                Text:  Blank filled
+  4   76   79   Number of sub-nodes      0 to 4,294,967,295
+  4   80   83   Entries for sub-nodes    0 to 4,294,967,295
+ 12   84   95   Pointer to sub-node table      Disk chunk, chunk offset.
+  2   96   97   Number of data chunks     0 to 65,535
+  1   98   98   Number of dimensions      0 to 12
+  1   99   99   Unused                    0
+ 96  100  195   Dimension values 0 to 11  8 bytes each
+ 12  196  207   Pointer to data chunk (or table)      Disk chunk, chunk offset.
+  4  208  211   "TaiL" boundary tag      Tag
+
+
    Variable: min   64   Sub-node table
 bytes   start   end   description      range / format
   4    0    3   "SNTb" boundary tag      Tag
@@ -166,6 +185,9 @@ bytes   start   end   description      range / format
 /***********************************************************************
  	Includes
 ***********************************************************************/
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+# define _GNU_SOURCE	/* for O_DIRECT */
+#endif
 #include <sys/types.h>
 #include <time.h>
 #include <stdio.h>
@@ -224,11 +246,83 @@ bytes   start   end   description      range / format
 # else
    typedef off64_t file_offset_t;
 #  define file_seek lseek64
+#  define file_pread pread64
+#  define file_pwrite pwrite64
+#  define file_preadv preadv64
+#  define file_pwritev pwritev64
+#  define file_fallocate posix_fallocate64
 # endif
 #else
   typedef off_t file_offset_t;
 # define file_seek LSEEK
+# define file_pread pread
+# define file_pwrite pwrite
+# define file_preadv preadv
+# define file_pwritev pwritev
+# define file_fallocate posix_fallocate
+#endif
+
+/***********************************************************************
+   Positional I/O - reads and writes give the file offset with each
+   call (pread/pwrite) instead of seeking first.  Where the system has
+   them, a contiguous piece of the file going to or from several
+   places in memory is done with a single preadv/pwritev.
+ ***********************************************************************/
+#if defined(_WIN32) && !defined(__NUTC__)
+static int file_pread( int fd, void *buf, unsigned int count,
+                       file_offset_t offset )
+{
+   if( file_seek( fd, offset, SEEK_SET ) < 0 ) return -1 ;
+   return READ( fd, buf, count ) ;
+}
+static int file_pwrite( int fd, const void *buf, unsigned int count,
+                        file_offset_t offset )
+{
+   if( file_seek( fd, offset, SEEK_SET ) < 0 ) return -1 ;
+   return WRITE( fd, buf, count ) ;
+}
+#elif defined(__linux__) || defined(__FreeBSD__) || defined(__NetBSD__) || \
+      defined(__OpenBSD__) || defined(HAVE_PREADV)
+# include <sys/uio.h>
+# define HAVE_VECTOR_IO
+#endif
+
+   /** most pieces passed to ADFI_read_file_vector/ADFI_write_file_vector **/
+#define MAX_IO_VECTORS 8
+
+   /** Direct I/O - transfers of ADF_direct_io_size bytes or more bypass
+       the system cache, through a second descriptor opened with O_DIRECT.
+       File offsets, lengths and memory must then be aligned to
+       DIRECT_IO_ALIGN; unaligned memory goes through a bounce buffer
+       of DIRECT_IO_BUFF_SIZE bytes. **/
+#define DIRECT_IO_ALIGN     4096
+#define DIRECT_IO_BUFF_SIZE (4*1024*1024)
+
+   /** Preallocation - disk space for a data-chunk may be reserved with
+       posix_fallocate as soon as it is allocated, rather than the file
+       growing piece by piece as the data is written **/
+#if !defined(_WIN32) && (defined(__linux__) || defined(__FreeBSD__) || \
+    defined(__NetBSD__) || defined(HAVE_POSIX_FALLOCATE))
+# define HAVE_FALLOCATE
+#endif
+
+   /** Queued I/O - on Linux, large reads and writes are split into
+       pieces of QUEUE_PIECE_SIZE bytes, up to ADF_queue_depth of them
+       in flight at once through io_uring, and the node headers of the
+       children listed by ADF_Children_IDs are read ahead.  Where
+       io_uring can't be set up at run time, or the library is built
+       with NO_IO_URING, transfers are done one at a time as before. **/
+#if defined(__linux__) && !defined(NO_IO_URING) && defined(__has_include)
+# if __has_include(<linux/io_uring.h>)
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <linux/io_uring.h>
+#  if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#   define HAVE_IO_URING
+#  endif
+# endif
 #endif
+#define QUEUE_PIECE_SIZE 262144
 
 extern int ADF_sys_err;
 
@@ -239,6 +333,32 @@ extern int ADF_sys_err;
 ADF_FILE *ADF_file;
 int maximum_files = 0;
 
+   /** When FALSE the modification date (and version update) in the file
+       header are only written when the file is flushed or closed,
+       otherwise they are written after every change to the file **/
+int ADF_sync_header = FALSE ;
+
+   /** When TRUE the data-chunks of nodes which have been written in
+       several pieces are merged into one chunk when the file is
+       flushed or closed **/
+int ADF_merge_chunks = FALSE ;
+
+   /** When greater than 0, reads and writes of at least this many bytes
+       use direct I/O where the system supports it **/
+cglong_t ADF_direct_io_size = 0 ;
+
+   /** When greater than 1, large reads and writes keep up to this
+       many requests in flight, where the system supports it **/
+int ADF_queue_depth = 0 ;
+
+   /** When greater than 0, disk space for data-chunks of at least this
+       many bytes is reserved as soon as they are allocated **/
+cglong_t ADF_preallocate_size = 0 ;
+
+   /** When greater than 0, data written in one piece of at least this
+       many bytes is stored in a compressed data-chunk **/
+cglong_t ADF_compress_size = 0 ;
+
    /** Track the format of this machine as well as the format
        of eack of the files.  This is used for reading and
        writing numeric data associated with the nodes, which may
@@ -261,6 +381,27 @@ static  int    block_of_00_initialized = FALSE ;
 #define CONVERSION_BUFF_SIZE 100000
 static unsigned char from_to_data[ CONVERSION_BUFF_SIZE ] ;
 
+    /** sub-node tables are read and written this many entries at a time **/
+#define SUB_NODE_BUFF_ENTRIES 1024
+static char sub_node_data[ SUB_NODE_BUFF_ENTRIES *
+                           (ADF_NAME_LENGTH + DISK_POINTER_SIZE) ] ;
+
+    /** The block table of the last compressed data-chunk read, and the
+        last block expanded from it, for reads of a few elements at a
+        time.  file_index is -1 when nothing is cached. **/
+static struct {
+   int			file_index ;
+   struct DISK_POINTER	chunk ;
+   cglong_t		data_bytes ;
+   unsigned int		block_bytes ;
+   unsigned int		element_bytes ;
+   unsigned int		number_of_blocks ;
+   cglong_t		*block_start ;
+   unsigned int		current_block ;
+   unsigned char	*block_data ;
+   unsigned char	*work_data ;
+   } compressed_chunk = { -1, { 0, 0 }, 0, 0, 0, 0, NULL, 0, NULL, NULL } ;
+
     /** read/write buffering variables **/
 static char     rd_block_buffer[DISK_BLOCK_SIZE] ;
 static cglong_t last_rd_block = -1 ;
@@ -270,8 +411,6 @@ static char     wr_block_buffer[DISK_BLOCK_SIZE] ;
 static cglong_t last_wr_block = -2 ;
 static int      last_wr_file = -2 ;
 static int      flush_wr_block = -2 ;
-static double   last_link_ID = 0.0;
-static double   last_link_LID = 0.0;
 enum { FLUSH, FLUSH_CLOSE };
 
     /** Assumed machine variable sizes for the currently supported
@@ -288,14 +427,43 @@ static	size_t machine_sizes[NUMBER_KNOWN_MACHINES][16] = {
      /* CRAY     64 */	{ 1, 1, 1, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8 } } ;
 
 /***********************************************************************
-	pows: Powers of 16, from 16^0 to 16^7
 	ASCII_Hex: Hex numbers from 0 to 15.
+	ASCII_Hex_value: Value of each character as a hex digit, or 16
+	if the character is not a hex digit.
 ***********************************************************************/
-static const unsigned int pows[8] = {	/** Powers of 16 **/
-		1, 16, 256, 4096, 65536, 1048576, 16777216, 268435456 } ;
 static const char ASCII_Hex[16] = {
 		'0', '1', '2', '3', '4', '5', '6', '7',
 		'8', '9', 'A', 'B', 'C', 'D', 'E', 'F' } ;
+static const unsigned char ASCII_Hex_value[256] = {
+		16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+		16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+		16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+		 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 16, 16, 16, 16, 16, 16,
+		16, 10, 11, 12, 13, 14, 15, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+		16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+		16, 10, 11, 12, 13, 14, 15, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+		16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+		16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+		16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+		16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+		16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+		16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+		16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+		16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+		16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16 } ;
+
+    /** Decode string_length ASCII-Hex characters into num.  Invalid
+        characters are collected in bad (non-zero above bit 3) instead of
+        being tested one at a time. **/
+#define ASCII_HEX_DECODE(string,string_length,num,bad) {\
+   const unsigned char *hex_str_ = (const unsigned char *)(string);\
+   unsigned int hex_n_;\
+   (num) = 0;\
+   for (hex_n_ = 0; hex_n_ < (string_length); hex_n_++) {\
+      (num) = ((num) << 4) | ASCII_Hex_value[hex_str_[hex_n_]];\
+      (bad) |= ASCII_Hex_value[hex_str_[hex_n_]];\
+   }\
+}
 
 /***********************************************************************
     Character string defining the data tags:
@@ -313,6 +481,7 @@ static char     sub_node_end_tag[]   = "snTE" ;
 static char     data_chunk_table_start_tag[] = "DCtb" ;
 static char     data_chunk_table_end_tag[]   = "dcTE" ;
 char     data_chunk_start_tag[] = "DaTa" ; /* needed in ADF_interface.c */
+char     compressed_chunk_start_tag[] = "DaTz" ; /* needed in ADF_interface.c */
 static char     data_chunk_end_tag[]   = "dEnD" ;
 
 /***********************************************************************
@@ -322,7 +491,8 @@ static char     data_chunk_end_tag[]   = "dEnD" ;
 	a priority value associated with it and is used to determine
 	which entry to replace when the stack is full!! Each stack entry
 	could be as large as 274 bytes since the stack data could be for
-	a node where NODE_HEADER_SIZE = 246.
+	a node where NODE_HEADER_SIZE = 246 (COMPACT_NODE_HEADER_SIZE = 212
+	in version C files).
 ***********************************************************************/
 #define MAX_STACK 50
 static struct {
@@ -373,9 +543,7 @@ void	ADFI_ASCII_Hex_2_unsigned_int(
 		unsigned int *number,
 		int *error_return )
 {
-unsigned int	i,	/** Index from 0 to string_length - 1 **/
-		ir,	/** Index from string_length - 1 to 0 **/
-		j,	/** Temoprary integer variable **/
+unsigned int	bad,	/** Non-hex characters seen **/
 		num ;	/** Working value of ther number **/
 
 if( string == NULL ) {
@@ -406,22 +574,12 @@ if( minimum > maximum ) {
 *error_return = NO_ERROR ;
 
 	/** Convert the ASCII-Hex string into decimal  **/
-num = 0 ;
-ir = (string_length - 1) << 2;
-for( i=0; i<string_length; i++) {
-   if (string[i] >= '0' && string[i] <= '9')
-      j = string[i] - 48;
-   else if (string[i] >= 'A' && string[i] <= 'F')
-      j = string[i] - 55;
-   else if (string[i] >= 'a' && string[i] <= 'f')
-      j = string[i] - 87;
-   else {
-      *error_return = STRING_NOT_A_HEX_STRING ;
-      return ;
-   }
-   num += (j << ir);
-   ir -= 4;
-}
+bad = 0 ;
+ASCII_HEX_DECODE( string, string_length, num, bad ) ;
+if( bad & ~0xF ) {
+   *error_return = STRING_NOT_A_HEX_STRING ;
+   return ;
+   } /* end if */
 
 if( num < minimum ) {
    *error_return = NUMBER_LESS_THAN_MINIMUM ;
@@ -817,6 +975,52 @@ if ( block_offset->block < oblock ) {
 
 } /* end of ADFI_adjust_disk_pointer */
 /* end of file ADFI_adjust_disk_pointer.c */
+/* file ADFI_batch_run_length.c */
+/***********************************************************************
+ADFI batch run length:
+	Count the entries of a batched read, from the first, that can be
+	read as one run: batched entries in the same file, each starting
+	no more than BATCH_RUN_GAP bytes after the end of those before,
+	and spanning no more than BATCH_RUN_MAXIMUM bytes.  An entry
+	covers its bytes and overhead_bytes more.  The first entry is
+	always in the run.
+
+input:  const int count			Number of entries left.
+input:  const struct BATCH_ENTRY entries[]  The sorted entries.
+input:  const int overhead_bytes	Bytes on disk besides each entry's.
+output: The number of entries in the run.
+
+   Possible errors:
+None allowed
+***********************************************************************/
+int     ADFI_batch_run_length(
+		const int count,
+		const struct BATCH_ENTRY entries[],
+		const int overhead_bytes )
+{
+cglong_t	run_start, run_end, start, end ;
+int		k ;
+
+if( count < 1 ) return 0 ;
+if( ! entries[0].batched ) return 1 ;
+
+run_start = (cglong_t)entries[0].start.block * DISK_BLOCK_SIZE +
+	    entries[0].start.offset ;
+run_end = run_start + overhead_bytes + entries[0].bytes ;
+for( k=1; k<count; k++ ) {
+   if( ! entries[k].batched ||
+       entries[k].file_index != entries[0].file_index ) break ;
+   start = (cglong_t)entries[k].start.block * DISK_BLOCK_SIZE +
+	   entries[k].start.offset ;
+   end = start + overhead_bytes + entries[k].bytes ;
+   if( start - run_end > BATCH_RUN_GAP ||
+       end - run_start > BATCH_RUN_MAXIMUM ) break ;
+   if( end > run_end ) run_end = end ;
+   } /* end for */
+return k ;
+
+} /* end of ADFI_batch_run_length */
+/* end of file ADFI_batch_run_length.c */
 /* file ADFI_big_endian_32_swap_64.c */
 /***********************************************************************
 ADFI big endian 32 swap 64:
@@ -1444,12 +1648,125 @@ static void ADFI_link_add(
       (ADF_file[link_index].in_use)++;
    }
 }
+/***********************************************************************
+ADFI link cache find
+
+input:  file_index	the file containing the link node
+input:  link            block/offset of the link node
+output: pos             where the entry is, or should be inserted
+return: the cache entry for the link, or NULL if not resolved yet
+***********************************************************************/
+static struct LINK_CACHE_ENTRY *ADFI_link_cache_find(
+        unsigned int file_index,
+        const struct DISK_POINTER *link,
+        int *pos)
+{
+   int lo = 0, hi = ADF_file[file_index].nlink_cache - 1, mid;
+   struct LINK_CACHE_ENTRY *entry;
+
+   while (lo <= hi) {
+      mid = (lo + hi) >> 1;
+      entry = &ADF_file[file_index].link_cache[mid];
+      if (link->block < entry->link.block ||
+         (link->block == entry->link.block &&
+          link->offset < entry->link.offset))
+         hi = mid - 1;
+      else if (link->block > entry->link.block ||
+               link->offset > entry->link.offset)
+         lo = mid + 1;
+      else {
+         *pos = mid;
+         return entry;
+      }
+   }
+   *pos = lo;
+   return NULL;
+}
+/***********************************************************************
+ADFI link cache add
+
+input:  file_index	the file containing the link node
+input:  link            block/offset of the link node
+input:  target_index    the file containing the (non-link) target node
+input:  target          block/offset of the target node
+***********************************************************************/
+static void ADFI_link_cache_add(
+        unsigned int file_index,
+        const struct DISK_POINTER *link,
+        unsigned int target_index,
+        const struct DISK_POINTER *target)
+{
+   int n, pos;
+   struct LINK_CACHE_ENTRY *cache;
+
+   if (ADFI_link_cache_find(file_index, link, &pos) != NULL) return;
+   n = ADF_file[file_index].nlink_cache;
+   cache = (struct LINK_CACHE_ENTRY *) realloc (ADF_file[file_index].link_cache,
+              (n + 1) * sizeof(struct LINK_CACHE_ENTRY));
+   if (cache == NULL) return;
+   if (pos < n)
+      memmove (&cache[pos+1], &cache[pos],
+               (n - pos) * sizeof(struct LINK_CACHE_ENTRY));
+   cache[pos].link = *link;
+   cache[pos].file_index = target_index;
+   cache[pos].target = *target;
+   ADF_file[file_index].nlink_cache = n + 1;
+   ADF_file[file_index].link_cache = cache;
+}
+/***********************************************************************
+ADFI link file path
+
+input:  file_index	the file that references the link
+input/output: linkfile  the link file name, replaced by its full path
+output: int *error_return       Error return.
+***********************************************************************/
+static void ADFI_link_file_path(
+        unsigned int file_index,
+        char *linkfile,
+        int *error_return)
+{
+   int n, nfiles = ADF_file[file_index].nlink_files;
+   char *name, *path;
+   struct LINK_FILE_ENTRY *files = ADF_file[file_index].link_files;
+
+   for (n = 0; n < nfiles; n++) {
+      if (0 == strcmp (files[n].link_file, linkfile)) {
+         strcpy (linkfile, files[n].path);
+         *error_return = NO_ERROR;
+         return;
+      }
+   }
+   name = (char *) malloc (strlen(linkfile) + 1);
+   if (name != NULL) strcpy (name, linkfile);
+
+   ADFI_find_file(ADF_file[file_index].file_name, linkfile, error_return);
+   if (*error_return != NO_ERROR || name == NULL) {
+      if (name != NULL) free (name);
+      return;
+   }
+
+   path = (char *) malloc (strlen(linkfile) + 1);
+   files = (struct LINK_FILE_ENTRY *) realloc (files,
+              (nfiles + 1) * sizeof(struct LINK_FILE_ENTRY));
+   if (path == NULL || files == NULL) {
+      free (name);
+      if (path != NULL) free (path);
+      if (files != NULL) ADF_file[file_index].link_files = files;
+      return;
+   }
+   strcpy (path, linkfile);
+   files[nfiles].link_file = name;
+   files[nfiles].path = path;
+   ADF_file[file_index].nlink_files = nfiles + 1;
+   ADF_file[file_index].link_files = files;
+}
 /* file ADFI_chase_link.c */
 /***********************************************************************
 ADFI chase link:
     Given an ID, return the ID, file, block/offset, and node header
     of the node.  If the ID is a link, traverse the link(s) until a
-    non-link node is found.  This is the data returned.
+    non-link node is found.  This is the data returned.  The resolved
+    target of each link is remembered in the link cache of its file.
 
 input:  const double ID         ID of the node.
 output: double *LID             ID of the non-link node (may == ID)
@@ -1469,8 +1786,10 @@ void    ADFI_chase_link(
 double        Link_ID, temp_ID ;
 int           done = FALSE ;
 int           link_depth = 0 ;
-int           found ;
-unsigned int  link_file_index ;
+int           found, pos ;
+unsigned int  link_file_index, ID_file_index ;
+struct DISK_POINTER  ID_block_offset ;
+struct LINK_CACHE_ENTRY *cached ;
 char          status[10] ;
 char          link_file[ADF_FILENAME_LENGTH+1],
               link_path[ADF_MAX_LINK_DATA_SIZE+1] ;
@@ -1481,10 +1800,16 @@ if( (LID == NULL) || (file_index == NULL) || (block_offset == NULL) ||
    return ;
 } /* end if */
 
-if (ID == last_link_ID) {
-   *LID = last_link_LID;
-   ADFI_ID_2_file_block_offset( last_link_LID, file_index, &block_offset->block,
-                &block_offset->offset, error_return ) ;
+ADFI_ID_2_file_block_offset( ID, &ID_file_index, &ID_block_offset.block,
+             &ID_block_offset.offset, error_return ) ;
+CHECK_ABORT(*error_return);
+
+cached = ADFI_link_cache_find( ID_file_index, &ID_block_offset, &pos ) ;
+if( cached != NULL ) {
+   *file_index = cached->file_index ;
+   *block_offset = cached->target ;
+   ADFI_file_block_offset_2_ID( *file_index, block_offset->block,
+                block_offset->offset, LID, error_return ) ;
    if( *error_return != NO_ERROR )
       return ;
    ADFI_read_node_header( *file_index, block_offset, node_header,
@@ -1513,8 +1838,8 @@ while( done == FALSE ) {
 
       if( link_file[0] != '\0' ) { /* A filename is specified, open it. **/
          /* locate the file */
-         ADFI_find_file(ADF_file[*file_index].file_name, link_file, error_return);
-         CHECK_ABORT(*error_return);
+         ADFI_link_file_path( *file_index, link_file, error_return ) ;
+         CHECK_ABORT(*error_return);
 
          /** Link_ID = root-node of the new file.
              note:  the file could already be opened, and may be the
@@ -1560,8 +1885,8 @@ while( done == FALSE ) {
 
 *LID = Link_ID ;
 if (Link_ID != ID) {
-   last_link_ID = ID;
-   last_link_LID = Link_ID;
+   ADFI_link_cache_add( ID_file_index, &ID_block_offset, *file_index,
+                        block_offset ) ;
 }
 
 } /* end of ADFI_chase_link */
@@ -1729,6 +2054,37 @@ for( i=0; i<str_length; i++ ) {
    } /* end for */
 }
 /* end of file ADFI_check_string_length.c */
+/* file ADFI_clear_link_cache.c */
+/***********************************************************************
+ADFI clear link cache:
+	Discard the resolved link targets and linked file paths of a file.
+	This is needed whenever a node is deleted, moved or renamed, since
+	that may change the node a link resolves to.
+
+input:  const int file_index	Index of ADF file, or -1 for all files.
+***********************************************************************/
+void    ADFI_clear_link_cache(
+		const int file_index )
+{
+int i, n ;
+
+for( i=0; i<maximum_files; i++ ) {
+   if( file_index >= 0 && i != file_index ) continue ;
+   if( ADF_file[i].link_cache != NULL )
+      free( ADF_file[i].link_cache ) ;
+   ADF_file[i].link_cache = NULL ;
+   ADF_file[i].nlink_cache = 0 ;
+   for( n=0; n<ADF_file[i].nlink_files; n++ ) {
+      free( ADF_file[i].link_files[n].link_file ) ;
+      free( ADF_file[i].link_files[n].path ) ;
+      } /* end for */
+   if( ADF_file[i].link_files != NULL )
+      free( ADF_file[i].link_files ) ;
+   ADF_file[i].link_files = NULL ;
+   ADF_file[i].nlink_files = 0 ;
+   } /* end for */
+} /* end of ADFI_clear_link_cache */
+/* end of file ADFI_clear_link_cache.c */
 /* file ADFI_close_file.c */
 /***********************************************************************
 ADFI close file:
@@ -1765,6 +2121,8 @@ index = ADF_file[file_index].in_use - 1;
 if ( index == 0) {
    ADF_sys_err = 0;
    if( ADF_file[file_index].file >= 0 ) {
+      ADFI_merge_data_chunks( file_index, error_return );
+      ADFI_flush_modification_date( file_index, error_return );
       ADFI_flush_buffers( file_index, FLUSH_CLOSE, error_return );
       if( CLOSE( ADF_file[file_index].file ) < 0 ) {
          ADF_sys_err = errno;
@@ -1772,6 +2130,11 @@ if ( index == 0) {
       }
    } /* end if */
    ADF_file[file_index].file = -1 ;
+   if( compressed_chunk.file_index == file_index )
+      compressed_chunk.file_index = -1 ;
+   if( ADF_file[file_index].direct_file >= 0 )
+      CLOSE( ADF_file[file_index].direct_file ) ;
+   ADF_file[file_index].direct_file = -1 ;
 	/** Clear this file's entry **/
    ADFI_stack_control(file_index,0,0,CLEAR_STK,0,0,NULL);
 
@@ -1852,6 +2215,420 @@ for( ; i<ADF_NAME_LENGTH; i++ ) {
 *names_match = 1 ;	/* Yes, they match */
 } /* end of ADFI_compare_node_names */
 /* end of file ADFI_compare_node_names.c */
+/* file ADFI_compress_block.c */
+/***********************************************************************
+ADFI compress block:
+	Compress one block of a compressed data-chunk.  The bytes of the
+	data elements are first regrouped by their position within the
+	element (all first bytes, then all second bytes, ...), which puts
+	the slowly changing sign and exponent bytes of numeric data next
+	to each other.  The result is then coded as literal runs and back
+	references to the last 8K bytes:
+
+	000lllll			l+1 literal bytes follow
+	lllooooo oooooooo		copy l+2 bytes from o+1 bytes back
+	111ooooo llllllll oooooooo	copy l+9 bytes from o+1 bytes back
+
+	Blocks which do not compress are stored as they are.
+
+input:  const unsigned char *data	Block of data.
+input:  const unsigned int data_bytes	Number of bytes in the block.
+input:  const unsigned int element_bytes Size of a data element in bytes.
+output: unsigned char *work		Work space of data_bytes.
+output: unsigned char *packed		The compressed block.
+input:  const unsigned int packed_size	Space available for the block.
+output: unsigned int *packed_bytes	Size of the compressed block, 0 if
+					it does not fit in packed_size.
+***********************************************************************/
+#define LZ_HASH_BITS       13
+#define LZ_MAX_LITERALS    32
+#define LZ_MAX_OFFSET    8192
+#define LZ_MAX_LENGTH   (7 + 255 + 2)
+
+static unsigned int	lz_hash_table[ 1 << LZ_HASH_BITS ] ;
+
+static void	ADFI_shuffle_bytes(
+		const unsigned char *from_data,
+		const unsigned int data_bytes,
+		const unsigned int element_bytes,
+		unsigned char *to_data )
+{
+unsigned int	i, j, number_of_elements = data_bytes / element_bytes ;
+
+for( j=0; j<element_bytes; j++ )
+   for( i=0; i<number_of_elements; i++ )
+      to_data[ j * number_of_elements + i ] =
+		from_data[ i * element_bytes + j ] ;
+} /* end of ADFI_shuffle_bytes */
+
+static void	ADFI_unshuffle_bytes(
+		const unsigned char *from_data,
+		const unsigned int data_bytes,
+		const unsigned int element_bytes,
+		unsigned char *to_data )
+{
+unsigned int	i, j, number_of_elements = data_bytes / element_bytes ;
+
+for( j=0; j<element_bytes; j++ )
+   for( i=0; i<number_of_elements; i++ )
+      to_data[ i * element_bytes + j ] =
+		from_data[ j * number_of_elements + i ] ;
+} /* end of ADFI_unshuffle_bytes */
+
+static unsigned int	ADFI_lz_compress(
+		const unsigned char *in_data,
+		const unsigned int in_bytes,
+		unsigned char *out_data,
+		const unsigned int out_bytes )
+{
+unsigned int	in_pos = 0, out_pos = 1, control = 0, literals = 0 ;
+unsigned int	hash, ref, offset, length, max_length, misses = 0, step ;
+
+memset( lz_hash_table, 0, sizeof( lz_hash_table ) ) ;
+
+while( in_pos + 2 < in_bytes ) {
+   hash = (((unsigned int)in_data[in_pos] << 16) |
+	   ((unsigned int)in_data[in_pos+1] << 8) |
+	    (unsigned int)in_data[in_pos+2]) * 2654435761U ;
+   hash >>= 32 - LZ_HASH_BITS ;
+   ref = lz_hash_table[ hash ] ;	/** position + 1, 0 if unused **/
+   lz_hash_table[ hash ] = in_pos + 1 ;
+
+   if( ref != 0 && (offset = in_pos - ref) < LZ_MAX_OFFSET &&
+       in_data[ref-1] == in_data[in_pos] &&
+       in_data[ref] == in_data[in_pos+1] &&
+       in_data[ref+1] == in_data[in_pos+2] ) {
+      max_length = MIN( in_bytes - in_pos, LZ_MAX_LENGTH ) ;
+      for( length=3; length<max_length &&
+		in_data[ref-1+length] == in_data[in_pos+length]; length++ ) ;
+
+      if( out_pos + 3 > out_bytes )
+         return 0 ;
+	/** Close the literal run, or drop its unused control byte **/
+      if( literals > 0 )
+         out_data[ control ] = (unsigned char)(literals - 1) ;
+      else
+         out_pos = control ;
+      length -= 2 ;
+      if( length < 7 )
+         out_data[ out_pos++ ] = (unsigned char)((length << 5) + (offset >> 8)) ;
+      else {
+         out_data[ out_pos++ ] = (unsigned char)((7 << 5) + (offset >> 8)) ;
+         out_data[ out_pos++ ] = (unsigned char)(length - 7) ;
+         } /* end else */
+      out_data[ out_pos++ ] = (unsigned char)(offset & 0xff) ;
+      in_pos += length + 2 ;
+      literals = 0 ;
+      control = out_pos++ ;
+      misses = 0 ;
+      } /* end if */
+   else {
+	/** The longer nothing matches, the fewer places are looked at **/
+      for( step = 1 + (misses++ >> 5); step > 0 && in_pos + 2 < in_bytes;
+		step-- ) {
+         if( out_pos >= out_bytes )
+            return 0 ;
+         out_data[ out_pos++ ] = in_data[ in_pos++ ] ;
+         if( ++literals == LZ_MAX_LITERALS ) {
+            out_data[ control ] = (unsigned char)(literals - 1) ;
+            literals = 0 ;
+            control = out_pos++ ;
+            } /* end if */
+         } /* end for */
+      } /* end else */
+   } /* end while */
+
+	/** The last few bytes are always literals **/
+while( in_pos < in_bytes ) {
+   if( out_pos >= out_bytes )
+      return 0 ;
+   out_data[ out_pos++ ] = in_data[ in_pos++ ] ;
+   if( ++literals == LZ_MAX_LITERALS ) {
+      out_data[ control ] = (unsigned char)(literals - 1) ;
+      literals = 0 ;
+      control = out_pos++ ;
+      } /* end if */
+   } /* end while */
+
+if( literals > 0 )
+   out_data[ control ] = (unsigned char)(literals - 1) ;
+else
+   out_pos = control ;
+return out_pos ;
+} /* end of ADFI_lz_compress */
+
+static unsigned int	ADFI_lz_expand(
+		const unsigned char *in_data,
+		const unsigned int in_bytes,
+		unsigned char *out_data,
+		const unsigned int out_bytes )
+{
+unsigned int	in_pos = 0, out_pos = 0, control, length, back ;
+
+while( in_pos < in_bytes ) {
+   control = in_data[ in_pos++ ] ;
+   if( control < LZ_MAX_LITERALS ) {	/** literal run **/
+      length = control + 1 ;
+      if( in_pos + length > in_bytes || out_pos + length > out_bytes )
+         return 0 ;
+      memcpy( &out_data[ out_pos ], &in_data[ in_pos ], length ) ;
+      in_pos += length ;
+      out_pos += length ;
+      } /* end if */
+   else {				/** back reference **/
+      length = control >> 5 ;
+      if( length == 7 ) {
+         if( in_pos >= in_bytes )
+            return 0 ;
+         length += in_data[ in_pos++ ] ;
+         } /* end if */
+      if( in_pos >= in_bytes )
+         return 0 ;
+      back = ((control & 0x1f) << 8) + in_data[ in_pos++ ] + 1 ;
+      length += 2 ;
+      if( back > out_pos || out_pos + length > out_bytes )
+         return 0 ;
+      if( back >= length ) {
+         memcpy( &out_data[ out_pos ], &out_data[ out_pos - back ], length ) ;
+         out_pos += length ;
+         } /* end if */
+      else {	/** the copy overlaps what it writes, go byte by byte **/
+         for( ; length > 0; length--, out_pos++ )
+            out_data[ out_pos ] = out_data[ out_pos - back ] ;
+         } /* end else */
+      } /* end else */
+   } /* end while */
+return out_pos ;
+} /* end of ADFI_lz_expand */
+
+static void	ADFI_compress_block(
+		const unsigned char *data,
+		const unsigned int data_bytes,
+		const unsigned int element_bytes,
+		unsigned char *work,
+		unsigned char *packed,
+		const unsigned int packed_size,
+		unsigned int *packed_bytes )
+{
+if( element_bytes > 1 ) {
+   ADFI_shuffle_bytes( data, data_bytes, element_bytes, work ) ;
+   data = work ;
+   } /* end if */
+
+	/** Only keep it if it is smaller than the data **/
+*packed_bytes = ADFI_lz_compress( data, data_bytes, packed,
+		MIN( packed_size, data_bytes - 1 ) ) ;
+} /* end of ADFI_compress_block */
+
+static void	ADFI_expand_block(
+		const unsigned char *packed,
+		const unsigned int packed_bytes,
+		const unsigned int data_bytes,
+		const unsigned int element_bytes,
+		unsigned char *work,
+		unsigned char *data,
+		int *error_return )
+{
+*error_return = NO_ERROR ;
+
+	/** A block stored as it is **/
+if( packed_bytes == data_bytes ) {
+   memcpy( data, packed, data_bytes ) ;
+   return ;
+   } /* end if */
+
+if( ADFI_lz_expand( packed, packed_bytes,
+		element_bytes > 1 ? work : data, data_bytes ) != data_bytes ) {
+   *error_return = BAD_COMPRESSED_DATA ;
+   return ;
+   } /* end if */
+if( element_bytes > 1 )
+   ADFI_unshuffle_bytes( work, data_bytes, element_bytes, data ) ;
+} /* end of ADFI_expand_block */
+
+/***********************************************************************
+ADFI compressed chunk open:
+	Read the header and block table of a compressed data-chunk into
+	compressed_chunk, unless they are there already.
+
+input:  const unsigned int file_index	The file index.
+input:  const struct DISK_POINTER *block_offset  Block & offset of the chunk.
+output:	int *error_return		Error return.
+***********************************************************************/
+static void	ADFI_compressed_chunk_open(
+		const unsigned int file_index,
+		const struct DISK_POINTER *block_offset,
+		int *error_return )
+{
+char		header[ TAG_SIZE + DISK_POINTER_SIZE + COMPRESSED_HEADER_SIZE ] ;
+char		tag[ TAG_SIZE + 1 ] ;
+char		*table ;
+struct DISK_POINTER	end_of_chunk_tag, location ;
+cglong_t	*block_start, data_bytes, table_bytes, chunk_bytes ;
+unsigned int	high, low, block_bytes, element_bytes, number_of_blocks ;
+unsigned int	packed_bytes, i ;
+unsigned char	*block_data, *work_data ;
+
+*error_return = NO_ERROR ;
+
+if( compressed_chunk.file_index == (int)file_index &&
+    compressed_chunk.chunk.block == block_offset->block &&
+    compressed_chunk.chunk.offset == block_offset->offset )
+   return ;
+compressed_chunk.file_index = -1 ;
+
+ADFI_read_chunk_length( file_index, block_offset, tag, &end_of_chunk_tag,
+	error_return ) ;
+if( *error_return != NO_ERROR )
+   return ;
+tag[ TAG_SIZE ] = '\0' ;
+if( ADFI_stridx_c( tag, compressed_chunk_start_tag ) != 0 ) {
+   *error_return = ADF_DISK_TAG_ERROR ;
+   return ;
+   } /* end if */
+ADFI_read_file( file_index, block_offset->block, block_offset->offset,
+	sizeof( header ), header, error_return ) ;
+if( *error_return != NO_ERROR )
+   return ;
+
+	/** data size, block size and element size **/
+i = TAG_SIZE + DISK_POINTER_SIZE ;
+ADFI_ASCII_Hex_2_unsigned_int( 0, MAXIMUM_32_BITS, 8, &header[i],
+	&high, error_return ) ;
+if( *error_return != NO_ERROR )
+   return ;
+ADFI_ASCII_Hex_2_unsigned_int( 0, MAXIMUM_32_BITS, 8, &header[i+8],
+	&low, error_return ) ;
+if( *error_return != NO_ERROR )
+   return ;
+ADFI_ASCII_Hex_2_unsigned_int( 0, MAXIMUM_32_BITS, 8, &header[i+16],
+	&block_bytes, error_return ) ;
+if( *error_return != NO_ERROR )
+   return ;
+ADFI_ASCII_Hex_2_unsigned_int( 0, MAXIMUM_32_BITS, 8, &header[i+24],
+	&element_bytes, error_return ) ;
+if( *error_return != NO_ERROR )
+   return ;
+data_bytes = ((cglong_t)high << 32) + low ;
+if( data_bytes <= 0 || block_bytes == 0 || element_bytes == 0 ||
+    block_bytes > COMPRESSED_BLOCK_SIZE || block_bytes % element_bytes ) {
+   *error_return = BAD_COMPRESSED_DATA ;
+   return ;
+   } /* end if */
+number_of_blocks =
+	(unsigned int)((data_bytes + block_bytes - 1) / block_bytes) ;
+
+	/** The block table follows the header **/
+table_bytes = (cglong_t)number_of_blocks * COMPRESSED_ENTRY_SIZE ;
+table = (char *)malloc( (size_t)table_bytes ) ;
+block_start = (cglong_t *)
+	malloc( (number_of_blocks + 1) * sizeof( *block_start ) ) ;
+block_data = (unsigned char *)malloc( block_bytes ) ;
+work_data = (unsigned char *)malloc( 2 * block_bytes ) ;
+if( table == NULL || block_start == NULL || block_data == NULL ||
+    work_data == NULL ) {
+   if( table != NULL ) free( table ) ;
+   if( block_start != NULL ) free( block_start ) ;
+   if( block_data != NULL ) free( block_data ) ;
+   if( work_data != NULL ) free( work_data ) ;
+   *error_return = MEMORY_ALLOCATION_FAILED ;
+   return ;
+   } /* end if */
+
+location.block = block_offset->block ;
+location.offset = block_offset->offset + sizeof( header ) ;
+ADFI_adjust_disk_pointer( &location, error_return ) ;
+if( *error_return == NO_ERROR )
+   ADFI_read_file( file_index, location.block, location.offset,
+	table_bytes, table, error_return ) ;
+
+	/** Offsets of the blocks from the start of the chunk **/
+block_start[ 0 ] = sizeof( header ) + table_bytes ;
+for( i=0; i<number_of_blocks && *error_return == NO_ERROR; i++ ) {
+   ADFI_ASCII_Hex_2_unsigned_int( 1, block_bytes, COMPRESSED_ENTRY_SIZE,
+	&table[ i * COMPRESSED_ENTRY_SIZE ], &packed_bytes, error_return ) ;
+   block_start[ i+1 ] = block_start[ i ] + packed_bytes ;
+   } /* end for */
+free( table ) ;
+
+chunk_bytes = (end_of_chunk_tag.block - block_offset->block) *
+	DISK_BLOCK_SIZE + end_of_chunk_tag.offset - block_offset->offset ;
+if( *error_return == NO_ERROR && chunk_bytes != block_start[ i ] )
+   *error_return = BAD_COMPRESSED_DATA ;
+if( *error_return != NO_ERROR ) {
+   if( *error_return == NUMBER_GREATER_THAN_MAXIMUM ||
+       *error_return == NUMBER_LESS_THAN_MINIMUM )
+      *error_return = BAD_COMPRESSED_DATA ;
+   free( block_start ) ;
+   free( block_data ) ;
+   free( work_data ) ;
+   return ;
+   } /* end if */
+
+if( compressed_chunk.block_start != NULL ) {
+   free( compressed_chunk.block_start ) ;
+   free( compressed_chunk.block_data ) ;
+   free( compressed_chunk.work_data ) ;
+   } /* end if */
+compressed_chunk.file_index = (int)file_index ;
+compressed_chunk.chunk.block = block_offset->block ;
+compressed_chunk.chunk.offset = block_offset->offset ;
+compressed_chunk.data_bytes = data_bytes ;
+compressed_chunk.block_bytes = block_bytes ;
+compressed_chunk.element_bytes = element_bytes ;
+compressed_chunk.number_of_blocks = number_of_blocks ;
+compressed_chunk.block_start = block_start ;
+compressed_chunk.current_block = number_of_blocks ;
+compressed_chunk.block_data = block_data ;
+compressed_chunk.work_data = work_data ;
+} /* end of ADFI_compressed_chunk_open */
+
+/***********************************************************************
+ADFI compressed chunk block:
+	Expand a block of the open compressed data-chunk into
+	compressed_chunk.block_data, unless it is there already.
+
+input:  const unsigned int block	The block number.
+output:	int *error_return		Error return.
+***********************************************************************/
+static void	ADFI_compressed_chunk_block(
+		const unsigned int block,
+		int *error_return )
+{
+struct DISK_POINTER	location ;
+unsigned int		packed_bytes, data_bytes ;
+
+*error_return = NO_ERROR ;
+if( block == compressed_chunk.current_block )
+   return ;
+compressed_chunk.current_block = compressed_chunk.number_of_blocks ;
+
+data_bytes = (unsigned int)MIN( (cglong_t)compressed_chunk.block_bytes,
+	compressed_chunk.data_bytes -
+		(cglong_t)block * compressed_chunk.block_bytes ) ;
+packed_bytes = (unsigned int)(compressed_chunk.block_start[ block+1 ] -
+		compressed_chunk.block_start[ block ]) ;
+
+location.block = compressed_chunk.chunk.block ;
+location.offset = compressed_chunk.chunk.offset +
+		compressed_chunk.block_start[ block ] ;
+ADFI_adjust_disk_pointer( &location, error_return ) ;
+if( *error_return != NO_ERROR )
+   return ;
+ADFI_read_file( compressed_chunk.file_index, location.block, location.offset,
+	packed_bytes, (char *)compressed_chunk.work_data, error_return ) ;
+if( *error_return != NO_ERROR )
+   return ;
+
+ADFI_expand_block( compressed_chunk.work_data, packed_bytes, data_bytes,
+	compressed_chunk.element_bytes,
+	compressed_chunk.work_data + compressed_chunk.block_bytes,
+	compressed_chunk.block_data, error_return ) ;
+if( *error_return != NO_ERROR )
+   return ;
+compressed_chunk.current_block = block ;
+} /* end of ADFI_compressed_chunk_block */
+/* end of file ADFI_compress_block.c */
 /* file ADFI_convert_number_format.c */
 /***********************************************************************
 ADFI convert number format:
@@ -2699,6 +3476,49 @@ printf("\n" ) ;
    } /* end switch */
 } /* end of ADFI_cray_to_little_endian */
 /* end of file ADFI_cray_to_little_endian.c */
+/* file ADFI_data_chunk_offsets.c */
+/***********************************************************************
+ADFI data chunk offsets:
+
+Compute where the data of each entry of a data-chunk table starts,
+relative to the start of the node's data.  Chunk i holds the data
+bytes from chunk_offsets[i] up to chunk_offsets[i+1], so the table
+can be searched with ADFI_find_data_chunk.
+
+input:  const unsigned int number_of_chunks	Entries in the table.
+input:  const struct DATA_CHUNK_TABLE_ENTRY data_chunk_table[] The table.
+output: cgulong_t chunk_offsets[]	number_of_chunks+1 data offsets.
+output:	int *error_return		Error return.
+
+   Possible errors:
+NO_ERROR
+NULL_POINTER
+***********************************************************************/
+void    ADFI_data_chunk_offsets(
+		const unsigned int number_of_chunks,
+		const struct DATA_CHUNK_TABLE_ENTRY data_chunk_table[],
+		cgulong_t chunk_offsets[],
+		int *error_return )
+{
+unsigned int	i ;
+
+if( (data_chunk_table == NULL) || (chunk_offsets == NULL) ) {
+   *error_return = NULL_POINTER ;
+   return ;
+   } /* end if */
+
+*error_return = NO_ERROR ;
+
+chunk_offsets[ 0 ] = 0 ;
+for( i=0; i<number_of_chunks; i++ ) {
+   chunk_offsets[ i+1 ] = chunk_offsets[ i ] +
+	(data_chunk_table[i].end.block - data_chunk_table[i].start.block) *
+		DISK_BLOCK_SIZE +
+	(data_chunk_table[i].end.offset - data_chunk_table[i].start.offset) -
+		(TAG_SIZE + DISK_POINTER_SIZE) ;
+   } /* end for */
+} /* end of ADFI_data_chunk_offsets */
+/* end of file ADFI_data_chunk_offsets.c */
 /* file ADFI_delete_data.c */
 /***********************************************************************
 ADFI delete data:
@@ -3013,7 +3833,7 @@ void    ADFI_disk_pointer_from_ASCII_Hex(
 		struct DISK_POINTER *block_offset,
 		int *error_return )
 {
-unsigned int	tmp ;
+unsigned int	tmp, bad = 0 ;
 
 if( (block == NULL) || (offset == NULL) ) {
    *error_return = NULL_STRING_POINTER ;
@@ -3028,16 +3848,18 @@ if( block_offset == NULL ) {
 *error_return = NO_ERROR ;
 
 	/** Convert into numeric form **/
-ADFI_ASCII_Hex_2_unsigned_int( 0, MAXIMUM_32_BITS, 8, block,
-		&tmp, error_return ) ;
-if( *error_return != NO_ERROR )
-   return ;
+ASCII_HEX_DECODE( block, 8, tmp, bad ) ;
 block_offset->block = tmp ;
 
-ADFI_ASCII_Hex_2_unsigned_int( 0, DISK_BLOCK_SIZE, 4, offset,
-		&tmp, error_return ) ;
-if( *error_return != NO_ERROR )
+ASCII_HEX_DECODE( offset, 4, tmp, bad ) ;
+if( bad & ~0xF ) {
+   *error_return = STRING_NOT_A_HEX_STRING ;
+   return ;
+   } /* end if */
+if( tmp > DISK_BLOCK_SIZE ) {
+   *error_return = NUMBER_GREATER_THAN_MAXIMUM ;
    return ;
+   } /* end if */
 
 block_offset->offset = tmp ;
 } /* end of ADFI_disk_pointer_from_ASCII_Hex */
@@ -3335,26 +4157,37 @@ tokenized_data_type[ current_token ].file_type_size = *file_bytes;
 tokenized_data_type[ current_token ].machine_type_size = *machine_bytes ;
 } /* end of ADFI_evaluate_datatype */
 /* end of file ADFI_evaluate_datatype.c */
-/* file ADFI_fflush_file.c */
+/* file ADFI_expand_compressed_chunk.c */
 /***********************************************************************
-ADFI fflush file:
-    To flush the file output stream.
+ADFI expand compressed chunk:
+	Replace a compressed data-chunk by an ordinary data-chunk holding
+	the same data, so that parts of it can be rewritten in place.
 
-input:  const unsigned int file_index   File to use.
-output: int *error_return               Error return.
+input:  const unsigned int file_index	The file index.
+input/output: struct DISK_POINTER *block_offset  Block & offset of the
+					chunk, on return of the new chunk.
+output:	int *error_return		Error return.
 
-    Possible errors:
+   Possible errors:
 NO_ERROR
+NULL_POINTER
 ADF_FILE_NOT_OPENED
-FFLUSH_ERROR
+MEMORY_ALLOCATION_FAILED
+BAD_COMPRESSED_DATA
 ***********************************************************************/
-void    ADFI_fflush_file(
-        const unsigned int file_index,
-        int *error_return )
+void    ADFI_expand_compressed_chunk(
+		const unsigned int file_index,
+		struct DISK_POINTER *block_offset,
+		int *error_return )
 {
+struct DISK_POINTER	new_block_offset, data_start, end_of_chunk_tag ;
+cglong_t		data_bytes ;
+char			*data ;
 
-
-int  iret ;
+if( block_offset == NULL ) {
+   *error_return = NULL_POINTER ;
+   return ;
+   } /* end if */
 
 if( (int)file_index >= maximum_files || ADF_file[file_index].in_use == 0 ) {
    *error_return = ADF_FILE_NOT_OPENED ;
@@ -3363,15 +4196,103 @@ if( (int)file_index >= maximum_files || ADF_file[file_index].in_use == 0 ) {
 
 *error_return = NO_ERROR ;
 
-ADF_sys_err = 0;
-# ifdef _WIN32
-iret = _commit( ADF_file[file_index].file ) ;
-# else
-iret = fsync( ADF_file[file_index].file ) ;
-# endif
-if (iret < 0) {
-   ADF_sys_err = errno;
-   *error_return = FFLUSH_ERROR ;
+ADFI_compressed_chunk_open( file_index, block_offset, error_return ) ;
+if( *error_return != NO_ERROR )
+   return ;
+data_bytes = compressed_chunk.data_bytes ;
+
+	/** Expand all of the data, in the file format **/
+data = (char *)malloc( (size_t)data_bytes ) ;
+if( data == NULL ) {
+   *error_return = MEMORY_ALLOCATION_FAILED ;
+   return ;
+   } /* end if */
+ADFI_read_compressed_chunk( file_index, block_offset, NULL, 1, 0,
+	data_bytes, data, error_return ) ;
+
+	/** Write it to a new data-chunk **/
+if( *error_return == NO_ERROR )
+   ADFI_file_malloc( file_index,
+	data_bytes + TAG_SIZE + TAG_SIZE + DISK_POINTER_SIZE,
+	&new_block_offset, error_return ) ;
+if( *error_return == NO_ERROR )
+   ADFI_write_file( file_index, new_block_offset.block,
+	new_block_offset.offset, TAG_SIZE, data_chunk_start_tag,
+	error_return ) ;
+if( *error_return == NO_ERROR ) {
+   data_start.block = new_block_offset.block ;
+   data_start.offset = new_block_offset.offset + TAG_SIZE ;
+   ADFI_adjust_disk_pointer( &data_start, error_return ) ;
+   } /* end if */
+if( *error_return == NO_ERROR ) {
+   end_of_chunk_tag.block = data_start.block ;
+   end_of_chunk_tag.offset = data_start.offset + DISK_POINTER_SIZE +
+		data_bytes ;
+   ADFI_adjust_disk_pointer( &end_of_chunk_tag, error_return ) ;
+   } /* end if */
+if( *error_return == NO_ERROR )
+   ADFI_write_disk_pointer_2_disk( file_index, data_start.block,
+	data_start.offset, &end_of_chunk_tag, error_return ) ;
+if( *error_return == NO_ERROR ) {
+   data_start.offset += DISK_POINTER_SIZE ;
+   ADFI_adjust_disk_pointer( &data_start, error_return ) ;
+   } /* end if */
+if( *error_return == NO_ERROR )
+   ADFI_write_file( file_index, data_start.block, data_start.offset,
+	data_bytes, data, error_return ) ;
+if( *error_return == NO_ERROR )
+   ADFI_write_file( file_index, end_of_chunk_tag.block,
+	end_of_chunk_tag.offset, TAG_SIZE, data_chunk_end_tag, error_return ) ;
+free( data ) ;
+if( *error_return != NO_ERROR )
+   return ;
+
+	/** Free the compressed chunk **/
+ADFI_file_free( file_index, block_offset, 0, error_return ) ;
+if( *error_return != NO_ERROR )
+   return ;
+block_offset->block = new_block_offset.block ;
+block_offset->offset = new_block_offset.offset ;
+
+} /* end of ADFI_expand_compressed_chunk */
+/* end of file ADFI_expand_compressed_chunk.c */
+/* file ADFI_fflush_file.c */
+/***********************************************************************
+ADFI fflush file:
+    To flush the file output stream.
+
+input:  const unsigned int file_index   File to use.
+output: int *error_return               Error return.
+
+    Possible errors:
+NO_ERROR
+ADF_FILE_NOT_OPENED
+FFLUSH_ERROR
+***********************************************************************/
+void    ADFI_fflush_file(
+        const unsigned int file_index,
+        int *error_return )
+{
+
+
+int  iret ;
+
+if( (int)file_index >= maximum_files || ADF_file[file_index].in_use == 0 ) {
+   *error_return = ADF_FILE_NOT_OPENED ;
+   return ;
+   } /* end if */
+
+*error_return = NO_ERROR ;
+
+ADF_sys_err = 0;
+# ifdef _WIN32
+iret = _commit( ADF_file[file_index].file ) ;
+# else
+iret = fsync( ADF_file[file_index].file ) ;
+# endif
+if (iret < 0) {
+   ADF_sys_err = errno;
+   *error_return = FFLUSH_ERROR ;
    } /* end if */
 } /* end of ADFI_fflush_file */
 /* end of file ADFI_fflush_file.c */
@@ -3496,7 +4417,8 @@ else if( ADFI_stridx_c( CRAY_FORMAT_STRING, format ) == 0 ) {
    requested_os     = OS_64_BIT ;
    } /* end else if */
 else if( ADFI_stridx_c( NATIVE_FORMAT_STRING, format ) == 0 ||
-	 ADFI_stridx_c( LEGACY_FORMAT_STRING, format ) == 0 ) {
+	 ADFI_stridx_c( LEGACY_FORMAT_STRING, format ) == 0 ||
+	 ADFI_stridx_c( COMPACT_FORMAT_STRING, format ) == 0 ) {
    requested_format = NATIVE_FORMAT_CHAR ;
    requested_os     = OS_32_BIT ;
    } /* end else if */
@@ -3923,6 +4845,12 @@ if( file_index >= maximum_files || ADF_file[file_index].in_use == 0 ) {
    return ;
    } /* end if */
 
+	/** Forget a compressed data-chunk being freed **/
+if( compressed_chunk.file_index == file_index &&
+    compressed_chunk.chunk.block == block_offset->block &&
+    compressed_chunk.chunk.offset == block_offset->offset )
+   compressed_chunk.file_index = -1 ;
+
 if( number_of_bytes == 0 ) {
 
    /** Check the disk tag to see what kind of disk chunk we have.
@@ -3943,8 +4871,8 @@ if( number_of_bytes == 0 ) {
          return ;
          } /* end if */
       end_of_chunk_tag.block = block_offset->block ;
-      end_of_chunk_tag.offset = block_offset->offset + NODE_HEADER_SIZE -
-	                        TAG_SIZE ;
+      end_of_chunk_tag.offset = block_offset->offset +
+	                FILE_NODE_HEADER_SIZE( file_index ) - TAG_SIZE ;
       if ( end_of_chunk_tag.offset > DISK_BLOCK_SIZE ) {
          ADFI_adjust_disk_pointer( &end_of_chunk_tag, error_return ) ;
          if( *error_return != NO_ERROR )
@@ -4046,7 +4974,8 @@ if( number_of_bytes == 0 ) {
          return ;
          } /* end if */
       } /* end else if */
-   else if( ADFI_stridx_c( tag, data_chunk_start_tag ) == 0 ) {
+   else if( ADFI_stridx_c( tag, data_chunk_start_tag ) == 0 ||
+	    ADFI_stridx_c( tag, compressed_chunk_start_tag ) == 0 ) {
 
            /** Set a temporary block/offset to read disk pointer **/
       tmp_blk_ofst.block = block_offset->block ;
@@ -4390,10 +5319,114 @@ if( memory_found != TRUE ) { /* Append memory at end of file **/
    ADFI_write_file_header( file_index, &file_header, error_return ) ;
    if( *error_return != NO_ERROR )
       return ;
+
+	/** Reserve the disk space for large chunks up front **/
+   if( ADF_preallocate_size > 0 && size_bytes >= ADF_preallocate_size ) {
+      ADFI_file_reserve( file_index, block_offset, size_bytes,
+		error_return ) ;
+      if( *error_return != NO_ERROR )
+         return ;
+      } /* end if */
    } /* end if */
 
 } /* end of ADFI_file_malloc */
 /* end of file ADFI_file_malloc.c */
+/* file ADFI_file_offset.c */
+/***********************************************************************
+ADFI_file_offset:
+	The byte offset in the file of a block and offset, for use with
+	pread() and pwrite().  Need to allow for files larger than what
+	a long int can represent.
+
+input:	const unsigned int file_index	File to use.
+input:	const unsigned long file_block	Block within the file.
+input:	const unsigned long block_offset Offset within the block.
+output:	file_offset_t *offset		Offset in the file.
+output:	int *error_return		Error return.
+
+   Possible errors:
+NO_ERROR
+ADF_FILE_NOT_OPENED
+MAX_FILE_SIZE_EXCEEDED
+***********************************************************************/
+static void	ADFI_file_offset(
+		const unsigned int file_index,
+		const cgulong_t file_block,
+		const cgulong_t block_offset,
+		file_offset_t *offset,
+		int *error_return )
+{
+if( (int)file_index >= maximum_files || ADF_file[file_index].in_use == 0 ) {
+   *error_return = ADF_FILE_NOT_OPENED ;
+   return ;
+   } /* end if */
+
+*offset = (file_offset_t)(file_block * DISK_BLOCK_SIZE + block_offset) ;
+if (*offset < 0) {
+   *error_return = MAX_FILE_SIZE_EXCEEDED;
+   return;
+}
+
+*error_return = NO_ERROR ;
+} /* end of ADFI_file_offset */
+/* end of file ADFI_file_offset.c */
+/* file ADFI_file_reserve.c */
+/***********************************************************************
+ADFI file reserve:
+	Reserve the disk space for a chunk of the file, so that it is
+	allocated all at once rather than as it is written.  Only a full
+	disk is reported as an error; where reserving space is not
+	supported this does nothing.
+
+input:  const unsigned int file_index	The file index.
+input:  const struct DISK_POINTER *block_offset  Start of the chunk.
+input:  const cglong_t size_bytes	The size of the chunk in bytes.
+output:	int *error_return		Error return.
+
+   Possible errors:
+NO_ERROR
+NULL_POINTER
+ADF_FILE_NOT_OPENED
+FWRITE_ERROR
+***********************************************************************/
+void	ADFI_file_reserve(
+		const unsigned int file_index,
+		const struct DISK_POINTER *block_offset,
+		const cglong_t size_bytes,
+		int *error_return )
+{
+#ifdef HAVE_FALLOCATE
+file_offset_t	offset ;
+#endif
+
+if( block_offset == NULL ) {
+   *error_return = NULL_POINTER ;
+   return ;
+   } /* end if */
+
+if( (int)file_index >= maximum_files || ADF_file[file_index].in_use == 0 ) {
+   *error_return = ADF_FILE_NOT_OPENED ;
+   return ;
+   } /* end if */
+
+*error_return = NO_ERROR ;
+if( size_bytes <= 0 )
+   return ;
+
+#ifdef HAVE_FALLOCATE
+ADFI_file_offset( file_index, block_offset->block, block_offset->offset,
+	&offset, error_return ) ;
+if( *error_return != NO_ERROR )
+   return ;
+
+if( file_fallocate( ADF_file[file_index].file, offset,
+	(file_offset_t)size_bytes ) == ENOSPC ) {
+   ADF_sys_err = ENOSPC ;
+   *error_return = FWRITE_ERROR ;
+   } /* end if */
+#endif
+} /* end of ADFI_file_reserve */
+/* end of file ADFI_file_reserve.c */
 /* file ADFI_fill_initial_file_header.c */
 /***********************************************************************
 ADFI fill initial file header:
@@ -4535,7 +5568,8 @@ else
 file_header->root_node.block = ROOT_NODE_BLOCK ;
 file_header->root_node.offset = ROOT_NODE_OFFSET ;
 file_header->end_of_file.block = ROOT_NODE_BLOCK ;
-file_header->end_of_file.offset = ROOT_NODE_OFFSET + NODE_HEADER_SIZE - 1 ;
+file_header->end_of_file.offset = ROOT_NODE_OFFSET - 1 +
+	(what_string[25] == 'C' ? COMPACT_NODE_HEADER_SIZE : NODE_HEADER_SIZE) ;
 file_header->free_chunks.block = FREE_CHUNKS_BLOCK ;
 file_header->free_chunks.offset = FREE_CHUNKS_OFFSET ;
 ADFI_set_blank_disk_pointer( &file_header->extra ) ;
@@ -4636,6 +5670,41 @@ node_header->number_of_data_chunks = 0 ;
 ADFI_set_blank_disk_pointer( &node_header->data_chunks ) ;
 } /* end of ADFI_fill_initial_node_header */
 /* end of file ADFI_fill_initial_node_header.c */
+/* file ADFI_find_data_chunk.c */
+/***********************************************************************
+ADFI find data chunk:
+
+Binary search of the data offsets from ADFI_data_chunk_offsets for the
+data-chunk holding the byte at relative_offset from the start of the
+node's data.
+
+input:  const unsigned int number_of_chunks	Entries in the table.
+input:  const cgulong_t chunk_offsets[]	number_of_chunks+1 data offsets.
+input:  const cgulong_t relative_offset	Offset of the byte wanted.
+return: index of the data-chunk, or number_of_chunks if the offset is
+	past the end of the data.
+***********************************************************************/
+unsigned int    ADFI_find_data_chunk(
+		const unsigned int number_of_chunks,
+		const cgulong_t chunk_offsets[],
+		const cgulong_t relative_offset )
+{
+unsigned int	lo = 0, hi = number_of_chunks, mid ;
+
+if( relative_offset >= chunk_offsets[ number_of_chunks ] )
+   return number_of_chunks ;
+
+	/** Find the last chunk starting at or before the offset **/
+while( hi - lo > 1 ) {
+   mid = (lo + hi) >> 1 ;
+   if( chunk_offsets[ mid ] <= relative_offset )
+      lo = mid ;
+   else
+      hi = mid ;
+   } /* end while */
+return lo ;
+} /* end of ADFI_find_data_chunk */
+/* end of file ADFI_find_data_chunk.c */
 /* file ADFI_flush_buffers.c */
 /***********************************************************************
 ADFI Flush buffers:
@@ -4683,53 +5752,72 @@ if ( (int) file_index == last_rd_file && flush_mode == FLUSH_CLOSE ) {
 
 } /* end of ADFI_flush_buffers */
 /* end of file ADFI_flush_buffers.c */
-/* file ADFI_fseek_file.c */
+/* file ADFI_flush_modification_date.c */
 /***********************************************************************
-ADFI_fseek_file:
-	To position the current position for fread() or fwrite().
-	Need to allow for files larger than what a long int can
-	represent (the offset for fseek).
+ADFI flush modification date:
+    Writes the current date/time into the modification date field of
+    the file header if the file has been modified.  Also updates the
+    file version (what string) in the header if the file version global
+    variable has been set - after writing, file version global variable
+    is unset so that it is only written once.
 
-input:	const unsigned int file_index	File to use.
-input:	const unsigned long file_block	Block within the file.
-input:	const unsigned long block_offset Offset within the block.
-output:	int *error_return		Error return.
+input:  const int  file_index    File index to write to.
+output:	int *error_return        Error return.
 
    Possible errors:
 NO_ERROR
 ADF_FILE_NOT_OPENED
-FSEEK_ERROR
+FWRITE_ERROR
 ***********************************************************************/
-void	ADFI_fseek_file(
-		const unsigned int file_index,
-		const cgulong_t file_block,
-		const cgulong_t block_offset,
-		int *error_return )
+void	ADFI_flush_modification_date(
+        const int  file_index,
+        int *error_return )
 {
-file_offset_t offset;
-file_offset_t iret;
+int	    i_block_offset ;
+char    mod_date[DATE_TIME_SIZE] ;
 
-if( (int)file_index >= maximum_files || ADF_file[file_index].in_use == 0 ) {
+if( file_index >= maximum_files || ADF_file[file_index].in_use == 0 ) {
    *error_return = ADF_FILE_NOT_OPENED ;
    return ;
    } /* end if */
 
-offset = (file_offset_t)(file_block * DISK_BLOCK_SIZE + block_offset) ;
-if (offset < 0) {
-   *error_return = MAX_FILE_SIZE_EXCEEDED;
+*error_return = NO_ERROR ;
+if( ! ADF_file[file_index].modified ) return ;
+
+ADFI_get_current_date( mod_date ) ;
+
+     /** block offset depends on the location the of modification date
+         in the FILE_HEADER structure **/
+i_block_offset = WHAT_STRING_SIZE + TAG_SIZE + DATE_TIME_SIZE + TAG_SIZE ;
+ADFI_write_file( file_index, 0, i_block_offset, DATE_TIME_SIZE, mod_date,
+                 error_return ) ;
+if( *error_return != NO_ERROR ) {
    return;
-}
+   } /* end if */
 
-*error_return = NO_ERROR ;
+if( ADF_file[file_index].version_update[0] != '\0' )
+{
+   i_block_offset = 0 ;   /* what-string is first field in header */
+   ADFI_write_file( file_index, 0, i_block_offset, WHAT_STRING_SIZE,
+                    ADF_file[file_index].version_update, error_return ) ;
 
-ADF_sys_err = 0;
-iret = file_seek( ADF_file[file_index].file, offset, SEEK_SET ) ;
-if( iret < 0 ) {
-   ADF_sys_err = errno;
-   *error_return = FSEEK_ERROR ;
+/** reset the version to default so that it only gets updated once **/
+   ADF_file[file_index].version_update[0] = '\0' ;
+   if( *error_return != NO_ERROR ) {
+      return;
+      } /* end if */
+   } /* end if */
+
+     /** Flush the write buffer to ensure the file is current!! **/
+ADFI_flush_buffers( file_index, FLUSH, error_return );
+if( *error_return != NO_ERROR ) {
+   return;
    } /* end if */
-} /* end of ADFI_fseek_file */
-/* end of file ADFI_fseek_file.c */
+
+ADF_file[file_index].modified = 0 ;
+
+} /* end of ADFI_flush_modification_date */
+/* end of file ADFI_flush_modification_date.c */
 /* file ADFI_get_current_date.c */
 /***********************************************************************
 ADFI get current date:
@@ -5412,86 +6500,353 @@ printf("\n" ) ;
    } /* end switch */
 } /* end of ADFI_little_endian_to_cray */
 /* end of file ADFI_little_endian_to_cray.c */
-/* file ADFI_open_file.c */
+/* file ADFI_map_data_chunks.c */
 /***********************************************************************
-ADFI open file:
-
-    Track the files used by index.
-    Also track which files are within a given system so a close for
-    the system can close all related files.
+ADFI map data chunks:
+	Find where the data of each data-chunk of a node starts on disk
+	and how many bytes it holds, checking the tags of each chunk
+	once, so that many small pieces of the data can then be read
+	with ADFI_read_data_extents without going back to the tags.
 
-input:  const char *file    The filename to open.
-input:  const char *status  The status in which to open the file.
-        Allowable values are:
-                READ_ONLY - File must exist.  Writing NOT allowed.
-                OLD - File must exist.  Reading and writing allowed.
-                NEW - File must not exist.
-                SCRATCH - New file.  Filename is ignored.
-                UNKNOWN - OLD if file exists, else NEW is used.
-input:  const int top_file_index  -1 if this is the top file.
-output: unsigned int *file_index  Returned index of the file.
-output: int *error_return   Error return.
+input:  const unsigned int file_index	The file index.
+input:  const struct NODE_HEADER *node	The node header.
+input:  const struct DATA_CHUNK_TABLE_ENTRY data_chunk_table[]  The chunk
+					table, NULL if the node has one chunk.
+output: struct DATA_EXTENT extents[]	One entry per data-chunk.
+output:	int *error_return		Error return.
 
    Possible errors:
 NO_ERROR
 NULL_POINTER
-NULL_STRING_POINTER
-TOO_MANY_ADF_FILES_OPENED
-ADF_FILE_STATUS_NOT_RECOGNIZED
-FILE_OPEN_ERROR
+ADF_FILE_NOT_OPENED
+ADF_DISK_TAG_ERROR
 ***********************************************************************/
-void    ADFI_open_file(
-        const char *file,
-        const char *status,
-        unsigned int *file_index,
-        int *error_return )
+void    ADFI_map_data_chunks(
+		const unsigned int file_index,
+		const struct NODE_HEADER *node,
+		const struct DATA_CHUNK_TABLE_ENTRY data_chunk_table[],
+		struct DATA_EXTENT extents[],
+		int *error_return )
 {
-int index;
-int f_ret, f_mode;
-char header_data[102];
+char	tag[TAG_SIZE + 1] ;
+struct DISK_POINTER	chunk_start, end_of_chunk_tag ;
+unsigned int		i ;
 
-if( (status == NULL) ||
-    ((file == NULL) && (ADFI_stridx_c( status, "SCRATCH" ) != 0) ) ) {
-   *error_return = NULL_STRING_POINTER ;
+if( node == NULL || extents == NULL ) {
+   *error_return = NULL_POINTER ;
    return ;
-} /* end if */
+   } /* end if */
 
-if( file_index == NULL ) {
-   *error_return = NULL_POINTER ;
+if( (int)file_index >= maximum_files || ADF_file[file_index].in_use == 0 ) {
+   *error_return = ADF_FILE_NOT_OPENED ;
    return ;
-} /* end if */
+   } /* end if */
 
 *error_return = NO_ERROR ;
 
-for( index=0; index<maximum_files; index++ ) {
-   if( ADF_file[index].in_use == 0 )
-      break ;
-} /* end for */
+for( i=0; i<node->number_of_data_chunks; i++ ) {
+   if( data_chunk_table == NULL )
+      chunk_start = node->data_chunks ;
+   else
+      chunk_start = data_chunk_table[i].start ;
 
-if( index >= maximum_files ) {
-   ADF_FILE *files;
-   /* I don't use realloc, because I don't want to lose
-      any currently open file information if it fails */
-   files = (ADF_FILE *) calloc (maximum_files + ADF_FILE_INC, sizeof(ADF_FILE));
-   if (files == NULL) {
-      *error_return = MEMORY_ALLOCATION_FAILED ;
+   ADFI_read_chunk_length( file_index, &chunk_start, tag, &end_of_chunk_tag,
+		error_return ) ;
+   if( *error_return != NO_ERROR )
       return ;
-   }
-   if (maximum_files) {
-      memcpy (files, ADF_file, maximum_files * sizeof(ADF_FILE));
-      free (ADF_file);
-   } else {
-      ADFI_stack_control(0,0,0,INIT_STK,0,0,NULL);
-   }
-   ADF_file = files;
-   index = maximum_files;
-   maximum_files += ADF_FILE_INC;
-} /* end if */
+   tag[TAG_SIZE] = '\0' ;
 
-if (index > MAXIMUM_FILES) {
-   *error_return = TOO_MANY_ADF_FILES_OPENED;
-   return;
-}
+	/** Compressed chunks are read through their block table **/
+   if( ADFI_stridx_c( tag, compressed_chunk_start_tag ) == 0 ) {
+      ADFI_compressed_chunk_open( file_index, &chunk_start, error_return ) ;
+      if( *error_return != NO_ERROR )
+         return ;
+      extents[i].start = chunk_start ;
+      extents[i].bytes = compressed_chunk.data_bytes ;
+      extents[i].compressed = 1 ;
+      continue ;
+      } /* end if */
+
+   if( ADFI_stridx_c( tag, data_chunk_start_tag ) != 0 ) {
+      *error_return = ADF_DISK_TAG_ERROR ;
+      return ;
+      } /* end if */
+
+   ADFI_read_file( file_index, end_of_chunk_tag.block,
+		end_of_chunk_tag.offset, TAG_SIZE, tag, error_return ) ;
+   if( *error_return != NO_ERROR )
+      return ;
+   tag[TAG_SIZE] = '\0' ;
+   if( ADFI_stridx_c( tag, data_chunk_end_tag ) != 0 ) {
+      *error_return = ADF_DISK_TAG_ERROR ;
+      return ;
+      } /* end if */
+
+	/** The data sits between the chunk length and the end tag **/
+   extents[i].start.block = chunk_start.block ;
+   extents[i].start.offset = chunk_start.offset + TAG_SIZE + DISK_POINTER_SIZE ;
+   ADFI_adjust_disk_pointer( &extents[i].start, error_return ) ;
+   if( *error_return != NO_ERROR )
+      return ;
+   extents[i].bytes = (cglong_t)(end_of_chunk_tag.block -
+			extents[i].start.block) * DISK_BLOCK_SIZE +
+		      (cglong_t)end_of_chunk_tag.offset -
+		      (cglong_t)extents[i].start.offset ;
+   extents[i].compressed = 0 ;
+   } /* end for */
+
+} /* end of ADFI_map_data_chunks */
+/* end of file ADFI_map_data_chunks.c */
+/* file ADFI_merge_data_chunks.c */
+/***********************************************************************
+ADFI merge data chunks:
+
+Merge the data of each node remembered by ADFI_remember_data_chunks
+into a single data-chunk.  The data is copied as it is on disk into a
+new chunk, the node-header is pointed at it, and then the old chunks
+and the data-chunk table are freed.  Remembered locations which no
+longer hold a node with multiple data-chunks (the node was deleted,
+or has already been merged) are skipped.
+
+input:  const int file_index	The file index.
+output:	int *error_return	Error return.
+
+   Possible errors:
+NO_ERROR
+ADF_FILE_NOT_OPENED
+MEMORY_ALLOCATION_FAILED
+***********************************************************************/
+void    ADFI_merge_data_chunks(
+		const int file_index,
+		int *error_return )
+{
+struct DISK_POINTER	*fragmented, chunk_start, end_of_chunk_tag,
+			from, to ;
+struct NODE_HEADER	node, old_node ;
+struct DATA_CHUNK_TABLE_ENTRY	*data_chunk_table ;
+struct TOKENIZED_DATA_TYPE
+		tokenized_data_type[ 1 + (ADF_DATA_TYPE_LENGTH + 1)/3 ] ;
+char		disk_format, machine_format ;
+int		file_bytes, memory_bytes ;
+int		n, nfragmented, err ;
+unsigned int	i ;
+cglong_t	total_bytes, chunk_bytes, data_bytes, nbytes ;
+
+if( file_index >= maximum_files || ADF_file[file_index].in_use == 0 ) {
+   *error_return = ADF_FILE_NOT_OPENED ;
+   return ;
+   } /* end if */
+
+*error_return = NO_ERROR ;
+
+nfragmented = ADF_file[file_index].nfragmented ;
+fragmented = ADF_file[file_index].fragmented ;
+ADF_file[file_index].nfragmented = 0 ;
+ADF_file[file_index].fragmented = NULL ;
+
+for( n=0; n<nfragmented; n++ ) {
+   ADFI_read_node_header( file_index, &fragmented[n], &node, &err ) ;
+   if( err != NO_ERROR || node.number_of_data_chunks < 2 )
+      continue ;
+
+   ADFI_evaluate_datatype( file_index, node.data_type, &file_bytes,
+	&memory_bytes, tokenized_data_type, &disk_format, &machine_format,
+	error_return ) ;
+   if( *error_return != NO_ERROR )
+      break ;
+   total_bytes = file_bytes ;
+   for( i=0; i<node.number_of_dimensions; i++ )
+      total_bytes *= node.dimension_values[i] ;
+
+   data_chunk_table = (struct DATA_CHUNK_TABLE_ENTRY *)
+	malloc( node.number_of_data_chunks * sizeof( *data_chunk_table ) ) ;
+   if( data_chunk_table == NULL ) {
+      *error_return = MEMORY_ALLOCATION_FAILED ;
+      break ;
+      } /* end if */
+   ADFI_read_data_chunk_table( file_index, &node.data_chunks,
+	data_chunk_table, error_return ) ;
+   if( *error_return != NO_ERROR ) {
+      free( data_chunk_table ) ;
+      break ;
+      } /* end if */
+
+	/** Leave incomplete data as it is **/
+   data_bytes = 0 ;
+   for( i=0; i<node.number_of_data_chunks; i++ ) {
+      data_bytes +=
+	(data_chunk_table[i].end.block - data_chunk_table[i].start.block) *
+		DISK_BLOCK_SIZE +
+	(data_chunk_table[i].end.offset - data_chunk_table[i].start.offset) -
+		(TAG_SIZE + DISK_POINTER_SIZE) ;
+      } /* end for */
+   if( total_bytes == 0 || data_bytes < total_bytes ) {
+      free( data_chunk_table ) ;
+      continue ;
+      } /* end if */
+
+	/** Allocate the new data-chunk and write its tags **/
+   ADFI_file_malloc( file_index,
+	total_bytes + TAG_SIZE + TAG_SIZE + DISK_POINTER_SIZE,
+	&chunk_start, error_return ) ;
+   if( *error_return == NO_ERROR )
+      ADFI_write_file( file_index, chunk_start.block, chunk_start.offset,
+	TAG_SIZE, data_chunk_start_tag, error_return ) ;
+   end_of_chunk_tag.block = chunk_start.block ;
+   end_of_chunk_tag.offset = chunk_start.offset + TAG_SIZE +
+	DISK_POINTER_SIZE + total_bytes ;
+   to.block = chunk_start.block ;
+   to.offset = chunk_start.offset + TAG_SIZE ;
+   if( *error_return == NO_ERROR )
+      ADFI_adjust_disk_pointer( &end_of_chunk_tag, error_return ) ;
+   if( *error_return == NO_ERROR )
+      ADFI_adjust_disk_pointer( &to, error_return ) ;
+   if( *error_return == NO_ERROR )
+      ADFI_write_disk_pointer_2_disk( file_index, to.block, to.offset,
+	&end_of_chunk_tag, error_return ) ;
+   if( *error_return == NO_ERROR )
+      ADFI_write_file( file_index, end_of_chunk_tag.block,
+	end_of_chunk_tag.offset, TAG_SIZE, data_chunk_end_tag, error_return ) ;
+   to.offset += DISK_POINTER_SIZE ;
+
+	/** Copy the data, chunk by chunk, through the conversion buffer **/
+   data_bytes = 0 ;
+   for( i=0; i<node.number_of_data_chunks && data_bytes < total_bytes &&
+	     *error_return == NO_ERROR; i++ ) {
+      chunk_bytes =
+	(data_chunk_table[i].end.block - data_chunk_table[i].start.block) *
+		DISK_BLOCK_SIZE +
+	(data_chunk_table[i].end.offset - data_chunk_table[i].start.offset) -
+		(TAG_SIZE + DISK_POINTER_SIZE) ;
+      chunk_bytes = MIN( chunk_bytes, total_bytes - data_bytes ) ;
+      from.block = data_chunk_table[i].start.block ;
+      from.offset = data_chunk_table[i].start.offset +
+	TAG_SIZE + DISK_POINTER_SIZE ;
+      while( chunk_bytes > 0 ) {
+         nbytes = MIN( chunk_bytes, CONVERSION_BUFF_SIZE ) ;
+         ADFI_adjust_disk_pointer( &from, error_return ) ;
+         if( *error_return != NO_ERROR )
+            break ;
+         ADFI_adjust_disk_pointer( &to, error_return ) ;
+         if( *error_return != NO_ERROR )
+            break ;
+         ADFI_read_file( file_index, from.block, from.offset, nbytes,
+		(char *)from_to_data, error_return ) ;
+         if( *error_return != NO_ERROR )
+            break ;
+         ADFI_write_file( file_index, to.block, to.offset, nbytes,
+		(char *)from_to_data, error_return ) ;
+         if( *error_return != NO_ERROR )
+            break ;
+         from.offset += nbytes ;
+         to.offset += nbytes ;
+         chunk_bytes -= nbytes ;
+         data_bytes += nbytes ;
+         } /* end while */
+      } /* end for */
+   free( data_chunk_table ) ;
+   if( *error_return != NO_ERROR )
+      break ;
+
+	/** Point the node at the new chunk, then free the old ones **/
+   old_node = node ;
+   node.number_of_data_chunks = 1 ;
+   node.data_chunks = chunk_start ;
+   ADFI_write_node_header( file_index, &fragmented[n], &node, error_return ) ;
+   if( *error_return != NO_ERROR )
+      break ;
+   ADFI_delete_data( file_index, &old_node, error_return ) ;
+   if( *error_return != NO_ERROR )
+      break ;
+   ADFI_write_modification_date( file_index, error_return ) ;
+   if( *error_return != NO_ERROR )
+      break ;
+   } /* end for */
+
+if( fragmented != NULL )
+   free( fragmented ) ;
+} /* end of ADFI_merge_data_chunks */
+/* end of file ADFI_merge_data_chunks.c */
+/* file ADFI_open_file.c */
+/***********************************************************************
+ADFI open file:
+
+    Track the files used by index.
+    Also track which files are within a given system so a close for
+    the system can close all related files.
+
+input:  const char *file    The filename to open.
+input:  const char *status  The status in which to open the file.
+        Allowable values are:
+                READ_ONLY - File must exist.  Writing NOT allowed.
+                OLD - File must exist.  Reading and writing allowed.
+                NEW - File must not exist.
+                SCRATCH - New file.  Filename is ignored.
+                UNKNOWN - OLD if file exists, else NEW is used.
+input:  const int top_file_index  -1 if this is the top file.
+output: unsigned int *file_index  Returned index of the file.
+output: int *error_return   Error return.
+
+   Possible errors:
+NO_ERROR
+NULL_POINTER
+NULL_STRING_POINTER
+TOO_MANY_ADF_FILES_OPENED
+ADF_FILE_STATUS_NOT_RECOGNIZED
+FILE_OPEN_ERROR
+***********************************************************************/
+void    ADFI_open_file(
+        const char *file,
+        const char *status,
+        unsigned int *file_index,
+        int *error_return )
+{
+int index;
+int f_ret, f_mode;
+char header_data[102];
+
+if( (status == NULL) ||
+    ((file == NULL) && (ADFI_stridx_c( status, "SCRATCH" ) != 0) ) ) {
+   *error_return = NULL_STRING_POINTER ;
+   return ;
+} /* end if */
+
+if( file_index == NULL ) {
+   *error_return = NULL_POINTER ;
+   return ;
+} /* end if */
+
+*error_return = NO_ERROR ;
+
+for( index=0; index<maximum_files; index++ ) {
+   if( ADF_file[index].in_use == 0 )
+      break ;
+} /* end for */
+
+if( index >= maximum_files ) {
+   ADF_FILE *files;
+   /* I don't use realloc, because I don't want to lose
+      any currently open file information if it fails */
+   files = (ADF_FILE *) calloc (maximum_files + ADF_FILE_INC, sizeof(ADF_FILE));
+   if (files == NULL) {
+      *error_return = MEMORY_ALLOCATION_FAILED ;
+      return ;
+   }
+   if (maximum_files) {
+      memcpy (files, ADF_file, maximum_files * sizeof(ADF_FILE));
+      free (ADF_file);
+   } else {
+      ADFI_stack_control(0,0,0,INIT_STK,0,0,NULL);
+   }
+   ADF_file = files;
+   index = maximum_files;
+   maximum_files += ADF_FILE_INC;
+} /* end if */
+
+if (index > MAXIMUM_FILES) {
+   *error_return = TOO_MANY_ADF_FILES_OPENED;
+   return;
+}
 
 ADF_file[index].in_use = 1 ;
 ADF_file[index].nlinks = 0;
@@ -5502,6 +6857,15 @@ ADF_file[index].format  = UNDEFINED_FORMAT ;
 ADF_file[index].os_size = UNDEFINED_FORMAT ;
 ADF_file[index].link_separator = '>' ;
 ADF_file[index].old_version = 0 ;
+ADF_file[index].compact = 0 ;
+ADF_file[index].modified = 0 ;
+ADF_file[index].nlink_cache = 0 ;
+ADF_file[index].link_cache = NULL ;
+ADF_file[index].nlink_files = 0 ;
+ADF_file[index].link_files = NULL ;
+ADF_file[index].nfragmented = 0 ;
+ADF_file[index].fragmented = NULL ;
+ADF_file[index].direct_file = -1 ;
 
 /***
                 READ_ONLY - File must exist.  Writing NOT allowed.
@@ -5558,7 +6922,8 @@ if( ADFI_stridx_c( status, "SCRATCH" ) ) {
 
 /* try to read first part of header to determine version and format */
 if (102 == READ(f_ret, header_data, 102)) {
-    if (header_data[25] != 'B') ADF_file[index].old_version = 1;
+    if (header_data[25] == 'C') ADF_file[index].compact = 1;
+    else if (header_data[25] != 'B') ADF_file[index].old_version = 1;
     ADF_file[index].format  = header_data[100];
     ADF_file[index].os_size = header_data[101];
 }
@@ -5581,6 +6946,137 @@ if (ADF_file[index].file_name != NULL) {
 
 } /* end of ADFI_open_file */
 /* end of file ADFI_open_file.c */
+/* file ADFI_read_batch_run.c */
+/***********************************************************************
+ADFI read batch run:
+	Read the data-chunks of a run of batched requests, sorted into
+	file order and close together, with one read, and copy the data
+	of each request into place.  A run of one chunk is read straight
+	into its buffer.  Each chunk must be a plain data-chunk holding
+	exactly the data of its node; a request whose chunk is not (it is
+	compressed, or was left larger when the data shrank) is marked as
+	not batched, to be read on its own, and so is every request of
+	the run when the read itself fails.
+
+input:  const int count			Number of entries in the run.
+input:  struct BATCH_ENTRY entries[]	The sorted entries of the run.
+output: char *data[]			The buffers, indexed by request.
+output:	int *error_return		Error return.
+
+   Possible errors:
+NO_ERROR
+NULL_POINTER
+ADF_FILE_NOT_OPENED
+***********************************************************************/
+void    ADFI_read_batch_run(
+		const int count,
+		struct BATCH_ENTRY entries[],
+		char *data[],
+		int *error_return )
+{
+char	info[TAG_SIZE + DISK_POINTER_SIZE] ;
+char	start_tag[TAG_SIZE + 1], end_tag[TAG_SIZE + 1] ;
+char	*buffer = NULL, *chunk, *pieces[3] ;
+struct DISK_POINTER	end_of_chunk_tag ;
+unsigned int		file_index ;
+cglong_t		run_start, run_end, chunk_start, chunk_end ;
+cglong_t		lengths[3] ;
+int			i, err ;
+
+if( count < 1 || entries == NULL || data == NULL ) {
+   *error_return = NULL_POINTER ;
+   return ;
+   } /* end if */
+
+file_index = entries[0].file_index ;
+if( (int)file_index >= maximum_files || ADF_file[file_index].in_use == 0 ) {
+   *error_return = ADF_FILE_NOT_OPENED ;
+   return ;
+   } /* end if */
+
+*error_return = NO_ERROR ;
+
+	/** A chunk is its tag and end pointer, the data and the end tag **/
+run_start = (cglong_t)entries[0].start.block * DISK_BLOCK_SIZE +
+	    entries[0].start.offset ;
+run_end = run_start ;
+for( i=0; i<count; i++ ) {
+   chunk_end = (cglong_t)entries[i].start.block * DISK_BLOCK_SIZE +
+	       entries[i].start.offset + TAG_SIZE + DISK_POINTER_SIZE +
+	       entries[i].bytes + TAG_SIZE ;
+   if( chunk_end > run_end ) run_end = chunk_end ;
+   } /* end for */
+
+if( count == 1 ) {
+   pieces[0] = info ;
+   pieces[1] = data[entries[0].request] ;
+   pieces[2] = end_tag ;
+   lengths[0] = TAG_SIZE + DISK_POINTER_SIZE ;
+   lengths[1] = entries[0].bytes ;
+   lengths[2] = TAG_SIZE ;
+   ADFI_read_file_vector( file_index, entries[0].start.block,
+		entries[0].start.offset, 3, lengths, pieces, &err ) ;
+   } /* end if */
+else {
+   buffer = (char *) malloc( (size_t)(run_end - run_start) ) ;
+   if( buffer == NULL )
+      err = MEMORY_ALLOCATION_FAILED ;
+   else
+      ADFI_read_file( file_index, entries[0].start.block,
+		entries[0].start.offset, run_end - run_start, buffer, &err ) ;
+   } /* end else */
+
+	/** Leave the whole run to be read request by request **/
+if( err != NO_ERROR ) {
+   for( i=0; i<count; i++ )
+      entries[i].batched = 0 ;
+   if( buffer != NULL ) free( buffer ) ;
+   return ;
+   } /* end if */
+
+for( i=0; i<count; i++ ) {
+   chunk_start = (cglong_t)entries[i].start.block * DISK_BLOCK_SIZE +
+		 entries[i].start.offset ;
+   if( buffer == NULL ) {
+      chunk = info ;
+      } /* end if */
+   else {
+      chunk = buffer + (chunk_start - run_start) ;
+      memcpy( end_tag, chunk + TAG_SIZE + DISK_POINTER_SIZE +
+	      entries[i].bytes, TAG_SIZE ) ;
+      } /* end else */
+   memcpy( start_tag, chunk, TAG_SIZE ) ;
+   start_tag[TAG_SIZE] = '\0' ;
+   end_tag[TAG_SIZE] = '\0' ;
+
+	/** Check the tags, and that the data fills the chunk **/
+#ifdef NEW_DISK_POINTER
+   ADFI_read_disk_pointer( file_index, &chunk[TAG_SIZE],
+		&chunk[DISK_POINTER_SIZE], &end_of_chunk_tag, &err ) ;
+#else
+   ADFI_disk_pointer_from_ASCII_Hex( &chunk[TAG_SIZE],
+		&chunk[DISK_POINTER_SIZE], &end_of_chunk_tag, &err ) ;
+#endif
+   chunk_end = (cglong_t)end_of_chunk_tag.block * DISK_BLOCK_SIZE +
+	       end_of_chunk_tag.offset ;
+   if( err != NO_ERROR ||
+       ADFI_stridx_c( start_tag, data_chunk_start_tag ) != 0 ||
+       ADFI_stridx_c( end_tag, data_chunk_end_tag ) != 0 ||
+       chunk_end != chunk_start + TAG_SIZE + DISK_POINTER_SIZE +
+		    entries[i].bytes ) {
+      entries[i].batched = 0 ;
+      continue ;
+      } /* end if */
+
+   if( buffer != NULL )
+      memcpy( data[entries[i].request], chunk + TAG_SIZE + DISK_POINTER_SIZE,
+	      (size_t)entries[i].bytes ) ;
+   } /* end for */
+
+if( buffer != NULL ) free( buffer ) ;
+
+} /* end of ADFI_read_batch_run */
+/* end of file ADFI_read_batch_run.c */
 /* file ADFI_read_chunk_length.c */
 /***********************************************************************
 ADFI read chunk length:
@@ -5714,7 +7210,7 @@ else {
       if( ADFI_stridx_c( tag, node_start_tag ) == 0 ) { /** Node **/
          end_of_chunk_tag->block = block_offset->block ;
          end_of_chunk_tag->offset = block_offset->offset +
-		NODE_HEADER_SIZE - TAG_SIZE ;
+		FILE_NODE_HEADER_SIZE( file_index ) - TAG_SIZE ;
          ADFI_adjust_disk_pointer( end_of_chunk_tag, error_return ) ;
          if( *error_return != NO_ERROR )
             return ;
@@ -5737,6 +7233,119 @@ else {
 
 } /* end of ADFI_read_chunk_length */
 /* end of file ADFI_read_chunk_length.c */
+/* file ADFI_read_compressed_chunk.c */
+/***********************************************************************
+ADFI read compressed chunk:
+	Read data from a compressed data-chunk.  Only the blocks holding
+	the requested bytes are read and expanded.
+
+input:  const unsigned int file_index	The file index.
+input:  const struct DISK_POINTER *block_offset  Block & offset in the file.
+input:  const struct TOKENIZED_DATA_TYPE *tokenized_data_type Array, NULL
+					to return the data in the file format.
+input:  const int data_size		Size of data entity in bytes.
+input:  const long start_offset		Starting offset into the data.
+input:  const long total_bytes		Number of bytes to read.
+output: char *data			Pointer to the resulting data.
+output:	int *error_return		Error return.
+
+   Possible errors:
+NO_ERROR
+NULL_POINTER
+ADF_FILE_NOT_OPENED
+ADF_DISK_TAG_ERROR
+REQUESTED_DATA_TOO_LONG
+BAD_COMPRESSED_DATA
+***********************************************************************/
+void    ADFI_read_compressed_chunk(
+		const unsigned int file_index,
+		const struct DISK_POINTER *block_offset,
+		const struct TOKENIZED_DATA_TYPE *tokenized_data_type,
+		const int data_size,
+		const cglong_t start_offset,
+		const cglong_t total_bytes,
+		char *data,
+		int *error_return )
+{
+int		format_compare = 1 ;
+int		current_token = -1 ;
+int		machine_size = data_size ;
+unsigned int	block, block_bytes, start, count ;
+cglong_t	offset, bytes_left ;
+
+if( (block_offset == NULL) || (data == NULL) ) {
+   *error_return = NULL_POINTER ;
+   return ;
+   } /* end if */
+
+if( (int)file_index >= maximum_files || ADF_file[file_index].in_use == 0 ) {
+   *error_return = ADF_FILE_NOT_OPENED ;
+   return ;
+   } /* end if */
+
+*error_return = NO_ERROR ;
+
+ADFI_compressed_chunk_open( file_index, block_offset, error_return ) ;
+if( *error_return != NO_ERROR )
+   return ;
+
+if( start_offset < 0 ||
+    start_offset + total_bytes > compressed_chunk.data_bytes ) {
+   *error_return = REQUESTED_DATA_TOO_LONG ;
+   return ;
+   } /* end if */
+
+	/** check for need of data translation **/
+if( tokenized_data_type != NULL ) {
+   ADFI_file_and_machine_compare( file_index, tokenized_data_type,
+				  &format_compare, error_return );
+   if( *error_return != NO_ERROR )
+      return ;
+   if( format_compare != 1 ) {
+	/** Get machine size of element stored in the NULL element **/
+      do {
+        machine_size = tokenized_data_type[ ++current_token ].machine_type_size ;
+      } while( tokenized_data_type[ current_token ].type[0] != 0 ) ;
+      } /* end if */
+   } /* end if */
+
+offset = start_offset ;
+bytes_left = total_bytes ;
+while( bytes_left > 0 ) {
+   block = (unsigned int)(offset / compressed_chunk.block_bytes) ;
+   start = (unsigned int)(offset % compressed_chunk.block_bytes) ;
+   ADFI_compressed_chunk_block( block, error_return ) ;
+   if( *error_return != NO_ERROR )
+      return ;
+
+   block_bytes = (unsigned int)MIN( (cglong_t)compressed_chunk.block_bytes,
+	compressed_chunk.data_bytes -
+		(cglong_t)block * compressed_chunk.block_bytes ) ;
+   count = (unsigned int)MIN( (cglong_t)(block_bytes - start), bytes_left ) ;
+   if( format_compare == 1 ) {
+      memcpy( data, compressed_chunk.block_data + start, count ) ;
+      data += count ;
+      } /* end if */
+   else {
+      ADFI_convert_number_format(
+		ADF_file[file_index].format, /* from format */
+		ADF_file[file_index].os_size, /* from os size */
+		ADF_this_machine_format, /* to format */
+		ADF_this_machine_os_size, /* to os size */
+		FROM_FILE_FORMAT,
+		tokenized_data_type, count / data_size,
+		compressed_chunk.block_data + start,
+		(unsigned char *)data, error_return ) ;
+      if( *error_return != NO_ERROR )
+         return ;
+      data += (count / data_size) * machine_size ;
+      } /* end else */
+   offset += count ;
+   bytes_left -= count ;
+   } /* end while */
+
+} /* end of ADFI_read_compressed_chunk */
+/* end of file ADFI_read_compressed_chunk.c */
 /* file ADFI_read_data_chunk.c */
 /***********************************************************************
 ADFI read data chunk:
@@ -5773,6 +7382,8 @@ int format_compare ;
 char	tag[TAG_SIZE + 1] ;
 struct DISK_POINTER	data_start, end_of_chunk_tag ;
 cglong_t			chunk_total_bytes ;
+char			*pieces[2] ;
+cglong_t		lengths[2] ;
 
 if( block_offset == NULL ) {
    *error_return = NULL_POINTER ;
@@ -5803,20 +7414,15 @@ if( *error_return != NO_ERROR )
    return ;
 tag[TAG_SIZE] = '\0' ;
 
-	/** Check start-of-chunk tag **/
-if( ADFI_stridx_c( tag, data_chunk_start_tag ) != 0 ) {
-   *error_return = ADF_DISK_TAG_ERROR ;
+	/** Compressed chunks expand the blocks holding the data **/
+if( ADFI_stridx_c( tag, compressed_chunk_start_tag ) == 0 ) {
+   ADFI_read_compressed_chunk( file_index, block_offset, tokenized_data_type,
+		data_size, start_offset, total_bytes, data, error_return ) ;
    return ;
    } /* end if */
 
-	/** Check end-of-chunk tag **/
-ADFI_read_file( file_index, end_of_chunk_tag.block, end_of_chunk_tag.offset,
-	TAG_SIZE, tag, error_return ) ;
-if( *error_return != NO_ERROR )
-   return ;
-tag[TAG_SIZE] = '\0' ;
-
-if( ADFI_stridx_c( tag, data_chunk_end_tag ) != 0 ) {
+	/** Check start-of-chunk tag **/
+if( ADFI_stridx_c( tag, data_chunk_start_tag ) != 0 ) {
    *error_return = ADF_DISK_TAG_ERROR ;
    return ;
    } /* end if */
@@ -5836,30 +7442,59 @@ if( chunk_bytes > chunk_total_bytes ) {
    *error_return = REQUESTED_DATA_TOO_LONG ;
    return ;
    } /* end if */
-else {
-   if( chunk_bytes < chunk_total_bytes )
-      *error_return = REQUESTED_DATA_TOO_LONG ;
 
-       /** check for need of data translation **/
-    ADFI_file_and_machine_compare( file_index, tokenized_data_type,
-				   &format_compare, error_return );
-    if( *error_return != NO_ERROR )
-       return ;
-    if( format_compare == 1 ) {
+       /** check for need of data translation **/
+ADFI_file_and_machine_compare( file_index, tokenized_data_type,
+			       &format_compare, error_return );
+if( *error_return != NO_ERROR )
+   return ;
+
+	/** If the data runs up to the end-of-chunk tag, read the data and
+	    the tag together, then check the tag **/
+if( format_compare == 1 && start_offset + total_bytes == chunk_total_bytes ) {
+   pieces[0] = data ;
+   pieces[1] = tag ;
+   lengths[0] = total_bytes ;
+   lengths[1] = TAG_SIZE ;
+   ADFI_read_file_vector( file_index, data_start.block, data_start.offset,
+		2, lengths, pieces, error_return ) ;
+   if( *error_return != NO_ERROR )
+      return ;
+   tag[TAG_SIZE] = '\0' ;
+
+   if( ADFI_stridx_c( tag, data_chunk_end_tag ) != 0 ) {
+      *error_return = ADF_DISK_TAG_ERROR ;
+      return ;
+      } /* end if */
+   return ;
+   } /* end if */
+
+	/** Check end-of-chunk tag **/
+ADFI_read_file( file_index, end_of_chunk_tag.block, end_of_chunk_tag.offset,
+	TAG_SIZE, tag, error_return ) ;
+if( *error_return != NO_ERROR )
+   return ;
+tag[TAG_SIZE] = '\0' ;
+
+if( ADFI_stridx_c( tag, data_chunk_end_tag ) != 0 ) {
+   *error_return = ADF_DISK_TAG_ERROR ;
+   return ;
+   } /* end if */
+
+if( format_compare == 1 ) {
 	/** Read the data off of disk **/
 assert(data_start.offset <= 0x1fff);
-      ADFI_read_file( file_index, data_start.block, data_start.offset,
-		      total_bytes, data, error_return ) ;
-      if( *error_return != NO_ERROR )
-         return ;
-      } /* end if */
-   else {
-      ADFI_read_data_translated( file_index, data_start.block,
+   ADFI_read_file( file_index, data_start.block, data_start.offset,
+		   total_bytes, data, error_return ) ;
+   if( *error_return != NO_ERROR )
+      return ;
+   } /* end if */
+else {
+   ADFI_read_data_translated( file_index, data_start.block,
 		data_start.offset, tokenized_data_type, data_size,
 		total_bytes, data, error_return ) ;
-      if( *error_return != NO_ERROR )
-         return ;
-      } /* end else */
+   if( *error_return != NO_ERROR )
+      return ;
    } /* end else */
 
 } /* end of ADFI_read_data_chunk */
@@ -5955,6 +7590,107 @@ if( ADFI_stridx_c( tag, data_chunk_table_end_tag ) != 0 ) {
 
 } /* end of ADFI_read_data_chunk_table */
 /* end of file ADFI_read_data_chunk_table.c */
+/* file ADFI_read_data_extents.c */
+/***********************************************************************
+ADFI read data extents:
+	Read a span of a node's data from the extents found by
+	ADFI_map_data_chunks.  Bytes past the last extent are returned
+	as zeros with INCOMPLETE_DATA.
+
+input:  const unsigned int file_index	The file index.
+input:  const int number_of_extents	The number of extents.
+input:  const struct DATA_EXTENT extents[]  The data-chunk extents.
+input:  const struct TOKENIZED_DATA_TYPE *tokenized_data_type Array.
+input:  const int file_bytes		Size of data entity in the file.
+input:  const int memory_bytes		Size of data entity in memory.
+input:  const cglong_t start_byte	Starting offset into the data (file).
+input:  const cglong_t total_bytes	Number of bytes to read (file).
+output: char *data			Pointer to the resulting data.
+output:	int *error_return		Error return.
+
+   Possible errors:
+NO_ERROR
+NULL_POINTER
+ADF_FILE_NOT_OPENED
+INCOMPLETE_DATA
+***********************************************************************/
+void    ADFI_read_data_extents(
+		const unsigned int file_index,
+		const int number_of_extents,
+		const struct DATA_EXTENT extents[],
+		const struct TOKENIZED_DATA_TYPE *tokenized_data_type,
+		const int file_bytes,
+		const int memory_bytes,
+		const cglong_t start_byte,
+		const cglong_t total_bytes,
+		char *data,
+		int *error_return )
+{
+int		format_compare, i ;
+cglong_t	extent_start, offset, bytes ;
+cglong_t	bytes_left = total_bytes ;
+struct DISK_POINTER	data_start ;
+
+if( extents == NULL || tokenized_data_type == NULL || data == NULL ) {
+   *error_return = NULL_POINTER ;
+   return ;
+   } /* end if */
+
+if( (int)file_index >= maximum_files || ADF_file[file_index].in_use == 0 ) {
+   *error_return = ADF_FILE_NOT_OPENED ;
+   return ;
+   } /* end if */
+
+ADFI_file_and_machine_compare( file_index, tokenized_data_type,
+			       &format_compare, error_return );
+if( *error_return != NO_ERROR )
+   return ;
+
+extent_start = 0 ;
+for( i=0; i<number_of_extents && bytes_left > 0; i++ ) {
+   if( start_byte + total_bytes - bytes_left >=
+       extent_start + extents[i].bytes ) {
+      extent_start += extents[i].bytes ;
+      continue ;
+      } /* end if */
+   offset = start_byte + total_bytes - bytes_left - extent_start ;
+   bytes = MIN( bytes_left, extents[i].bytes - offset ) ;
+
+   if( extents[i].compressed ) {
+      ADFI_read_compressed_chunk( file_index, &extents[i].start,
+		tokenized_data_type, file_bytes, offset, bytes,
+		data, error_return ) ;
+      } /* end if */
+   else {
+      data_start.block = extents[i].start.block ;
+      data_start.offset = extents[i].start.offset + offset ;
+      ADFI_adjust_disk_pointer( &data_start, error_return ) ;
+      if( *error_return != NO_ERROR )
+         return ;
+      if( format_compare == 1 )
+         ADFI_read_file( file_index, data_start.block, data_start.offset,
+		bytes, data, error_return ) ;
+      else
+         ADFI_read_data_translated( file_index, data_start.block,
+		data_start.offset, tokenized_data_type, file_bytes,
+		bytes, data, error_return ) ;
+      } /* end else */
+   if( *error_return != NO_ERROR )
+      return ;
+
+   data += (bytes / file_bytes) * memory_bytes ;
+   bytes_left -= bytes ;
+   extent_start += extents[i].bytes ;
+   } /* end for */
+
+	/** Data never written is zero **/
+if( bytes_left > 0 ) {
+   memset( data, 0, (size_t)((bytes_left / file_bytes) * memory_bytes) ) ;
+   *error_return = INCOMPLETE_DATA ;
+   } /* end if */
+
+} /* end of ADFI_read_data_extents */
+/* end of file ADFI_read_data_extents.c */
 /* file ADFI_read_data_translated.c */
 /***********************************************************************
 ADFI read data translated:
@@ -6137,10 +7873,423 @@ if( *error_return != NO_ERROR )
 } /* end of ADFI_read_disk_pointer_from_disk */
 /* end of file ADFI_read_disk_pointer_from_disk.c */
 
+#ifdef HAVE_IO_URING
+/***********************************************************************
+ADFI queue
+
+The io_uring used for queued I/O, with its rings mapped into memory
+and a slot for each request which may be in flight.  state is 0 until
+it is first wanted, then 1 if it was set up, or -1 if it couldn't be
+(which is remembered until the queue depth is changed).  queued is the
+number of requests put in the submission ring but not yet passed to
+the system, and prefetches the number of read-aheads not yet reaped.
+***********************************************************************/
+struct QUEUE_SLOT {
+   file_offset_t offset;
+   char *data;
+   cglong_t length;
+   cglong_t done;
+   struct iovec iov;
+   int busy;
+};
+
+static struct {
+   int state;
+   int fd;
+   int depth;
+   unsigned int queued;
+   int prefetches;
+   unsigned int sq_entries, cq_entries;
+   unsigned int *sq_head, *sq_tail, *sq_mask, *sq_array;
+   unsigned int *cq_head, *cq_tail, *cq_mask;
+   struct io_uring_sqe *sqes;
+   struct io_uring_cqe *cqes;
+   void *sq_ring, *cq_ring;
+   size_t sq_size, cq_size;
+   struct QUEUE_SLOT *slots;
+} ADF_queue = { 0, -1, 0, 0, 0, 0, 0, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+                NULL, NULL, NULL, NULL, 0, 0, NULL };
+
+/***********************************************************************
+ADFI queue open
+
+Set up the queue for ADF_queue_depth requests, if it isn't already.
+return: 0 if the queue may be used, -1 if not
+***********************************************************************/
+static int ADFI_queue_open(void)
+{
+   struct io_uring_params p;
+   char *sq, *cq;
+
+   if (ADF_queue.state > 0 && ADF_queue.depth == ADF_queue_depth) return 0;
+   if (ADF_queue.state > 0) ADFI_queue_close();
+   if (ADF_queue.state < 0) return -1;
+   ADF_queue.state = -1;
+
+   memset(&p, 0, sizeof(p));
+   ADF_queue.fd = (int)syscall(__NR_io_uring_setup,
+                               (unsigned int)ADF_queue_depth, &p);
+   if (ADF_queue.fd < 0) return -1;
+
+   ADF_queue.sq_size = p.sq_off.array + p.sq_entries * sizeof(unsigned int);
+   ADF_queue.cq_size = p.cq_off.cqes +
+                       p.cq_entries * sizeof(struct io_uring_cqe);
+   if (p.features & IORING_FEAT_SINGLE_MMAP)
+      ADF_queue.sq_size = ADF_queue.cq_size =
+         MAX(ADF_queue.sq_size, ADF_queue.cq_size);
+   ADF_queue.sq_ring = mmap(NULL, ADF_queue.sq_size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, ADF_queue.fd,
+                            IORING_OFF_SQ_RING);
+   if (ADF_queue.sq_ring == MAP_FAILED) {
+      ADF_queue.sq_ring = NULL;
+      ADFI_queue_close();
+      ADF_queue.state = -1;
+      return -1;
+   }
+   if (p.features & IORING_FEAT_SINGLE_MMAP)
+      ADF_queue.cq_ring = ADF_queue.sq_ring;
+   else {
+      ADF_queue.cq_ring = mmap(NULL, ADF_queue.cq_size,
+                               PROT_READ | PROT_WRITE,
+                               MAP_SHARED | MAP_POPULATE, ADF_queue.fd,
+                               IORING_OFF_CQ_RING);
+      if (ADF_queue.cq_ring == MAP_FAILED) ADF_queue.cq_ring = NULL;
+   }
+   ADF_queue.sqes = (struct io_uring_sqe *)mmap(NULL,
+                       p.sq_entries * sizeof(struct io_uring_sqe),
+                       PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       ADF_queue.fd, IORING_OFF_SQES);
+   if (ADF_queue.sqes == MAP_FAILED) ADF_queue.sqes = NULL;
+   ADF_queue.slots = (struct QUEUE_SLOT *)calloc(ADF_queue_depth,
+                                                 sizeof(struct QUEUE_SLOT));
+   ADF_queue.sq_entries = p.sq_entries;
+   ADF_queue.cq_entries = p.cq_entries;
+   if (ADF_queue.cq_ring == NULL || ADF_queue.sqes == NULL ||
+       ADF_queue.slots == NULL) {
+      ADFI_queue_close();
+      ADF_queue.state = -1;
+      return -1;
+   }
+
+   sq = (char *)ADF_queue.sq_ring;
+   cq = (char *)ADF_queue.cq_ring;
+   ADF_queue.sq_head  = (unsigned int *)(sq + p.sq_off.head);
+   ADF_queue.sq_tail  = (unsigned int *)(sq + p.sq_off.tail);
+   ADF_queue.sq_mask  = (unsigned int *)(sq + p.sq_off.ring_mask);
+   ADF_queue.sq_array = (unsigned int *)(sq + p.sq_off.array);
+   ADF_queue.cq_head  = (unsigned int *)(cq + p.cq_off.head);
+   ADF_queue.cq_tail  = (unsigned int *)(cq + p.cq_off.tail);
+   ADF_queue.cq_mask  = (unsigned int *)(cq + p.cq_off.ring_mask);
+   ADF_queue.cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+   ADF_queue.depth = ADF_queue_depth;
+   ADF_queue.queued = 0;
+   ADF_queue.prefetches = 0;
+   ADF_queue.state = 1;
+   return 0;
+}
+
+/***********************************************************************
+ADFI queue wanted
+
+return: 1 if a transfer of data_length bytes should go through the
+	queue, otherwise 0
+***********************************************************************/
+static int ADFI_queue_wanted(
+        const cglong_t data_length)
+{
+   return ADF_queue_depth > 1 && data_length >= 2 * QUEUE_PIECE_SIZE &&
+          ADFI_queue_open() == 0;
+}
+
+/***********************************************************************
+ADFI queue sqe
+
+return: the next free submission entry, cleared.  It is passed to the
+	system by the next ADFI_queue_enter.  There must be room for it.
+***********************************************************************/
+static struct io_uring_sqe *ADFI_queue_sqe(void)
+{
+   unsigned int index = (*ADF_queue.sq_tail + ADF_queue.queued++) &
+                        *ADF_queue.sq_mask;
+   struct io_uring_sqe *sqe = &ADF_queue.sqes[index];
+
+   memset(sqe, 0, sizeof(*sqe));
+   return sqe;
+}
+
+/***********************************************************************
+ADFI queue enter
+
+Pass the queued requests, and any the system didn't take before, to
+the system, and wait for at least one completion if wait is set.
+return: 0, or the errno of the failure
+***********************************************************************/
+static int ADFI_queue_enter(
+        const int wait)
+{
+   unsigned int tail = *ADF_queue.sq_tail, n;
+
+   for (n = 0; n < ADF_queue.queued; n++)
+      ADF_queue.sq_array[(tail + n) & *ADF_queue.sq_mask] =
+         (tail + n) & *ADF_queue.sq_mask;
+   tail += ADF_queue.queued;
+   ADF_queue.queued = 0;
+   __atomic_store_n(ADF_queue.sq_tail, tail, __ATOMIC_RELEASE);
+
+   while (1) {
+      n = tail - __atomic_load_n(ADF_queue.sq_head, __ATOMIC_ACQUIRE);
+      if (n == 0 && !wait) return 0;
+      if (syscall(__NR_io_uring_enter, ADF_queue.fd, n, wait ? 1 : 0,
+                  wait ? IORING_ENTER_GETEVENTS : 0, NULL, 0) >= 0)
+         return 0;
+      if (errno != EINTR) return errno;
+   }
+}
+
+/***********************************************************************
+ADFI queue reap
+
+Take the next completion, if there is one.
+output: user_data	what the request was submitted with
+output: res		the result of the request
+return: 1 if a completion was taken, 0 if there was none
+***********************************************************************/
+static int ADFI_queue_reap(
+        __u64 *user_data,
+        int *res)
+{
+   unsigned int head = *ADF_queue.cq_head;
+   struct io_uring_cqe *cqe;
+
+   if (head == __atomic_load_n(ADF_queue.cq_tail, __ATOMIC_ACQUIRE))
+      return 0;
+   cqe = &ADF_queue.cqes[head & *ADF_queue.cq_mask];
+   *user_data = cqe->user_data;
+   *res = cqe->res;
+   __atomic_store_n(ADF_queue.cq_head, head + 1, __ATOMIC_RELEASE);
+   return 1;
+}
+
+/***********************************************************************
+ADFI queue slot
+
+Submit what is left of the transfer of a slot.
+***********************************************************************/
+static void ADFI_queue_slot(
+        const int op,
+        const int fd,
+        const int n)
+{
+   struct QUEUE_SLOT *slot = &ADF_queue.slots[n];
+   struct io_uring_sqe *sqe = ADFI_queue_sqe();
+
+   slot->iov.iov_base = slot->data + slot->done;
+   slot->iov.iov_len = (size_t)(slot->length - slot->done);
+   sqe->opcode = (__u8)op;
+   sqe->fd = fd;
+   sqe->off = (__u64)(slot->offset + slot->done);
+   sqe->addr = (__u64)(size_t)&slot->iov;
+   sqe->len = 1;
+   sqe->user_data = (__u64)(n + 1);
+}
+
+/***********************************************************************
+ADFI queue io
+
+Read (IORING_OP_READV) or write (IORING_OP_WRITEV) a large piece of a
+file through the queue.  It is split into pieces of QUEUE_PIECE_SIZE
+bytes, up to ADF_queue_depth of which are in flight at once, and
+transfers which stop short are continued from where they stopped.
+Completions of read-aheads are counted off as they come.
+
+input:  fd		the file descriptor
+input:  op		IORING_OP_READV or IORING_OP_WRITEV
+input:  offset		where in the file
+input:  data_length	how many bytes
+input:  data		where in memory
+return: the number of bytes transferred before the first which
+	couldn't be (the end of the file), or -1 on an error, with the
+	errno in ADF_sys_err
+***********************************************************************/
+static cglong_t ADFI_queue_io (
+        const int fd,
+        const int op,
+        const file_offset_t offset,
+        const cglong_t data_length,
+        char *data)
+{
+   struct QUEUE_SLOT *slot;
+   cglong_t next = 0, stop = data_length;
+   int busy = 0, err = 0, n, res;
+   __u64 user_data;
+
+   ADF_sys_err = 0;
+   for (n = 0; n < ADF_queue.depth; n++)
+      ADF_queue.slots[n].busy = 0;
+
+   while (1) {
+      for (n = 0; n < ADF_queue.depth && next < stop && !err; n++) {
+         slot = &ADF_queue.slots[n];
+         if (slot->busy) continue;
+         slot->offset = offset + next;
+         slot->data = data + next;
+         slot->length = MIN(QUEUE_PIECE_SIZE, stop - next);
+         slot->done = 0;
+         slot->busy = 1;
+         ADFI_queue_slot(op, fd, n);
+         next += slot->length;
+         busy++;
+      }
+      if (busy == 0) break;
+
+      res = ADFI_queue_enter(1);
+      if (res && res != EAGAIN && res != EBUSY) {
+         /* the requests in flight can't be waited for, so the queue
+            is given up */
+         ADF_queue.state = -1;
+         ADF_sys_err = res;
+         return -1;
+      }
+
+      while (ADFI_queue_reap(&user_data, &res)) {
+         if (user_data == 0) {
+            ADF_queue.prefetches--;
+            continue;
+         }
+         n = (int)user_data - 1;
+         slot = &ADF_queue.slots[n];
+         if (res == -EINTR || res == -EAGAIN) {
+            ADFI_queue_slot(op, fd, n);
+            continue;
+         }
+         if (res > 0) {
+            slot->done += res;
+            if (slot->done < slot->length) {
+               ADFI_queue_slot(op, fd, n);
+               continue;
+            }
+         }
+         else {
+            if (res < 0 && !err) err = -res;
+            stop = MIN(stop, slot->offset - offset + slot->done);
+         }
+         slot->busy = 0;
+         busy--;
+      }
+   }
+
+   if (err) {
+      ADF_sys_err = err;
+      return -1;
+   }
+   return stop;
+}
+#endif
+
+/* file ADFI_prefetch_node_headers.c */
+/***********************************************************************
+ADFI prefetch node headers:
+	Ask the system to read the node headers of the children in a
+	piece of a sub-node table into its cache, without waiting for
+	them, since they are usually read soon after.  Only done when
+	queued I/O is in use, and when the headers are in at least two
+	disk blocks other than the one in the read buffer, since a single
+	block costs no more to read when it is wanted.
+
+input:	const unsigned int file_index	The file of the children.
+input:	const int count			The number of children.
+input:	const struct SUB_NODE_TABLE_ENTRY sub_node_table[] The children.
+***********************************************************************/
+void	ADFI_prefetch_node_headers(
+		const unsigned int file_index,
+		const int count,
+		const struct SUB_NODE_TABLE_ENTRY sub_node_table[] )
+{
+#ifdef HAVE_IO_URING
+struct io_uring_sqe *sqe ;
+file_offset_t offset, first, last, done ;
+unsigned int room, blocks ;
+int n, pass, res, err ;
+__u64 user_data ;
+
+if( count < 2 || ADF_queue_depth < 2 || ADFI_queue_open() != 0 )
+   return ;
+
+	/** Count off the read-aheads already done, and leave room in
+	    the completion ring for a full queue of reads **/
+while( ADFI_queue_reap( &user_data, &res ) )
+   if( user_data == 0 ) ADF_queue.prefetches-- ;
+room = ADF_queue.cq_entries - ADF_queue.depth - ADF_queue.prefetches ;
+room = MIN( room, ADF_queue.sq_entries - ( *ADF_queue.sq_tail -
+	    __atomic_load_n( ADF_queue.sq_head, __ATOMIC_ACQUIRE ) ) ) ;
+
+	/** Count the blocks first, then ask for them; consecutive
+	    children in the same blocks are asked for once **/
+for( pass=0; pass<2; pass++ ) {
+   done = (int)file_index == last_rd_file ? last_rd_block : -1 ;
+   blocks = 0 ;
+   for( n=0; n<count && blocks < room; n++ ) {
+      ADFI_file_offset( file_index, sub_node_table[n].child_location.block,
+		     sub_node_table[n].child_location.offset, &offset, &err ) ;
+      if( err != NO_ERROR ) continue ;
+      first = offset / DISK_BLOCK_SIZE ;
+      last = ( offset + FILE_NODE_HEADER_SIZE( file_index ) - 1 ) /
+	     DISK_BLOCK_SIZE ;
+      if( first <= done && last >= done ) first = done + 1 ;
+      if( first > last ) continue ;
+      done = last ;
+      blocks += (unsigned int)( last - first + 1 ) ;
+      if( pass == 0 ) continue ;
+
+      sqe = ADFI_queue_sqe() ;
+      sqe->opcode = IORING_OP_FADVISE ;
+      sqe->fd = ADF_file[file_index].file ;
+      sqe->off = (__u64)( first * DISK_BLOCK_SIZE ) ;
+      sqe->len = (__u32)( ( last - first + 1 ) * DISK_BLOCK_SIZE ) ;
+      sqe->fadvise_advice = POSIX_FADV_WILLNEED ;
+      sqe->user_data = 0 ;
+      ADF_queue.prefetches++ ;
+      } /* end for */
+   if( blocks < 2 ) return ;
+   } /* end for */
+
+ADFI_queue_enter( 0 ) ;
+#endif
+} /* end of ADFI_prefetch_node_headers */
+/* end of file ADFI_prefetch_node_headers.c */
+
+/* file ADFI_queue_close.c */
+/***********************************************************************
+ADFI queue close:
+	Release the io_uring of queued I/O, if there is one.  It is set
+	up again, for the current queue depth, when next wanted.  No
+	reads or writes are in flight outside of ADFI_queue_io, and
+	read-aheads need not be waited for.
+***********************************************************************/
+void	ADFI_queue_close()
+{
+#ifdef HAVE_IO_URING
+if( ADF_queue.sqes != NULL )
+   munmap( ADF_queue.sqes, ADF_queue.sq_entries * sizeof(struct io_uring_sqe) ) ;
+if( ADF_queue.cq_ring != NULL && ADF_queue.cq_ring != ADF_queue.sq_ring )
+   munmap( ADF_queue.cq_ring, ADF_queue.cq_size ) ;
+if( ADF_queue.sq_ring != NULL )
+   munmap( ADF_queue.sq_ring, ADF_queue.sq_size ) ;
+if( ADF_queue.fd >= 0 )
+   CLOSE( ADF_queue.fd ) ;
+if( ADF_queue.slots != NULL )
+   free( ADF_queue.slots ) ;
+memset( &ADF_queue, 0, sizeof(ADF_queue) ) ;
+ADF_queue.fd = -1 ;
+#endif
+} /* end of ADFI_queue_close */
+/* end of file ADFI_queue_close.c */
+
 /***********************************************************************/
 
 cglong_t ADFI_read (
         const unsigned int file_index,
+        const file_offset_t offset,
         const cglong_t data_length,
         char *data)
 {
@@ -6149,10 +8298,16 @@ cglong_t ADFI_read (
    cglong_t bytes_read = 0;
    int nbytes, to_read;
 
+#ifdef HAVE_IO_URING
+   if (ADFI_queue_wanted(data_length))
+      return ADFI_queue_io(ADF_file[file_index].file, IORING_OP_READV,
+                           offset, data_length, data);
+#endif
    ADF_sys_err = 0;
    while (bytes_left > 0) {
       to_read = bytes_left > CG_MAX_INT32 ? CG_MAX_INT32 : (int)bytes_left;
-      nbytes = (int) READ (ADF_file[file_index].file, data_ptr, to_read);
+      nbytes = (int) file_pread (ADF_file[file_index].file, data_ptr, to_read,
+                                 offset + bytes_read);
       if (0 == nbytes) break;
       if (-1 == nbytes) {
           if (EINTR != errno) {
@@ -6169,6 +8324,144 @@ cglong_t ADFI_read (
    return bytes_read;
 }
 
+#ifdef HAVE_VECTOR_IO
+static cglong_t ADFI_readv (
+        const unsigned int file_index,
+        const file_offset_t offset,
+        const int count,
+        const cglong_t data_length[],
+        char *data[])
+{
+   struct iovec iov[MAX_IO_VECTORS];
+   cglong_t bytes_read = 0;
+   ssize_t nbytes;
+   int first = 0, n;
+
+   for (n = 0; n < count; n++) {
+      iov[n].iov_base = data[n];
+      iov[n].iov_len = (size_t)data_length[n];
+   }
+   ADF_sys_err = 0;
+   while (first < count) {
+      nbytes = file_preadv (ADF_file[file_index].file, &iov[first],
+                            count - first, offset + bytes_read);
+      if (0 == nbytes) break;
+      if (-1 == nbytes) {
+          if (EINTR != errno) {
+             ADF_sys_err = errno;
+             return -1;
+          }
+          continue;
+      }
+      bytes_read += nbytes;
+      /* skip the pieces filled, and move into a partly filled one */
+      while (first < count && (size_t)nbytes >= iov[first].iov_len) {
+          nbytes -= iov[first].iov_len;
+          first++;
+      }
+      if (first < count) {
+          iov[first].iov_base = (char *)iov[first].iov_base + nbytes;
+          iov[first].iov_len -= nbytes;
+      }
+   }
+   return bytes_read;
+}
+#endif
+
+#ifdef O_DIRECT
+/***********************************************************************
+ADFI direct file
+
+input:  file_index	the file
+return: a descriptor for the file opened with O_DIRECT, or -1 if the
+	file (or its file system) can't be opened that way
+***********************************************************************/
+static int ADFI_direct_file(
+        const unsigned int file_index)
+{
+   int mode;
+
+   if (ADF_file[file_index].direct_file == -1) {
+      ADF_file[file_index].direct_file = -2;
+      if (ADF_file[file_index].file_name == NULL) return -1;
+      mode = ADFI_stridx_c(ADF_file[file_index].open_mode, "READ_ONLY") ?
+             O_RDWR : O_RDONLY;
+      ADF_file[file_index].direct_file =
+         file_open(ADF_file[file_index].file_name, mode | O_DIRECT, 0666);
+      if (ADF_file[file_index].direct_file < 0)
+         ADF_file[file_index].direct_file = -2;
+   }
+   return ADF_file[file_index].direct_file < 0 ? -1 :
+          ADF_file[file_index].direct_file;
+}
+
+/***********************************************************************
+ADFI read direct
+
+Read with direct I/O.  The part of the data in whole aligned blocks of
+the file is read directly into memory, or through a bounce buffer if
+memory isn't aligned; the unaligned head and tail are read as usual.
+***********************************************************************/
+static cglong_t ADFI_read_direct (
+        const unsigned int file_index,
+        const file_offset_t offset,
+        const cglong_t data_length,
+        char *data)
+{
+   file_offset_t start, end;
+   cglong_t head, body, tail, done = 0, size;
+   char *buff = NULL, *ptr;
+   ssize_t nbytes;
+   int fd = ADFI_direct_file(file_index);
+
+   start = (offset + DIRECT_IO_ALIGN - 1) / DIRECT_IO_ALIGN * DIRECT_IO_ALIGN;
+   end = (offset + data_length) / DIRECT_IO_ALIGN * DIRECT_IO_ALIGN;
+   if (fd < 0 || end <= start)
+      return ADFI_read(file_index, offset, data_length, data);
+   head = start - offset;
+   body = end - start;
+   tail = data_length - head - body;
+
+   if (head && ADFI_read(file_index, offset, head, data) != head)
+      return -1;
+   ptr = data + head;
+   if (((size_t)ptr % DIRECT_IO_ALIGN) != 0) {
+      if (posix_memalign((void **)&buff, DIRECT_IO_ALIGN,
+                         (size_t)MIN(body, DIRECT_IO_BUFF_SIZE)))
+         return ADFI_read(file_index, offset, data_length, data);
+   }
+
+   ADF_sys_err = 0;
+#ifdef HAVE_IO_URING
+   if (buff == NULL && ADFI_queue_wanted(body)) {
+      done = ADFI_queue_io(fd, IORING_OP_READV, start, body, ptr);
+      if (done < 0) done = 0;
+   }
+#endif
+   while (done < body) {
+      size = MIN(body - done, buff == NULL ?
+                 CG_MAX_INT32 / DIRECT_IO_ALIGN * DIRECT_IO_ALIGN :
+                 DIRECT_IO_BUFF_SIZE);
+      nbytes = file_pread(fd, buff == NULL ? ptr + done : buff,
+                          (size_t)size, start + done);
+      if (-1 == nbytes) {
+          if (EINTR == errno) continue;
+          ADF_sys_err = errno;
+          break;
+      }
+      if (buff != NULL) memcpy(ptr + done, buff, (size_t)nbytes);
+      done += nbytes;
+      if (nbytes < size) break;
+   }
+   if (buff != NULL) free(buff);
+   if (done < body) return head + done;
+
+   if (tail && ADFI_read(file_index, end, tail, ptr + body) != tail)
+      return head + body;
+   return data_length;
+}
+#endif
+
 /* file ADFI_read_file.c */
 /***********************************************************************
 ADFI read file:
@@ -6200,7 +8493,7 @@ void    ADFI_read_file(
         int *error_return )
 {
 cglong_t iret ;
-
+file_offset_t offset ;
 
 if( data == NULL ) {
    *error_return = NULL_STRING_POINTER ;
@@ -6219,14 +8512,31 @@ if( (int)file_index >= maximum_files || ADF_file[file_index].in_use == 0 ) {
 
 if( data_length + block_offset > DISK_BLOCK_SIZE ) {
 
-	/** Position the file **/
-   ADFI_fseek_file( file_index, file_block, block_offset, error_return ) ;
+	/** The write buffer is no longer flushed after every change, so
+	    make sure the disk is current if it overlaps this read **/
+   if( (int) file_index == last_wr_file && flush_wr_block > 0 &&
+       last_wr_block >= (cglong_t) file_block &&
+       last_wr_block <= (cglong_t) (file_block +
+                        (block_offset + data_length) / DISK_BLOCK_SIZE) ) {
+      ADFI_flush_buffers( file_index, FLUSH, error_return ) ;
+      if( *error_return != NO_ERROR ) {
+         return ;
+         } /* end if */
+      } /* end if */
+
+	/** Get the position in the file **/
+   ADFI_file_offset( file_index, file_block, block_offset, &offset, error_return ) ;
    if( *error_return != NO_ERROR ) {
       return ;
       } /* end if */
 
 	/** Read the data from disk **/
-   iret = ADFI_read ( file_index, data_length, data ) ;
+#ifdef O_DIRECT
+   if( ADF_direct_io_size > 0 && data_length >= ADF_direct_io_size )
+      iret = ADFI_read_direct( file_index, offset, data_length, data ) ;
+   else
+#endif
+   iret = ADFI_read ( file_index, offset, data_length, data ) ;
    if( iret != data_length ) {
       *error_return = FREAD_ERROR ;
       return ;
@@ -6259,14 +8569,14 @@ if( num_in_rd_block < DISK_BLOCK_SIZE ||  /*- buffer is not full -*/
   }
   else {
 
-    /** Position the file **/
-    ADFI_fseek_file( file_index, file_block, 0, error_return ) ;
+    /** Get the position in the file **/
+    ADFI_file_offset( file_index, file_block, 0, &offset, error_return ) ;
     if( *error_return != NO_ERROR ) {
       return ;
       } /* end if */
 
     /** Read the data from disk **/
-     iret = ADFI_read( file_index, DISK_BLOCK_SIZE, rd_block_buffer ) ;
+     iret = ADFI_read( file_index, offset, DISK_BLOCK_SIZE, rd_block_buffer ) ;
      if( iret <= 0 ) {
         *error_return = FREAD_ERROR ;
         return ;
@@ -6521,13 +8831,129 @@ if( strncmp( file_header->tag4, file_header_tags[4], TAG_SIZE )!= 0 ) {
    return ;
    } /* end if */
 
-if( strncmp( file_header->tag5, file_header_tags[5], TAG_SIZE )!= 0 ) {
-   *error_return = ADF_MEMORY_TAG_ERROR ;
+if( strncmp( file_header->tag5, file_header_tags[5], TAG_SIZE )!= 0 ) {
+   *error_return = ADF_MEMORY_TAG_ERROR ;
+   return ;
+   } /* end if */
+
+} /* end of ADFI_read_file_header */
+/* end of file ADFI_read_file_header.c */
+/* file ADFI_read_file_vector.c */
+/***********************************************************************
+ADFI read file vector:
+	Read a contiguous piece of the file into several places in
+	memory.  If the piece is larger than a block it is read with a
+	single preadv(), where available, otherwise each part is read
+	with ADFI_read_file.
+
+input:  const unsigned int file_index	The file index.
+input:  const cgulong_t file_block	Block the piece starts in.
+input:  const cgulong_t block_offset	Offset within the block.
+input:  const int count			Number of parts (up to 8).
+input:  const cglong_t data_length[]	The length of each part.
+output: char *data[]			Where each part goes.
+output:	int *error_return		Error return.
+
+   Possible errors:
+NO_ERROR
+NULL_STRING_POINTER
+ADF_FILE_NOT_OPENED
+FREAD_ERROR
+***********************************************************************/
+void    ADFI_read_file_vector(
+        const unsigned int file_index,
+        const cgulong_t file_block,
+        const cgulong_t block_offset,
+        const int count,
+        const cglong_t data_length[],
+        char *data[],
+        int *error_return )
+{
+struct DISK_POINTER	current ;
+cglong_t		total_length = 0 ;
+int			i, vector = FALSE ;
+#ifdef HAVE_VECTOR_IO
+file_offset_t		offset ;
+cglong_t		iret ;
+#endif
+
+if( count > MAX_IO_VECTORS ) {
+   *error_return = NULL_STRING_POINTER ;
+   return ;
+   } /* end if */
+
+for( i=0; i<count; i++ ) {
+   if( data[i] == NULL ) {
+      *error_return = NULL_STRING_POINTER ;
+      return ;
+      } /* end if */
+   total_length += data_length[i] ;
+   } /* end for */
+
+if( (int)file_index >= maximum_files || ADF_file[file_index].in_use == 0 ) {
+   *error_return = ADF_FILE_NOT_OPENED ;
+   return ;
+   } /* end if */
+
+*error_return = NO_ERROR ;
+
+#ifdef HAVE_VECTOR_IO
+if( total_length + block_offset > DISK_BLOCK_SIZE ) {
+   vector = TRUE ;
+   for( i=0; i<count; i++ ) {
+      if( data_length[i] > CG_MAX_INT32 ) vector = FALSE ;
+#ifdef O_DIRECT
+	/** leave large parts to direct I/O in ADFI_read/write_file **/
+      if( ADF_direct_io_size > 0 && data_length[i] >= ADF_direct_io_size )
+         vector = FALSE ;
+#endif
+      } /* end for */
+   } /* end if */
+#endif
+
+	/** Small pieces go through the block buffer part by part **/
+if( vector == FALSE ) {
+   current.block = file_block ;
+   current.offset = block_offset ;
+   for( i=0; i<count; i++ ) {
+      if( data_length[i] == 0 )
+         continue ;
+      ADFI_read_file( file_index, current.block, current.offset,
+		data_length[i], data[i], error_return ) ;
+      if( *error_return != NO_ERROR )
+         return ;
+      current.offset += data_length[i] ;
+      ADFI_adjust_disk_pointer( &current, error_return ) ;
+      if( *error_return != NO_ERROR )
+         return ;
+      } /* end for */
+   return ;
+   } /* end if */
+
+#ifdef HAVE_VECTOR_IO
+	/** Make sure the disk is current if the write buffer overlaps **/
+if( (int) file_index == last_wr_file && flush_wr_block > 0 &&
+    last_wr_block >= (cglong_t) file_block &&
+    last_wr_block <= (cglong_t) (file_block +
+                     (block_offset + total_length) / DISK_BLOCK_SIZE) ) {
+   ADFI_flush_buffers( file_index, FLUSH, error_return ) ;
+   if( *error_return != NO_ERROR )
+      return ;
+   } /* end if */
+
+ADFI_file_offset( file_index, file_block, block_offset, &offset, error_return ) ;
+if( *error_return != NO_ERROR )
+   return ;
+
+iret = ADFI_readv( file_index, offset, count, data_length, data ) ;
+if( iret != total_length ) {
+   *error_return = FREAD_ERROR ;
    return ;
    } /* end if */
+#endif
 
-} /* end of ADFI_read_file_header */
-/* end of file ADFI_read_file_header.c */
+} /* end of ADFI_read_file_vector */
+/* end of file ADFI_read_file_vector.c */
 /* file ADFI_read_free_chunk.c */
 /***********************************************************************
 ADFI read free chunk:
@@ -6788,7 +9214,8 @@ void	ADFI_read_node_header(
 		int *error_return )
 {
 char	disk_node_data[ NODE_HEADER_SIZE ] ;
-int	i ;
+int	i, header_size ;
+unsigned int bad = 0 ;
 
 if( (block_offset == NULL) || (node_header == NULL) ) {
    *error_return = NULL_POINTER ;
@@ -6801,16 +9228,17 @@ if( (int)file_index >= maximum_files || ADF_file[file_index].in_use == 0 ) {
    } /* end if */
 
 *error_return = NO_ERROR ;
+header_size = FILE_NODE_HEADER_SIZE( file_index ) ;
 
         /** Check the stack for header **/
 if ( ADFI_stack_control(file_index, block_offset->block,
 			(unsigned int)block_offset->offset,
-			GET_STK, NODE_STK, NODE_HEADER_SIZE,
+			GET_STK, NODE_STK, header_size,
 			disk_node_data ) != NO_ERROR ) {
 
 	/** Get the node header from disk **/
   ADFI_read_file( file_index, block_offset->block, block_offset->offset,
-  	NODE_HEADER_SIZE, disk_node_data, error_return ) ;
+  	header_size, disk_node_data, error_return ) ;
   if( *error_return != NO_ERROR )
      return ;
 
@@ -6820,7 +9248,7 @@ if ( ADFI_stack_control(file_index, block_offset->block,
      return ;
    } /* end of */
 
-  if( ADFI_stridx_c( &disk_node_data[ NODE_HEADER_SIZE - TAG_SIZE ],
+  if( ADFI_stridx_c( &disk_node_data[ header_size - TAG_SIZE ],
 		node_end_tag ) != 0 ) {
      *error_return = ADF_DISK_TAG_ERROR ;
      return ;
@@ -6829,27 +9257,79 @@ if ( ADFI_stack_control(file_index, block_offset->block,
          /** Set the header onto the stack **/
   ADFI_stack_control(file_index, block_offset->block,
 		(unsigned int)block_offset->offset,
-		SET_STK, NODE_STK,  NODE_HEADER_SIZE, disk_node_data );
+		SET_STK, NODE_STK,  header_size, disk_node_data );
 } /* end if */
 
 	/** Convert into memory **/
 strncpy( (char *)node_header->node_start_tag, &disk_node_data[ 0], TAG_SIZE ) ;
 strncpy( (char *)node_header->node_end_tag,
-	&disk_node_data[ NODE_HEADER_SIZE - TAG_SIZE], TAG_SIZE ) ;
+	&disk_node_data[ header_size - TAG_SIZE], TAG_SIZE ) ;
 
 strncpy( (char *)node_header->name,  &disk_node_data[ TAG_SIZE],
 		ADF_NAME_LENGTH ) ;
 strncpy( (char *)node_header->label, &disk_node_data[ 36], ADF_LABEL_LENGTH ) ;
 
-ADFI_ASCII_Hex_2_unsigned_int( 0, MAXIMUM_32_BITS, 8, &disk_node_data[ 68],
-	&node_header->num_sub_nodes, error_return ) ;
-if( *error_return != NO_ERROR )
-   return ;
+if (ADF_file[file_index].compact) {
+	/** The compact header is binary throughout **/
+   unsigned short nchunks ;
+   strncpy( (char *)node_header->data_type, &disk_node_data[ 68],
+		COMPACT_DATA_TYPE_LENGTH ) ;
+   for( i=COMPACT_DATA_TYPE_LENGTH; i<ADF_DATA_TYPE_LENGTH; i++ )
+      node_header->data_type[i] = ' ' ;
+   ADFI_convert_integers(4, 1, ADF_file[file_index].format,
+	ADF_this_machine_format, &disk_node_data[76],
+	(char *)&node_header->num_sub_nodes, error_return);
+   if( *error_return != NO_ERROR ) return ;
+   ADFI_convert_integers(4, 1, ADF_file[file_index].format,
+	ADF_this_machine_format, &disk_node_data[80],
+	(char *)&node_header->entries_for_sub_nodes, error_return);
+   if( *error_return != NO_ERROR ) return ;
+   ADFI_read_disk_pointer( file_index, &disk_node_data[84],
+	&disk_node_data[92], &node_header->sub_node_table, error_return ) ;
+   if( *error_return != NO_ERROR ) return ;
+   ADFI_convert_integers(2, 1, ADF_file[file_index].format,
+	ADF_this_machine_format, &disk_node_data[96], (char *)&nchunks,
+	error_return);
+   if( *error_return != NO_ERROR ) return ;
+   node_header->number_of_data_chunks = nchunks ;
+   node_header->number_of_dimensions = (unsigned char)disk_node_data[98] ;
+   if( node_header->number_of_dimensions > 12 ) {
+      *error_return = NUMBER_GREATER_THAN_MAXIMUM ;
+      return ;
+      } /* end if */
+   ADFI_convert_integers(8, 12, ADF_file[file_index].format,
+	ADF_this_machine_format, &disk_node_data[100],
+	(char *)node_header->dimension_values, error_return);
+   if( *error_return != NO_ERROR ) return ;
+   ADFI_read_disk_pointer( file_index, &disk_node_data[196],
+	&disk_node_data[204], &node_header->data_chunks, error_return ) ;
+   if( *error_return != NO_ERROR ) return ;
+   goto Check_Tags ;
+} /* end if */
 
-ADFI_ASCII_Hex_2_unsigned_int( 0, MAXIMUM_32_BITS, 8, &disk_node_data[ 76],
-	&node_header->entries_for_sub_nodes, error_return ) ;
-if( *error_return != NO_ERROR )
+	/** The ASCII-Hex fields are decoded together and checked once **/
+ASCII_HEX_DECODE( &disk_node_data[ 68], 8, node_header->num_sub_nodes, bad ) ;
+ASCII_HEX_DECODE( &disk_node_data[ 76], 8,
+	node_header->entries_for_sub_nodes, bad ) ;
+ASCII_HEX_DECODE( &disk_node_data[128], 2,
+	node_header->number_of_dimensions, bad ) ;
+ASCII_HEX_DECODE( &disk_node_data[226], 4,
+	node_header->number_of_data_chunks, bad ) ;
+if (ADF_file[file_index].old_version) {
+   unsigned int dim;
+   for( i=0; i<ADF_MAX_DIMENSIONS; i++ ) {
+      ASCII_HEX_DECODE( &disk_node_data[130+(i*8)], 8, dim, bad ) ;
+      node_header->dimension_values[i] = dim;
+   } /* end for */
+}
+if( bad & ~0xF ) {
+   *error_return = STRING_NOT_A_HEX_STRING ;
+   return ;
+   } /* end if */
+if( node_header->number_of_dimensions > 12 ) {
+   *error_return = NUMBER_GREATER_THAN_MAXIMUM ;
    return ;
+   } /* end if */
 
 #ifdef NEW_DISK_POINTER
 ADFI_read_disk_pointer( file_index, &disk_node_data[84], &disk_node_data[92],
@@ -6864,31 +9344,12 @@ if( *error_return != NO_ERROR )
 strncpy( (char *)node_header->data_type, &disk_node_data[ 96],
 			ADF_DATA_TYPE_LENGTH ) ;
 
-ADFI_ASCII_Hex_2_unsigned_int( 0, 12, 2, &disk_node_data[128],
-		&node_header->number_of_dimensions, error_return ) ;
-if( *error_return != NO_ERROR )
-   return ;
-
-if (ADF_file[file_index].old_version) {
-   unsigned int dim;
-   for( i=0; i<ADF_MAX_DIMENSIONS; i++ ) {
-      ADFI_ASCII_Hex_2_unsigned_int( 0, MAXIMUM_32_BITS, 8,
-	&disk_node_data[130+(i*8)], &dim, error_return ) ;
-      if( *error_return != NO_ERROR )
-         return ;
-      node_header->dimension_values[i] = dim;
-   } /* end for */
-} else {
+if (! ADF_file[file_index].old_version) {
    ADFI_convert_integers(8, 12, ADF_file[file_index].format, ADF_this_machine_format,
 	   &disk_node_data[130], (char *)node_header->dimension_values, error_return);
    if( *error_return != NO_ERROR ) return ;
 }
 
-ADFI_ASCII_Hex_2_unsigned_int( 0, 65535, 4, &disk_node_data[226],
-	&node_header->number_of_data_chunks, error_return ) ;
-if( *error_return != NO_ERROR )
-   return ;
-
 #ifdef NEW_DISK_POINTER
 ADFI_read_disk_pointer( file_index, &disk_node_data[230], &disk_node_data[238],
 	&node_header->data_chunks, error_return ) ;
@@ -6899,6 +9360,7 @@ ADFI_disk_pointer_from_ASCII_Hex( &disk_node_data[230], &disk_node_data[238],
 if( *error_return != NO_ERROR )
    return ;
 
+Check_Tags:
 	/** Check memory tags **/
 if( ADFI_stridx_c( node_header->node_start_tag, node_start_tag ) != 0 ) {
    *error_return = ADF_MEMORY_TAG_ERROR ;
@@ -6912,6 +9374,85 @@ if( ADFI_stridx_c( node_header->node_end_tag, node_end_tag ) != 0 ) {
 
 } /* end of ADFI_read_node_header */
 /* end of file ADFI_read_node_header.c */
+/* file ADFI_read_sub_node_entries.c */
+/***********************************************************************
+ADFI read sub node entries:
+
+	Read consecutive entries of a sub-node table.  The entries are
+	contiguous on disk, so they are read a buffer at a time and
+	converted into memory together.
+	No boundary checking is possible!
+
+input:  const unsigned int file_index	The file index.
+input:  const struct DISK_POINTER *block_offset  Location of first entry.
+input:  const unsigned int number_of_entries Number of entries to read.
+output: struct SUB_NODE_TABLE_ENTRY sub_node_table[] Array of SN entries.
+output:	int *error_return		Error return.
+
+   Possible errors:
+NO_ERROR
+NULL_POINTER
+ADF_FILE_NOT_OPENED
+***********************************************************************/
+void    ADFI_read_sub_node_entries(
+		const unsigned int file_index,
+		const struct DISK_POINTER *block_offset,
+		const unsigned int number_of_entries,
+		struct SUB_NODE_TABLE_ENTRY sub_node_table[],
+		int *error_return )
+{
+char			*entry ;
+struct DISK_POINTER	current_child ;
+unsigned int		i, n, count ;
+
+if( (block_offset == NULL) || (sub_node_table == NULL) ) {
+   *error_return = NULL_POINTER ;
+   return ;
+   } /* end if */
+
+if( (int)file_index >= maximum_files || ADF_file[file_index].in_use == 0 ) {
+   *error_return = ADF_FILE_NOT_OPENED ;
+   return ;
+   } /* end if */
+
+*error_return = NO_ERROR ;
+
+current_child.block = block_offset->block ;
+current_child.offset = block_offset->offset ;
+
+for( i=0; i<number_of_entries; i+=count ) {
+   ADFI_adjust_disk_pointer( &current_child, error_return ) ;
+   if( *error_return != NO_ERROR )
+      return ;
+
+   count = MIN( number_of_entries - i, SUB_NODE_BUFF_ENTRIES ) ;
+   ADFI_read_file( file_index, current_child.block, current_child.offset,
+	(cglong_t)count * (ADF_NAME_LENGTH + DISK_POINTER_SIZE),
+	sub_node_data, error_return ) ;
+   if( *error_return != NO_ERROR )
+      return ;
+
+   for( n=0, entry=sub_node_data; n<count;
+        n++, entry += ADF_NAME_LENGTH + DISK_POINTER_SIZE ) {
+      memcpy( sub_node_table[i+n].child_name, entry, ADF_NAME_LENGTH ) ;
+#ifdef NEW_DISK_POINTER
+      ADFI_read_disk_pointer( file_index, &entry[ADF_NAME_LENGTH],
+	   &entry[ADF_NAME_LENGTH+8], &sub_node_table[i+n].child_location,
+	   error_return ) ;
+#else
+      ADFI_disk_pointer_from_ASCII_Hex( &entry[ADF_NAME_LENGTH],
+	   &entry[ADF_NAME_LENGTH+8], &sub_node_table[i+n].child_location,
+	   error_return ) ;
+#endif
+      if( *error_return != NO_ERROR )
+         return ;
+      } /* end for */
+
+   current_child.offset += count * (ADF_NAME_LENGTH + DISK_POINTER_SIZE) ;
+   } /* end for */
+
+} /* end of ADFI_read_sub_node_entries */
+/* end of file ADFI_read_sub_node_entries.c */
 /* file ADFI_read_sub_node_table.c */
 /***********************************************************************
 ADFI read sub node table:
@@ -6936,7 +9477,7 @@ void    ADFI_read_sub_node_table(
 {
 char			tag[TAG_SIZE + 1] ;
 struct DISK_POINTER	end_of_chunk_tag, current_child ;
-unsigned int		number_of_children, i ;
+unsigned int		number_of_children ;
 
 if( (block_offset == NULL) || (sub_node_table == NULL) ) {
    *error_return = NULL_POINTER ;
@@ -6963,36 +9504,11 @@ number_of_children = (unsigned int)(
       (end_of_chunk_tag.offset - block_offset->offset) ) /
 		(DISK_POINTER_SIZE + ADF_NAME_LENGTH) ;
 
+	/** Read and convert the variable-length table into memory **/
 current_child.block = block_offset->block ;
 current_child.offset = block_offset->offset + TAG_SIZE + DISK_POINTER_SIZE ;
-ADFI_adjust_disk_pointer( &current_child, error_return ) ;
-if( *error_return != NO_ERROR )
-   return ;
-
-	/** Read and convert the variable-length table into memory **/
-for( i=0; i<number_of_children; i++ ) {
-   ADFI_adjust_disk_pointer( &current_child, error_return ) ;
-   if( *error_return != NO_ERROR )
-      return ;
-
-   ADFI_read_file( file_index, current_child.block, current_child.offset,
-	ADF_NAME_LENGTH, sub_node_table[i].child_name, error_return ) ;
-   if( *error_return != NO_ERROR )
-      return ;
-
-   current_child.offset += ADF_NAME_LENGTH ;
-   ADFI_adjust_disk_pointer( &current_child, error_return ) ;
-   if( *error_return != NO_ERROR )
-      return ;
-
-   ADFI_read_disk_pointer_from_disk( file_index, current_child.block,
-	current_child.offset, &sub_node_table[i].child_location,
-	error_return ) ;
-   if( *error_return != NO_ERROR )
-      return ;
-
-   current_child.offset += DISK_POINTER_SIZE ;
-   } /* end for */
+ADFI_read_sub_node_entries( file_index, &current_child, number_of_children,
+                            sub_node_table, error_return ) ;
 
 } /* end of ADFI_read_sub_node_table */
 /* end of file ADFI_read_sub_node_table.c */
@@ -7071,6 +9587,71 @@ if( *error_return != NO_ERROR )
    return ;
 } /* end of ADFI_read_sub_node_table_entry */
 /* end of file ADFI_read_sub_node_table_entry.c */
+/* file ADFI_remember_data_chunks.c */
+/***********************************************************************
+ADFI remember data chunks:
+	Remember a node whose data is split over several data-chunks, so
+	that ADFI_merge_data_chunks can merge them when the file is
+	flushed or closed.  Does nothing unless ADF_merge_chunks is set.
+
+input:  const int file_index		Index for the file.
+input:  const struct DISK_POINTER *block_offset  The node.
+output: int *error_return		Error return.
+
+   Possible errors:
+NO_ERROR
+ADF_FILE_NOT_OPENED
+MEMORY_ALLOCATION_FAILED
+***********************************************************************/
+void    ADFI_remember_data_chunks(
+		const int file_index,
+		const struct DISK_POINTER *block_offset,
+		int *error_return )
+{
+struct DISK_POINTER	*fragmented ;
+int	lo, hi, mid, n ;
+
+if( file_index >= maximum_files || ADF_file[file_index].in_use == 0 ) {
+   *error_return = ADF_FILE_NOT_OPENED ;
+   return ;
+   } /* end if */
+
+*error_return = NO_ERROR ;
+if( ADF_merge_chunks == FALSE )
+   return ;
+
+	/** The list is sorted on block/offset; find the insertion point **/
+n = ADF_file[file_index].nfragmented ;
+fragmented = ADF_file[file_index].fragmented ;
+lo = 0 ;
+hi = n - 1 ;
+while( lo <= hi ) {
+   mid = (lo + hi) >> 1 ;
+   if( block_offset->block < fragmented[mid].block ||
+      (block_offset->block == fragmented[mid].block &&
+       block_offset->offset < fragmented[mid].offset) )
+      hi = mid - 1 ;
+   else if( block_offset->block > fragmented[mid].block ||
+            block_offset->offset > fragmented[mid].offset )
+      lo = mid + 1 ;
+   else
+      return ;
+   } /* end while */
+
+fragmented = (struct DISK_POINTER *) realloc( fragmented,
+		(n + 1) * sizeof( *fragmented ) ) ;
+if( fragmented == NULL ) {
+   *error_return = MEMORY_ALLOCATION_FAILED ;
+   return ;
+   } /* end if */
+if( lo < n )
+   memmove( &fragmented[lo+1], &fragmented[lo],
+	    (n - lo) * sizeof( *fragmented ) ) ;
+fragmented[lo] = *block_offset ;
+ADF_file[file_index].nfragmented = n + 1 ;
+ADF_file[file_index].fragmented = fragmented ;
+} /* end of ADFI_remember_data_chunks */
+/* end of file ADFI_remember_data_chunks.c */
 /* file ADFI_remember_file_format.c */
 /**********************************************************************
 ADFI remember file format:
@@ -7166,6 +9747,199 @@ block_offset->block = BLANK_FILE_BLOCK ;
 block_offset->offset = BLANK_BLOCK_OFFSET ;
 } /* end of ADFI_set_blank_disk_pointer */
 /* end of file ADFI_set_blank_disk_pointer.c */
+/* file ADFI_sort_batch.c */
+/***********************************************************************
+ADFI sort batch:
+	Sort the entries of a batched read by file and by the place of
+	their data in the file, so the data can be read in file order.
+	Entries of the same data keep their request order.
+
+input:  const int count			Number of entries.
+input/output: struct BATCH_ENTRY entries[]  The entries to sort.
+
+   Possible errors:
+None allowed
+***********************************************************************/
+static int compare_batch_entries( const void *v1, const void *v2 )
+{
+const struct BATCH_ENTRY *e1 = (const struct BATCH_ENTRY *)v1 ;
+const struct BATCH_ENTRY *e2 = (const struct BATCH_ENTRY *)v2 ;
+
+if( e1->file_index != e2->file_index )
+   return e1->file_index < e2->file_index ? -1 : 1 ;
+if( e1->start.block != e2->start.block )
+   return e1->start.block < e2->start.block ? -1 : 1 ;
+if( e1->start.offset != e2->start.offset )
+   return e1->start.offset < e2->start.offset ? -1 : 1 ;
+if( e1->request != e2->request )
+   return e1->request < e2->request ? -1 : 1 ;
+return 0 ;
+} /* end of compare_batch_entries */
+
+void    ADFI_sort_batch(
+		const int count,
+		struct BATCH_ENTRY entries[] )
+{
+if( count > 1 )
+   qsort( entries, (size_t)count, sizeof( struct BATCH_ENTRY ),
+	  compare_batch_entries ) ;
+} /* end of ADFI_sort_batch */
+/* end of file ADFI_sort_batch.c */
+/* file ADFI_sort_indices.c */
+/***********************************************************************
+ADFI sort indices:
+	Pair each index with its position in the request and sort the
+	pairs by index, so the data can be visited in file order.  Equal
+	indices keep their request order.
+
+input:  const cgsize_t num		Number of indices.
+input:  const cgsize_t indices[]	The 1-based indices into the data.
+input:  const cgsize_t max_index	The number of points in the data.
+output: struct INDEX_ENTRY entries[]	The sorted index/position pairs.
+output:	int *error_return		Error return.
+
+   Possible errors:
+NO_ERROR
+START_OUT_OF_DEFINED_RANGE
+END_OUT_OF_DEFINED_RANGE
+***********************************************************************/
+static int compare_index_entries( const void *v1, const void *v2 )
+{
+const struct INDEX_ENTRY *e1 = (const struct INDEX_ENTRY *)v1 ;
+const struct INDEX_ENTRY *e2 = (const struct INDEX_ENTRY *)v2 ;
+
+if( e1->index != e2->index )
+   return e1->index < e2->index ? -1 : 1 ;
+if( e1->position != e2->position )
+   return e1->position < e2->position ? -1 : 1 ;
+return 0 ;
+} /* end of compare_index_entries */
+
+void    ADFI_sort_indices(
+		const cgsize_t num,
+		const cgsize_t indices[],
+		const cgsize_t max_index,
+		struct INDEX_ENTRY entries[],
+		int *error_return )
+{
+cgsize_t	n ;
+int		sorted = 1 ;
+
+*error_return = NO_ERROR ;
+
+for( n=0; n<num; n++ ) {
+   if( indices[n] < 1 ) {
+      *error_return = START_OUT_OF_DEFINED_RANGE ;
+      return ;
+      } /* end if */
+   if( indices[n] > max_index ) {
+      *error_return = END_OUT_OF_DEFINED_RANGE ;
+      return ;
+      } /* end if */
+   entries[n].index = indices[n] ;
+   entries[n].position = n ;
+   if( n && indices[n] < indices[n-1] )
+      sorted = 0 ;
+   } /* end for */
+
+if( ! sorted )
+   qsort( entries, (size_t)num, sizeof( struct INDEX_ENTRY ),
+	  compare_index_entries ) ;
+
+} /* end of ADFI_sort_indices */
+/* end of file ADFI_sort_indices.c */
+/* file ADFI_stack_batch_headers.c */
+/***********************************************************************
+ADFI stack batch headers:
+	Read the node headers of a run of batched entries, sorted into
+	file order, with one read and put each on the priority stack, so
+	that ADFI_read_node_header finds them there.  Each entry's bytes
+	is the size of its header.  A header whose tags are wrong is left
+	off, to be read and reported on its own.
+
+input:  const int count			Number of entries in the run.
+input:  const struct BATCH_ENTRY entries[]  The sorted entries of the run.
+output:	int *error_return		Error return.
+
+   Possible errors:
+NO_ERROR
+NULL_POINTER
+ADF_FILE_NOT_OPENED
+MEMORY_ALLOCATION_FAILED
+FREAD_ERROR
+***********************************************************************/
+void    ADFI_stack_batch_headers(
+		const int count,
+		const struct BATCH_ENTRY entries[],
+		int *error_return )
+{
+char	disk_node_data[ NODE_HEADER_SIZE ] ;
+char	start_tag[TAG_SIZE + 1], end_tag[TAG_SIZE + 1] ;
+char	*buffer, *header ;
+unsigned int		file_index ;
+cglong_t		run_start, run_end, start ;
+int			i, header_size ;
+
+if( count < 1 || entries == NULL ) {
+   *error_return = NULL_POINTER ;
+   return ;
+   } /* end if */
+
+file_index = entries[0].file_index ;
+if( (int)file_index >= maximum_files || ADF_file[file_index].in_use == 0 ) {
+   *error_return = ADF_FILE_NOT_OPENED ;
+   return ;
+   } /* end if */
+
+*error_return = NO_ERROR ;
+header_size = FILE_NODE_HEADER_SIZE( file_index ) ;
+
+run_start = (cglong_t)entries[0].start.block * DISK_BLOCK_SIZE +
+	    entries[0].start.offset ;
+run_end = run_start ;
+for( i=0; i<count; i++ ) {
+   start = (cglong_t)entries[i].start.block * DISK_BLOCK_SIZE +
+	   entries[i].start.offset ;
+   if( start + header_size > run_end ) run_end = start + header_size ;
+   } /* end for */
+
+buffer = (char *) malloc( (size_t)(run_end - run_start) ) ;
+if( buffer == NULL ) {
+   *error_return = MEMORY_ALLOCATION_FAILED ;
+   return ;
+   } /* end if */
+ADFI_read_file( file_index, entries[0].start.block, entries[0].start.offset,
+		run_end - run_start, buffer, error_return ) ;
+if( *error_return != NO_ERROR ) {
+   free( buffer ) ;
+   return ;
+   } /* end if */
+
+for( i=0; i<count; i++ ) {
+   start = (cglong_t)entries[i].start.block * DISK_BLOCK_SIZE +
+	   entries[i].start.offset ;
+   header = buffer + (start - run_start) ;
+   memcpy( start_tag, header, TAG_SIZE ) ;
+   memcpy( end_tag, &header[ header_size - TAG_SIZE ], TAG_SIZE ) ;
+   start_tag[TAG_SIZE] = end_tag[TAG_SIZE] = '\0' ;
+   if( ADFI_stridx_c( start_tag, node_start_tag ) != 0 ||
+       ADFI_stridx_c( end_tag, node_end_tag ) != 0 )
+      continue ;
+
+	/** What is on the stack may be newer than the disk **/
+   if( ADFI_stack_control( file_index, entries[i].start.block,
+		(unsigned int)entries[i].start.offset, GET_STK, NODE_STK,
+		header_size, disk_node_data ) == NO_ERROR )
+      continue ;
+   ADFI_stack_control( file_index, entries[i].start.block,
+		(unsigned int)entries[i].start.offset, SET_STK, NODE_STK,
+		header_size, header ) ;
+   } /* end for */
+
+free( buffer ) ;
+
+} /* end of ADFI_stack_batch_headers */
+/* end of file ADFI_stack_batch_headers.c */
 /* file ADFI_stack_control.c */
 /***********************************************************************
 ADFI stack control:
@@ -7233,7 +10007,7 @@ if( ((int)file_index >= maximum_files || ADF_file[file_index].in_use == 0) &&
 	   PRISTK[i].priority_level = -1;
 	 } /* end for */
          /* just in case link or linked-to node deleted */
-         last_link_ID = 0.0;
+         ADFI_clear_link_cache( -1 ) ;
 	 break ;
       case GET_STK:
 	/* Try and find the entry in the current stack by matching the
@@ -7447,51 +10221,204 @@ void	ADFI_unsigned_int_2_ASCII_Hex(
 		char string[],
 		int *error_return )
 {
-unsigned int	i,	/** Index from 0 to string_length - 1 **/
-		ir,	/** Index from string_length - 1 to 0 **/
-		j,	/** Temoprary integer variable **/
-		num ;	/** Working value of ther number **/
+unsigned int	i ;	/** Index from 0 to string_length - 1 **/
+
+if( string == NULL ) {
+   *error_return = NULL_STRING_POINTER ;
+   return ;
+   } /* end if */
+
+if( number < minimum ) {
+   *error_return = NUMBER_LESS_THAN_MINIMUM ;
+   return ;
+   } /* end if */
+
+if( number > maximum ) {
+   *error_return = NUMBER_GREATER_THAN_MAXIMUM ;
+   return ;
+   } /* end if */
+
+if( string_length == 0 ) {
+   *error_return = STRING_LENGTH_ZERO ;
+   return ;
+   } /* end if */
+
+if( string_length > 8 ) {
+   *error_return = STRING_LENGTH_TOO_BIG ;
+   return ;
+   } /* end if */
+
+*error_return = NO_ERROR ;
+
+	/** Convert the number a hex digit at a time **/
+for( i=0; i<string_length; i++ )
+   string[i] = ASCII_Hex[ (number >> ((string_length - 1 - i) << 2)) & 0xF ] ;
+} /* end of ADFI_unsignedlong_2_ASCII_Hex */
+/* end of file ADFI_unsigned_int_2_ASCII_Hex.c */
+/* file ADFI_write_compressed_chunk.c */
+/***********************************************************************
+ADFI write compressed chunk:
+	Allocate a compressed data-chunk and write the data to it.
+	Nothing is written if the data is not in the format of the file
+	or the chunk would not be smaller than an ordinary data-chunk,
+	the caller then writes an ordinary data-chunk.
+
+input:  const unsigned int file_index	The file index.
+input:  const struct TOKENIZED_DATA_TYPE *tokenized_data_type Array.
+input:  const int data_size		Size of data entity in bytes.
+input:  const long total_bytes		Number of bytes to write.
+input:  const char *data		Pointer to the data.
+output: struct DISK_POINTER *block_offset  Block & offset of the chunk.
+output: int *compressed			TRUE if the chunk was written.
+output:	int *error_return		Error return.
+
+   Possible errors:
+NO_ERROR
+NULL_POINTER
+NULL_STRING_POINTER
+ADF_FILE_NOT_OPENED
+MEMORY_ALLOCATION_FAILED
+***********************************************************************/
+void    ADFI_write_compressed_chunk(
+		const unsigned int file_index,
+		const struct TOKENIZED_DATA_TYPE *tokenized_data_type,
+		const int data_size,
+		const cglong_t total_bytes,
+		const char *data,
+		struct DISK_POINTER *block_offset,
+		int *compressed,
+		int *error_return )
+{
+int		format_compare ;
+unsigned int	block_bytes, number_of_blocks, data_bytes, packed_bytes ;
+unsigned int	i ;
+cglong_t	header_bytes, limit, offset ;
+struct DISK_POINTER	end_of_chunk_tag ;
+unsigned char	*chunk, *work ;
+char		*header ;
 
-if( string == NULL ) {
-   *error_return = NULL_STRING_POINTER ;
+if( (block_offset == NULL) || (data == NULL) || (compressed == NULL) ) {
+   *error_return = NULL_POINTER ;
    return ;
    } /* end if */
 
-if( number < minimum ) {
-   *error_return = NUMBER_LESS_THAN_MINIMUM ;
+if( tokenized_data_type == NULL ) {
+   *error_return = NULL_STRING_POINTER ;
    return ;
    } /* end if */
 
-if( number > maximum ) {
-   *error_return = NUMBER_GREATER_THAN_MAXIMUM ;
+if( (int)file_index >= maximum_files || ADF_file[file_index].in_use == 0 ) {
+   *error_return = ADF_FILE_NOT_OPENED ;
    return ;
    } /* end if */
 
-if( string_length == 0 ) {
-   *error_return = STRING_LENGTH_ZERO ;
+*error_return = NO_ERROR ;
+*compressed = FALSE ;
+
+ADFI_file_and_machine_compare( file_index, tokenized_data_type,
+			       &format_compare, error_return );
+if( *error_return != NO_ERROR )
+   return ;
+if( format_compare != 1 || data_size <= 0 ||
+    data_size > COMPRESSED_BLOCK_SIZE || total_bytes % data_size )
    return ;
-   } /* end if */
 
-if( string_length > 8 ) {
-   *error_return = STRING_LENGTH_TOO_BIG ;
+	/** Blocks hold a whole number of elements **/
+block_bytes = (COMPRESSED_BLOCK_SIZE / data_size) * data_size ;
+number_of_blocks =
+	(unsigned int)((total_bytes + block_bytes - 1) / block_bytes) ;
+header_bytes = TAG_SIZE + DISK_POINTER_SIZE + COMPRESSED_HEADER_SIZE +
+	(cglong_t)number_of_blocks * COMPRESSED_ENTRY_SIZE ;
+
+	/** Give up as soon as it gets as big as an ordinary chunk **/
+limit = TAG_SIZE + DISK_POINTER_SIZE + total_bytes ;
+if( header_bytes >= limit )
    return ;
-   } /* end if */
 
-*error_return = NO_ERROR ;
+chunk = (unsigned char *)malloc( (size_t)(limit + TAG_SIZE) ) ;
+work = (unsigned char *)malloc( block_bytes ) ;
+if( chunk == NULL || work == NULL ) {
+   if( chunk != NULL ) free( chunk ) ;
+   if( work != NULL ) free( work ) ;
+   *error_return = MEMORY_ALLOCATION_FAILED ;
+   return ;
+   } /* end if */
+header = (char *)chunk ;
 
-	/** Convert the number using power-of-2 table **/
-num = number ;
-for( i=0, ir=string_length - 1; i<string_length; i++, ir-- ) {
-   if( num >= pows[ ir ] ) {
-      j = num / pows[ ir ] ;
-      num = num - j * pows[ ir ] ;
+offset = header_bytes ;
+for( i=0; i<number_of_blocks; i++ ) {
+   data_bytes = (unsigned int)MIN( (cglong_t)block_bytes,
+		total_bytes - (cglong_t)i * block_bytes ) ;
+   ADFI_compress_block( (const unsigned char *)data +
+		(cglong_t)i * block_bytes, data_bytes, data_size, work,
+		chunk + offset, (unsigned int)MIN( limit - offset,
+			(cglong_t)data_bytes ), &packed_bytes ) ;
+   if( packed_bytes == 0 ) {	/** store it as it is **/
+      if( offset + data_bytes >= limit )
+         break ;
+      memcpy( chunk + offset, data + (cglong_t)i * block_bytes, data_bytes ) ;
+      packed_bytes = data_bytes ;
       } /* end if */
-   else
-      j = 0 ;
-   string[i] = ASCII_Hex[ j ] ;
+   ADFI_unsigned_int_2_ASCII_Hex( packed_bytes, 0, MAXIMUM_32_BITS,
+	COMPRESSED_ENTRY_SIZE, &header[ TAG_SIZE + DISK_POINTER_SIZE +
+		COMPRESSED_HEADER_SIZE + i * COMPRESSED_ENTRY_SIZE ],
+	error_return ) ;
+   if( *error_return != NO_ERROR )
+      break ;
+   offset += packed_bytes ;
+   if( offset >= limit )
+      break ;
    } /* end for */
-} /* end of ADFI_unsignedlong_2_ASCII_Hex */
-/* end of file ADFI_unsigned_int_2_ASCII_Hex.c */
+free( work ) ;
+if( i < number_of_blocks ) {
+   free( chunk ) ;
+   return ;
+   } /* end if */
+
+	/** Fill in the header and the end-of-chunk tag **/
+memcpy( header, compressed_chunk_start_tag, TAG_SIZE ) ;
+i = TAG_SIZE + DISK_POINTER_SIZE ;
+ADFI_unsigned_int_2_ASCII_Hex( (unsigned int)(total_bytes >> 32), 0,
+	MAXIMUM_32_BITS, 8, &header[i], error_return ) ;
+if( *error_return == NO_ERROR )
+   ADFI_unsigned_int_2_ASCII_Hex( (unsigned int)(total_bytes & 0xffffffff),
+	0, MAXIMUM_32_BITS, 8, &header[i+8], error_return ) ;
+if( *error_return == NO_ERROR )
+   ADFI_unsigned_int_2_ASCII_Hex( block_bytes, 0, MAXIMUM_32_BITS, 8,
+	&header[i+16], error_return ) ;
+if( *error_return == NO_ERROR )
+   ADFI_unsigned_int_2_ASCII_Hex( (unsigned int)data_size, 0,
+	MAXIMUM_32_BITS, 8, &header[i+24], error_return ) ;
+memcpy( chunk + offset, data_chunk_end_tag, TAG_SIZE ) ;
+
+	/** Allocate the chunk and point to its end-of-chunk tag **/
+if( *error_return == NO_ERROR )
+   ADFI_file_malloc( file_index, offset + TAG_SIZE, block_offset,
+	error_return ) ;
+if( *error_return == NO_ERROR ) {
+   end_of_chunk_tag.block = block_offset->block ;
+   end_of_chunk_tag.offset = block_offset->offset + offset ;
+   ADFI_adjust_disk_pointer( &end_of_chunk_tag, error_return ) ;
+   } /* end if */
+if( *error_return == NO_ERROR ) {
+#ifdef NEW_DISK_POINTER
+   ADFI_write_disk_pointer( file_index, &end_of_chunk_tag,
+	&header[TAG_SIZE], &header[DISK_POINTER_SIZE], error_return ) ;
+#else
+   ADFI_disk_pointer_2_ASCII_Hex( &end_of_chunk_tag,
+	&header[TAG_SIZE], &header[DISK_POINTER_SIZE], error_return ) ;
+#endif
+   } /* end if */
+if( *error_return == NO_ERROR )
+   ADFI_write_file( file_index, block_offset->block, block_offset->offset,
+	offset + TAG_SIZE, header, error_return ) ;
+free( chunk ) ;
+if( *error_return != NO_ERROR )
+   return ;
+*compressed = TRUE ;
+
+} /* end of ADFI_write_compressed_chunk */
+/* end of file ADFI_write_compressed_chunk.c */
 /* file ADFI_write_data_chunk.c */
 /***********************************************************************
 ADFI write data chunk:
@@ -7525,6 +10452,9 @@ void    ADFI_write_data_chunk(
 {
 int format_compare ;
 struct DISK_POINTER	current_location, end_of_chunk_tag ;
+char		disk_pointer[DISK_POINTER_SIZE] ;
+const char	*pieces[4] ;
+cglong_t	lengths[4] ;
 
 if( block_offset == NULL ) {
    *error_return = NULL_POINTER ;
@@ -7548,12 +10478,6 @@ if( total_bytes+start_offset > chunk_bytes ) {
 
 *error_return = NO_ERROR ;
 
-	/** Write the tag **/
-ADFI_write_file( file_index, block_offset->block, block_offset->offset,
-	TAG_SIZE, data_chunk_start_tag, error_return ) ;
-if( *error_return != NO_ERROR )
-   return ;
-
 	/** Calculate the end-of-chunk-tag pointer **/
 end_of_chunk_tag.block = block_offset->block ;
 end_of_chunk_tag.offset = block_offset->offset + TAG_SIZE +
@@ -7562,6 +10486,43 @@ ADFI_adjust_disk_pointer( &end_of_chunk_tag, error_return ) ;
 if( *error_return != NO_ERROR )
    return ;
 
+	/** A whole chunk of data which needs no translation is written
+	    together with its tags and end-of-chunk pointer **/
+if( data != NULL && start_offset == 0 && total_bytes == chunk_bytes ) {
+   ADFI_file_and_machine_compare( file_index, tokenized_data_type,
+				  &format_compare, error_return );
+   if( *error_return != NO_ERROR )
+      return ;
+   if( format_compare == 1 ) {
+#ifdef NEW_DISK_POINTER
+      ADFI_write_disk_pointer( file_index, &end_of_chunk_tag,
+		&disk_pointer[0], &disk_pointer[8], error_return ) ;
+#else
+      ADFI_disk_pointer_2_ASCII_Hex( &end_of_chunk_tag,
+		&disk_pointer[0], &disk_pointer[8], error_return ) ;
+#endif
+      if( *error_return != NO_ERROR )
+         return ;
+      pieces[0] = data_chunk_start_tag ;
+      pieces[1] = disk_pointer ;
+      pieces[2] = data ;
+      pieces[3] = data_chunk_end_tag ;
+      lengths[0] = TAG_SIZE ;
+      lengths[1] = DISK_POINTER_SIZE ;
+      lengths[2] = total_bytes ;
+      lengths[3] = TAG_SIZE ;
+      ADFI_write_file_vector( file_index, block_offset->block,
+		block_offset->offset, 4, lengths, pieces, error_return ) ;
+      return ;
+      } /* end if */
+   } /* end if */
+
+	/** Write the tag **/
+ADFI_write_file( file_index, block_offset->block, block_offset->offset,
+	TAG_SIZE, data_chunk_start_tag, error_return ) ;
+if( *error_return != NO_ERROR )
+   return ;
+
 	/** Adjust location and write end-of-chunk pointer **/
 current_location.block = block_offset->block ;
 current_location.offset = block_offset->offset + TAG_SIZE ;
@@ -7920,6 +10881,7 @@ ADFI_stack_control(file_index, file_block, (unsigned int)block_offset,
 
 cglong_t ADFI_write (
         const unsigned int file_index,
+        const file_offset_t offset,
         const cglong_t data_length,
         const char *data)
 {
@@ -7928,10 +10890,16 @@ cglong_t ADFI_write (
    cglong_t bytes_out = 0;
    int nbytes, to_write;
 
+#ifdef HAVE_IO_URING
+   if (ADFI_queue_wanted(data_length))
+      return ADFI_queue_io(ADF_file[file_index].file, IORING_OP_WRITEV,
+                           offset, data_length, data_ptr);
+#endif
    ADF_sys_err = 0;
    while (bytes_left > 0) {
       to_write = bytes_left > CG_MAX_INT32 ? CG_MAX_INT32 : (int)bytes_left;
-      nbytes = (int) WRITE (ADF_file[file_index].file, data_ptr, to_write);
+      nbytes = (int) file_pwrite (ADF_file[file_index].file, data_ptr, to_write,
+                                  offset + bytes_out);
       if (-1 == nbytes) {
           if (EINTR != errno) {
              ADF_sys_err = errno;
@@ -7947,6 +10915,119 @@ cglong_t ADFI_write (
    return bytes_out;
 }
 
+#ifdef HAVE_VECTOR_IO
+static cglong_t ADFI_writev (
+        const unsigned int file_index,
+        const file_offset_t offset,
+        const int count,
+        const cglong_t data_length[],
+        const char *data[])
+{
+   struct iovec iov[MAX_IO_VECTORS];
+   cglong_t bytes_out = 0;
+   ssize_t nbytes;
+   int first = 0, n;
+
+   for (n = 0; n < count; n++) {
+      iov[n].iov_base = (char *)data[n];
+      iov[n].iov_len = (size_t)data_length[n];
+   }
+   ADF_sys_err = 0;
+   while (first < count) {
+      nbytes = file_pwritev (ADF_file[file_index].file, &iov[first],
+                             count - first, offset + bytes_out);
+      if (-1 == nbytes) {
+          if (EINTR != errno) {
+             ADF_sys_err = errno;
+             return -1;
+          }
+          continue;
+      }
+      bytes_out += nbytes;
+      /* skip the pieces written, and move into a partly written one */
+      while (first < count && (size_t)nbytes >= iov[first].iov_len) {
+          nbytes -= iov[first].iov_len;
+          first++;
+      }
+      if (first < count) {
+          iov[first].iov_base = (char *)iov[first].iov_base + nbytes;
+          iov[first].iov_len -= nbytes;
+      }
+   }
+   return bytes_out;
+}
+#endif
+
+#ifdef O_DIRECT
+/***********************************************************************
+ADFI write direct
+
+Write with direct I/O.  The part of the data in whole aligned blocks of
+the file is written directly from memory, or through a bounce buffer
+if memory isn't aligned; the unaligned head and tail are written as
+usual.
+***********************************************************************/
+static cglong_t ADFI_write_direct (
+        const unsigned int file_index,
+        const file_offset_t offset,
+        const cglong_t data_length,
+        const char *data)
+{
+   file_offset_t start, end;
+   cglong_t head, body, tail, done = 0, size;
+   char *buff = NULL;
+   const char *ptr;
+   ssize_t nbytes;
+   int fd = ADFI_direct_file(file_index);
+
+   start = (offset + DIRECT_IO_ALIGN - 1) / DIRECT_IO_ALIGN * DIRECT_IO_ALIGN;
+   end = (offset + data_length) / DIRECT_IO_ALIGN * DIRECT_IO_ALIGN;
+   if (fd < 0 || end <= start)
+      return ADFI_write(file_index, offset, data_length, data);
+   head = start - offset;
+   body = end - start;
+   tail = data_length - head - body;
+
+   if (head && ADFI_write(file_index, offset, head, data) != head)
+      return -1;
+   ptr = data + head;
+   if (((size_t)ptr % DIRECT_IO_ALIGN) != 0) {
+      if (posix_memalign((void **)&buff, DIRECT_IO_ALIGN,
+                         (size_t)MIN(body, DIRECT_IO_BUFF_SIZE)))
+         return ADFI_write(file_index, offset, data_length, data);
+   }
+
+   ADF_sys_err = 0;
+#ifdef HAVE_IO_URING
+   if (buff == NULL && ADFI_queue_wanted(body)) {
+      done = ADFI_queue_io(fd, IORING_OP_WRITEV, start, body, (char *)ptr);
+      if (done < 0) done = 0;
+   }
+#endif
+   while (done < body) {
+      size = MIN(body - done, buff == NULL ?
+                 CG_MAX_INT32 / DIRECT_IO_ALIGN * DIRECT_IO_ALIGN :
+                 DIRECT_IO_BUFF_SIZE);
+      if (buff != NULL) memcpy(buff, ptr + done, (size_t)size);
+      nbytes = file_pwrite(fd, buff == NULL ? ptr + done : buff,
+                           (size_t)size, start + done);
+      if (-1 == nbytes) {
+          if (EINTR == errno) continue;
+          ADF_sys_err = errno;
+          break;
+      }
+      done += nbytes;
+      if (nbytes < size) break;
+   }
+   if (buff != NULL) free(buff);
+   if (done < body) return head + done;
+
+   if (tail && ADFI_write(file_index, end, tail, ptr + body) != tail)
+      return head + body;
+   return data_length;
+}
+#endif
+
 /* file ADFI_write_file.c */
 /***********************************************************************
 ADFI write file:
@@ -7976,6 +11057,7 @@ void	ADFI_write_file(
 {
 cglong_t iret;
 cglong_t end_block;
+file_offset_t offset;
 
 if( data == NULL ) {
    *error_return = NULL_STRING_POINTER ;
@@ -8003,21 +11085,21 @@ if ( last_rd_file == (int) file_index && last_rd_block >= (cglong_t) file_block
     /** Check to see if we need to flush the write buffer. this happens if we
         are writing a large chunk or the write moves out of the current block.
 	If the data length is zero then just flush the buffer and return.
-	Note that the ADF_modification_date routine will flush the buffer
-	after any write operations !! **/
+	Note that the buffer is also flushed when the modification date
+	is written and when the file is flushed or closed !! **/
 
 if( ( (cgulong_t) data_length + block_offset > DISK_BLOCK_SIZE ||
       last_wr_block != (cglong_t) file_block || last_wr_file != (int) file_index ||
       data_length == 0 ) && flush_wr_block > 0 ) {
 
-        /** Position the file **/
-   ADFI_fseek_file( last_wr_file, last_wr_block, 0, error_return ) ;
+        /** Get the position in the file **/
+   ADFI_file_offset( last_wr_file, last_wr_block, 0, &offset, error_return ) ;
    if( *error_return != NO_ERROR ) {
       return ;
    } /* end if */
 
 	/** write the buffer **/
-   iret= ADFI_write( last_wr_file, DISK_BLOCK_SIZE, wr_block_buffer );
+   iret= ADFI_write( last_wr_file, offset, DISK_BLOCK_SIZE, wr_block_buffer );
    flush_wr_block = -2 ; /** Make sure we don't flush twice due to error **/
    if( iret != DISK_BLOCK_SIZE ) {
      *error_return = FWRITE_ERROR ;
@@ -8040,14 +11122,29 @@ if ( data_length == 0 ) return; /** Just a buffer flush **/
 
 if( data_length + block_offset > DISK_BLOCK_SIZE ) {
 
-	/** Position the file **/
-   ADFI_fseek_file( file_index, file_block, block_offset, error_return ) ;
+	/** A clean write buffer is not flushed above, so drop it if
+	    this write overlaps it, or it would later go back to disk
+	    with the old data **/
+   if ( last_wr_file == (int) file_index &&
+        last_wr_block >= (cglong_t) file_block &&
+        last_wr_block <= (cglong_t) end_block ) {
+      last_wr_block = -2;
+      last_wr_file  = -2;
+   }
+
+	/** Get the position in the file **/
+   ADFI_file_offset( file_index, file_block, block_offset, &offset, error_return ) ;
    if( *error_return != NO_ERROR ) {
       return ;
    } /* end if */
 
 	/** write the data **/
-   iret = ADFI_write( file_index, data_length, data ) ;
+#ifdef O_DIRECT
+   if( ADF_direct_io_size > 0 && data_length >= ADF_direct_io_size )
+      iret = ADFI_write_direct( file_index, offset, data_length, data ) ;
+   else
+#endif
+   iret = ADFI_write( file_index, offset, data_length, data ) ;
    if( iret != data_length ) {
      *error_return = FWRITE_ERROR ;
      return ;
@@ -8080,14 +11177,14 @@ if( (cglong_t) file_block != last_wr_block       ||  /*- a different block -*/
   }
   else {
 
-    /** Position the file **/
-    ADFI_fseek_file( file_index, file_block, 0, error_return ) ;
+    /** Get the position in the file **/
+    ADFI_file_offset( file_index, file_block, 0, &offset, error_return ) ;
     if( *error_return != NO_ERROR ) {
       return ;
      } /* end if */
 
     /** Read the data from disk **/
-     iret = ADFI_read( file_index, DISK_BLOCK_SIZE, wr_block_buffer ) ;
+     iret = ADFI_read( file_index, offset, DISK_BLOCK_SIZE, wr_block_buffer ) ;
      if( iret < DISK_BLOCK_SIZE ) {
        if ( iret < 0 ) iret = 0;
        memset( &wr_block_buffer[iret], (size_t) ' ', (size_t)(DISK_BLOCK_SIZE-iret) );
@@ -8288,6 +11385,118 @@ ADFI_stack_control(file_index, 0, 0, SET_STK, FILE_STK,
 		   FILE_HEADER_SIZE, disk_header );
 } /* end of ADFI_write_file_header */
 /* end of file ADFI_write_file_header.c */
+/* file ADFI_write_file_vector.c */
+/***********************************************************************
+ADFI write file vector:
+	Write several places in memory to a contiguous piece of the
+	file.  If the piece is larger than a block it is written with a
+	single pwritev(), where available, otherwise each part is written
+	with ADFI_write_file.
+
+input:  const unsigned int file_index	The file index.
+input:  const cgulong_t file_block	Block the piece starts in.
+input:  const cgulong_t block_offset	Offset within the block.
+input:  const int count			Number of parts (up to 8).
+input:  const cglong_t data_length[]	The length of each part.
+input:  const char *data[]		Where each part comes from.
+output:	int *error_return		Error return.
+
+   Possible errors:
+NO_ERROR
+NULL_STRING_POINTER
+ADF_FILE_NOT_OPENED
+FWRITE_ERROR
+***********************************************************************/
+void    ADFI_write_file_vector(
+        const unsigned int file_index,
+        const cgulong_t file_block,
+        const cgulong_t block_offset,
+        const int count,
+        const cglong_t data_length[],
+        const char *data[],
+        int *error_return )
+{
+struct DISK_POINTER	current ;
+cglong_t		total_length = 0 ;
+int			i, vector = FALSE ;
+#ifdef HAVE_VECTOR_IO
+file_offset_t		offset ;
+cglong_t		iret ;
+#endif
+
+if( count > MAX_IO_VECTORS ) {
+   *error_return = NULL_STRING_POINTER ;
+   return ;
+   } /* end if */
+
+for( i=0; i<count; i++ ) {
+   if( data[i] == NULL ) {
+      *error_return = NULL_STRING_POINTER ;
+      return ;
+      } /* end if */
+   total_length += data_length[i] ;
+   } /* end for */
+
+if( (int)file_index >= maximum_files || ADF_file[file_index].in_use == 0 ) {
+   *error_return = ADF_FILE_NOT_OPENED ;
+   return ;
+   } /* end if */
+
+*error_return = NO_ERROR ;
+
+#ifdef HAVE_VECTOR_IO
+if( total_length + block_offset > DISK_BLOCK_SIZE ) {
+   vector = TRUE ;
+   for( i=0; i<count; i++ ) {
+      if( data_length[i] > CG_MAX_INT32 ) vector = FALSE ;
+#ifdef O_DIRECT
+	/** leave large parts to direct I/O in ADFI_read/write_file **/
+      if( ADF_direct_io_size > 0 && data_length[i] >= ADF_direct_io_size )
+         vector = FALSE ;
+#endif
+      } /* end for */
+   } /* end if */
+#endif
+
+	/** Small pieces go through the block buffer part by part **/
+if( vector == FALSE ) {
+   current.block = file_block ;
+   current.offset = block_offset ;
+   for( i=0; i<count; i++ ) {
+      if( data_length[i] == 0 )
+         continue ;
+      ADFI_write_file( file_index, current.block, current.offset,
+		data_length[i], data[i], error_return ) ;
+      if( *error_return != NO_ERROR )
+         return ;
+      current.offset += data_length[i] ;
+      ADFI_adjust_disk_pointer( &current, error_return ) ;
+      if( *error_return != NO_ERROR )
+         return ;
+      } /* end for */
+   return ;
+   } /* end if */
+
+#ifdef HAVE_VECTOR_IO
+	/** Write out and drop the buffers of this file, so neither
+	    holds old data for this piece **/
+ADFI_flush_buffers( file_index, FLUSH_CLOSE, error_return ) ;
+if( *error_return != NO_ERROR )
+   return ;
+
+ADFI_file_offset( file_index, file_block, block_offset, &offset, error_return ) ;
+if( *error_return != NO_ERROR )
+   return ;
+
+iret = ADFI_writev( file_index, offset, count, data_length, data ) ;
+if( iret != total_length ) {
+   *error_return = FWRITE_ERROR ;
+   return ;
+   } /* end if */
+#endif
+
+} /* end of ADFI_write_file_vector */
+/* end of file ADFI_write_file_vector.c */
 /* file ADFI_write_free_chunk.c */
 /***********************************************************************
 ADFI write free chunk:
@@ -8551,18 +11760,15 @@ ADFI_stack_control(file_index, FREE_CHUNKS_BLOCK, FREE_CHUNKS_OFFSET,
 /* file ADFI_write_modification_date.c */
 /***********************************************************************
 ADFI write modification date:
-    Writes the current date/time into the modification date field of
-    the file header.  Also updates the file version (what string)
-    in the header if the file version global variable has been set -
-    after writing, file version global variable is unset so that it is
-    only written once.
+    Marks the file as modified.  The modification date and file version
+    in the header are written by ADFI_flush_modification_date when the
+    file is flushed or closed, or immediately if ADF_sync_header is set.
 
 input:  const int  file_index    File index to write to.
 output:	int *error_return        Error return.
 
    Possible errors:
 NO_ERROR
-NULL_STRING_POINTER
 ADF_FILE_NOT_OPENED
 FWRITE_ERROR
 ***********************************************************************/
@@ -8570,41 +11776,16 @@ void	ADFI_write_modification_date(
         const int  file_index,
         int *error_return )
 {
-int	    i_block_offset ;
-char    mod_date[DATE_TIME_SIZE] ;
-
-
-*error_return = NO_ERROR ;
-
-ADFI_get_current_date( mod_date ) ;
-
-     /** block offset depends on the location the of modification date
-         in the FILE_HEADER structure **/
-i_block_offset = WHAT_STRING_SIZE + TAG_SIZE + DATE_TIME_SIZE + TAG_SIZE ;
-ADFI_write_file( file_index, 0, i_block_offset, DATE_TIME_SIZE, mod_date,
-                 error_return ) ;
-if( *error_return != NO_ERROR ) {
-   return;
-   } /* end if */
-
-     /** Flush the write buffer to ensure the file is current!! **/
-ADFI_flush_buffers( file_index, FLUSH, error_return );
-if( *error_return != NO_ERROR ) {
-   return;
+if( file_index >= maximum_files || ADF_file[file_index].in_use == 0 ) {
+   *error_return = ADF_FILE_NOT_OPENED ;
+   return ;
    } /* end if */
 
-if( ADF_file[file_index].version_update[0] != '\0' )
-{
-   i_block_offset = 0 ;   /* what-string is first field in header */
-   ADFI_write_file( file_index, 0, i_block_offset, WHAT_STRING_SIZE,
-                    ADF_file[file_index].version_update, error_return ) ;
+*error_return = NO_ERROR ;
+ADF_file[file_index].modified = 1 ;
 
-/** reset the version to default so that it only gets updated once **/
-   ADF_file[file_index].version_update[0] = '\0' ;
-   if( *error_return != NO_ERROR ) {
-      return;
-      } /* end if */
-   } /* end if */
+if( ADF_sync_header )
+   ADFI_flush_modification_date( file_index, error_return ) ;
 
 } /* end of ADFI_write_modification_date */
 /* end of file ADFI_write_modification_date.c */
@@ -8630,7 +11811,7 @@ void	ADFI_write_node_header(
 		const struct NODE_HEADER *node_header,
 		int *error_return )
 {
-int	i ;
+int	i, header_size ;
 char	disk_node_data[ NODE_HEADER_SIZE ] ;
 
 if( (block_offset == NULL) || (node_header == NULL) ) {
@@ -8664,6 +11845,56 @@ strncpy( &disk_node_data[  TAG_SIZE], (char *)node_header->name,
 	ADF_NAME_LENGTH );
 strncpy( &disk_node_data[ 36], (char *)node_header->label, ADF_LABEL_LENGTH ) ;
 
+if (ADF_file[file_index].compact) {
+	/** The compact header is binary throughout **/
+   unsigned short nchunks ;
+   for( i=COMPACT_DATA_TYPE_LENGTH; i<ADF_DATA_TYPE_LENGTH; i++ ) {
+      if( node_header->data_type[i] != ' ' &&
+          node_header->data_type[i] != '\0' ) {
+         *error_return = DATA_TYPE_TOO_LONG ;
+         return ;
+         } /* end if */
+      } /* end for */
+   if( node_header->number_of_data_chunks > 65535 ) {
+      *error_return = NUMBER_GREATER_THAN_MAXIMUM ;
+      return ;
+      } /* end if */
+   strncpy( &disk_node_data[ 68], (char *)node_header->data_type,
+		COMPACT_DATA_TYPE_LENGTH ) ;
+   ADFI_convert_integers(4, 1, ADF_this_machine_format,
+	ADF_file[file_index].format, (char *)&node_header->num_sub_nodes,
+	&disk_node_data[76], error_return);
+   if( *error_return != NO_ERROR ) return ;
+   ADFI_convert_integers(4, 1, ADF_this_machine_format,
+	ADF_file[file_index].format,
+	(char *)&node_header->entries_for_sub_nodes, &disk_node_data[80],
+	error_return);
+   if( *error_return != NO_ERROR ) return ;
+   ADFI_write_disk_pointer(file_index, &node_header->sub_node_table,
+	&disk_node_data[84], &disk_node_data[92], error_return ) ;
+   if( *error_return != NO_ERROR ) return ;
+   nchunks = (unsigned short)node_header->number_of_data_chunks ;
+   ADFI_convert_integers(2, 1, ADF_this_machine_format,
+	ADF_file[file_index].format, (char *)&nchunks, &disk_node_data[96],
+	error_return);
+   if( *error_return != NO_ERROR ) return ;
+   if( node_header->number_of_dimensions > 12 ) {
+      *error_return = NUMBER_GREATER_THAN_MAXIMUM ;
+      return ;
+      } /* end if */
+   disk_node_data[98] = (char)node_header->number_of_dimensions ;
+   disk_node_data[99] = 0 ;
+   ADFI_convert_integers(8, 12, ADF_this_machine_format,
+	ADF_file[file_index].format, (char *)node_header->dimension_values,
+	&disk_node_data[100], error_return);
+   if( *error_return != NO_ERROR ) return ;
+   ADFI_write_disk_pointer(file_index, &node_header->data_chunks,
+	&disk_node_data[196], &disk_node_data[204], error_return ) ;
+   if( *error_return != NO_ERROR ) return ;
+   header_size = COMPACT_NODE_HEADER_SIZE ;
+   goto Write_Header ;
+} /* end if */
+
 ADFI_unsigned_int_2_ASCII_Hex( node_header->num_sub_nodes, 0,
 		MAXIMUM_32_BITS, 8, &disk_node_data[ 68], error_return ) ;
 if( *error_return != NO_ERROR )
@@ -8724,15 +11955,19 @@ ADFI_disk_pointer_2_ASCII_Hex( &node_header->data_chunks,
 if( *error_return != NO_ERROR )
    return ;
 
-strncpy( &disk_node_data[242], (char *)node_header->node_end_tag, TAG_SIZE ) ;
+header_size = NODE_HEADER_SIZE ;
+
+Write_Header:
+strncpy( &disk_node_data[header_size - TAG_SIZE],
+	(char *)node_header->node_end_tag, TAG_SIZE ) ;
 
    /** Now write the node-header out to disk... **/
 ADFI_write_file( file_index, block_offset->block, block_offset->offset,
-		NODE_HEADER_SIZE, disk_node_data, error_return ) ;
+		header_size, disk_node_data, error_return ) ;
    /** Set the header onto the stack **/
 ADFI_stack_control(file_index, block_offset->block,
 		   (unsigned int)block_offset->offset,
-		   SET_STK, NODE_STK, NODE_HEADER_SIZE, disk_node_data );
+		   SET_STK, NODE_STK, header_size, disk_node_data );
 } /* end of ADFI_write_node_header */
 /* end of file ADFI_write_node_header.c */
 /* file ADFI_write_sub_node_table.c */
@@ -8757,7 +11992,8 @@ void    ADFI_write_sub_node_table(
 		struct SUB_NODE_TABLE_ENTRY sub_node_table[],
 		int *error_return )
 {
-int			i ;
+int			i, n, count ;
+char			*entry ;
 struct DISK_POINTER	end_of_chunk_tag, current_child ;
 
 if( (block_offset == NULL) || (sub_node_table == NULL) ) {
@@ -8799,30 +12035,36 @@ ADFI_write_disk_pointer_2_disk( file_index, current_child.block,
 if( *error_return != NO_ERROR )
    return ;
 
-	/** Format and write out the table entries **/
+	/** Format the table entries in memory and write them out a
+	    buffer at a time, the table is contiguous on disk **/
 current_child.offset += DISK_POINTER_SIZE ;
-for( i=0; i<number_of_sub_nodes; i++ ) {
+for( i=0; i<number_of_sub_nodes; i+=count ) {
    ADFI_adjust_disk_pointer( &current_child, error_return ) ;
    if( *error_return != NO_ERROR )
       return ;
 
-   ADFI_write_file( file_index, current_child.block, current_child.offset,
-	ADF_NAME_LENGTH, sub_node_table[i].child_name, error_return ) ;
-   if( *error_return != NO_ERROR )
-      return ;
-
-   current_child.offset += ADF_NAME_LENGTH ;
-   ADFI_adjust_disk_pointer( &current_child, error_return ) ;
-   if( *error_return != NO_ERROR )
-      return ;
+   count = MIN( number_of_sub_nodes - i, SUB_NODE_BUFF_ENTRIES ) ;
+   for( n=0, entry=sub_node_data; n<count;
+        n++, entry += ADF_NAME_LENGTH + DISK_POINTER_SIZE ) {
+      memcpy( entry, sub_node_table[i+n].child_name, ADF_NAME_LENGTH ) ;
+#ifdef NEW_DISK_POINTER
+      ADFI_write_disk_pointer( file_index, &sub_node_table[i+n].child_location,
+	   &entry[ADF_NAME_LENGTH], &entry[ADF_NAME_LENGTH+8], error_return ) ;
+#else
+      ADFI_disk_pointer_2_ASCII_Hex( &sub_node_table[i+n].child_location,
+	   &entry[ADF_NAME_LENGTH], &entry[ADF_NAME_LENGTH+8], error_return ) ;
+#endif
+      if( *error_return != NO_ERROR )
+         return ;
+      } /* end for */
 
-   ADFI_write_disk_pointer_2_disk( file_index, current_child.block,
-        current_child.offset, &sub_node_table[i].child_location,
-        error_return ) ;
+   ADFI_write_file( file_index, current_child.block, current_child.offset,
+	(cglong_t)count * (ADF_NAME_LENGTH + DISK_POINTER_SIZE),
+	sub_node_data, error_return ) ;
    if( *error_return != NO_ERROR )
       return ;
 
-   current_child.offset += DISK_POINTER_SIZE ;
+   current_child.offset += count * (ADF_NAME_LENGTH + DISK_POINTER_SIZE) ;
    } /* end for */
 
 	/** Write closing tag **/
@@ -47,11 +47,43 @@ File:   ADF_internals.h
 #define FREE_CHUNK_TABLE_SIZE       80
 #define FREE_CHUNK_ENTRY_SIZE       32
 #define NODE_HEADER_SIZE           246
+#define COMPACT_NODE_HEADER_SIZE   212
+#define COMPACT_DATA_TYPE_LENGTH     8
 #define DISK_POINTER_SIZE           12
 #define TAG_SIZE                     4
 #define WHAT_STRING_SIZE            32
 #define DATE_TIME_SIZE              28
 
+   /* compressed data chunks are split into blocks of (about) this many
+    bytes, so that a partial read only has to expand the blocks it
+    touches.  The header holds the data size, block size and element
+    size, followed by the compressed size of each block.
+   */
+#define COMPRESSED_BLOCK_SIZE    65536
+#define COMPRESSED_HEADER_SIZE      32
+#define COMPRESSED_ENTRY_SIZE        8
+
+   /* indexed reads and writes merge points less than a disk block
+    apart into one run, and limit a run to about this many bytes.
+   */
+#define INDEX_RUN_GAP         DISK_BLOCK_SIZE
+#define INDEX_RUN_MAXIMUM     1048576
+
+   /* batched reads merge data-chunks less than a disk block apart
+    into one read, and limit a read to about this many bytes.
+   */
+#define BATCH_RUN_GAP         DISK_BLOCK_SIZE
+#define BATCH_RUN_MAXIMUM     1048576
+
+   /* node headers read together are kept on the priority stack, so no
+    more than half of the stack (MAX_STACK) is read at once.
+   */
+#define BATCH_HEADER_MAXIMUM  25
+
+   /* largest number of requests queued at once (ADF_Set_Queue_Depth)
+   */
+#define QUEUE_DEPTH_MAXIMUM   256
+
    /* smallest amount of data (chunk) to be allocated.  Minimum size
     corresponds to the free-chunk minimum size for the free-chunk
     linked lists.
@@ -92,6 +124,7 @@ File:   ADF_internals.h
 #define CRAY_FORMAT_STRING           "CRAY"
 #define NATIVE_FORMAT_STRING         "NATIVE"
 #define LEGACY_FORMAT_STRING         "LEGACY"
+#define COMPACT_FORMAT_STRING        "COMPACT"
 
 #ifndef FALSE
 #define FALSE (0)
@@ -213,6 +246,41 @@ struct TOKENIZED_DATA_TYPE {
    } ;
 /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 
+struct LINK_CACHE_ENTRY {
+   struct DISK_POINTER  link ;
+   unsigned int         file_index ;
+   struct DISK_POINTER  target ;
+   } ;
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+struct LINK_FILE_ENTRY {
+   char  *link_file ;
+   char  *path ;
+   } ;
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+struct INDEX_ENTRY {
+   cgsize_t  index ;
+   cgsize_t  position ;
+   } ;
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+struct DATA_EXTENT {
+   struct DISK_POINTER  start ;
+   cglong_t             bytes ;
+   int                  compressed ;
+   } ;
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
+struct BATCH_ENTRY {
+   int                  request ;
+   unsigned int         file_index ;
+   struct DISK_POINTER  start ;
+   cglong_t             bytes ;
+   int                  batched ;
+   } ;
+/* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
+
 /***********************************************************************
    Data structures for open ADF files
     in_use: number of times this file has been 'opened'
@@ -226,6 +294,17 @@ struct TOKENIZED_DATA_TYPE {
        needs its version updated once while open, so don't expect the
        version to persist until file closing.  Otherwise, the first
        byte in the string is null ('\0').
+    modified: set when the file has been changed and the modification
+       date (and version_update) in the header still need to be written.
+    nlink_cache, link_cache : resolved targets of the link nodes in this
+       file, sorted by the block/offset of the link node.
+    nlink_files, link_files : resolved paths of the files linked to.
+    nfragmented, fragmented : nodes written with multiple data-chunks,
+       sorted by block/offset, to be merged when the file is flushed.
+    direct_file : descriptor of the file opened for direct I/O, -1 if
+       not opened yet, -2 if it can't be.
+    compact : set for version C files, which have the compact binary
+       node header (COMPACT_NODE_HEADER_SIZE bytes).
     format : format of the file
     os_size : operating system size
     link_separator : separator character for links
@@ -243,11 +322,30 @@ typedef struct {
     char os_size;
     char link_separator;
     char old_version;
+    char compact;
+    char modified;
     int file;
+    int nlink_cache;
+    struct LINK_CACHE_ENTRY *link_cache;
+    int nlink_files;
+    struct LINK_FILE_ENTRY *link_files;
+    int nfragmented;
+    struct DISK_POINTER *fragmented;
+    int direct_file;
 } ADF_FILE;
 
 extern ADF_FILE *ADF_file;
+
+   /** size of a node header in an open file **/
+#define FILE_NODE_HEADER_SIZE(fi) \
+   (ADF_file[fi].compact ? COMPACT_NODE_HEADER_SIZE : NODE_HEADER_SIZE)
 extern int maximum_files;
+extern int ADF_sync_header;
+extern int ADF_merge_chunks;
+extern cglong_t ADF_direct_io_size;
+extern int ADF_queue_depth;
+extern cglong_t ADF_preallocate_size;
+extern cglong_t ADF_compress_size;
 
 /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
 /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
@@ -305,6 +403,11 @@ extern  void    ADFI_big_little_endian_swap(
 	    unsigned char *to_data,
             int *error_return );
 
+extern  int     ADFI_batch_run_length(
+            const int count,
+            const struct BATCH_ENTRY entries[],
+            const int overhead_bytes ) ;
+
 extern  void    ADFI_big_endian_32_swap_64(
 	    const char from_format,
 	    const char from_os_size,
@@ -343,6 +446,9 @@ extern  void    ADFI_check_string_length(
             const int max_length,
             int *error_return ) ;
 
+extern  void    ADFI_clear_link_cache(
+            const int file_index ) ;
+
 extern  void    ADFI_close_file(
             const int top_file_index,
             int *error_return ) ;
@@ -399,6 +505,12 @@ extern  void    ADFI_cray_to_little_endian(
 	    unsigned char *to_data,
             int *error_return );
 
+extern  void    ADFI_data_chunk_offsets(
+            const unsigned int number_of_chunks,
+            const struct DATA_CHUNK_TABLE_ENTRY data_chunk_table[],
+            cgulong_t chunk_offsets[],
+            int *error_return ) ;
+
 extern  void    ADFI_delete_data(
             const int file_index,
             const struct NODE_HEADER  *node_header,
@@ -438,6 +550,11 @@ extern  void    ADFI_evaluate_datatype(
             char *machine_format,
             int *error_return ) ;
 
+extern  void    ADFI_expand_compressed_chunk(
+            const unsigned int file_index,
+            struct DISK_POINTER *block_offset,
+            int *error_return ) ;
+
 extern  void    ADFI_figure_machine_format(
             const char *format,
             char *machine_format,
@@ -470,6 +587,12 @@ extern  void    ADFI_file_malloc(
             struct DISK_POINTER *block_offset,
             int *error_return ) ;
 
+extern  void    ADFI_file_reserve(
+            const unsigned int file_index,
+            const struct DISK_POINTER *block_offset,
+            const cglong_t size_bytes,
+            int *error_return ) ;
+
 extern  void    ADFI_fill_initial_file_header(
             const char format,
             const char os_size,
@@ -485,11 +608,10 @@ extern  void    ADFI_fill_initial_node_header(
             struct NODE_HEADER *node_header,
             int *error_return ) ;
 
-extern  void    ADFI_fseek_file(
-            const unsigned int file_index,
-            const cgulong_t file_block,
-            const cgulong_t block_offset,
-            int *error_return ) ;
+extern  unsigned int    ADFI_find_data_chunk(
+            const unsigned int number_of_chunks,
+            const cgulong_t chunk_offsets[],
+            const cgulong_t relative_offset ) ;
 
 extern  void    ADFI_get_current_date(
             char  date[] ) ;
@@ -551,12 +673,36 @@ extern  void    ADFI_little_endian_32_swap_64(
 	    unsigned char *to_data,
             int *error_return );
 
+extern  void    ADFI_map_data_chunks(
+            const unsigned int file_index,
+            const struct NODE_HEADER *node,
+            const struct DATA_CHUNK_TABLE_ENTRY data_chunk_table[],
+            struct DATA_EXTENT extents[],
+            int *error_return ) ;
+
+extern  void    ADFI_merge_data_chunks(
+            const int file_index,
+            int *error_return ) ;
+
 extern  void    ADFI_open_file(
             const char *file,
             const char *status,
             unsigned int *file_index,
             int *error_return ) ;
 
+extern  void    ADFI_prefetch_node_headers(
+            const unsigned int file_index,
+            const int count,
+            const struct SUB_NODE_TABLE_ENTRY sub_node_table[] ) ;
+
+extern  void    ADFI_queue_close() ;
+
+extern  void    ADFI_read_batch_run(
+            const int count,
+            struct BATCH_ENTRY entries[],
+            char *data[],
+            int *error_return ) ;
+
 extern  void    ADFI_read_chunk_length(
             const unsigned int file_index,
             const struct DISK_POINTER *block_offset,
@@ -564,6 +710,16 @@ extern  void    ADFI_read_chunk_length(
             struct DISK_POINTER *end_of_chunk_tag,
             int *error_return ) ;
 
+extern  void    ADFI_read_compressed_chunk(
+            const unsigned int file_index,
+            const struct DISK_POINTER *block_offset,
+            const struct TOKENIZED_DATA_TYPE *tokenized_data_type,
+            const int data_size,
+            const cglong_t start_offset,
+            const cglong_t total_bytes,
+            char *data,
+            int *error_return ) ;
+
 extern  void    ADFI_read_data_chunk(
             const unsigned int file_index,
             const struct DISK_POINTER *block_offset,
@@ -581,6 +737,18 @@ extern  void    ADFI_read_data_chunk_table(
             struct DATA_CHUNK_TABLE_ENTRY data_chunk_table[],
             int *error_return ) ;
 
+extern  void    ADFI_read_data_extents(
+            const unsigned int file_index,
+            const int number_of_extents,
+            const struct DATA_EXTENT extents[],
+            const struct TOKENIZED_DATA_TYPE *tokenized_data_type,
+            const int file_bytes,
+            const int memory_bytes,
+            const cglong_t start_byte,
+            const cglong_t total_bytes,
+            char *data,
+            int *error_return ) ;
+
 extern  void    ADFI_read_data_translated(
             const unsigned int file_index,
             const cgulong_t file_block,
@@ -613,6 +781,15 @@ extern  void    ADFI_read_file_header(
             struct FILE_HEADER *file_header,
             int *error_return ) ;
 
+extern  void    ADFI_read_file_vector(
+            const unsigned int file_index,
+            const cgulong_t file_block,
+            const cgulong_t block_offset,
+            const int count,
+            const cglong_t data_length[],
+            char *data[],
+            int *error_return ) ;
+
 extern  void    ADFI_read_free_chunk(
             const unsigned int file_index,
             const struct DISK_POINTER *block_offset,
@@ -630,6 +807,13 @@ extern  void    ADFI_read_node_header(
             struct NODE_HEADER *node_header,
             int *error_return ) ;
 
+extern  void    ADFI_read_sub_node_entries(
+            const unsigned int file_index,
+            const struct DISK_POINTER *block_offset,
+            const unsigned int number_of_entries,
+            struct SUB_NODE_TABLE_ENTRY sub_node_table[],
+            int *error_return ) ;
+
 extern  void    ADFI_read_sub_node_table(
             const unsigned int file_index,
             const struct DISK_POINTER *block_offset,
@@ -642,6 +826,11 @@ extern  void    ADFI_read_sub_node_table_entry(
             struct SUB_NODE_TABLE_ENTRY *sub_node_table_entry,
             int *error_return ) ;
 
+extern  void    ADFI_remember_data_chunks(
+            const int file_index,
+            const struct DISK_POINTER *block_offset,
+            int *error_return ) ;
+
 extern  void    ADFI_remember_file_format(
             const int file_index,
             const char numeric_format,
@@ -656,6 +845,17 @@ extern  void    ADFI_remember_version_update(
 extern  void    ADFI_set_blank_disk_pointer(
             struct DISK_POINTER *block_offset) ;
 
+extern  void    ADFI_sort_batch(
+            const int count,
+            struct BATCH_ENTRY entries[] ) ;
+
+extern  void    ADFI_sort_indices(
+            const cgsize_t num,
+            const cgsize_t indices[],
+            const cgsize_t max_index,
+            struct INDEX_ENTRY entries[],
+            int *error_return ) ;
+
 extern  int     ADFI_stridx_c(
             const char *str1,
             const char *str2 ) ;
@@ -679,6 +879,16 @@ extern  void    ADFI_unsigned_int_2_ASCII_Hex(
             char string[],
             int *error_return ) ;
 
+extern  void    ADFI_write_compressed_chunk(
+            const unsigned int file_index,
+            const struct TOKENIZED_DATA_TYPE *tokenized_data_type,
+            const int data_size,
+            const cglong_t total_bytes,
+            const char *data,
+            struct DISK_POINTER *block_offset,
+            int *compressed,
+            int *error_return ) ;
+
 extern  void    ADFI_write_data_chunk(
             const unsigned int file_index,
             const struct DISK_POINTER *block_offset,
@@ -729,6 +939,15 @@ extern  void    ADFI_write_file_header(
             const struct FILE_HEADER *file_header,
             int *error_return ) ;
 
+extern  void    ADFI_write_file_vector(
+            const unsigned int file_index,
+            const cgulong_t file_block,
+            const cgulong_t block_offset,
+            const int count,
+            const cglong_t data_length[],
+            const char *data[],
+            int *error_return ) ;
+
 extern  void    ADFI_write_free_chunk(
             const int file_index,
             const struct DISK_POINTER *block_offset,
@@ -740,6 +959,10 @@ extern  void    ADFI_write_free_chunk_table(
             const struct FREE_CHUNK_TABLE *free_chunk_table,
             int *error_return ) ;
 
+extern  void    ADFI_flush_modification_date(
+            const int  file_index,
+            int *error_return ) ;
+
 extern  void    ADFI_write_modification_date(
             const int  file_index,
             int *error_return ) ;
@@ -772,6 +995,11 @@ extern  void    ADFI_fflush_file(
             const unsigned int file_index,
             int *error_return ) ;
      
+extern  void    ADFI_stack_batch_headers(
+            const int count,
+            const struct BATCH_ENTRY entries[],
+            int *error_return ) ;
+
 extern  int     ADFI_stack_control(
 	    const unsigned int file_index,
 	    const cgulong_t file_block,
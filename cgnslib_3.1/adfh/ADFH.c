@@ -86,6 +86,8 @@ freely, subject to the following restrictions:
 #define ADFH_FORTRAN_INDEXING
 
 static int CompressData = -1;
+static hsize_t PreallocateSize = 0;
+static int NodeMeta = 1;
 
 #define TO_UPPER( c ) ((islower(c))?(toupper(c)):(c))
 
@@ -119,6 +121,8 @@ static int CompressData = -1;
 #define A_FILE    "file"
 #define A_REFCNT  "refcnt"
 #define A_FLAGS   "flags"
+#define A_META    "meta"
+#define A_TRANSPOSED "transposed"
 
 /* debugging */
 #define ADFH_CHECK_HID( hid ) \
@@ -161,6 +165,17 @@ printf aaa ; printf("\n"); fflush(stdout);
 
 #define ADFH_MAXIMUM_FILES 128
 
+/* name, label, type and flags of a node - with HDF5 1.8 or later these
+   are also kept together in the A_META attribute, so they may be read
+   in one go rather than one attribute at a time */
+
+typedef struct _ADFH_META {
+  char name[ADF_NAME_LENGTH+1];
+  char label[ADF_LABEL_LENGTH+1];
+  char type[3];
+  int  flags;
+} ADFH_META;
+
 /* Start to prepare re-entrance into lib, gather statics in one global struct  */
 /* Then, you'll just have to handle struct with something else but a static... */
 /* MTA stands for... Multi-Threads-Aware */
@@ -186,6 +201,10 @@ typedef struct _ADFH_MTA {
   int   g_flags;     
   hid_t g_files[ADFH_MAXIMUM_FILES];
 
+  /* metadata of the last node looked at */
+  hid_t g_metaid;
+  ADFH_META g_meta;
+
 } ADFH_MTA;
 
 static ADFH_MTA  *mta_root=NULL;
@@ -270,6 +289,7 @@ static struct _ErrorList {
   {ADFH_ERR_ROOTNULL,       "HDF5: Root descriptor is NULL"},
   {ADFH_ERR_NEED_TRANSPOSE, "dimensions need transposed - open in modify mode"},
   {ADFH_ERR_INVALID_OPTION, "invalid configuration option"},
+  {ADFH_ERR_SELECT_ELEMENTS,"H5Sselect_elements:point selection failed"},
 
   {ADFH_ERR_SENTINEL,       "<None>"}
 };
@@ -279,6 +299,8 @@ static struct _ErrorList {
 if (mta_root == NULL){set_error(ADFH_ERR_ROOTNULL, err);return;} 
 #define ROOT_OR_DIE_ERR(err) \
 if (mta_root == NULL){set_error(ADFH_ERR_ROOTNULL, err);return 1;} 
+#define ROOT_OR_DIE_NULL(err) \
+if (mta_root == NULL){set_error(ADFH_ERR_ROOTNULL, err);return NULL;} 
 
 /* usefull macros */
 
@@ -287,11 +309,19 @@ if (mta_root == NULL){set_error(ADFH_ERR_ROOTNULL, err);return 1;}
                         (r)->fileno[0]==(n)->fileno[0] && \
                         (r)->fileno[1]==(n)->fileno[1])
 
+#ifdef HDF5_PRE_1_8
 static herr_t gfind_by_name(hid_t, const char *, void *);
+#endif
 static herr_t find_by_name(hid_t, const char *, const H5A_info_t*, void *);
 
+#ifdef HDF5_PRE_1_8
 #define has_child(ID,NAME) H5Giterate(ID,".",NULL,gfind_by_name,(void *)NAME)
-#define has_data(ID)       H5Giterate(ID,".",NULL,gfind_by_name,(void *)D_DATA)
+#else
+/* direct lookup of the link - iterating over the group is linear in the
+   number of children, which makes creating N children quadratic */
+#define has_child(ID,NAME) (H5Lexists(ID,NAME,H5P_DEFAULT) > 0)
+#endif
+#define has_data(ID)       has_child(ID,D_DATA)
 
 #define has_att(ID,NAME)   H5Aiterate2(ID,H5_INDEX_NAME,H5_ITER_NATIVE,NULL,find_by_name,(void *)NAME)
 
@@ -677,6 +707,181 @@ static int set_int_att(hid_t id, char *name, int value, int *err)
 }
 #endif
 
+/* -----------------------------------------------------------------
+ * node metadata record - name, label, type and flags in one attribute
+ * ----------------------------------------------------------------- */
+
+#if !defined(HDF5_PRE_1_8)
+static hid_t meta_type(void)
+{
+  static hid_t tid = -1;
+  hid_t str;
+
+  /* built once and kept, since it is used for every node */
+  if (tid < 0) {
+    if ((str = H5Tcopy(H5T_C_S1)) < 0) return -1;
+    tid = H5Tcreate(H5T_COMPOUND, sizeof(ADFH_META));
+    if (tid >= 0) {
+      H5Tset_size(str, ADF_NAME_LENGTH+1);
+      H5Tinsert(tid, A_NAME, HOFFSET(ADFH_META, name), str);
+      H5Tset_size(str, ADF_LABEL_LENGTH+1);
+      H5Tinsert(tid, A_LABEL, HOFFSET(ADFH_META, label), str);
+      H5Tset_size(str, 3);
+      H5Tinsert(tid, A_TYPE, HOFFSET(ADFH_META, type), str);
+      H5Tinsert(tid, A_FLAGS, HOFFSET(ADFH_META, flags), H5T_NATIVE_INT);
+    }
+    H5Tclose(str);
+  }
+  return tid;
+}
+
+/* ----------------------------------------------------------------- */
+
+static int new_meta_att(hid_t id, const char *name, const char *label,
+                        const char *type, int *err)
+{
+  ADFH_META meta;
+  hid_t sid, tid, aid;
+  herr_t status;
+
+  memset(&meta, 0, sizeof(ADFH_META));
+  strcpy(meta.name, name);
+  strcpy(meta.label, label);
+  strcpy(meta.type, type);
+  meta.flags = mta_root->g_flags;
+
+  sid = H5Screate(H5S_SCALAR);
+  if (sid < 0) {
+    set_error(ADFH_ERR_SCREATE_SIMPLE, err);
+    return 1;
+  }
+
+  /* the file copy of the type is packed */
+  tid = H5Tcopy(meta_type());
+  if (tid < 0) {
+    H5Sclose(sid);
+    set_error(ADFH_ERR_TCOPY, err);
+    return 1;
+  }
+  H5Tpack(tid);
+
+  aid = H5Acreate2(id, A_META, tid, sid, H5P_DEFAULT, H5P_DEFAULT);
+  H5Tclose(tid);
+  H5Sclose(sid);
+  if (aid < 0) {
+    set_error(ADFH_ERR_ACREATE, err);
+    return 1;
+  }
+
+  status = H5Awrite(aid, meta_type(), &meta);
+  H5Aclose(aid);
+
+  if (status < 0) {
+    set_error(ADFH_ERR_AWRITE, err);
+    return 1;
+  }
+  set_error(NO_ERROR, err);
+  return 0;
+}
+#endif
+
+/* -----------------------------------------------------------------
+ * returns the metadata for a node, from the A_META attribute when
+ * there is one, otherwise from the separate attributes. The last one
+ * read is kept, since a node is usually asked for its name, label and
+ * type (and is_link for its type) one after the other. HDF5 does not
+ * reuse an id once closed, but the entry is dropped anyway when the
+ * node is released or any node metadata is changed.
+ * ----------------------------------------------------------------- */
+
+static ADFH_META *get_meta(hid_t id, int *err)
+{
+  ADFH_META *meta;
+#if !defined(HDF5_PRE_1_8)
+  hid_t aid;
+  herr_t status;
+#endif
+
+  ROOT_OR_DIE_NULL(err);
+  meta = &mta_root->g_meta;
+  if (id == mta_root->g_metaid) {
+    set_error(NO_ERROR, err);
+    return meta;
+  }
+  mta_root->g_metaid = -1;
+
+#if !defined(HDF5_PRE_1_8)
+  if (H5Aexists(id, A_META) > 0) {
+    if ((aid = H5Aopen_name(id, A_META)) < 0) {
+      set_error(ADFH_ERR_AOPEN, err);
+      return NULL;
+    }
+    status = H5Aread(aid, meta_type(), meta);
+    H5Aclose(aid);
+    if (status < 0) {
+      set_error(ADFH_ERR_AREAD, err);
+      return NULL;
+    }
+    set_error(NO_ERROR, err);
+  }
+  else
+#endif
+  {
+    if (get_str_att(id, A_NAME, meta->name, err) ||
+        get_str_att(id, A_LABEL, meta->label, err) ||
+        get_str_att(id, A_TYPE, meta->type, err)) return NULL;
+    meta->flags = 0;
+  }
+  mta_root->g_metaid = id;
+  return meta;
+}
+
+/* -----------------------------------------------------------------
+ * change the name, label or type attribute of a node, and the
+ * metadata record along with it if the node has one
+ * ----------------------------------------------------------------- */
+
+static int set_meta_att(hid_t id, const char *name, const char *value,
+                        int *err)
+{
+#if !defined(HDF5_PRE_1_8)
+  ADFH_META meta;
+  hid_t aid;
+  herr_t status;
+#endif
+
+  if (mta_root != NULL) mta_root->g_metaid = -1;
+  if (set_str_att(id, name, value, err)) return 1;
+
+#if !defined(HDF5_PRE_1_8)
+  if (H5Aexists(id, A_META) > 0) {
+    if ((aid = H5Aopen_name(id, A_META)) < 0) {
+      set_error(ADFH_ERR_AOPEN, err);
+      return 1;
+    }
+    if (H5Aread(aid, meta_type(), &meta) < 0) {
+      H5Aclose(aid);
+      set_error(ADFH_ERR_AREAD, err);
+      return 1;
+    }
+    if (0 == strcmp(name, A_NAME))
+      strcpy(meta.name, value);
+    else if (0 == strcmp(name, A_LABEL))
+      strcpy(meta.label, value);
+    else
+      strcpy(meta.type, value);
+    status = H5Awrite(aid, meta_type(), &meta);
+    H5Aclose(aid);
+    if (status < 0) {
+      set_error(ADFH_ERR_AWRITE, err);
+      return 1;
+    }
+  }
+#endif
+  set_error(NO_ERROR, err);
+  return 0;
+}
+
 /* ----------------------------------------------------------------- */
 
 static int new_str_data(hid_t id, const char *name, const char *value,
@@ -766,6 +971,7 @@ static int check_data_type(const char *tp, int *err)
  * callback routines for H5Giterate and H5Aiterate
  * ================================================================= */
 
+#ifdef HDF5_PRE_1_8
 /* ----------------------------------------------------------------- */
 
 static herr_t gfind_by_name(hid_t id, const char *name, void *dsname)
@@ -773,6 +979,7 @@ static herr_t gfind_by_name(hid_t id, const char *name, void *dsname)
     if (0 == strcmp (name, (char *)dsname)) return 1;
     return 0;
 }
+#endif
 
 /* ----------------------------------------------------------------- */
 
@@ -1092,10 +1299,10 @@ static hid_t open_link(hid_t id, int *err)
 
 static int is_link(hid_t id)
 {
-  char type[3];
+  ADFH_META *meta;
   int err;
 
-  if ((!get_str_att(id, A_TYPE, type, &err) && (0 == strcmp(ADFH_LK, type))))
+  if ((meta = get_meta(id, &err)) != NULL && 0 == strcmp(ADFH_LK, meta->type))
   {
     return 1;
   }
@@ -1247,7 +1454,11 @@ static char *check_name(const char *new_name, int *err)
 #ifdef ADFH_FORTRAN_INDEXING
 
 /*------------------------------------------------------------------
- * transpose multi-dimensional indices recursively
+ * Files written before ADFH_FORTRAN_INDEXING (those with D_OLDVERS)
+ * keep the dimensions in Fortran order. Rather than transposing the
+ * whole tree when such a file is opened for modification, each node
+ * is switched to the current layout the first time it is needed,
+ * and marked with the A_TRANSPOSED attribute.
  *------------------------------------------------------------------*/
 
 static int swap_dimensions (hid_t gid)
@@ -1258,38 +1469,34 @@ static int swap_dimensions (hid_t gid)
   sprintf(verstr, "/%s", D_OLDVERS);
   if ((did = H5Dopen2(gid, verstr, H5P_DEFAULT)) < 0) return 1;
   H5Dclose(did);
+#if !defined(HDF5_PRE_1_8)
+  if (H5Aexists(gid, A_TRANSPOSED) > 0) return 1;
+#endif
   return 0;
 }
 
-static void transpose_dimensions (hid_t hid, const char *name)
+/* ----------------------------------------------------------------- */
+/* the data itself stays in the same order, so only the dimensions of
+   the data space are reversed - this needs the data set rewritten,
+   since only chunked data may be resized, and then not reshaped */
+
+static int transpose_dimensions (hid_t hid)
 {
-#if 0
   hid_t did, sid, tid, mid;
-  int i, j, temp, ndims, diffs;
-  hsize_t bytes, dims[ADF_MAX_DIMENSIONS];
-  void *data = NULL;
-#else
-  hid_t did, sid;
   int i, j, ndims, diffs;
   hsize_t temp, dims[ADF_MAX_DIMENSIONS];
-#endif
+  size_t bytes;
+  void *data = NULL;
+  herr_t status = 0;
+  char tmpname[ADF_NAME_LENGTH+1];
 
-  if ((did = H5Dopen2(hid, D_DATA, H5P_DEFAULT)) < 0) return;
+  if ((did = H5Dopen2(hid, D_DATA, H5P_DEFAULT)) < 0) return 1;
 
   /* get dimensions and size */
   sid = H5Dget_space(did);
   ndims = H5Sget_simple_extent_dims(sid, dims, NULL);
+  bytes = (size_t)H5Sget_simple_extent_npoints(sid);
   H5Sclose(sid);
-  if (ndims < 2) {
-    H5Dclose(did);
-    return;
-  }
-#if 0
-  printf("%s:%d [%d", name, bytes, dims[0]);
-  for (i = 1; i < ndims; i++) printf(",%d", dims[i]);
-  printf("]\n");
-  fflush(stdout);
-#endif
 
   /* transpose dimensions */
   diffs = 0;
@@ -1303,53 +1510,59 @@ static void transpose_dimensions (hid_t hid, const char *name)
   }
   if (0 == diffs) {
     H5Dclose(did);
-    return;
+    return 0;
   }
-#if 0
-  /* read the data, then delete data set */
-  bytes = H5Dget_storage_size(did);
+
+  /* read the data */
   tid = H5Dget_type(did);
   mid = H5Tget_native_type(tid, H5T_DIR_ASCEND);
+  bytes *= H5Tget_size(mid);
   if (bytes > 0) {
-    data = malloc ((unsigned)bytes);
-    H5Dread(did, mid, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+    if ((data = malloc(bytes)) == NULL)
+      status = -1;
+    else
+      status = H5Dread(did, mid, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
   }
   H5Dclose(did);
-  H5Gunlink(hid, D_DATA);
 
-  /* rewrite data with new dimensions */
-  sid = H5Screate_simple(ndims, dims, NULL);
-  did = H5Dcreate2(hid, D_DATA, tid, sid, H5P_DEFAULT, mta_root->g_propdataset, H5P_DEFAULT);
-  if (data != NULL) {
-    H5Dwrite(did, mid, H5S_ALL, sid, H5P_DEFAULT, data);
-    free(data);
+  /* write it to a new data set, which then replaces the old one */
+  if (status >= 0) {
+    sprintf(tmpname, "%s.t", D_DATA);
+    sid = H5Screate_simple(ndims, dims, NULL);
+    did = H5Dcreate2(hid, tmpname, tid, sid,
+                     H5P_DEFAULT, mta_root->g_propdataset, H5P_DEFAULT);
+    H5Sclose(sid);
+    if (did < 0)
+      status = -1;
+    else {
+      if (data != NULL)
+        status = H5Dwrite(did, mid, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+      H5Dclose(did);
+      if (status < 0 || H5Gunlink(hid, D_DATA) < 0 ||
+          H5Gmove(hid, tmpname, D_DATA) < 0) {
+        H5Gunlink(hid, tmpname);
+        status = -1;
+      }
+    }
   }
+  if (data != NULL) free(data);
   H5Tclose(mid);
   H5Tclose(tid);
-  H5Sclose(sid);
-#else
-  if (H5Dset_extent(did, dims) < 0) {
-      fprintf(stderr, "H5Dset_extent failed\n");
-  }
-#endif
-  H5Dclose(did);
+  return status < 0;
 }
 
 /* ----------------------------------------------------------------- */
 
-static herr_t fix_dimensions(hid_t id, const char *name, void *data)
+static int fix_dimensions(hid_t hid)
 {
-  hid_t gid;
   int err;
-  char type[ADF_DATA_TYPE_LENGTH+1];
+  unsigned intent;
+  hid_t fid = get_file_id(hid);
 
-  if (*name != D_PREFIX && (gid = H5Gopen2(id, name, H5P_DEFAULT)) >= 0 &&
-     !get_str_att(gid, A_TYPE, type, &err) && strcmp(type, ADFH_LK)) {
-    H5Giterate(gid, ".", NULL, fix_dimensions, NULL);
-    transpose_dimensions(gid,name);
-    H5Gclose(gid);
-  }
-  return 0;
+  if (fid < 0 || H5Fget_intent(fid, &intent) < 0 ||
+      (intent & H5F_ACC_RDWR) == 0 || transpose_dimensions(hid))
+    return 1;
+  return new_int_att(hid, A_TRANSPOSED, 1, &err);
 }
 
 #endif
@@ -1370,6 +1583,23 @@ void ADFH_Configure(const int option, const void *value, int *err)
             CompressData = compress;
         set_error(NO_ERROR, err);
     }
+    else if (option == ADFH_CONFIG_PREALLOCATE) {
+        /* datasets this large get their file space when created */
+        PreallocateSize = (hsize_t)((size_t)value);
+        set_error(NO_ERROR, err);
+    }
+    else if (option == ADFH_CONFIG_NODE_META) {
+        /* also write the name, label and type as one record for new nodes */
+        NodeMeta = (int)((size_t)value);
+        set_error(NO_ERROR, err);
+    }
+    else if (option == ADFH_CONFIG_THREAD) {
+        /* error handlers are per-thread in thread-safe HDF5 builds */
+#ifndef ADFH_DEBUG_ON
+        H5Eset_auto2(H5E_DEFAULT, walk_H5_error, NULL);
+#endif
+        set_error(NO_ERROR, err);
+    }
     else {
         set_error(ADFH_ERR_INVALID_OPTION, err);
     }
@@ -1485,7 +1715,7 @@ void ADFH_Set_Label(const double  id,
     set_error(ADFH_ERR_LINK_DATA, err);
     return;
   }
-  set_str_att(hid, A_LABEL, label, err);
+  set_meta_att(hid, A_LABEL, label, err);
 }
 
 /* ----------------------------------------------------------------- */
@@ -1518,7 +1748,7 @@ void ADFH_Put_Name(const double  pid,
     if (H5Gmove(hpid, oname, nname) < 0)
       set_error(ADFH_ERR_GMOVE, err);
     else
-      set_str_att(hid, A_NAME, nname, err);
+      set_meta_att(hid, A_NAME, nname, err);
   }
 }
 
@@ -1530,7 +1760,7 @@ void ADFH_Get_Name(const double  id,
                    int          *err)
 {
   hid_t hid = to_HDF_ID(id);
-  char buffname[ADF_NAME_LENGTH+1];
+  ADFH_META *meta;
 
   ADFH_DEBUG((">ADFH_Get_Name"));
 
@@ -1538,8 +1768,8 @@ void ADFH_Get_Name(const double  id,
     set_error(NULL_STRING_POINTER, err);
     return;
   }
-  get_str_att(hid, A_NAME, buffname, err);
-  strcpy(name,buffname);
+  if ((meta = get_meta(hid, err)) == NULL) return;
+  strcpy(name,meta->name);
 
   ADFH_DEBUG(("<ADFH_Get_Name [%s]",name));
 
@@ -1552,7 +1782,8 @@ void ADFH_Get_Label(const double  id,
                     char         *label,
                     int          *err)
 {
-  hid_t hid;
+  hid_t hid = to_HDF_ID(id), lid;
+  ADFH_META *meta;
   char bufflabel[ADF_LABEL_LENGTH+1];
 
   ADFH_DEBUG((">ADFH_Get_Label"));
@@ -1562,15 +1793,22 @@ void ADFH_Get_Label(const double  id,
     return;
   }
 
-  if ((hid = open_node(id, err)) >= 0) 
+  if ((meta = get_meta(hid, err)) == NULL) return;
+  if (strcmp(meta->type, ADFH_LK)) {
+    strcpy(label,meta->label);
+    return;
+  }
+
+  /* the label of a link is that of the node linked to */
+  if ((lid = open_link(hid, err)) >= 0) 
   {
-    get_str_att(hid, A_LABEL, bufflabel, err);
-    if (H5Gclose(hid)<0)
+    get_str_att(lid, A_LABEL, bufflabel, err);
+    if (H5Gclose(lid)<0)
     {
       ADFH_DEBUG((">ADFH H5Gclose failed (G)"));
     }
+    strcpy(label,bufflabel);
   }
-  strcpy(label,bufflabel);
   ADFH_DEBUG(("<ADFH_Get_Label"));
 }
 
@@ -1626,6 +1864,9 @@ void ADFH_Create(const double  pid,
         new_str_att(gid, A_LABEL, "", ADF_NAME_LENGTH, err) ||
         new_str_att(gid, A_TYPE, ADFH_MT, 2, err) ||
         new_int_att(gid, A_FLAGS, mta_root->g_flags, err)) return;
+#if !defined(HDF5_PRE_1_8)
+    if (NodeMeta && new_meta_att(gid, pname, "", ADFH_MT, err)) return;
+#endif
 #else
     int order = 0;
     H5Giterate(hpid, ".", NULL, count_children, (void *)&order);
@@ -1688,6 +1929,7 @@ void ADFH_Delete(const double  pid,
 
   /* delete current node */
 
+  mta_root->g_metaid = -1;
   H5Gclose(hid);
   delete_node(hpid, old_name);
 
@@ -1718,7 +1960,27 @@ void ADFH_Number_of_Children(const double  id,
 
   *number = 0;
   if ((hid = open_node(id, err)) >= 0) {
+#ifdef HDF5_PRE_1_8
     H5Giterate(hid, ".", &gskip, count_children, (void*)number);
+#else
+    /* the number of links is kept in the group, so rather than
+       iterating, take off the hidden (D_PREFIX) entries there may be */
+    H5G_info_t ginfo;
+    static const char *hidden[] = {
+      D_DATA, D_FILE, D_PATH, D_LINK, D_FORMAT, D_VERSION
+#ifdef D_OLDVERS
+      , D_OLDVERS
+#endif
+    };
+    if (H5Gget_info(hid, &ginfo) < 0)
+      H5Giterate(hid, ".", &gskip, count_children, (void*)number);
+    else {
+      *number = (int)ginfo.nlinks;
+      for (nn = 0; nn < (int)(sizeof(hidden)/sizeof(char *)); nn++) {
+        if (has_child(hid, hidden[nn])) (*number)--;
+      }
+    }
+#endif
     H5Gclose(hid); 
   }
   nn=*number;
@@ -1888,6 +2150,8 @@ void ADFH_Release_ID(const double ID)
 {
   ADFH_DEBUG(("ADFH_Release_ID"));
 
+  if (mta_root != NULL && mta_root->g_metaid == to_HDF_ID(ID))
+    mta_root->g_metaid = -1;
   H5Gclose(to_HDF_ID(ID));
 }
 
@@ -1910,6 +2174,7 @@ void ADFH_Database_Open(const char   *name,
   {
     mta_root=(ADFH_MTA*)malloc(sizeof(struct _ADFH_MTA));
     mta_root->g_init = 0;
+    mta_root->g_metaid = -1;
   }
   mta_root->g_error_state = 0;
   /* flags is int seen as bitfield, fortran flag is first 0x0001 
@@ -2056,6 +2321,13 @@ void ADFH_Database_Open(const char   *name,
       H5Gclose(gid);
       return;
     }
+#if !defined(HDF5_PRE_1_8)
+    if (NodeMeta && new_meta_att(gid, "HDF5 MotherNode",
+          "Root Node of HDF5 File", ADFH_MT, err)) {
+      H5Gclose(gid);
+      return;
+    }
+#endif
   }
   else {
     if (H5Fis_hdf5(name) <= 0) {
@@ -2087,12 +2359,6 @@ void ADFH_Database_Open(const char   *name,
       return;
     }
     gid = H5Gopen2(fid, "/", H5P_DEFAULT);
-#ifdef ADFH_FORTRAN_INDEXING
-    if (mode != ADFH_MODE_RDO && has_child(gid, D_OLDVERS)) {
-      H5Giterate(gid, ".", NULL, fix_dimensions, NULL);
-      H5Gmove(gid, D_OLDVERS, D_VERSION);
-    }
-#endif
   }
 
   mta_root->g_files[pos] = fid;
@@ -2190,6 +2456,7 @@ void ADFH_Database_Close(const double  root,
   if ((n = get_file_number(to_HDF_ID(root), status)) < 0) return;
   fid = mta_root->g_files[n];
   mta_root->g_files[n] = 0;
+  mta_root->g_metaid = -1;
 
   ADFH_DEBUG(("ADFH_Database_Close 3"));
   /* free up all open accesses */
@@ -2393,14 +2660,19 @@ void ADFH_Get_Data_Type(const double  id,
                         char         *data_type,
                         int          *err)
 {
-  hid_t hid;
+  hid_t hid = to_HDF_ID(id), lid;
+  ADFH_META *meta;
   char buffdata_type[3];
 
   ADFH_DEBUG(("ADFH_Get_Data_Type"));
 
-  if ((hid = open_node(id, err)) >= 0) {
-    get_str_att(hid, A_TYPE, buffdata_type, err);
-    H5Gclose(hid);
+  if ((meta = get_meta(hid, err)) == NULL) return;
+  if (strcmp(meta->type, ADFH_LK)) {
+    strcpy(data_type,meta->type);
+  }
+  else if ((lid = open_link(hid, err)) >= 0) {
+    get_str_att(lid, A_TYPE, buffdata_type, err);
+    H5Gclose(lid);
     strcpy(data_type,buffdata_type);
   }
 }
@@ -2412,14 +2684,18 @@ void ADFH_Get_Number_of_Dimensions(const double  id,
                                    int          *err)
 {
   hid_t hid, did, sid;
+  ADFH_META *meta;
   char type[3];
 
   ADFH_DEBUG(("ADFH_Get_Number_of_Dimensions"));
 
   *num_dims = 0;
+  if ((meta = get_meta(to_HDF_ID(id), err)) == NULL ||
+    0 == strcmp(meta->type, ADFH_MT)) return;
+  strcpy(type, meta->type);
   if ((hid = open_node(id, err)) < 0) return;
-  if (get_str_att(hid, A_TYPE, type, err) ||
-    0 == strcmp(type, ADFH_MT) || 0 == strcmp(type, ADFH_LK)) {
+  if (0 == strcmp(type, ADFH_LK) && (get_str_att(hid, A_TYPE, type, err) ||
+    0 == strcmp(type, ADFH_MT) || 0 == strcmp(type, ADFH_LK))) {
     H5Gclose(hid);
     return;
   }
@@ -2521,7 +2797,7 @@ void ADFH_Put_Dimension_Information(const double   id,
   if (0 == strcmp(new_type, ADFH_MT)) {
     if (has_data(hid))
       H5Gunlink(hid, D_DATA);
-    set_str_att(hid, A_TYPE, new_type, err);
+    set_meta_att(hid, A_TYPE, new_type, err);
     return;
   }
 
@@ -2554,7 +2830,7 @@ void ADFH_Put_Dimension_Information(const double   id,
     H5Gunlink(hid, D_DATA);
   }
 
-  if (set_str_att(hid, A_TYPE, new_type, err)) {
+  if (set_meta_att(hid, A_TYPE, new_type, err)) {
     if (data != NULL) free(data);
     return;
   }
@@ -2562,7 +2838,12 @@ void ADFH_Put_Dimension_Information(const double   id,
   /* recreate the data space with the new values */
 
 #ifdef ADFH_FORTRAN_INDEXING
-  if (dims > 1) swap = swap_dimensions(hid);
+  if (dims > 1) {
+    /* new data in an old layout file takes the current layout */
+    int terr;
+    swap = swap_dimensions(hid);
+    if (!swap && !new_int_att(hid, A_TRANSPOSED, 1, &terr)) swap = 1;
+  }
 #endif
   if (swap) {
     for (i = 0; i < dims; i++)
@@ -2592,8 +2873,18 @@ void ADFH_Put_Dimension_Information(const double   id,
 #endif
 
   ADFH_CHECK_HID(sid);
+  /* allocate the file space now rather than at the first write */
+  if (PreallocateSize > 0) {
+    hsize_t nbytes = H5Tget_size(tid);
+    for (i = 0; i < dims; i++)
+      nbytes *= new_dims[i];
+    if (nbytes >= PreallocateSize)
+      H5Pset_alloc_time(mta_root->g_propdataset, H5D_ALLOC_TIME_EARLY);
+  }
   did = H5Dcreate2(hid, D_DATA, tid, sid,
 		   H5P_DEFAULT, mta_root->g_propdataset, H5P_DEFAULT);
+  if (PreallocateSize > 0)
+    H5Pset_alloc_time(mta_root->g_propdataset, H5D_ALLOC_TIME_DEFAULT);
 /*  H5Eprint1(stdout);*/
   ADFH_CHECK_HID(did);
 
@@ -2683,7 +2974,7 @@ void ADFH_Link(const double  pid,
   if (*err != NO_ERROR) return;
   lid = to_HDF_ID(*id);
   ADFH_CHECK_HID(lid);
-  if (set_str_att(lid, A_TYPE, ADFH_LK, err)) return;
+  if (set_meta_att(lid, A_TYPE, ADFH_LK, err)) return;
 
 #if !defined(HDF5_PRE_1_8)
   /*
@@ -3001,9 +3292,14 @@ void ADFH_Read_Data(const double ID,
   if (ndim > 1 && !swap_dimensions(hid)) {
       H5Sclose(dspace);
       H5Dclose(did);
-      H5Gclose(hid);
-      set_error(ADFH_ERR_NEED_TRANSPOSE, err);
-      return;
+      if (fix_dimensions(hid) ||
+          (did = H5Dopen2(hid, D_DATA, H5P_DEFAULT)) < 0) {
+        H5Gclose(hid);
+        set_error(ADFH_ERR_NEED_TRANSPOSE, err);
+        return;
+      }
+      dspace = H5Dget_space(did);
+      H5Sget_simple_extent_dims(dspace, dims, NULL);
   }
 #endif
   for (n = 0; n < ndim; n++) {
@@ -3017,8 +3313,7 @@ void ADFH_Read_Data(const double ID,
       set_error(END_OUT_OF_DEFINED_RANGE, err);
     else if (s_start[n] > s_end[n])
       set_error(MINIMUM_GT_MAXIMUM, err);
-    else if (s_stride[n] < 1 ||
-      s_stride[n] > (s_end[n] - s_start[n] + 1))
+    else if (s_stride[n] < 1)
       set_error(BAD_STRIDE_VALUE, err);
     else
       set_error(NO_ERROR, err);
@@ -3031,11 +3326,11 @@ void ADFH_Read_Data(const double ID,
 #ifdef ADFH_FORTRAN_INDEXING
     start[ndim-1-n] = s_start[n] - 1;
     stride[ndim-1-n] = s_stride[n];
-    count[ndim-1-n] = (s_end[n] - s_start[n] + 1) / s_stride[n];
+    count[ndim-1-n] = (s_end[n] - s_start[n]) / s_stride[n] + 1;
 #else
     start[n] = s_start[n] - 1;
     stride[n] = s_stride[n];
-    count[n] = (s_end[n] - s_start[n] + 1) / s_stride[n];
+    count[n] = (s_end[n] - s_start[n]) / s_stride[n] + 1;
 #endif
   }
 
@@ -3050,8 +3345,7 @@ void ADFH_Read_Data(const double ID,
       set_error(END_OUT_OF_DEFINED_RANGE, err);
     else if (m_start[n] > m_end[n])
       set_error(MINIMUM_GT_MAXIMUM, err);
-    else if (m_stride[n] < 1 ||
-      m_stride[n] > (m_end[n] - m_start[n] + 1))
+    else if (m_stride[n] < 1)
       set_error(BAD_STRIDE_VALUE, err);
     else
       set_error(NO_ERROR, err);
@@ -3065,12 +3359,12 @@ void ADFH_Read_Data(const double ID,
     dims[m_num_dims-1-n] = m_dims[n];
     start[m_num_dims-1-n] = m_start[n] - 1;
     stride[m_num_dims-1-n] = m_stride[n];
-    count[m_num_dims-1-n] = (m_end[n] - m_start[n] + 1) / m_stride[n];
+    count[m_num_dims-1-n] = (m_end[n] - m_start[n]) / m_stride[n] + 1;
 #else
     dims[n] = m_dims[n];
     start[n] = m_start[n] - 1;
     stride[n] = m_stride[n];
-    count[n] = (m_end[n] - m_start[n] + 1) / m_stride[n];
+    count[n] = (m_end[n] - m_start[n]) / m_stride[n] + 1;
 #endif
   }
 
@@ -3111,6 +3405,170 @@ void ADFH_Read_Data(const double ID,
 
 /* ----------------------------------------------------------------- */
 
+typedef struct {
+  cgsize_t index;
+  cgsize_t position;
+} POINT_INDEX;
+
+static int compare_points(const void *v1, const void *v2)
+{
+  const POINT_INDEX *p1 = (const POINT_INDEX *)v1;
+  const POINT_INDEX *p2 = (const POINT_INDEX *)v2;
+
+  if (p1->index != p2->index)
+    return p1->index < p2->index ? -1 : 1;
+  if (p1->position != p2->position)
+    return p1->position < p2->position ? -1 : 1;
+  return 0;
+}
+
+static hid_t select_indices(hid_t did, const cgsize_t num,
+                            const cgsize_t indices[], hid_t *mspace,
+                            int *err)
+{
+  int n, ndim;
+  cgsize_t i;
+  hid_t dspace;
+  hsize_t dims[ADF_MAX_DIMENSIONS], npts, index, count;
+  hsize_t *coord;
+  POINT_INDEX *points;
+
+  /* the indices are linear positions in the stored data, which
+   * HDF5 holds in C order, so the last dimension varies fastest */
+
+  dspace = H5Dget_space(did);
+  ADFH_CHECK_HID(dspace);
+  ndim = H5Sget_simple_extent_ndims(dspace);
+  H5Sget_simple_extent_dims(dspace, dims, NULL);
+  npts = (hsize_t)H5Sget_simple_extent_npoints(dspace);
+  if (ndim < 1) ndim = 1;
+
+  points = (POINT_INDEX *) malloc ((size_t)num * sizeof(POINT_INDEX));
+  coord = (hsize_t *) malloc ((size_t)num * ndim * sizeof(hsize_t));
+  if (points == NULL || coord == NULL) {
+    if (points != NULL) free(points);
+    if (coord != NULL) free(coord);
+    H5Sclose(dspace);
+    set_error(MEMORY_ALLOCATION_FAILED, err);
+    return -1;
+  }
+  for (i = 0; i < num; i++) {
+    if (indices[i] < 1 || (hsize_t)indices[i] > npts) {
+      free(points);
+      free(coord);
+      H5Sclose(dspace);
+      set_error(indices[i] < 1 ? START_OUT_OF_DEFINED_RANGE :
+                END_OUT_OF_DEFINED_RANGE, err);
+      return -1;
+    }
+    points[i].index = indices[i];
+    points[i].position = i;
+  }
+
+  /* the points are selected in file order, so that the sieve buffer
+   * moves forward through the data, and the memory selection lists
+   * where each one goes. Repeated indices keep the order given, so on
+   * a write the last value is the one left in the file */
+
+  qsort(points, (size_t)num, sizeof(POINT_INDEX), compare_points);
+
+  for (i = 0; i < num; i++) {
+    index = (hsize_t)(points[i].index - 1);
+    for (n = ndim - 1; n > 0; n--) {
+      coord[i*ndim+n] = index % dims[n];
+      index /= dims[n];
+    }
+    coord[i*ndim] = index;
+  }
+  if (H5Sselect_elements(dspace, H5S_SELECT_SET, (size_t)num, coord) < 0) {
+    free(points);
+    free(coord);
+    H5Sclose(dspace);
+    set_error(ADFH_ERR_SELECT_ELEMENTS, err);
+    return -1;
+  }
+
+  for (i = 0; i < num; i++)
+    coord[i] = (hsize_t)points[i].position;
+  free(points);
+  count = (hsize_t)num;
+  *mspace = H5Screate_simple(1, &count, NULL);
+  if (*mspace < 0 ||
+      H5Sselect_elements(*mspace, H5S_SELECT_SET, (size_t)num, coord) < 0) {
+    if (*mspace >= 0) H5Sclose(*mspace);
+    free(coord);
+    H5Sclose(dspace);
+    set_error(ADFH_ERR_SELECT_ELEMENTS, err);
+    return -1;
+  }
+  free(coord);
+  set_error(NO_ERROR, err);
+  return dspace;
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFH_Read_Indices(const double ID,
+                       const cgsize_t num,
+                       const cgsize_t indices[],
+                       char *data,
+                       int *err)
+{
+  hid_t hid, did, mid, tid, dspace, mspace;
+  herr_t status;
+
+  ADFH_DEBUG(("ADFH_Read_Indices"));
+
+  if (data == NULL || indices == NULL) {
+    set_error(NULL_POINTER, err);
+    return;
+  }
+  if (num < 0) {
+    set_error(NUMBER_LESS_THAN_MINIMUM, err);
+    return;
+  }
+  set_error(NO_ERROR, err);
+  if (num == 0) return;
+
+  if ((hid = open_node(ID, err)) < 0) return;
+
+  if (!has_data(hid)) {
+    H5Gclose(hid);
+    set_error(NO_DATA, err);
+    return;
+  }
+  if ((did = H5Dopen2(hid, D_DATA, H5P_DEFAULT)) < 0) {
+    H5Gclose(hid);
+    set_error(ADFH_ERR_DOPEN, err);
+    return;
+  }
+  if ((dspace = select_indices(did, num, indices, &mspace, err)) < 0) {
+    H5Dclose(did);
+    H5Gclose(hid);
+    return;
+  }
+
+  tid = H5Dget_type(did);
+  ADFH_CHECK_HID(tid);
+  mid = H5Tget_native_type(tid, H5T_DIR_ASCEND);
+  ADFH_CHECK_HID(mid);
+  status = H5Dread(did, mid, mspace, dspace, H5P_DEFAULT, data);
+
+  H5Sclose(mspace);
+  H5Sclose(dspace);
+  H5Tclose(mid);
+  H5Tclose(tid);
+  H5Dclose(did);
+  H5Gclose(hid);
+
+  if (status < 0)
+    set_error(ADFH_ERR_DREAD, err);
+  else
+    set_error(NO_ERROR, err);
+}
+
+/* ----------------------------------------------------------------- */
+
 void ADFH_Read_All_Data(const double  id,
                         char         *data,
                         int          *err)
@@ -3145,6 +3603,57 @@ void ADFH_Read_All_Data(const double  id,
 
 /* ----------------------------------------------------------------- */
 
+void ADFH_Reserve_Data(const double  id,
+                       int          *err)
+{
+  hid_t hid = to_HDF_ID(id);
+  hid_t did, tid, sid;
+  H5D_space_status_t status;
+
+  ADFH_DEBUG(("ADFH_Reserve_Data"));
+
+  if (is_link(hid)) {
+    set_error(ADFH_ERR_LINK_DATA, err);
+    return;
+  }
+  if (!has_data(hid)) {
+    set_error(NO_DATA, err);
+    return;
+  }
+  did = H5Dopen2(hid, D_DATA, H5P_DEFAULT);
+  ADFH_CHECK_HID(did);
+  if (H5Dget_space_status(did, &status) < 0 ||
+      status != H5D_SPACE_STATUS_NOT_ALLOCATED) {
+    H5Dclose(did);
+    set_error(NO_ERROR, err);
+    return;
+  }
+
+  /* nothing written yet, so recreate the data set with early allocation */
+  tid = H5Dget_type(did);
+  ADFH_CHECK_HID(tid);
+  sid = H5Dget_space(did);
+  ADFH_CHECK_HID(sid);
+  H5Dclose(did);
+  H5Gunlink(hid, D_DATA);
+
+  H5Pset_alloc_time(mta_root->g_propdataset, H5D_ALLOC_TIME_EARLY);
+  did = H5Dcreate2(hid, D_DATA, tid, sid,
+		   H5P_DEFAULT, mta_root->g_propdataset, H5P_DEFAULT);
+  H5Pset_alloc_time(mta_root->g_propdataset, H5D_ALLOC_TIME_DEFAULT);
+  H5Sclose(sid);
+  H5Tclose(tid);
+
+  if (did < 0)
+    set_error(ADFH_ERR_DCREATE, err);
+  else {
+    H5Dclose(did);
+    set_error(NO_ERROR, err);
+  }
+}
+
+/* ----------------------------------------------------------------- */
+
 void ADFH_Write_Block_Data(const double ID,
                             const cgsize_t b_start,
                             const cgsize_t b_end,
@@ -3286,8 +3795,13 @@ void ADFH_Write_Data(const double ID,
   if (ndim > 1 && !swap_dimensions(hid)) {
       H5Sclose(dspace);
       H5Dclose(did);
-      set_error(ADFH_ERR_NEED_TRANSPOSE, err);
-      return;
+      if (fix_dimensions(hid) ||
+          (did = H5Dopen2(hid, D_DATA, H5P_DEFAULT)) < 0) {
+        set_error(ADFH_ERR_NEED_TRANSPOSE, err);
+        return;
+      }
+      dspace = H5Dget_space(did);
+      H5Sget_simple_extent_dims(dspace, dims, NULL);
   }
 #endif
   for (n = 0; n < ndim; n++) {
@@ -3301,8 +3815,7 @@ void ADFH_Write_Data(const double ID,
       set_error(END_OUT_OF_DEFINED_RANGE, err);
     else if (s_start[n] > s_end[n])
       set_error(MINIMUM_GT_MAXIMUM, err);
-    else if (s_stride[n] < 1 ||
-      s_stride[n] > (s_end[n] - s_start[n] + 1))
+    else if (s_stride[n] < 1)
       set_error(BAD_STRIDE_VALUE, err);
     else
       set_error(NO_ERROR, err);
@@ -3314,11 +3827,11 @@ void ADFH_Write_Data(const double ID,
 #ifdef ADFH_FORTRAN_INDEXING
     start[ndim-1-n] = s_start[n] - 1;
     stride[ndim-1-n] = s_stride[n];
-    count[ndim-1-n] = (s_end[n] - s_start[n] + 1) / s_stride[n];
+    count[ndim-1-n] = (s_end[n] - s_start[n]) / s_stride[n] + 1;
 #else
     start[n] = s_start[n] - 1;
     stride[n] = s_stride[n];
-    count[n] = (s_end[n] - s_start[n] + 1) / s_stride[n];
+    count[n] = (s_end[n] - s_start[n]) / s_stride[n] + 1;
 #endif
   }
 
@@ -3333,8 +3846,7 @@ void ADFH_Write_Data(const double ID,
       set_error(END_OUT_OF_DEFINED_RANGE, err);
     else if (m_start[n] > m_end[n])
       set_error(MINIMUM_GT_MAXIMUM, err);
-    else if (m_stride[n] < 1 ||
-      m_stride[n] > (m_end[n] - m_start[n] + 1))
+    else if (m_stride[n] < 1)
       set_error(BAD_STRIDE_VALUE, err);
     else
       set_error(NO_ERROR, err);
@@ -3347,12 +3859,12 @@ void ADFH_Write_Data(const double ID,
     dims[m_num_dims-1-n] = m_dims[n];
     start[m_num_dims-1-n] = m_start[n] - 1;
     stride[m_num_dims-1-n] = m_stride[n];
-    count[m_num_dims-1-n] = (m_end[n] - m_start[n] + 1) / m_stride[n];
+    count[m_num_dims-1-n] = (m_end[n] - m_start[n]) / m_stride[n] + 1;
 #else
     dims[n] = m_dims[n];
     start[n] = m_start[n] - 1;
     stride[n] = m_stride[n];
-    count[n] = (m_end[n] - m_start[n] + 1) / m_stride[n];
+    count[n] = (m_end[n] - m_start[n]) / m_stride[n] + 1;
 #endif
   }
 
@@ -3392,6 +3904,67 @@ void ADFH_Write_Data(const double ID,
 
 /* ----------------------------------------------------------------- */
 
+void ADFH_Write_Indices(const double ID,
+                        const cgsize_t num,
+                        const cgsize_t indices[],
+                        const char *data,
+                        int *err)
+{
+  hid_t hid, did, mid, tid, dspace, mspace;
+  herr_t status;
+
+  ADFH_DEBUG(("ADFH_Write_Indices"));
+
+  if (data == NULL || indices == NULL) {
+    set_error(NULL_POINTER, err);
+    return;
+  }
+  if (num < 0) {
+    set_error(NUMBER_LESS_THAN_MINIMUM, err);
+    return;
+  }
+  set_error(NO_ERROR, err);
+  if (num == 0) return;
+
+  hid = to_HDF_ID(ID);
+  if (is_link(hid)) {
+    set_error(ADFH_ERR_LINK_DATA, err);
+    return;
+  }
+  if (!has_data(hid)) {
+    set_error(NO_DATA, err);
+    return;
+  }
+  if ((did = H5Dopen2(hid, D_DATA, H5P_DEFAULT)) < 0) {
+    set_error(ADFH_ERR_DOPEN, err);
+    return;
+  }
+
+  if ((dspace = select_indices(did, num, indices, &mspace, err)) < 0) {
+    H5Dclose(did);
+    return;
+  }
+
+  tid = H5Dget_type(did);
+  ADFH_CHECK_HID(tid);
+  mid = H5Tget_native_type(tid, H5T_DIR_ASCEND);
+  ADFH_CHECK_HID(mid);
+  status = H5Dwrite(did, mid, mspace, dspace, H5P_DEFAULT, data);
+
+  H5Sclose(mspace);
+  H5Sclose(dspace);
+  H5Tclose(mid);
+  H5Tclose(tid);
+  H5Dclose(did);
+
+  if (status < 0)
+    set_error(ADFH_ERR_DWRITE, err);
+  else
+    set_error(NO_ERROR, err);
+}
+
+/* ----------------------------------------------------------------- */
+
 void ADFH_Write_All_Data(const double  id,
                          const char   *data,
                          int          *err)
@@ -133,12 +133,16 @@
 #define ADFH_ERR_ROOTNULL              106
 #define ADFH_ERR_NEED_TRANSPOSE        107
 #define ADFH_ERR_INVALID_OPTION        108
+#define ADFH_ERR_SELECT_ELEMENTS       109
 
 #define ADFH_ERR_SENTINEL              999
 
 /* configuration options */
 
 #define ADFH_CONFIG_COMPRESS  1
+#define ADFH_CONFIG_THREAD    2
+#define ADFH_CONFIG_PREALLOCATE 3
+#define ADFH_CONFIG_NODE_META 4
 
 /***********************************************************************
 	Prototypes for Interface Routines
@@ -353,6 +357,17 @@ EXTERN	void	ADFH_Read_Data(
 			char *data,
 			int *error_return ) ;
 
+EXTERN	void	ADFH_Read_Indices(
+			const double ID,
+			const cgsize_t num,
+			const cgsize_t indices[],
+			char *data,
+			int *error_return ) ;
+
+EXTERN	void	ADFH_Reserve_Data(
+			const double ID,
+			int *error_return ) ;
+
 EXTERN	void	ADFH_Set_Error_State(
 			const int error_state,
 			int *error_return ) ;
@@ -387,6 +402,13 @@ EXTERN	void	ADFH_Write_Data(
 			const char *data,
 			int *error_return ) ;
 
+EXTERN	void	ADFH_Write_Indices(
+			const double ID,
+			const cgsize_t num,
+			const cgsize_t indices[],
+			const char *data,
+			int *error_return ) ;
+
 #define HAS_ADF_RELEASE_ID
 
 EXTERN  void	ADFH_Release_ID ( const double ID );
@@ -0,0 +1,1671 @@
+/*-------------------------------------------------------------------------
+This software is provided 'as-is', without any express or implied warranty.
+In no event will the authors be held liable for any damages arising from
+the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+
+2. Altered source versions must be plainly marked as such, and must not
+   be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------*/
+
+/*-------------------------------------------------------------------
+ * in-memory interface to ADF
+ *
+ * A database is a tree of nodes held in RAM. Nodes are allocated
+ * from blocks of an arena owned by the tree, and are looked up by
+ * parent and name in a hash table, so building or searching a tree
+ * costs the same per node whatever its size. Data is kept in the
+ * native format of the node's data type.
+ *
+ * A named database lives on after it is closed, so it can be opened
+ * again by name, until it is replaced by a new one of the same name,
+ * or deleted. A SCRATCH database has no name and is freed when it is
+ * closed. Links are followed only to databases that are in memory.
+ *
+ * IDs hold the database number in the high 32 bits and the node
+ * number in the low 32 bits, both of which are exact in a double.
+ *-------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+
+#include "ADFM.h"
+
+#define ADFM_VERSION    "ADFM Database Version M01000"
+#define ADFM_LIBRARY    "ADFM Library Version M01000"
+
+#define ADFM_BLOCK_SIZE 1024
+#define ADFM_TREE_SCALE 4294967296.0
+
+#define set_error(e, err) *(err) = (e)
+
+typedef struct {
+    char name[ADF_NAME_LENGTH+1];
+    char label[ADF_LABEL_LENGTH+1];
+    char data_type[3];
+    int in_use;
+    int parent;
+    int ndims;
+    cglong_t dims[ADF_MAX_DIMENSIONS];
+    char *data;
+    int num_children;
+    int max_children;
+    int *children;
+    char *link_file;
+    char *link_path;
+} ADFM_NODE;
+
+typedef struct {
+    char *name;
+    int open;
+    char created[ADF_DATE_LENGTH+1];
+    char modified[ADF_DATE_LENGTH+1];
+    int num_blocks;
+    ADFM_NODE **blocks;
+    int num_nodes;
+    int free_nodes;
+    int hash_size;
+    int hash_used;
+    int *hash;
+} ADFM_TREE;
+
+static int num_trees = 0;
+static ADFM_TREE **trees = NULL;
+
+/* ----------------------------------------------------------------- */
+
+static double to_ID (int tree, int node)
+{
+    return (double)tree * ADFM_TREE_SCALE + (double)node;
+}
+
+/* ----------------------------------------------------------------- */
+
+static ADFM_NODE *tree_node (ADFM_TREE *tree, int node)
+{
+    return &tree->blocks[(node-1) / ADFM_BLOCK_SIZE]
+                        [(node-1) % ADFM_BLOCK_SIZE];
+}
+
+/* ----------------------------------------------------------------- */
+
+/* finds the tree and node number of an ID */
+
+static ADFM_NODE *get_node (double ID, int *ptree, int *pnode, int *err)
+{
+    int t, n;
+    ADFM_TREE *tree;
+    ADFM_NODE *node;
+
+    if (ID == 0.0) {
+        set_error(NODE_ID_ZERO, err);
+        return NULL;
+    }
+    t = (int)(ID / ADFM_TREE_SCALE);
+    n = (int)(ID - (double)t * ADFM_TREE_SCALE);
+    if (t < 1 || t > num_trees || (tree = trees[t-1]) == NULL ||
+        !tree->open) {
+        set_error(ADF_FILE_NOT_OPENED, err);
+        return NULL;
+    }
+    if (n < 1 || n > tree->num_nodes ||
+        !(node = tree_node(tree, n))->in_use) {
+        set_error(ADF_MEMORY_TAG_ERROR, err);
+        return NULL;
+    }
+    if (ptree != NULL) *ptree = t;
+    if (pnode != NULL) *pnode = n;
+    set_error(NO_ERROR, err);
+    return node;
+}
+
+/* ----------------------------------------------------------------- */
+
+static void current_date (char *date)
+{
+    time_t now = time(NULL);
+    char *p = ctime(&now);
+
+    strncpy(date, p == NULL ? "" : p, ADF_DATE_LENGTH);
+    date[ADF_DATE_LENGTH] = 0;
+    if ((p = strchr(date, '\n')) != NULL) *p = 0;
+}
+
+/*===================================================================
+ * name lookup
+ *===================================================================*/
+
+static unsigned int hash_name (int parent, const char *name)
+{
+    unsigned int hash = 2166136261u ^ (unsigned int)parent;
+
+    while (*name) {
+        hash ^= (unsigned char)*name++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/* ----------------------------------------------------------------- */
+
+/* returns the slot holding the node, or the empty slot for it;
+   slots hold node numbers, 0 when empty and -1 when deleted */
+
+static int hash_slot (ADFM_TREE *tree, int parent, const char *name)
+{
+    int n, slot = -1;
+    unsigned int mask = (unsigned int)tree->hash_size - 1;
+    ADFM_NODE *node;
+
+    for (n = (int)(hash_name(parent, name) & mask); tree->hash[n];
+         n = (int)((n + 1) & mask)) {
+        if (tree->hash[n] < 0) {
+            if (slot < 0) slot = n;
+            continue;
+        }
+        node = tree_node(tree, tree->hash[n]);
+        if (node->parent == parent && 0 == strcmp(node->name, name))
+            return n;
+    }
+    return slot < 0 ? n : slot;
+}
+
+/* ----------------------------------------------------------------- */
+
+static int hash_find (ADFM_TREE *tree, int parent, const char *name)
+{
+    int n;
+
+    if (tree->hash_used == 0) return 0;
+    n = hash_slot(tree, parent, name);
+    return tree->hash[n] > 0 ? tree->hash[n] : 0;
+}
+
+/* ----------------------------------------------------------------- */
+
+static int hash_add (ADFM_TREE *tree, int node_num, int *err)
+{
+    int n, size, *hash;
+    ADFM_NODE *node;
+
+    if (2 * (tree->hash_used + 1) > tree->hash_size) {
+        size = tree->hash_size;
+        hash = tree->hash;
+        tree->hash_size = size ? 2 * size : 64;
+        tree->hash = (int *) calloc (tree->hash_size, sizeof(int));
+        if (tree->hash == NULL) {
+            tree->hash = hash;
+            tree->hash_size = size;
+            set_error(MEMORY_ALLOCATION_FAILED, err);
+            return 1;
+        }
+        tree->hash_used = 0;
+        for (n = 0; n < size; n++) {
+            if (hash[n] > 0) {
+                node = tree_node(tree, hash[n]);
+                tree->hash[hash_slot(tree, node->parent, node->name)] =
+                    hash[n];
+                tree->hash_used++;
+            }
+        }
+        free(hash);
+    }
+    node = tree_node(tree, node_num);
+    n = hash_slot(tree, node->parent, node->name);
+    if (tree->hash[n] == 0) tree->hash_used++;
+    tree->hash[n] = node_num;
+    return 0;
+}
+
+/* ----------------------------------------------------------------- */
+
+static void hash_remove (ADFM_TREE *tree, int node_num)
+{
+    int n;
+    ADFM_NODE *node = tree_node(tree, node_num);
+
+    if (tree->hash_used == 0) return;
+    n = hash_slot(tree, node->parent, node->name);
+    if (tree->hash[n] == node_num) tree->hash[n] = -1;
+}
+
+/*===================================================================
+ * node allocation
+ *===================================================================*/
+
+static int new_node (ADFM_TREE *tree, int *err)
+{
+    int n;
+    ADFM_NODE *node, **blocks;
+
+    if (tree->free_nodes) {
+        n = tree->free_nodes;
+        node = tree_node(tree, n);
+        tree->free_nodes = node->parent;
+    }
+    else {
+        if (tree->num_nodes == tree->num_blocks * ADFM_BLOCK_SIZE) {
+            blocks = (ADFM_NODE **) realloc (tree->blocks,
+                (tree->num_blocks + 1) * sizeof(ADFM_NODE *));
+            if (blocks == NULL) {
+                set_error(MEMORY_ALLOCATION_FAILED, err);
+                return 0;
+            }
+            tree->blocks = blocks;
+            blocks[tree->num_blocks] = (ADFM_NODE *)
+                malloc (ADFM_BLOCK_SIZE * sizeof(ADFM_NODE));
+            if (blocks[tree->num_blocks] == NULL) {
+                set_error(MEMORY_ALLOCATION_FAILED, err);
+                return 0;
+            }
+            tree->num_blocks++;
+        }
+        n = ++tree->num_nodes;
+        node = tree_node(tree, n);
+    }
+    memset(node, 0, sizeof(ADFM_NODE));
+    strcpy(node->data_type, "MT");
+    node->in_use = 1;
+    return n;
+}
+
+/* ----------------------------------------------------------------- */
+
+/* frees a node and everything below it */
+
+static void free_node (ADFM_TREE *tree, int node_num)
+{
+    int n;
+    ADFM_NODE *node = tree_node(tree, node_num);
+
+    for (n = 0; n < node->num_children; n++)
+        free_node(tree, node->children[n]);
+    hash_remove(tree, node_num);
+    if (node->data != NULL) free(node->data);
+    if (node->children != NULL) free(node->children);
+    if (node->link_file != NULL) free(node->link_file);
+    node->in_use = 0;
+    node->parent = tree->free_nodes;
+    tree->free_nodes = node_num;
+}
+
+/* ----------------------------------------------------------------- */
+
+static int add_child (ADFM_TREE *tree, int parent, int child, int *err)
+{
+    int *children;
+    ADFM_NODE *node = tree_node(tree, parent);
+
+    if (node->num_children == node->max_children) {
+        children = (int *) realloc (node->children,
+            (node->max_children + 8 + node->max_children / 2) * sizeof(int));
+        if (children == NULL) {
+            set_error(MEMORY_ALLOCATION_FAILED, err);
+            return 1;
+        }
+        node->children = children;
+        node->max_children += 8 + node->max_children / 2;
+    }
+    node->children[node->num_children++] = child;
+    tree_node(tree, child)->parent = parent;
+    return hash_add(tree, child, err);
+}
+
+/* ----------------------------------------------------------------- */
+
+static void remove_child (ADFM_TREE *tree, int parent, int child)
+{
+    int n;
+    ADFM_NODE *node = tree_node(tree, parent);
+
+    for (n = node->num_children - 1; n >= 0; n--) {
+        if (node->children[n] == child) {
+            node->num_children--;
+            memmove(&node->children[n], &node->children[n+1],
+                (node->num_children - n) * sizeof(int));
+            break;
+        }
+    }
+    hash_remove(tree, child);
+}
+
+/* ----------------------------------------------------------------- */
+
+static void free_tree (int t)
+{
+    int n;
+    ADFM_TREE *tree = trees[t-1];
+
+    for (n = 0; n < tree->num_blocks; n++)
+        free(tree->blocks[n]);
+    free(tree->blocks);
+    free(tree->hash);
+    if (tree->name != NULL) free(tree->name);
+    free(tree);
+    trees[t-1] = NULL;
+}
+
+/* ----------------------------------------------------------------- */
+
+static void delete_tree (int t)
+{
+    int n;
+    ADFM_TREE *tree = trees[t-1];
+    ADFM_NODE *node;
+
+    for (n = 1; n <= tree->num_nodes; n++) {
+        node = tree_node(tree, n);
+        if (!node->in_use) continue;
+        if (node->data != NULL) free(node->data);
+        if (node->children != NULL) free(node->children);
+        if (node->link_file != NULL) free(node->link_file);
+    }
+    free_tree(t);
+}
+
+/* ----------------------------------------------------------------- */
+
+static int find_tree (const char *filename)
+{
+    int t;
+
+    for (t = 0; t < num_trees; t++) {
+        if (trees[t] != NULL && trees[t]->name != NULL &&
+            0 == strcmp(trees[t]->name, filename))
+            return t + 1;
+    }
+    return 0;
+}
+
+/*===================================================================
+ * names and links
+ *===================================================================*/
+
+static int check_name (const char *name, int *err)
+{
+    if (name == NULL) {
+        set_error(NULL_STRING_POINTER, err);
+        return 1;
+    }
+    if (!*name) {
+        set_error(STRING_LENGTH_ZERO, err);
+        return 1;
+    }
+    if (strlen(name) > ADF_NAME_LENGTH) {
+        set_error(STRING_LENGTH_TOO_BIG, err);
+        return 1;
+    }
+    if (strchr(name, '/') != NULL || 0 == strcmp(name, ".") ||
+        0 == strcmp(name, "..")) {
+        set_error(INVALID_NODE_NAME, err);
+        return 1;
+    }
+    return 0;
+}
+
+/* ----------------------------------------------------------------- */
+
+static int find_path (int t, int n, const char *path, int follow,
+    int *pt, int *pn, int depth, int *err);
+
+/* follows a link node to what it points to, if that is in memory */
+
+static int chase_link (int *pt, int *pn, int depth, int *err)
+{
+    int t;
+    ADFM_NODE *node = tree_node(trees[*pt-1], *pn);
+
+    while (node->link_path != NULL) {
+        if (++depth > ADF_MAXIMUM_LINK_DEPTH) {
+            set_error(LINKS_TOO_DEEP, err);
+            return 1;
+        }
+        t = *node->link_file ? find_tree(node->link_file) : *pt;
+        if (t == 0) {
+            set_error(LINKED_TO_FILE_NOT_THERE, err);
+            return 1;
+        }
+        if (find_path(t, 1, node->link_path, 1, pt, pn, depth, err)) {
+            if (*err == ADF_MEMORY_TAG_ERROR)
+                set_error(LINK_TARGET_NOT_THERE, err);
+            return 1;
+        }
+        node = tree_node(trees[*pt-1], *pn);
+    }
+    return 0;
+}
+
+/* ----------------------------------------------------------------- */
+
+/* looks up a path of names below a node, following the links along
+   the way, and the last one too if follow is set */
+
+static int find_path (int t, int n, const char *path, int follow,
+    int *pt, int *pn, int depth, int *err)
+{
+    int len;
+    char name[ADF_NAME_LENGTH+1];
+    const char *p;
+
+    if (*path == '/') {
+        n = 1;
+        while (*path == '/') path++;
+    }
+    while (*path) {
+        if (chase_link(&t, &n, depth, err)) return 1;
+        for (p = path; *p && *p != '/'; p++)
+            ;
+        len = (int)(p - path);
+        if (len > ADF_NAME_LENGTH) {
+            set_error(STRING_LENGTH_TOO_BIG, err);
+            return 1;
+        }
+        strncpy(name, path, len);
+        name[len] = 0;
+        if ((n = hash_find(trees[t-1], n, name)) == 0) {
+            set_error(ADF_MEMORY_TAG_ERROR, err);
+            return 1;
+        }
+        for (path = p; *path == '/'; path++)
+            ;
+    }
+    if (follow && chase_link(&t, &n, depth, err)) return 1;
+    *pt = t;
+    *pn = n;
+    set_error(NO_ERROR, err);
+    return 0;
+}
+
+/* ----------------------------------------------------------------- */
+
+/* gets the node of an ID, following it if it is a link */
+
+static ADFM_NODE *get_data_node (double ID, int *ptree, int *pnode,
+    int *err)
+{
+    int t, n;
+
+    if (get_node(ID, &t, &n, err) == NULL ||
+        chase_link(&t, &n, 0, err)) return NULL;
+    if (ptree != NULL) *ptree = t;
+    if (pnode != NULL) *pnode = n;
+    return tree_node(trees[t-1], n);
+}
+
+/*===================================================================
+ * data
+ *===================================================================*/
+
+static int type_size (const char *data_type)
+{
+    switch (data_type[0]) {
+        case 'B':
+        case 'C':
+            return data_type[1] == '1' ? 1 : 0;
+        case 'I':
+        case 'U':
+        case 'R':
+            if (data_type[1] == '4') return 4;
+            if (data_type[1] == '8') return 8;
+            return 0;
+        case 'X':
+            if (data_type[1] == '4') return 8;
+            if (data_type[1] == '8') return 16;
+            return 0;
+    }
+    return 0;
+}
+
+/* ----------------------------------------------------------------- */
+
+static cglong_t data_count (ADFM_NODE *node)
+{
+    int n;
+    cglong_t count;
+
+    if (node->ndims < 1) return 0;
+    for (count = 1, n = 0; n < node->ndims; n++)
+        count *= node->dims[n];
+    return count;
+}
+
+/* ----------------------------------------------------------------- */
+
+/* the data of a node, allocated and zeroed when it is first written */
+
+static char *node_data (ADFM_NODE *node, int create, int *err)
+{
+    cglong_t bytes = data_count(node) * type_size(node->data_type);
+
+    if (bytes == 0) {
+        set_error(NO_DATA, err);
+        return NULL;
+    }
+    if (node->data == NULL) {
+        if (!create) {
+            set_error(NO_DATA, err);
+            return NULL;
+        }
+        node->data = (char *) calloc ((size_t)bytes, 1);
+        if (node->data == NULL) {
+            set_error(MEMORY_ALLOCATION_FAILED, err);
+            return NULL;
+        }
+    }
+    return node->data;
+}
+
+/* ----------------------------------------------------------------- */
+
+/* a hyperslab is walked in runs of contiguous elements */
+
+typedef struct {
+    int ndims;
+    cglong_t count[ADF_MAX_DIMENSIONS];
+    cglong_t step[ADF_MAX_DIMENSIONS];
+    cglong_t index[ADF_MAX_DIMENSIONS];
+    cglong_t base;
+    cglong_t offset;
+    cglong_t total;
+    int contiguous;
+} HYPERSLAB;
+
+static int init_slab (HYPERSLAB *slab, int ndims, const cglong_t *dims,
+    const cgsize_t *start, const cgsize_t *end, const cgsize_t *stride,
+    int *err)
+{
+    int n;
+    cglong_t size = 1;
+
+    if (ndims < 1 || ndims > ADF_MAX_DIMENSIONS) {
+        set_error(BAD_NUMBER_OF_DIMENSIONS, err);
+        return 1;
+    }
+    slab->ndims = ndims;
+    slab->base = 0;
+    slab->total = 1;
+    for (n = 0; n < ndims; n++) {
+        if (start[n] < 1) {
+            set_error(START_OUT_OF_DEFINED_RANGE, err);
+            return 1;
+        }
+        if (end[n] > dims[n]) {
+            set_error(END_OUT_OF_DEFINED_RANGE, err);
+            return 1;
+        }
+        if (start[n] > end[n]) {
+            set_error(MINIMUM_GT_MAXIMUM, err);
+            return 1;
+        }
+        if (stride[n] < 1) {
+            set_error(BAD_STRIDE_VALUE, err);
+            return 1;
+        }
+        slab->count[n] = (end[n] - start[n]) / stride[n] + 1;
+        slab->step[n] = stride[n] * size;
+        slab->index[n] = 0;
+        slab->base += (start[n] - 1) * size;
+        slab->total *= slab->count[n];
+        size *= dims[n];
+    }
+    slab->offset = slab->base;
+    slab->contiguous = stride[0] == 1;
+    return 0;
+}
+
+static cglong_t slab_run (HYPERSLAB *slab)
+{
+    return slab->contiguous ? slab->count[0] - slab->index[0] : 1;
+}
+
+static void slab_advance (HYPERSLAB *slab, cglong_t count)
+{
+    int n;
+
+    slab->index[0] += count;
+    slab->offset += count * slab->step[0];
+    if (slab->index[0] < slab->count[0]) return;
+    slab->index[0] = 0;
+    for (n = 1; n < slab->ndims; n++) {
+        if (++slab->index[n] < slab->count[n]) break;
+        slab->index[n] = 0;
+    }
+    slab->offset = slab->base;
+    for (n = 0; n < slab->ndims; n++)
+        slab->offset += slab->index[n] * slab->step[n];
+}
+
+/* ----------------------------------------------------------------- */
+
+static void copy_slab (ADFM_NODE *node, const cgsize_t s_start[],
+    const cgsize_t s_end[], const cgsize_t s_stride[], int m_num_dims,
+    const cgsize_t m_dims[], const cgsize_t m_start[],
+    const cgsize_t m_end[], const cgsize_t m_stride[],
+    char *data, int to_node, int *err)
+{
+    int n, size = type_size(node->data_type);
+    cglong_t count, remaining, mdims[ADF_MAX_DIMENSIONS];
+    HYPERSLAB disk, memory;
+    char *node_buf;
+
+    if (node->ndims < 1 || size == 0) {
+        set_error(NO_DATA, err);
+        return;
+    }
+    if (m_num_dims < 1 || m_num_dims > ADF_MAX_DIMENSIONS) {
+        set_error(BAD_NUMBER_OF_DIMENSIONS, err);
+        return;
+    }
+    for (n = 0; n < m_num_dims; n++)
+        mdims[n] = m_dims[n];
+    if (init_slab(&disk, node->ndims, node->dims, s_start, s_end,
+            s_stride, err) ||
+        init_slab(&memory, m_num_dims, mdims, m_start, m_end,
+            m_stride, err))
+        return;
+    if (disk.total != memory.total) {
+        set_error(UNEQUAL_MEMORY_AND_DISK_DIMS, err);
+        return;
+    }
+    if ((node_buf = node_data(node, to_node, err)) == NULL) return;
+
+    for (remaining = disk.total; remaining > 0; remaining -= count) {
+        count = slab_run(&disk);
+        if (count > slab_run(&memory)) count = slab_run(&memory);
+        if (to_node)
+            memcpy(node_buf + disk.offset * size,
+                data + memory.offset * size, (size_t)(count * size));
+        else
+            memcpy(data + memory.offset * size,
+                node_buf + disk.offset * size, (size_t)(count * size));
+        slab_advance(&disk, count);
+        slab_advance(&memory, count);
+    }
+    set_error(NO_ERROR, err);
+}
+
+/* ----------------------------------------------------------------- */
+
+static char *check_block (ADFM_NODE *node, cgsize_t b_start,
+    cgsize_t b_end, int create, int *err)
+{
+    if (b_start < 1) {
+        set_error(START_OUT_OF_DEFINED_RANGE, err);
+        return NULL;
+    }
+    if (b_end > data_count(node)) {
+        set_error(END_OUT_OF_DEFINED_RANGE, err);
+        return NULL;
+    }
+    if (b_start > b_end) {
+        set_error(MINIMUM_GT_MAXIMUM, err);
+        return NULL;
+    }
+    return node_data(node, create, err);
+}
+
+/* ----------------------------------------------------------------- */
+
+static char *check_indices (ADFM_NODE *node, cgsize_t num,
+    const cgsize_t indices[], int create, int *err)
+{
+    cgsize_t n;
+    cglong_t count = data_count(node);
+
+    if (num < 1 || indices == NULL) {
+        set_error(NULL_POINTER, err);
+        return NULL;
+    }
+    for (n = 0; n < num; n++) {
+        if (indices[n] < 1) {
+            set_error(START_OUT_OF_DEFINED_RANGE, err);
+            return NULL;
+        }
+        if (indices[n] > count) {
+            set_error(END_OUT_OF_DEFINED_RANGE, err);
+            return NULL;
+        }
+    }
+    return node_data(node, create, err);
+}
+
+/*===================================================================
+ * databases
+ *===================================================================*/
+
+/* status is NEW to make a named database, replacing one that is not
+   open, OLD or READ_ONLY to open one that exists, and SCRATCH for an
+   unnamed one that goes away when it is closed */
+
+void ADFM_Database_Open(const char *filename,
+                        const char *status,
+                        double *root_ID,
+                        int *err)
+{
+    int t, scratch;
+    ADFM_TREE *tree, **newtrees;
+
+    if (status == NULL || root_ID == NULL) {
+        set_error(NULL_POINTER, err);
+        return;
+    }
+    scratch = 0 == strcmp(status, "SCRATCH");
+    if (!scratch && (filename == NULL || !*filename)) {
+        set_error(STRING_LENGTH_ZERO, err);
+        return;
+    }
+
+    if (0 == strcmp(status, "OLD") || 0 == strcmp(status, "READ_ONLY")) {
+        if ((t = find_tree(filename)) == 0) {
+            set_error(REQUESTED_OLD_FILE_NOT_FOUND, err);
+            return;
+        }
+        trees[t-1]->open++;
+        *root_ID = to_ID(t, 1);
+        set_error(NO_ERROR, err);
+        return;
+    }
+    if (!scratch && strcmp(status, "NEW")) {
+        set_error(ADF_FILE_STATUS_NOT_RECOGNIZED, err);
+        return;
+    }
+    if (!scratch && (t = find_tree(filename)) != 0) {
+        if (trees[t-1]->open) {
+            set_error(REQUESTED_NEW_FILE_EXISTS, err);
+            return;
+        }
+        delete_tree(t);
+    }
+
+    for (t = 0; t < num_trees; t++) {
+        if (trees[t] == NULL) break;
+    }
+    if (t == num_trees) {
+        newtrees = (ADFM_TREE **) realloc (trees,
+            (num_trees + 1) * sizeof(ADFM_TREE *));
+        if (newtrees == NULL) {
+            set_error(MEMORY_ALLOCATION_FAILED, err);
+            return;
+        }
+        trees = newtrees;
+        trees[num_trees++] = NULL;
+    }
+    tree = (ADFM_TREE *) calloc (1, sizeof(ADFM_TREE));
+    if (tree == NULL) {
+        set_error(MEMORY_ALLOCATION_FAILED, err);
+        return;
+    }
+    if (!scratch) {
+        tree->name = (char *) malloc (strlen(filename) + 1);
+        if (tree->name == NULL) {
+            free(tree);
+            set_error(MEMORY_ALLOCATION_FAILED, err);
+            return;
+        }
+        strcpy(tree->name, filename);
+    }
+    trees[t] = tree;
+    if (new_node(tree, err) != 1) {
+        free_tree(t + 1);
+        return;
+    }
+    strcpy(tree_node(tree, 1)->name, "ADF MotherNode");
+    strcpy(tree_node(tree, 1)->label, "Root Node of ADF File");
+    current_date(tree->created);
+    strcpy(tree->modified, tree->created);
+    tree->open = 1;
+    *root_ID = to_ID(t + 1, 1);
+    set_error(NO_ERROR, err);
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Database_Close(const double ID,
+                         int *err)
+{
+    int t;
+
+    if (get_node(ID, &t, NULL, err) == NULL) return;
+    if (--trees[t-1]->open == 0 && trees[t-1]->name == NULL)
+        delete_tree(t);
+}
+
+/* ----------------------------------------------------------------- */
+
+/* deletes a named database, or all of those that are closed when
+   the name is NULL */
+
+void ADFM_Database_Delete(const char *filename,
+                          int *err)
+{
+    int t;
+
+    if (filename == NULL) {
+        for (t = 1; t <= num_trees; t++) {
+            if (trees[t-1] != NULL && !trees[t-1]->open)
+                delete_tree(t);
+        }
+        set_error(NO_ERROR, err);
+        return;
+    }
+    if ((t = find_tree(filename)) == 0) {
+        set_error(REQUESTED_OLD_FILE_NOT_FOUND, err);
+        return;
+    }
+    if (trees[t-1]->open) {
+        set_error(FILE_CLOSE_ERROR, err);
+        return;
+    }
+    delete_tree(t);
+    set_error(NO_ERROR, err);
+}
+
+/* ----------------------------------------------------------------- */
+
+/* renames a database that is closed, replacing any of the new name */
+
+void ADFM_Database_Rename(const char *filename,
+                          const char *new_filename,
+                          int *err)
+{
+    int t, told;
+    char *name;
+
+    if (filename == NULL || new_filename == NULL) {
+        set_error(NULL_STRING_POINTER, err);
+        return;
+    }
+    if ((t = find_tree(filename)) == 0) {
+        set_error(REQUESTED_OLD_FILE_NOT_FOUND, err);
+        return;
+    }
+    if ((told = find_tree(new_filename)) == t) {
+        set_error(NO_ERROR, err);
+        return;
+    }
+    if (trees[t-1]->open || (told && trees[told-1]->open)) {
+        set_error(FILE_CLOSE_ERROR, err);
+        return;
+    }
+    name = (char *) malloc (strlen(new_filename) + 1);
+    if (name == NULL) {
+        set_error(MEMORY_ALLOCATION_FAILED, err);
+        return;
+    }
+    strcpy(name, new_filename);
+    if (told) delete_tree(told);
+    free(trees[t-1]->name);
+    trees[t-1]->name = name;
+    set_error(NO_ERROR, err);
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Database_Valid(const char *filename,
+                         int *err)
+{
+    if (filename == NULL || !*filename) {
+        set_error(NULL_STRING_POINTER, err);
+        return;
+    }
+    if (find_tree(filename))
+        set_error(NO_ERROR, err);
+    else
+        set_error(REQUESTED_OLD_FILE_NOT_FOUND, err);
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Database_Version(const double Root_ID,
+                           char *version,
+                           char *creation_date,
+                           char *modification_date,
+                           int *err)
+{
+    int t;
+
+    if (get_node(Root_ID, &t, NULL, err) == NULL) return;
+    if (version != NULL) strcpy(version, ADFM_VERSION);
+    if (creation_date != NULL)
+        strcpy(creation_date, trees[t-1]->created);
+    if (modification_date != NULL)
+        strcpy(modification_date, trees[t-1]->modified);
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Library_Version(char *version,
+                          int *err)
+{
+    if (version == NULL) {
+        set_error(NULL_STRING_POINTER, err);
+        return;
+    }
+    strcpy(version, ADFM_LIBRARY);
+    set_error(NO_ERROR, err);
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Get_Root_ID(const double ID,
+                      double *Root_ID,
+                      int *err)
+{
+    int t;
+
+    if (get_node(ID, &t, NULL, err) != NULL)
+        *Root_ID = to_ID(t, 1);
+}
+
+/*===================================================================
+ * nodes
+ *===================================================================*/
+
+void ADFM_Create(const double PID,
+                 const char *name,
+                 double *ID,
+                 int *err)
+{
+    int t, p, n;
+    ADFM_TREE *tree;
+
+    if (ID == NULL) {
+        set_error(NULL_NODEID_POINTER, err);
+        return;
+    }
+    if (check_name(name, err) ||
+        get_data_node(PID, &t, &p, err) == NULL) return;
+    tree = trees[t-1];
+    if (hash_find(tree, p, name)) {
+        set_error(DUPLICATE_CHILD_NAME, err);
+        return;
+    }
+    if ((n = new_node(tree, err)) == 0) return;
+    strcpy(tree_node(tree, n)->name, name);
+    if (add_child(tree, p, n, err)) {
+        tree_node(tree, n)->in_use = 0;
+        tree_node(tree, n)->parent = tree->free_nodes;
+        tree->free_nodes = n;
+        return;
+    }
+    *ID = to_ID(t, n);
+    set_error(NO_ERROR, err);
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Delete(const double PID,
+                 const double ID,
+                 int *err)
+{
+    int pt, p, t, n;
+
+    if (get_data_node(PID, &pt, &p, err) == NULL ||
+        get_node(ID, &t, &n, err) == NULL) return;
+    if (n == 1) {
+        set_error(FREE_OF_ROOT_NODE, err);
+        return;
+    }
+    if (t != pt || tree_node(trees[t-1], n)->parent != p) {
+        set_error(CHILD_NOT_OF_GIVEN_PARENT, err);
+        return;
+    }
+    remove_child(trees[t-1], p, n);
+    free_node(trees[t-1], n);
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Move_Child(const double PID,
+                     const double ID,
+                     const double NPID,
+                     int *err)
+{
+    int pt, p, t, n, nt, np, up;
+    ADFM_TREE *tree;
+    ADFM_NODE *node;
+
+    if (get_data_node(PID, &pt, &p, err) == NULL ||
+        get_node(ID, &t, &n, err) == NULL ||
+        get_data_node(NPID, &nt, &np, err) == NULL) return;
+    if (t != pt || t != nt) {
+        set_error(NODES_NOT_IN_SAME_FILE, err);
+        return;
+    }
+    tree = trees[t-1];
+    node = tree_node(tree, n);
+    if (node->parent != p) {
+        set_error(CHILD_NOT_OF_GIVEN_PARENT, err);
+        return;
+    }
+    if (np == p) return;
+    for (up = np; up; up = tree_node(tree, up)->parent) {
+        if (up == n) {
+            set_error(CHILD_NOT_OF_GIVEN_PARENT, err);
+            return;
+        }
+    }
+    if (hash_find(tree, np, node->name)) {
+        set_error(DUPLICATE_CHILD_NAME, err);
+        return;
+    }
+    remove_child(tree, p, n);
+    if (add_child(tree, np, n, err)) return;
+    set_error(NO_ERROR, err);
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Put_Name(const double PID,
+                   const double ID,
+                   const char *name,
+                   int *err)
+{
+    int pt, p, t, n;
+    ADFM_TREE *tree;
+    ADFM_NODE *node;
+
+    if (check_name(name, err) ||
+        get_data_node(PID, &pt, &p, err) == NULL ||
+        (node = get_node(ID, &t, &n, err)) == NULL) return;
+    tree = trees[t-1];
+    if (t != pt || node->parent != p) {
+        set_error(CHILD_NOT_OF_GIVEN_PARENT, err);
+        return;
+    }
+    if (0 == strcmp(node->name, name)) return;
+    if (hash_find(tree, p, name)) {
+        set_error(DUPLICATE_CHILD_NAME, err);
+        return;
+    }
+    hash_remove(tree, n);
+    strcpy(node->name, name);
+    hash_add(tree, n, err);
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Get_Name(const double ID,
+                   char *name,
+                   int *err)
+{
+    ADFM_NODE *node;
+
+    if (name == NULL) {
+        set_error(NULL_STRING_POINTER, err);
+        return;
+    }
+    if ((node = get_node(ID, NULL, NULL, err)) != NULL)
+        strcpy(name, node->name);
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Get_Label(const double ID,
+                    char *label,
+                    int *err)
+{
+    ADFM_NODE *node;
+
+    if (label == NULL) {
+        set_error(NULL_STRING_POINTER, err);
+        return;
+    }
+    if ((node = get_data_node(ID, NULL, NULL, err)) != NULL)
+        strcpy(label, node->label);
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Set_Label(const double ID,
+                    const char *label,
+                    int *err)
+{
+    ADFM_NODE *node;
+
+    if (label == NULL) {
+        set_error(NULL_STRING_POINTER, err);
+        return;
+    }
+    if (strlen(label) > ADF_LABEL_LENGTH) {
+        set_error(STRING_LENGTH_TOO_BIG, err);
+        return;
+    }
+    if ((node = get_data_node(ID, NULL, NULL, err)) != NULL)
+        strcpy(node->label, label);
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Get_Node_ID(const double PID,
+                      const char *name,
+                      double *ID,
+                      int *err)
+{
+    int t, n;
+
+    if (name == NULL) {
+        set_error(NULL_STRING_POINTER, err);
+        return;
+    }
+    if (ID == NULL) {
+        set_error(NULL_NODEID_POINTER, err);
+        return;
+    }
+    if (get_node(PID, &t, &n, err) == NULL ||
+        find_path(t, n, name, 0, &t, &n, 0, err)) return;
+    *ID = to_ID(t, n);
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Number_of_Children(const double ID,
+                             int *num_children,
+                             int *err)
+{
+    ADFM_NODE *node;
+
+    if (num_children == NULL) {
+        set_error(NULL_POINTER, err);
+        return;
+    }
+    if ((node = get_data_node(ID, NULL, NULL, err)) != NULL)
+        *num_children = node->num_children;
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Children_IDs(const double PID,
+                       const int istart,
+                       const int ilen,
+                       int *ilen_ret,
+                       double *IDs,
+                       int *err)
+{
+    int t, n;
+    ADFM_NODE *node;
+
+    if (ilen_ret == NULL || IDs == NULL) {
+        set_error(NULL_POINTER, err);
+        return;
+    }
+    if (istart < 1 || ilen < 1) {
+        set_error(NUMBER_LESS_THAN_MINIMUM, err);
+        return;
+    }
+    if ((node = get_data_node(PID, &t, NULL, err)) == NULL) return;
+    for (n = 0; n < ilen && istart + n <= node->num_children; n++)
+        IDs[n] = to_ID(t, node->children[istart+n-1]);
+    *ilen_ret = n;
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Children_Names(const double PID,
+                         const int istart,
+                         const int ilen,
+                         const int name_length,
+                         int *ilen_ret,
+                         char *names,
+                         int *err)
+{
+    int t, n;
+    char *p;
+    ADFM_NODE *node;
+
+    if (ilen_ret == NULL) {
+        set_error(NULL_POINTER, err);
+        return;
+    }
+    if (names == NULL) {
+        set_error(NULL_STRING_POINTER, err);
+        return;
+    }
+    if (istart < 1 || ilen < 1 || name_length < 1) {
+        set_error(NUMBER_LESS_THAN_MINIMUM, err);
+        return;
+    }
+    if ((node = get_data_node(PID, &t, NULL, err)) == NULL) return;
+    memset(names, 0, ilen*name_length);
+    for (n = 0; n < ilen && istart + n <= node->num_children; n++) {
+        p = names + n * name_length;
+        strncpy(p, tree_node(trees[t-1],
+            node->children[istart+n-1])->name, name_length-1);
+        p[name_length-1] = 0;
+    }
+    *ilen_ret = n;
+}
+
+/*===================================================================
+ * links
+ *===================================================================*/
+
+void ADFM_Link(const double PID,
+               const char *name,
+               const char *file,
+               const char *name_in_file,
+               double *ID,
+               int *err)
+{
+    int t, n;
+    size_t flen;
+    ADFM_NODE *node;
+
+    if (file == NULL || name_in_file == NULL) {
+        set_error(NULL_STRING_POINTER, err);
+        return;
+    }
+    if (!*name_in_file) {
+        set_error(STRING_LENGTH_ZERO, err);
+        return;
+    }
+    flen = strlen(file);
+    if (flen + strlen(name_in_file) + 1 > ADF_MAX_LINK_DATA_SIZE) {
+        set_error(STRING_LENGTH_TOO_BIG, err);
+        return;
+    }
+    ADFM_Create(PID, name, ID, err);
+    if (*err != NO_ERROR) return;
+    node = get_node(*ID, &t, &n, err);
+    node->link_file = (char *) malloc (flen + strlen(name_in_file) + 2);
+    if (node->link_file == NULL) {
+        set_error(MEMORY_ALLOCATION_FAILED, err);
+        return;
+    }
+    strcpy(node->link_file, file);
+    node->link_path = node->link_file + flen + 1;
+    strcpy(node->link_path, name_in_file);
+    strcpy(node->data_type, "LK");
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Is_Link(const double ID,
+                  int *link_path_length,
+                  int *err)
+{
+    ADFM_NODE *node;
+
+    if (link_path_length == NULL) {
+        set_error(NULL_POINTER, err);
+        return;
+    }
+    if ((node = get_node(ID, NULL, NULL, err)) == NULL) return;
+    if (node->link_path == NULL)
+        *link_path_length = 0;
+    else
+        *link_path_length = (int)(strlen(node->link_file) +
+                                  strlen(node->link_path));
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Link_Size(const double ID,
+                    int *file_length,
+                    int *name_length,
+                    int *err)
+{
+    ADFM_NODE *node;
+
+    if (file_length == NULL || name_length == NULL) {
+        set_error(NULL_POINTER, err);
+        return;
+    }
+    if ((node = get_node(ID, NULL, NULL, err)) == NULL) return;
+    if (node->link_path == NULL) {
+        *file_length = *name_length = 0;
+        return;
+    }
+    *file_length = (int)strlen(node->link_file);
+    *name_length = (int)strlen(node->link_path);
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Get_Link_Path(const double ID,
+                        char *filename,
+                        char *link_path,
+                        int *err)
+{
+    ADFM_NODE *node;
+
+    if (filename == NULL || link_path == NULL) {
+        set_error(NULL_STRING_POINTER, err);
+        return;
+    }
+    if ((node = get_node(ID, NULL, NULL, err)) == NULL) return;
+    if (node->link_path == NULL) {
+        set_error(NODE_IS_NOT_A_LINK, err);
+        return;
+    }
+    strcpy(filename, node->link_file);
+    strcpy(link_path, node->link_path);
+}
+
+/*===================================================================
+ * dimensions and data
+ *===================================================================*/
+
+void ADFM_Get_Data_Type(const double ID,
+                        char *data_type,
+                        int *err)
+{
+    ADFM_NODE *node;
+
+    if (data_type == NULL) {
+        set_error(NULL_STRING_POINTER, err);
+        return;
+    }
+    if ((node = get_data_node(ID, NULL, NULL, err)) != NULL)
+        strcpy(data_type, node->data_type);
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Get_Number_of_Dimensions(const double ID,
+                                   int *num_dims,
+                                   int *err)
+{
+    ADFM_NODE *node;
+
+    if (num_dims == NULL) {
+        set_error(NULL_POINTER, err);
+        return;
+    }
+    if ((node = get_data_node(ID, NULL, NULL, err)) != NULL)
+        *num_dims = node->ndims;
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Get_Dimension_Values(const double ID,
+                               cgsize_t dim_vals[],
+                               int *err)
+{
+    int n;
+    ADFM_NODE *node;
+
+    if (dim_vals == NULL) {
+        set_error(NULL_POINTER, err);
+        return;
+    }
+    if ((node = get_data_node(ID, NULL, NULL, err)) == NULL) return;
+    if (node->ndims == 0) {
+        set_error(ZERO_DIMENSIONS, err);
+        return;
+    }
+    for (n = 0; n < node->ndims; n++) {
+#if CG_SIZEOF_SIZE == 32
+        if (node->dims[n] > CG_MAX_INT32) {
+            set_error(MAX_INT32_SIZE_EXCEEDED, err);
+            return;
+        }
+#endif
+        dim_vals[n] = (cgsize_t)node->dims[n];
+    }
+}
+
+/* ----------------------------------------------------------------- */
+
+/* the data is kept when only the shape changes, and is dropped when
+   the type or number of values does */
+
+void ADFM_Put_Dimension_Information(const double ID,
+                                    const char *data_type,
+                                    const int dims,
+                                    const cgsize_t dim_vals[],
+                                    int *err)
+{
+    int n;
+    char type[3];
+    cglong_t count;
+    ADFM_NODE *node;
+
+    if (data_type == NULL) {
+        set_error(NULL_STRING_POINTER, err);
+        return;
+    }
+    if (strlen(data_type) != 2) {
+        set_error(INVALID_DATA_TYPE, err);
+        return;
+    }
+    type[0] = (char)toupper(data_type[0]);
+    type[1] = (char)toupper(data_type[1]);
+    type[2] = 0;
+    if (strcmp(type, "MT") && type_size(type) == 0) {
+        set_error(INVALID_DATA_TYPE, err);
+        return;
+    }
+    if (dims < 0 || dims > ADF_MAX_DIMENSIONS) {
+        set_error(BAD_NUMBER_OF_DIMENSIONS, err);
+        return;
+    }
+    if (dims && dim_vals == NULL) {
+        set_error(NULL_POINTER, err);
+        return;
+    }
+    for (n = 0; n < dims; n++) {
+        if (dim_vals[n] < 1) {
+            set_error(BAD_DIMENSION_VALUE, err);
+            return;
+        }
+    }
+    if ((node = get_data_node(ID, NULL, NULL, err)) == NULL) return;
+
+    count = data_count(node);
+    if (strcmp(type, node->data_type) || 0 == strcmp(type, "MT")) count = -1;
+    node->ndims = strcmp(type, "MT") ? dims : 0;
+    for (n = 0; n < node->ndims; n++)
+        node->dims[n] = dim_vals[n];
+    strcpy(node->data_type, type);
+    if (count != data_count(node) && node->data != NULL) {
+        free(node->data);
+        node->data = NULL;
+    }
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Read_All_Data(const double ID,
+                        char *data,
+                        int *err)
+{
+    char *buf;
+    ADFM_NODE *node;
+
+    if (data == NULL) {
+        set_error(NULL_POINTER, err);
+        return;
+    }
+    if ((node = get_data_node(ID, NULL, NULL, err)) == NULL ||
+        (buf = node_data(node, 0, err)) == NULL) return;
+    memcpy(data, buf, (size_t)(data_count(node) *
+        type_size(node->data_type)));
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Read_Block_Data(const double ID,
+                          const cgsize_t b_start,
+                          const cgsize_t b_end,
+                          char *data,
+                          int *err)
+{
+    int size;
+    char *buf;
+    ADFM_NODE *node;
+
+    if (data == NULL) {
+        set_error(NULL_POINTER, err);
+        return;
+    }
+    if ((node = get_data_node(ID, NULL, NULL, err)) == NULL ||
+        (buf = check_block(node, b_start, b_end, 0, err)) == NULL) return;
+    size = type_size(node->data_type);
+    memcpy(data, buf + (b_start - 1) * size,
+        (size_t)((b_end - b_start + 1) * size));
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Read_Data(const double ID,
+                    const cgsize_t s_start[],
+                    const cgsize_t s_end[],
+                    const cgsize_t s_stride[],
+                    const int m_num_dims,
+                    const cgsize_t m_dims[],
+                    const cgsize_t m_start[],
+                    const cgsize_t m_end[],
+                    const cgsize_t m_stride[],
+                    char *data,
+                    int *err)
+{
+    ADFM_NODE *node;
+
+    if (data == NULL) {
+        set_error(NULL_POINTER, err);
+        return;
+    }
+    if ((node = get_data_node(ID, NULL, NULL, err)) == NULL) return;
+    copy_slab(node, s_start, s_end, s_stride, m_num_dims, m_dims,
+        m_start, m_end, m_stride, data, 0, err);
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Read_Indices(const double ID,
+                       const cgsize_t num,
+                       const cgsize_t indices[],
+                       char *data,
+                       int *err)
+{
+    int size;
+    cgsize_t n;
+    char *buf;
+    ADFM_NODE *node;
+
+    if (data == NULL) {
+        set_error(NULL_POINTER, err);
+        return;
+    }
+    if ((node = get_data_node(ID, NULL, NULL, err)) == NULL ||
+        (buf = check_indices(node, num, indices, 0, err)) == NULL) return;
+    size = type_size(node->data_type);
+    for (n = 0; n < num; n++)
+        memcpy(data + n * size, buf + (indices[n] - 1) * size, size);
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Reserve_Data(const double ID,
+                       int *err)
+{
+    ADFM_NODE *node;
+
+    if ((node = get_data_node(ID, NULL, NULL, err)) != NULL)
+        node_data(node, 1, err);
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Write_All_Data(const double ID,
+                         const char *data,
+                         int *err)
+{
+    char *buf;
+    ADFM_NODE *node;
+
+    if (data == NULL) {
+        set_error(NULL_POINTER, err);
+        return;
+    }
+    if ((node = get_data_node(ID, NULL, NULL, err)) == NULL ||
+        (buf = node_data(node, 1, err)) == NULL) return;
+    memcpy(buf, data, (size_t)(data_count(node) *
+        type_size(node->data_type)));
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Write_Block_Data(const double ID,
+                           const cgsize_t b_start,
+                           const cgsize_t b_end,
+                           const char *data,
+                           int *err)
+{
+    int size;
+    char *buf;
+    ADFM_NODE *node;
+
+    if (data == NULL) {
+        set_error(NULL_POINTER, err);
+        return;
+    }
+    if ((node = get_data_node(ID, NULL, NULL, err)) == NULL ||
+        (buf = check_block(node, b_start, b_end, 1, err)) == NULL) return;
+    size = type_size(node->data_type);
+    memcpy(buf + (b_start - 1) * size, data,
+        (size_t)((b_end - b_start + 1) * size));
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Write_Data(const double ID,
+                     const cgsize_t s_start[],
+                     const cgsize_t s_end[],
+                     const cgsize_t s_stride[],
+                     const int m_num_dims,
+                     const cgsize_t m_dims[],
+                     const cgsize_t m_start[],
+                     const cgsize_t m_end[],
+                     const cgsize_t m_stride[],
+                     const char *data,
+                     int *err)
+{
+    ADFM_NODE *node;
+
+    if (data == NULL) {
+        set_error(NULL_POINTER, err);
+        return;
+    }
+    if ((node = get_data_node(ID, NULL, NULL, err)) == NULL) return;
+    copy_slab(node, s_start, s_end, s_stride, m_num_dims, m_dims,
+        m_start, m_end, m_stride, (char *)data, 1, err);
+}
+
+/* ----------------------------------------------------------------- */
+
+void ADFM_Write_Indices(const double ID,
+                        const cgsize_t num,
+                        const cgsize_t indices[],
+                        const char *data,
+                        int *err)
+{
+    int size;
+    cgsize_t n;
+    char *buf;
+    ADFM_NODE *node;
+
+    if (data == NULL) {
+        set_error(NULL_POINTER, err);
+        return;
+    }
+    if ((node = get_data_node(ID, NULL, NULL, err)) == NULL ||
+        (buf = check_indices(node, num, indices, 1, err)) == NULL) return;
+    size = type_size(node->data_type);
+    for (n = 0; n < num; n++)
+        memcpy(buf + (indices[n] - 1) * size, data + n * size, size);
+}
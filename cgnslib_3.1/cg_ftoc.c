@@ -142,6 +142,13 @@ CGNSDLL void FMNAME(cg_close_f, CG_CLOSE_F) (cgsize_t *fn, cgsize_t *ier)
 
 /*-----------------------------------------------------------------------*/
 
+CGNSDLL void FMNAME(cg_flush_f, CG_FLUSH_F) (cgsize_t *fn, cgsize_t *ier)
+{
+    *ier = cg_flush((int)*fn);
+}
+
+/*-----------------------------------------------------------------------*/
+
 CGNSDLL void FMNAME(cg_save_as_f, CG_SAVE_AS_F) (cgsize_t *fn,
 	STR_PSTR(filename), cgsize_t *file_type, cgsize_t *follow_links,
 	cgsize_t *ier STR_PLEN(filename))
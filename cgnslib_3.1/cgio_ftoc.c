@@ -604,6 +604,14 @@ CGIODLL void FMNAME(cgio_set_dimensions_f, CGIO_SET_DIMENSIONS_F) (
 
 /*---------------------------------------------------------*/
 
+CGIODLL void FMNAME(cgio_reserve_data_f, CGIO_RESERVE_DATA_F) (
+    cgsize_t *cgio_num, double *id, cgsize_t *ier)
+{
+    *ier = cgio_reserve_data((int)*cgio_num, *id);
+}
+
+/*---------------------------------------------------------*/
+
 CGIODLL void FMNAME(cgio_write_all_data_f, CGIO_WRITE_ALL_DATA_F) (
     cgsize_t *cgio_num, double *id, void *data, cgsize_t *ier)
 {
@@ -135,6 +135,7 @@ typedef int cgint3_t[3];
 
 #define SKIP_DATA 0
 #define READ_DATA 1
+#define DEFER_DATA 2
 
 /*
  * Internal Structures:
@@ -679,6 +680,7 @@ typedef struct {            /* FlowSolution_t node          */
     cgns_units *units;      /* Dimensional Units                    */
     int nuser_data;         /* number of user defined data nodes    */  /* V2.1 */
     cgns_user_data *user_data; /* User defined data.        */  /* V2.1 */
+    int indexed;            /* set if only the name has been read   */
 } cgns_sol;
 
 typedef struct {            /* GridCoordinates_t node       */
@@ -910,6 +912,13 @@ typedef struct {            /* CGNSBase_t Node          */
     cgns_rotating *rotating;/* ptrs to in-memory copy of Rot. Coord.*/      /* V2.2 */
 } cgns_base;
 
+typedef struct cgns_async_s { /* pending cgio_new_node_async array   */
+    struct cgns_async_s *next;
+    int B, Z, S;            /* S = 0 for a GridCoordinates array    */
+    int index;              /* coordinate or field number           */
+    double id;              /* set by the I/O thread                */
+} cgns_async;
+
 typedef struct {
     char *filename;         /* name of file                         */
     int version;            /* version of the CGNS file * 1000  */
@@ -925,6 +934,7 @@ typedef struct {
     char_33 adf_lib_version;/* ADF Library Version          */
     int nbases;             /* number of bases in the file          */
     cgns_base *base;        /* ptrs to in-memory copies of bases    */
+    cgns_async *async;      /* arrays still queued for writing      */
 } cgns_file;
 
 typedef struct {
@@ -971,6 +981,7 @@ CGNSDLL void *cgi_malloc(size_t cnt,size_t size);
 CGNSDLL void *cgi_realloc(void *old,size_t bytes);
 
 /* retrieve addresses of nodes who may have children */
+CGNSDLL cgns_file      *cgi_find_file (int file_number);
 CGNSDLL cgns_file      *cgi_get_file (int file_number);
 CGNSDLL cgns_base      *cgi_get_base (cgns_file *cg, int B);
 CGNSDLL cgns_zone      *cgi_get_zone (cgns_file *cg, int B, int Z);
@@ -1046,6 +1057,7 @@ cgns_dataset * cgi_bcdataset_address(int local_mode, int given_no,
 /* read CGNS file into internal database */
 int cgi_read();
 int cgi_read_base(cgns_base *base);
+int cgi_read_zones(cgns_base *base);
 int cgi_read_zone(cgns_zone *zone);
   int cgi_read_zonetype(double parent_id, char_33 parent_name, CGNS_ENUMT(ZoneType_t) *type);
 int cgi_read_family(cgns_family *family);
@@ -1080,6 +1092,7 @@ int cgi_read_integral(int in_link, double parent_id, int *nintegrals,
 int cgi_read_discrete(int in_link, double parent_id, int *ndiscrete,
                       cgns_discrete **discrete);
 int cgi_read_sol(int in_link, double parent_id, int *nsols, cgns_sol **sol);
+int cgi_read_sol_node(cgns_sol *sol);
 int cgi_read_zcoor(int in_link, double parent_id, int *nzcoor,
                    cgns_zcoor **zcoor);
 int cgi_read_zconn(int in_link, double parent_id, int *nzconn, cgns_zconn **zconn);
@@ -1167,6 +1180,10 @@ int cgi_new_node_partial(double parent_id, char const *name, char const *label,
 	double *node_id, char const *data_type, int ndim,
 	cgsize_t const *dim_vals, cgsize_t const *rmin, cgsize_t const *rmax,
 	void const *data);
+int cgi_new_node_async(int B, int Z, int S, int index, double parent_id,
+	char const *name, char const *label, char const *data_type,
+	int ndim, cgsize_t const *dim_vals, void const *data);
+int cgi_async_wait(cgns_file *cg);
 int cgi_move_node(double old_id, double node_id, double new_id, cchar_33 node_name);
 int cgi_delete_node (double parent_id, double node_id);
 
@@ -1217,6 +1234,24 @@ CGNSDLL int cgi_read_int_data(double id, char_33 data_type, cgsize_t cnt, cgsize
 int cgi_convert_data(cgsize_t cnt,
 	CGNS_ENUMT(DataType_t) from_type, const void *from_data,
         CGNS_ENUMT(DataType_t) to_type, void *to_data);
+int cgi_general_range(int s_numdim, const cgsize_t *s_dimvals,
+	const cgsize_t *s_rmin, const cgsize_t *s_rmax,
+	const cgsize_t *s_stride, int m_numdim, const cgsize_t *m_dimvals,
+	const cgsize_t *m_rmin, const cgsize_t *m_rmax,
+	const cgsize_t *m_stride, cgsize_t *s_str, cgsize_t *m_str,
+	cgsize_t *numpt);
+int cgi_array_general_read(cgns_array *array, CGNS_ENUMT(DataType_t) type,
+	const cgsize_t *s_rmin, const cgsize_t *s_rmax,
+	const cgsize_t *s_stride, int m_numdim, const cgsize_t *m_dimvals,
+	const cgsize_t *m_rmin, const cgsize_t *m_rmax,
+	const cgsize_t *m_stride, void *data);
+int cgi_array_indexed_read(cgns_array *array, CGNS_ENUMT(DataType_t) type,
+	cgsize_t num, const cgsize_t *indices, void *data);
+int cgi_array_general_write(double parent_id, cgns_array *array,
+	const cgsize_t *s_rmin, const cgsize_t *s_rmax,
+	const cgsize_t *s_stride, int m_numdim, const cgsize_t *m_dimvals,
+	const cgsize_t *m_rmin, const cgsize_t *m_rmax,
+	const cgsize_t *m_stride, const void *data);
 
 int cgi_add_czone(char_33 zonename, cgsize6_t range, cgsize6_t donor_range,
 		  int idim, int *ndouble, char_33 **Dzonename,
@@ -50,6 +50,13 @@ int NumberOfSteps;      /* Number of steps             */
 int posit_depth = 0;
 cgns_posit posit_stack[CG_MAX_GOTO_DEPTH+1];
 
+/*----- reads put off until the whole file has been read -----*/
+
+static int defer_reads = 0;
+static int num_deferred = 0;
+static int max_deferred = 0;
+static cgio_read_t *deferred = NULL;
+
 /***********************************************************************\
  *          Internal functions                 *
 \***********************************************************************/
@@ -78,6 +85,24 @@ void *cgi_realloc(void *oldbuf, size_t bytes)
  *    Read CGNS file and store in internal data structures         *
 \***********************************************************************/
 
+/* the data read with DEFER_DATA is read here, in one batch, which
+   lets cgio read it in the order it is in the file */
+
+static int cgi_read_deferred()
+{
+    int ierr = 0;
+
+    if (num_deferred &&
+        cgio_read_batch(cg->cgio, num_deferred, deferred)) {
+        cg_io_error("cgio_read_batch");
+        ierr = 1;
+    }
+    free(deferred);
+    deferred = NULL;
+    num_deferred = max_deferred = 0;
+    return ierr;
+}
+
 int cgi_read()
 {
     int b;
@@ -92,9 +117,16 @@ int cgi_read()
     free(id);
 
      /* read and save CGNSBase_t data */
-    for (b=0; b<cg->nbases; b++) if (cgi_read_base(&cg->base[b])) return 1;
+    defer_reads = 1;
+    for (b=0; b<cg->nbases; b++) {
+        if (cgi_read_base(&cg->base[b])) {
+            defer_reads = num_deferred = 0;
+            return 1;
+        }
+    }
+    defer_reads = 0;
 
-    return 0;
+    return cgi_read_deferred();
 }
 
 int cgi_read_base(cgns_base *base)
@@ -148,6 +180,12 @@ int cgi_read_base(cgns_base *base)
     Cdim = base->cell_dim;
     Pdim = base->phys_dim;
 
+     /* CG_MODE_APPEND: index only what is needed to add solutions */
+    if (cg->mode == CG_MODE_APPEND) {
+        if (cgi_read_biter(0, base->id, &base->biter)) return 1;
+        return cgi_read_zones(base);
+    }
+
     /* update version */
     if (cg->mode == CG_MODE_MODIFY && cg->version < 1100) {
         dim_vals[0] = 2;
@@ -214,6 +252,14 @@ int cgi_read_base(cgns_base *base)
         &base->user_data)) return 1;
 
      /* Zone_t (depends on NumberOfSteps) */
+    return cgi_read_zones(base);
+}
+
+int cgi_read_zones(cgns_base *base)
+{
+    double *id;
+    int n;
+
     if (cgi_get_nodes(base->id, "Zone_t", &base->nzones, &id)) return 1;
     if (base->nzones>0) {
          /* Order zones alpha-numerically */
@@ -321,6 +367,16 @@ int cgi_read_zone(cgns_zone *zone)
         }
     }
 
+     /* CG_MODE_APPEND: FlowSolution_t names and ZoneIterativeData_t only */
+    if (cg->mode == CG_MODE_APPEND) {
+        if (cgi_read_sol(in_link, zone->id, &zone->nsols, &zone->sol))
+            return 1;
+        if (NumberOfSteps) {
+            if (cgi_read_ziter(in_link, zone->id, &zone->ziter)) return 1;
+        } else zone->ziter = 0;
+        return 0;
+    }
+
     /* update version */
     if (cg->mode == CG_MODE_MODIFY && cg->version < 1100 && !in_link) {
         dim_vals[0] = zone->index_dim;
@@ -1312,9 +1368,8 @@ int cgi_read_section(int in_link, double parent_id, int *nsections,
 
 int cgi_read_sol(int in_link, double parent_id, int *nsols, cgns_sol **sol)
 {
-    double *id, *idf;
-    int s, z, n, linked;
-    cgsize_t DataSize[3], DataCount = 0;
+    double *id;
+    int s;
 
     if (cgi_get_nodes(parent_id, "FlowSolution_t", nsols, &id))
         return 1;
@@ -1328,92 +1383,108 @@ int cgi_read_sol(int in_link, double parent_id, int *nsols, cgns_sol **sol)
         sol[0][s].id = id[s];
         sol[0][s].link = cgi_read_link(id[s]);
         sol[0][s].in_link = in_link;
-        linked = sol[0][s].link ? 1 : in_link;
 
-     /* FlowSolution_t Name */
-        if (cgio_get_name(cg->cgio, sol[0][s].id, sol[0][s].name)) {
-            cg_io_error("cgio_get_name");
-            return 1;
+     /* in CG_MODE_APPEND only the names are indexed; the rest of the
+        FlowSolution_t is read by cgi_get_sol when first needed */
+        if (cg->mode == CG_MODE_APPEND) {
+            if (cgio_get_name(cg->cgio, sol[0][s].id, sol[0][s].name)) {
+                cg_io_error("cgio_get_name");
+                return 1;
+            }
+            sol[0][s].indexed = 1;
+            continue;
         }
+        if (cgi_read_sol_node(&sol[0][s])) return 1;
+    }
+
+    free(id);
+
+    return 0;
+}
+
+int cgi_read_sol_node(cgns_sol *sol)
+{
+    double *idf;
+    int z, n, linked = sol->link ? 1 : sol->in_link;
+    cgsize_t DataSize[3], DataCount = 0;
+
+     /* FlowSolution_t Name */
+    if (cgio_get_name(cg->cgio, sol->id, sol->name)) {
+        cg_io_error("cgio_get_name");
+        return 1;
+    }
 
      /* GridLocation */
-        if (cgi_read_location(sol[0][s].id, sol[0][s].name,
-            &sol[0][s].location)) return 1;
+    if (cgi_read_location(sol->id, sol->name, &sol->location)) return 1;
 
      /* Rind Planes */
-        if (cgi_read_rind(sol[0][s].id, &sol[0][s].rind_planes)) return 1;
- 
+    if (cgi_read_rind(sol->id, &sol->rind_planes)) return 1;
+
      /* Determine data size */
-        if (cgi_datasize(Idim, CurrentDim, sol[0][s].location,
-                sol[0][s].rind_planes, DataSize)) return 1;
-    
+    if (cgi_datasize(Idim, CurrentDim, sol->location,
+            sol->rind_planes, DataSize)) return 1;
+
      /* check for PointList/PointRange */
-        if (cgi_read_one_ptset(linked, sol[0][s].id,
-                &sol[0][s].ptset)) return 1;
-        if (sol[0][s].ptset != NULL) {
-            if (sol[0][s].ptset->type == CGNS_ENUMV(ElementList) ||
-                sol[0][s].ptset->type == CGNS_ENUMV(ElementRange)) {
-                cgi_error("ElementList/Range not supported under FlowSolution");
-                return 1;
-            }
-            DataCount = sol[0][s].ptset->size_of_patch;
+    if (cgi_read_one_ptset(linked, sol->id, &sol->ptset)) return 1;
+    if (sol->ptset != NULL) {
+        if (sol->ptset->type == CGNS_ENUMV(ElementList) ||
+            sol->ptset->type == CGNS_ENUMV(ElementRange)) {
+            cgi_error("ElementList/Range not supported under FlowSolution");
+            return 1;
         }
- 
+        DataCount = sol->ptset->size_of_patch;
+    }
+
      /* DataArray_t */
-        if (cgi_get_nodes(sol[0][s].id, "DataArray_t", &sol[0][s].nfields,
-            &idf)) return 1;
-        if (sol[0][s].nfields > 0) {
-            sol[0][s].field = CGNS_NEW(cgns_array, sol[0][s].nfields);
-            for (z=0; z<sol[0][s].nfields; z++) {
-                sol[0][s].field[z].id = idf[z];
-                sol[0][s].field[z].link = cgi_read_link(idf[z]);
-                sol[0][s].field[z].in_link = linked;
-
-                if (cgi_read_array(&sol[0][s].field[z],"FlowSolution_t",
-                    sol[0][s].id)) return 1;
+    if (cgi_get_nodes(sol->id, "DataArray_t", &sol->nfields, &idf)) return 1;
+    if (sol->nfields > 0) {
+        sol->field = CGNS_NEW(cgns_array, sol->nfields);
+        for (z=0; z<sol->nfields; z++) {
+            sol->field[z].id = idf[z];
+            sol->field[z].link = cgi_read_link(idf[z]);
+            sol->field[z].in_link = linked;
+
+            if (cgi_read_array(&sol->field[z],"FlowSolution_t", sol->id))
+                return 1;
 
-             /* check data */
-                if (sol[0][s].ptset == NULL) {
-                    if (sol[0][s].field[z].data_dim != Idim) {
-                        cgi_error("Wrong number of dimension in DataArray %s",
-                            sol[0][s].field[z].name);
-                        return 1;
-                    }
-                    for (n=0; n<Idim; n++) {
-                        if (sol[0][s].field[z].dim_vals[n]!=DataSize[n]) {
-                            cgi_error("Invalid field array dimension");
-                            return 1;
-                        }
-                    }
-                } else {
-                    if (sol[0][s].field[z].data_dim != 1 ||
-                        sol[0][s].field[z].dim_vals[0] != DataCount) {
-                        cgi_error("Invalid field array dimension for ptset solution");
+         /* check data */
+            if (sol->ptset == NULL) {
+                if (sol->field[z].data_dim != Idim) {
+                    cgi_error("Wrong number of dimension in DataArray %s",
+                        sol->field[z].name);
+                    return 1;
+                }
+                for (n=0; n<Idim; n++) {
+                    if (sol->field[z].dim_vals[n]!=DataSize[n]) {
+                        cgi_error("Invalid field array dimension");
                         return 1;
                     }
                 }
-                if (strcmp(sol[0][s].field[z].data_type,"I4") &&
-                    strcmp(sol[0][s].field[z].data_type,"I8") &&
-                    strcmp(sol[0][s].field[z].data_type,"R4") &&
-                    strcmp(sol[0][s].field[z].data_type,"R8")) {
-                    cgi_error("Datatype %d not supported for flow solutions");
+            } else {
+                if (sol->field[z].data_dim != 1 ||
+                    sol->field[z].dim_vals[0] != DataCount) {
+                    cgi_error("Invalid field array dimension for ptset solution");
                     return 1;
                 }
             }
-            free(idf);
+            if (strcmp(sol->field[z].data_type,"I4") &&
+                strcmp(sol->field[z].data_type,"I8") &&
+                strcmp(sol->field[z].data_type,"R4") &&
+                strcmp(sol->field[z].data_type,"R8")) {
+                cgi_error("Datatype %d not supported for flow solutions");
+                return 1;
+            }
         }
+        free(idf);
+    }
 
      /* Descriptor_t, DataClass_t, DimensionalUnits_t */
-        if (cgi_read_DDD(linked, sol[0][s].id, &sol[0][s].ndescr,
-            &sol[0][s].descr, &sol[0][s].data_class, &sol[0][s].units))
-            return 1;
+    if (cgi_read_DDD(linked, sol->id, &sol->ndescr, &sol->descr,
+        &sol->data_class, &sol->units)) return 1;
 
      /* UserDefinedData_t */
-        if (cgi_read_user_data(linked, sol[0][s].id, &sol[0][s].nuser_data,
-            &sol[0][s].user_data)) return 1;
-    }
-
-    free(id);
+    if (cgi_read_user_data(linked, sol->id, &sol->nuser_data,
+        &sol->user_data)) return 1;
 
     return 0;
 }
@@ -2296,7 +2367,7 @@ int cgi_read_boco(cgns_boco *boco)
         boco->normal->in_link = linked;
         if (cgi_read_node(IA_id[n], boco->normal->name, boco->normal->data_type,
             &boco->normal->data_dim, boco->normal->dim_vals, &boco->normal->data,
-            READ_DATA)) {
+            DEFER_DATA)) {
             cgi_error("Error reading boco->normal");
             return 1;
         }
@@ -4093,7 +4164,7 @@ int cgi_read_amotion(int in_link, double parent_id, int *namotions,
 
 int cgi_read_array(cgns_array *array, char *parent_label, double parent_id)
 {
-    int data_flag=1;
+    int data_flag=DEFER_DATA;
     int linked = array->link ? 1 : array->in_link;
     char_33 data_type, temp_name;
     int nchild, ndim;
@@ -4109,6 +4180,9 @@ int cgi_read_array(cgns_array *array, char *parent_label, double parent_id)
         data_flag=SKIP_DATA;
         array->data=0;
     }
+     /* NumberOfZones and NumberOfFamilies are looked at right away */
+    else if (strcmp(parent_label,"BaseIterativeData_t")==0)
+        data_flag=READ_DATA;
     if (cgi_read_node(array->id, array->name, array->data_type,
         &array->data_dim, array->dim_vals, &array->data, data_flag)) {
         cgi_error("Error reading array under %s",parent_label);
@@ -4195,7 +4269,7 @@ int cgi_read_conversion(int in_link, double parent_id, cgns_conversion **convert
     free(id);
 
     if (cgi_read_node(convert[0]->id, convert[0]->name, convert[0]->data_type,
-        &ndim, dim_vals,  &convert[0]->data, READ_DATA)) {
+        &ndim, dim_vals,  &convert[0]->data, DEFER_DATA)) {
         cgi_error("Error reading '%s'",convert[0]->name);
         return 1;
     }
@@ -4212,8 +4286,8 @@ int cgi_read_conversion(int in_link, double parent_id, cgns_conversion **convert
 
 int cgi_read_exponents(int in_link, double parent_id, cgns_exponent **exponents)
 {
-    int nnod, ndim;
-    double *id;
+    int nnod, ndim, nadd;
+    double *id, *add_id;
     cgsize_t dim_vals[12];
 
     if (cgi_get_nodes(parent_id, "DimensionalExponents_t", &nnod, &id)) return 1;
@@ -4227,31 +4301,36 @@ int cgi_read_exponents(int in_link, double parent_id, cgns_exponent **exponents)
     exponents[0]->in_link = in_link;
     free(id);
 
+     /* the data is put off unless AdditionalExponents are added to it */
+    if (cgi_get_nodes(exponents[0]->id, "AdditionalExponents_t", &nadd,
+        &add_id)) return 1;
     if (cgi_read_node(exponents[0]->id, exponents[0]->name,
-        exponents[0]->data_type, &ndim, dim_vals, &exponents[0]->data, READ_DATA)) {
+        exponents[0]->data_type, &ndim, dim_vals, &exponents[0]->data,
+        nadd > 0 ? READ_DATA : DEFER_DATA)) {
+        if (nadd > 0) free(add_id);
         cgi_error("Error reading '%s'",exponents[0]->name);
         return 1;
     }
     if (strcmp(exponents[0]->data_type,"R4") &&
         strcmp(exponents[0]->data_type,"R8")) {
+        if (nadd > 0) free(add_id);
         cgi_error("Wrong Data Type in '%s'",exponents[0]->name);
         return 1;
     }
     if (ndim != 1 || dim_vals[0] != 5) {
+        if (nadd > 0) free(add_id);
         cgi_error("Wrong dimensions in '%s'",exponents[0]->name);
         return 1;
     }
     exponents[0]->nexps = 5;
 
-    if (cgi_get_nodes(exponents[0]->id, "AdditionalExponents_t", &nnod, &id))
-        return 1;
-    if (nnod > 0) {
+    if (nadd > 0) {
         int ierr;
         char_33 data_type, name;
         void *data;
-        ierr = cgi_read_node(id[0], name, data_type, &ndim, dim_vals,
+        ierr = cgi_read_node(add_id[0], name, data_type, &ndim, dim_vals,
                              &data, READ_DATA);
-        free(id);
+        free(add_id);
         if (ierr) {
             cgi_error("Error reading AdditionalExponents for 's'",
                 exponents[0]->name);
@@ -5202,6 +5281,22 @@ int cgi_read_node(double node_id, char_33 name, char_33 data_type,
     else if (strcmp(data_type,"R8")==0) data[0]=CGNS_NEW(double, size);
     else if (strcmp(data_type,"C1")==0) data[0]=CGNS_NEW(char, size+1);
 
+     /* put off reading the data until the whole file has been read */
+    if (data_flag == DEFER_DATA && defer_reads) {
+        if (num_deferred == max_deferred) {
+            max_deferred += 256;
+            deferred = (cgio_read_t *)cgi_realloc(deferred,
+                max_deferred * sizeof(cgio_read_t));
+        }
+        deferred[num_deferred].id = node_id;
+        deferred[num_deferred].b_start = 0;
+        deferred[num_deferred].b_end = 0;
+        deferred[num_deferred].data = data[0];
+        deferred[num_deferred].err = 0;
+        num_deferred++;
+        return 0;
+    }
+
      /* read data */
     if (cgio_read_all_data(cg->cgio, node_id, data[0])) {
         cg_io_error("cgio_read_all_data");
@@ -5562,6 +5657,234 @@ int cgi_convert_data(cgsize_t cnt,
     return ierr;
 }
 
+/***********************************************************************\
+ *       Strided (hyperslab) transfer of DataArray_t data              *
+\***********************************************************************/
+
+int cgi_general_range(int s_numdim, const cgsize_t *s_dimvals,
+                      const cgsize_t *s_rmin, const cgsize_t *s_rmax,
+                      const cgsize_t *s_stride, int m_numdim,
+                      const cgsize_t *m_dimvals, const cgsize_t *m_rmin,
+                      const cgsize_t *m_rmax, const cgsize_t *m_stride,
+                      cgsize_t *s_str, cgsize_t *m_str, cgsize_t *numpt)
+{
+    int n;
+    cgsize_t s_numpt = 1, m_numpt = 1;
+
+    if (s_rmin == NULL || s_rmax == NULL || m_dimvals == NULL ||
+        m_rmin == NULL || m_rmax == NULL) {
+        cgi_error("NULL range value.");
+        return 1;
+    }
+    if (m_numdim < 1 || m_numdim > CGIO_MAX_DIMENSIONS) {
+        cgi_error("Invalid number of dimensions in memory array: %d",
+            m_numdim);
+        return 1;
+    }
+
+     /* a NULL stride selects every point */
+    for (n = 0; n < s_numdim; n++) {
+        s_str[n] = s_stride == NULL ? 1 : s_stride[n];
+        if (s_rmin[n] > s_rmax[n] || s_rmin[n] < 1 ||
+            s_rmax[n] > s_dimvals[n] || s_str[n] < 1) {
+            cgi_error("Invalid range of data requested");
+            return 1;
+        }
+        s_numpt *= (s_rmax[n] - s_rmin[n]) / s_str[n] + 1;
+    }
+    for (n = 0; n < m_numdim; n++) {
+        m_str[n] = m_stride == NULL ? 1 : m_stride[n];
+        if (m_rmin[n] > m_rmax[n] || m_rmin[n] < 1 ||
+            m_rmax[n] > m_dimvals[n] || m_str[n] < 1) {
+            cgi_error("Invalid range of memory array provided");
+            return 1;
+        }
+        m_numpt *= (m_rmax[n] - m_rmin[n]) / m_str[n] + 1;
+    }
+    if (s_numpt != m_numpt) {
+        cgi_error("Number of locations in range of memory array (%ld) "
+                  "do not match number of locations requested in range "
+                  "of file (%ld)", (long)m_numpt, (long)s_numpt);
+        return 1;
+    }
+    *numpt = s_numpt;
+    return 0;
+}
+
+/* copy a contiguous buffer into a hyperslab of a (Fortran ordered)
+   memory array */
+
+static void cgi_scatter_data(int size, cgsize_t numpt, const void *from,
+                             int m_numdim, const cgsize_t *m_dimvals,
+                             const cgsize_t *m_rmin, const cgsize_t *m_rmax,
+                             const cgsize_t *m_str, void *to)
+{
+    int n;
+    cgsize_t i, off, cnt[CGIO_MAX_DIMENSIONS], pos[CGIO_MAX_DIMENSIONS];
+    cgsize_t len[CGIO_MAX_DIMENSIONS];
+    const char *src = (const char *)from;
+    char *dest = (char *)to;
+
+    len[0] = 1;
+    for (n = 1; n < m_numdim; n++)
+        len[n] = len[n-1] * m_dimvals[n-1];
+    for (n = 0; n < m_numdim; n++) {
+        cnt[n] = (m_rmax[n] - m_rmin[n]) / m_str[n] + 1;
+        pos[n] = 0;
+    }
+
+    for (i = 0; i < numpt; i++) {
+        off = 0;
+        for (n = 0; n < m_numdim; n++)
+            off += (m_rmin[n] - 1 + pos[n] * m_str[n]) * len[n];
+        memcpy(dest + off * size, src + i * size, size);
+        for (n = 0; n < m_numdim; n++) {
+            if (++pos[n] < cnt[n]) break;
+            pos[n] = 0;
+        }
+    }
+}
+
+int cgi_array_general_read(cgns_array *array, CGNS_ENUMT(DataType_t) type,
+                           const cgsize_t *s_rmin, const cgsize_t *s_rmax,
+                           const cgsize_t *s_stride, int m_numdim,
+                           const cgsize_t *m_dimvals, const cgsize_t *m_rmin,
+                           const cgsize_t *m_rmax, const cgsize_t *m_stride,
+                           void *data)
+{
+    int n, contiguous = 1, ierr;
+    cgsize_t numpt, one = 1;
+    cgsize_t s_str[CGIO_MAX_DIMENSIONS], m_str[CGIO_MAX_DIMENSIONS];
+    char_33 data_type;
+    void *values, *conv;
+
+    if (cgi_general_range(array->data_dim, array->dim_vals, s_rmin, s_rmax,
+            s_stride, m_numdim, m_dimvals, m_rmin, m_rmax, m_stride,
+            s_str, m_str, &numpt)) return 1;
+
+     /* quick transfer of data if same data types */
+    if (type == cgi_datatype(array->data_type)) {
+        if (cgio_read_data(cg->cgio, array->id, s_rmin, s_rmax, s_str,
+                m_numdim, m_dimvals, m_rmin, m_rmax, m_str, data)) {
+            cg_io_error("cgio_read_data");
+            return 1;
+        }
+        return 0;
+    }
+
+     /* otherwise read contiguous, convert, then scatter */
+    values = malloc((size_t)(numpt*size_of(array->data_type)));
+    if (values == NULL) {
+        cgi_error("Error allocating values");
+        return 1;
+    }
+    if (cgio_read_data(cg->cgio, array->id, s_rmin, s_rmax, s_str,
+            1, &numpt, &one, &numpt, &one, values)) {
+        free(values);
+        cg_io_error("cgio_read_data");
+        return 1;
+    }
+    for (n = 0; n < m_numdim; n++) {
+        if (m_rmin[n] != 1 || m_rmax[n] != m_dimvals[n] || m_str[n] != 1) {
+            contiguous = 0;
+            break;
+        }
+    }
+    if (contiguous) {
+        ierr = cgi_convert_data(numpt, cgi_datatype(array->data_type),
+                   values, type, data);
+        free(values);
+        return ierr;
+    }
+    strcpy(data_type, cgi_adf_datatype(type));
+    n = size_of(data_type);
+    conv = malloc((size_t)(numpt*n));
+    if (conv == NULL) {
+        free(values);
+        cgi_error("Error allocating values");
+        return 1;
+    }
+    ierr = cgi_convert_data(numpt, cgi_datatype(array->data_type),
+               values, type, conv);
+    free(values);
+    if (!ierr)
+        cgi_scatter_data(n, numpt, conv, m_numdim, m_dimvals, m_rmin,
+            m_rmax, m_str, data);
+    free(conv);
+    return ierr;
+}
+
+int cgi_array_indexed_read(cgns_array *array, CGNS_ENUMT(DataType_t) type,
+                           cgsize_t num, const cgsize_t *indices, void *data)
+{
+    int n, ierr;
+    cgsize_t i, npts = 1;
+    void *values;
+
+    for (n = 0; n < array->data_dim; n++)
+        npts *= array->dim_vals[n];
+    for (i = 0; i < num; i++) {
+        if (indices[i] < 1 || indices[i] > npts) {
+            cgi_error("Invalid index of data requested");
+            return 1;
+        }
+    }
+    if (num < 1) return 0;
+
+     /* quick transfer of data if same data types */
+    if (type == cgi_datatype(array->data_type)) {
+        if (cgio_read_indices(cg->cgio, array->id, num, indices, data)) {
+            cg_io_error("cgio_read_indices");
+            return 1;
+        }
+        return 0;
+    }
+
+     /* otherwise read into temp array to convert data */
+    values = malloc((size_t)(num*size_of(array->data_type)));
+    if (values == NULL) {
+        cgi_error("Error allocating values");
+        return 1;
+    }
+    if (cgio_read_indices(cg->cgio, array->id, num, indices, values)) {
+        free(values);
+        cg_io_error("cgio_read_indices");
+        return 1;
+    }
+    ierr = cgi_convert_data(num, cgi_datatype(array->data_type),
+               values, type, data);
+    free(values);
+    return ierr;
+}
+
+int cgi_array_general_write(double parent_id, cgns_array *array,
+                            const cgsize_t *s_rmin, const cgsize_t *s_rmax,
+                            const cgsize_t *s_stride, int m_numdim,
+                            const cgsize_t *m_dimvals, const cgsize_t *m_rmin,
+                            const cgsize_t *m_rmax, const cgsize_t *m_stride,
+                            const void *data)
+{
+    cgsize_t numpt;
+    cgsize_t s_str[CGIO_MAX_DIMENSIONS], m_str[CGIO_MAX_DIMENSIONS];
+
+    if (cgi_general_range(array->data_dim, array->dim_vals, s_rmin, s_rmax,
+            s_stride, m_numdim, m_dimvals, m_rmin, m_rmax, m_stride,
+            s_str, m_str, &numpt)) return 1;
+
+     /* create the node (without data) if not yet on disk */
+    if (array->id == 0 &&
+        cgi_new_node_partial(parent_id, array->name, "DataArray_t",
+            &array->id, array->data_type, array->data_dim, array->dim_vals,
+            s_rmin, s_rmax, NULL)) return 1;
+
+    if (cgio_write_data(cg->cgio, array->id, s_rmin, s_rmax, s_str,
+            m_numdim, m_dimvals, m_rmin, m_rmax, m_str, data)) {
+        cg_io_error("cgio_write_data");
+        return 1;
+    }
+    return 0;
+}
+
 /***********************************************************************\
  *       Write a CGNS file from in-memory data             *
 \***********************************************************************/
@@ -7568,6 +7891,69 @@ int cgi_new_node(double parent_id, char const *name, char const *label,
  * It will write data for a subset of dim_vals based on rmin and rmax
  * using ADF_Write_Data(..).
 */
+int cgi_new_node_async(int B, int Z, int S, int index, double parent_id,
+                       char const *name, char const *label,
+                       char const *data_type, int ndim,
+                       cgsize_t const *dim_vals, void const *data)
+{
+    cgns_async *async;
+
+     /* verify input */
+    if (cgi_check_strlen(name) || cgi_check_strlen(label) ||
+        cgi_check_strlen(data_type)) return 1;
+
+    async = CGNS_NEW(cgns_async, 1);
+    async->B = B;
+    async->Z = Z;
+    async->S = S;
+    async->index = index;
+
+     /* the node id is filled in by the I/O thread */
+    if (cgio_new_node_async(cg->cgio, parent_id, name, label, data_type,
+            ndim, dim_vals, (void *)data, NULL, &async->id)) {
+        free(async);
+        cg_io_error("cgio_new_node_async");
+        return 1;
+    }
+    async->next = cg->async;
+    cg->async = async;
+    (cg->added)++;
+    return 0;
+}
+
+int cgi_async_wait(cgns_file *cg)
+{
+    int ierr;
+    cgns_async *async, *next;
+    cgns_array *array;
+    cgns_zcoor *zcoor;
+
+    ierr = cgio_wait(cg->cgio);
+
+     /* copy the node ids into the in-memory arrays */
+    for (async = cg->async; async; async = next) {
+        next = async->next;
+        array = 0;
+        if (async->S)
+            array = cgi_get_field(cg, async->B, async->Z, async->S,
+                                  async->index);
+        else {
+            zcoor = cgi_get_zcoorGC(cg, async->B, async->Z);
+            if (zcoor && async->index > 0 && async->index <= zcoor->ncoords)
+                array = &zcoor->coord[async->index-1];
+        }
+        if (array) array->id = async->id;
+        free(async);
+    }
+    cg->async = 0;
+
+    if (ierr) {
+        cg_io_error("cgio_wait");
+        return 1;
+    }
+    return 0;
+}
+
 int cgi_new_node_partial(double parent_id, char const *name, char const *label,
                          double *node_id, char const *data_type, int ndim,
                          cgsize_t const *dim_vals, cgsize_t const *rmin,
@@ -7862,6 +8248,17 @@ int cgi_check_mode(char const *filename, int file_mode, int mode_wanted)
         cgi_error("File %s not open for writing", filename);
         return 1;
     }
+    /* CG_MODE_APPEND as mode_wanted is a read of something kept in the
+       lightweight index built for CG_MODE_APPEND */
+    if (mode_wanted==CG_MODE_APPEND && file_mode==CG_MODE_WRITE) {
+        cgi_error("File %s not open for reading", filename);
+        return 1;
+    }
+    if (mode_wanted==CG_MODE_READ && file_mode==CG_MODE_APPEND) {
+        cgi_error("File %s opened in append mode; use modify mode to read",
+            filename);
+        return 1;
+    }
     return 0;
 }
 
@@ -7972,7 +8369,7 @@ cgsize_t cgi_element_data_size(CGNS_ENUMT(ElementType_t) type,
  *       Get the memory address of a data structure        *
 \***********************************************************************/
 
-cgns_file *cgi_get_file(int file_number)
+cgns_file *cgi_find_file(int file_number)
 {
     int filenum = file_number - file_number_offset;
     if (filenum <= 0 || filenum > n_cgns_files) {
@@ -7987,6 +8384,15 @@ cgns_file *cgi_get_file(int file_number)
     return cg;
 }
 
+cgns_file *cgi_get_file(int file_number)
+{
+    if (cgi_find_file(file_number) == 0) return 0;
+
+     /* complete any write-behind arrays before the tree is used */
+    if (cg->async && cgi_async_wait(cg)) return 0;
+    return cg;
+}
+
 cgns_base *cgi_get_base(cgns_file *cg, int B)
 {
     if (B>cg->nbases || B<=0) {
@@ -8167,6 +8573,15 @@ cgns_sol *cgi_get_sol(cgns_file *cg, int B, int Z, int S)
         cgi_error("FlowSolution node number %d invalid",S);
         return 0;
     }
+
+     /* complete a FlowSolution_t only indexed by name in CG_MODE_APPEND */
+    if (zone->sol[S-1].indexed) {
+        int n;
+        Idim = zone->index_dim;
+        for (n=0; n<Idim*3; n++) CurrentDim[n] = zone->nijk[n];
+        if (cgi_read_sol_node(&zone->sol[S-1])) return 0;
+        zone->sol[S-1].indexed = 0;
+    }
     return &(zone->sol[S-1]);
 }
 
@@ -8788,6 +9203,9 @@ static int cgi_next_posit(char *label, int index, char *name)
                 }
             }
             if (index >= 0 && index < z->nsols) {
+                if (z->sol[index].indexed &&
+                    cgi_get_sol(cg, posit_base, posit_zone, index + 1) == 0)
+                    return CG_ERROR;
                 return cgi_add_posit((void *)&z->sol[index],
                            label, index + 1, z->sol[index].id);
             }
@@ -10591,7 +11009,8 @@ char *cgi_famname_address(int local_mode, int *ier)
         (*ier) = CG_INCORRECT_PATH;
         return 0;
     }
-    if (cg->mode == CG_MODE_MODIFY && local_mode == CG_MODE_WRITE) {
+    if ((cg->mode == CG_MODE_MODIFY || cg->mode == CG_MODE_APPEND) &&
+        local_mode == CG_MODE_WRITE) {
         if (cgi_get_nodes(parent_id, "FamilyName_t", &nnod, &id)) {
             *ier = CG_ERROR;
             return 0;
@@ -10697,7 +11116,8 @@ CGNS_ENUMV(DataClass_t) *cgi_dataclass_address(int local_mode, int *ier)
         (*ier) = CG_INCORRECT_PATH;
         return 0;
     }
-    if (cg->mode == CG_MODE_MODIFY && local_mode == CG_MODE_WRITE) {
+    if ((cg->mode == CG_MODE_MODIFY || cg->mode == CG_MODE_APPEND) &&
+        local_mode == CG_MODE_WRITE) {
         if (cgi_get_nodes(parent_id, "DataClass_t", &nnod, &id)) return 0;
         if (nnod>0) {
             if (cgi_delete_node (parent_id, id[0])) {
@@ -10859,7 +11279,8 @@ int *cgi_ordinal_address(int local_mode, int *ier)
         (*ier) = CG_INCORRECT_PATH;
         return 0;
     }
-    if (cg->mode == CG_MODE_MODIFY && local_mode == CG_MODE_WRITE) {
+    if ((cg->mode == CG_MODE_MODIFY || cg->mode == CG_MODE_APPEND) &&
+        local_mode == CG_MODE_WRITE) {
         if (cgi_get_nodes(parent_id, "Ordinal_t", &nnod, &id)) return 0;
         if (nnod>0) {
             if (cgi_delete_node (parent_id, id[0])) {
@@ -10928,7 +11349,8 @@ int *cgi_rind_address(int local_mode, int *ier)
         (*ier) = CG_NODE_NOT_FOUND;
         return 0;
     }
-    if (parent_id && cg->mode==CG_MODE_MODIFY) {
+    if (parent_id &&
+        (cg->mode==CG_MODE_MODIFY || cg->mode==CG_MODE_APPEND)) {
         if (cgi_get_nodes(parent_id, "Rind_t", &nnod, &id)) return 0;
         if (nnod>0) {
             if (cgi_delete_node (parent_id, id[0])) {
@@ -10981,7 +11403,8 @@ CGNS_ENUMT(GridLocation_t) *cgi_location_address(int local_mode, int *ier)
         (*ier) = CG_INCORRECT_PATH;
         return 0;
     }
-    if (cg->mode == CG_MODE_MODIFY && local_mode == CG_MODE_WRITE) {
+    if ((cg->mode == CG_MODE_MODIFY || cg->mode == CG_MODE_APPEND) &&
+        local_mode == CG_MODE_WRITE) {
         if (cgi_get_nodes(parent_id, "GridLocation_t", &nnod, &id)) return 0;
         if (nnod>0) {
             if (cgi_delete_node (parent_id, id[0])) {
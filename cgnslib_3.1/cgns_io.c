@@ -22,6 +22,7 @@ freely, subject to the following restrictions:
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <stdarg.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #if defined(_WIN32) && !defined(__NUTC__)
@@ -34,22 +35,127 @@ freely, subject to the following restrictions:
 # define UNLINK unlink
 #endif
 #include <errno.h>
+#include <time.h>
+#ifndef _WIN32
+# define CGIO_ASYNC_THREADS
+# include <pthread.h>
+#endif
 
 #include "cgns_io.h"
 #include "adf/ADF.h"
 #ifdef BUILD_HDF5
 #include "adfh/ADFH.h"
 #endif
+#include "adfm/ADFM.h"
 #ifdef MEM_DEBUG
 #include "cg_malloc.h"
 #endif
 
+/* all of these file types are handled by the ADF library */
+
+#define IS_ADF(type) ((type) == CGIO_FILE_ADF || (type) == CGIO_FILE_ADF2 || \
+                      (type) == CGIO_FILE_ADF3)
+
+/* in a file search, any of the ADF types will do when one of them is wanted */
+
+#define SAME_TYPE(want, type) ((want) == (type) || \
+                               (IS_ADF(want) && IS_ADF(type)))
+
+/* cgio_copy_node copies data larger than this in blocks of this size,
+   so that copying a file doesn't need memory for its largest array */
+
+#define COPY_BLOCK_SIZE 4194304
+
+/* persistent node index (.cgidx) - node headers of an ADF file, saved in
+   breadth-first order so that the children of a node are contiguous.
+   Nodes are located by block and offset, which unlike the ID do not
+   depend on the order in which the files were opened */
+
+typedef struct {
+    cgulong_t block;
+    cgulong_t offset;
+    cglong_t dims[CGIO_MAX_DIMENSIONS];
+    int ndims;
+    int link_len;
+    int nchildren;
+    int children;
+    char name[CGIO_MAX_NAME_LENGTH+1];
+    char label[CGIO_MAX_LABEL_LENGTH+1];
+    char data_type[CGIO_MAX_DATATYPE_LENGTH+1];
+} cgio_index_node;
+
+typedef struct {
+    char magic[8];
+    int byte_order;
+    int node_size;
+    int nnodes;
+    int reserved;
+    cglong_t file_size;
+    cglong_t file_time;
+    cglong_t file_nsec;
+    cglong_t file_ctime;
+    cglong_t file_cnsec;
+    cglong_t file_ino;
+    char modified[CGIO_MAX_DATE_LENGTH+8];
+} cgio_index_head;
+
+typedef struct {
+    double id;
+    int node;
+} cgio_index_key;
+
+typedef struct {
+    cgio_index_head head;
+    cgio_index_node *nodes;
+    double *ids;
+    cgio_index_key *keys;
+} cgio_index;
+
 typedef struct {
     int type;
     int mode;
     double rootid;
+    int async_err;
+    char *filename;
+    cgio_index *index;
+    cgio_stats_t stats;
 } cgns_io;
 
+/* a call being timed, op is 0 when nothing is recorded */
+
+typedef struct {
+    int op;
+    int cgio_num;
+    cglong_t bytes;
+    double start;
+    int nested;
+    int recording;
+    int args_done;
+    char *record;
+    size_t record_len;
+    size_t record_size;
+    int out_type;
+    int *out_num;
+    void *out;
+} stats_call;
+
+/* queued request for cgio_new_node_async */
+
+typedef struct cgio_request_s {
+    struct cgio_request_s *next;
+    int cgio_num;
+    double pid;
+    char name[CGIO_MAX_NAME_LENGTH+1];
+    char label[CGIO_MAX_LABEL_LENGTH+1];
+    char data_type[CGIO_MAX_DATATYPE_LENGTH+1];
+    int ndims;
+    cgsize_t dims[CGIO_MAX_DIMENSIONS];
+    void *data;
+    void (*release)(void *);
+    double *id;
+    int record_seq;
+} cgio_request;
+
 static int num_open = 0;
 static int num_iolist = 0;
 static cgns_io *iolist;
@@ -77,13 +183,139 @@ static char *cgio_ErrorMessage[] = {
 
 #define get_error()  last_err
 
-static int last_err = CGIO_ERR_NONE;
-static int last_type = CGIO_FILE_NONE;
+/* the error is kept per thread, so that a failure in the I/O thread
+   doesn't overwrite the error of a call in the caller's thread */
+
+#ifdef CGIO_ASYNC_THREADS
+# define THREAD_LOCAL __thread
+#else
+# define THREAD_LOCAL
+#endif
+
+static THREAD_LOCAL int last_err = CGIO_ERR_NONE;
+static THREAD_LOCAL int last_type = CGIO_FILE_NONE;
 static int abort_on_error = 0;
 
+static int index_files = 0;
+
 static int cgio_n_paths = 0;
 static char **cgio_paths = 0;
 
+/* write-behind queue, serviced by a single I/O thread. Neither ADF
+   nor HDF5 is thread-safe, so any other cgio call waits for the
+   queue to drain before touching the file. */
+
+static cgio_request *async_head = NULL;
+static cgio_request *async_tail = NULL;
+#ifdef CGIO_ASYNC_THREADS
+static int async_running = 0;
+static int async_busy = 0;
+static int async_stop = 0;
+static pthread_t async_thread;
+static pthread_mutex_t async_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t async_work = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t async_done = PTHREAD_COND_INITIALIZER;
+#endif
+
+/* call statistics, indexed by op - 1 */
+
+enum {
+    STATS_OPEN_FILE = 1,
+    STATS_CLOSE_FILE,
+    STATS_COMPRESS_FILE,
+    STATS_COPY_FILE,
+    STATS_FLUSH_TO_DISK,
+    STATS_LIBRARY_VERSION,
+    STATS_FILE_VERSION,
+    STATS_CREATE_NODE,
+    STATS_NEW_NODE,
+    STATS_NEW_NODE_ASYNC,
+    STATS_DELETE_NODE,
+    STATS_MOVE_NODE,
+    STATS_COPY_NODE,
+    STATS_IS_LINK,
+    STATS_LINK_SIZE,
+    STATS_CREATE_LINK,
+    STATS_GET_LINK,
+    STATS_NUMBER_CHILDREN,
+    STATS_CHILDREN_IDS,
+    STATS_CHILDREN_NAMES,
+    STATS_GET_NODE_ID,
+    STATS_GET_NAME,
+    STATS_GET_LABEL,
+    STATS_GET_DATA_TYPE,
+    STATS_GET_DIMENSIONS,
+    STATS_READ_ALL_DATA,
+    STATS_READ_BLOCK_DATA,
+    STATS_READ_DATA,
+    STATS_READ_INDICES,
+    STATS_SET_NAME,
+    STATS_SET_LABEL,
+    STATS_SET_DIMENSIONS,
+    STATS_RESERVE_DATA,
+    STATS_WRITE_ALL_DATA,
+    STATS_WRITE_BLOCK_DATA,
+    STATS_WRITE_DATA,
+    STATS_WRITE_INDICES,
+    STATS_READ_BATCH,
+    STATS_EXTRACT_NODE,
+    STATS_NUM_OPS = STATS_EXTRACT_NODE
+};
+
+static const char *stats_names[STATS_NUM_OPS] = {
+    "cgio_open_file",
+    "cgio_close_file",
+    "cgio_compress_file",
+    "cgio_copy_file",
+    "cgio_flush_to_disk",
+    "cgio_library_version",
+    "cgio_file_version",
+    "cgio_create_node",
+    "cgio_new_node",
+    "cgio_new_node_async",
+    "cgio_delete_node",
+    "cgio_move_node",
+    "cgio_copy_node",
+    "cgio_is_link",
+    "cgio_link_size",
+    "cgio_create_link",
+    "cgio_get_link",
+    "cgio_number_children",
+    "cgio_children_ids",
+    "cgio_children_names",
+    "cgio_get_node_id",
+    "cgio_get_name",
+    "cgio_get_label",
+    "cgio_get_data_type",
+    "cgio_get_dimensions",
+    "cgio_read_all_data",
+    "cgio_read_block_data",
+    "cgio_read_data",
+    "cgio_read_indices",
+    "cgio_set_name",
+    "cgio_set_label",
+    "cgio_set_dimensions",
+    "cgio_reserve_data",
+    "cgio_write_all_data",
+    "cgio_write_block_data",
+    "cgio_write_data",
+    "cgio_write_indices",
+    "cgio_read_batch",
+    "cgio_extract_node"
+};
+
+static int stats_enabled = 0;
+static cgio_stats_t stats_ops[STATS_NUM_OPS];
+static FILE *stats_trace = NULL;
+static int stats_events = 0;
+static double stats_epoch = 0.0;
+static FILE *record_file = NULL;
+static int record_depth = 0;
+static int record_seq = 0;
+#ifdef CGIO_ASYNC_THREADS
+static pthread_mutex_t stats_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
 /*=========================================================
  * support routines
  *=========================================================*/
@@ -95,8 +327,107 @@ static int set_error (int errcode)
     return last_err;
 }
 
+static void async_execute (cgio_request *req)
+{
+    double id;
+    cgns_io *cgio = &iolist[req->cgio_num-1];
+
+    if (cgio_new_node(req->cgio_num, req->pid, req->name, req->label,
+            req->data_type, req->ndims, req->dims, req->data, &id)) {
+        if (cgio->async_err == CGIO_ERR_NONE)
+            cgio->async_err = get_error();
+    }
+    else {
+        *req->id = id;
+        /* ties the ID to its cgio_new_node_async in the record */
+        if (req->record_seq) {
+#ifdef CGIO_ASYNC_THREADS
+            pthread_mutex_lock(&stats_mutex);
+#endif
+            if (record_file != NULL)
+                fprintf(record_file, "async_id 0 %d %.17g\n",
+                    req->record_seq, id);
+#ifdef CGIO_ASYNC_THREADS
+            pthread_mutex_unlock(&stats_mutex);
+#endif
+        }
+    }
+    if (req->release != NULL)
+        (*req->release)(req->data);
+    else
+        free(req->data);
+    free(req);
+}
+
+#ifdef CGIO_ASYNC_THREADS
+
+static void *async_worker (void *arg)
+{
+    cgio_request *req;
+#ifdef BUILD_HDF5
+    int ierr;
+
+    ADFH_Configure(ADFH_CONFIG_THREAD, NULL, &ierr);
+#endif
+
+    pthread_mutex_lock(&async_mutex);
+    for (;;) {
+        while (async_head == NULL && !async_stop)
+            pthread_cond_wait(&async_work, &async_mutex);
+        if (async_head == NULL) break;
+        req = async_head;
+        async_head = req->next;
+        if (async_head == NULL) async_tail = NULL;
+        async_busy = 1;
+        pthread_mutex_unlock(&async_mutex);
+        async_execute(req);
+        pthread_mutex_lock(&async_mutex);
+        async_busy = 0;
+        pthread_cond_broadcast(&async_done);
+    }
+    pthread_mutex_unlock(&async_mutex);
+    return arg;
+}
+
+static void async_shutdown (void)
+{
+    if (!async_running) return;
+    pthread_mutex_lock(&async_mutex);
+    async_stop = 1;
+    pthread_cond_signal(&async_work);
+    pthread_mutex_unlock(&async_mutex);
+    pthread_join(async_thread, NULL);
+    async_running = async_stop = 0;
+}
+
+#endif
+
+/* wait until the I/O thread has finished all queued requests */
+
+static void async_drain (void)
+{
+#ifdef CGIO_ASYNC_THREADS
+    if (!async_running || pthread_equal(pthread_self(), async_thread))
+        return;
+    pthread_mutex_lock(&async_mutex);
+    while (async_head != NULL || async_busy)
+        pthread_cond_wait(&async_done, &async_mutex);
+    pthread_mutex_unlock(&async_mutex);
+#else
+    cgio_request *req;
+    while ((req = async_head) != NULL) {
+        async_head = req->next;
+        async_execute(req);
+    }
+    async_tail = NULL;
+#endif
+}
+
+/*---------------------------------------------------------*/
+
 static cgns_io *get_cgnsio (int cgio_num, int write)
 {
+    async_drain();
     if (--cgio_num < 0 || cgio_num >= num_iolist) {
         last_err = CGIO_ERR_BAD_CGIO;
         return NULL;
@@ -112,6 +443,287 @@ static cgns_io *get_cgnsio (int cgio_num, int write)
 
 /*---------------------------------------------------------*/
 
+#define INDEX_MAGIC  "CGIDX02"
+#define INDEX_SUFFIX ".cgidx"
+
+static void index_free (cgio_index *index)
+{
+    if (index == NULL) return;
+    if (index->nodes) free(index->nodes);
+    if (index->ids) free(index->ids);
+    if (index->keys) free(index->keys);
+    free(index);
+}
+
+/* the seconds in st_mtime and st_ctime are too coarse to notice a
+   change made just after the index was written, so the nanoseconds and
+   the inode are kept as well where the system has them */
+
+#if defined(_WIN32)
+# define STAT_MNSEC(st) 0
+# define STAT_CNSEC(st) 0
+#elif defined(__APPLE__)
+# define STAT_MNSEC(st) (st).st_mtimespec.tv_nsec
+# define STAT_CNSEC(st) (st).st_ctimespec.tv_nsec
+#else
+# define STAT_MNSEC(st) (st).st_mtim.tv_nsec
+# define STAT_CNSEC(st) (st).st_ctim.tv_nsec
+#endif
+
+static void index_stat_copy (const struct stat *st, cgio_index_head *head)
+{
+    head->file_size = (cglong_t)st->st_size;
+    head->file_time = (cglong_t)st->st_mtime;
+    head->file_nsec = (cglong_t)STAT_MNSEC(*st);
+    head->file_ctime = (cglong_t)st->st_ctime;
+    head->file_cnsec = (cglong_t)STAT_CNSEC(*st);
+    head->file_ino = (cglong_t)st->st_ino;
+}
+
+static int index_stat (const char *filename, cgio_index_head *head)
+{
+    struct stat st;
+
+    if (stat(filename, &st)) return 1;
+    index_stat_copy(&st, head);
+    return 0;
+}
+
+static int index_compare (const void *v1, const void *v2)
+{
+    double id1 = ((const cgio_index_key *)v1)->id;
+    double id2 = ((const cgio_index_key *)v2)->id;
+
+    return id1 < id2 ? -1 : (id1 > id2 ? 1 : 0);
+}
+
+/*---------------------------------------------------------*/
+
+/* read the index of an ADF file opened for reading; returns NULL if
+   there is none or if the file has changed since it was written */
+
+static cgio_index *index_load (cgns_io *cgio)
+{
+    int n, ierr;
+    char *idxname, version[CGIO_MAX_VERSION_LENGTH+1];
+    char created[CGIO_MAX_DATE_LENGTH+1], modified[CGIO_MAX_DATE_LENGTH+1];
+    cgio_index_head head, file, idx;
+    cgio_index *index;
+    struct stat st;
+    FILE *fp;
+
+    idxname = (char *) malloc (strlen(cgio->filename) + 7);
+    if (idxname == NULL) return NULL;
+    sprintf(idxname, "%s%s", cgio->filename, INDEX_SUFFIX);
+    fp = fopen(idxname, "rb");
+    free(idxname);
+    if (fp == NULL) return NULL;
+
+    if (fread(&head, sizeof(cgio_index_head), 1, fp) != 1 ||
+        strcmp(head.magic, INDEX_MAGIC) || head.byte_order != 1 ||
+        head.node_size != (int)sizeof(cgio_index_node) || head.nnodes < 1) {
+        fclose(fp);
+        return NULL;
+    }
+
+    /* check that the file has not changed since it was indexed. A file
+       changed in the same clock tick as the index was written would
+       look the same, so the index must also be newer than the file */
+    ADF_Database_Version(cgio->rootid, version, created, modified, &ierr);
+    if (ierr > 0 || strcmp(modified, head.modified) ||
+        index_stat(cgio->filename, &file) ||
+        file.file_size != head.file_size ||
+        file.file_time != head.file_time ||
+        file.file_nsec != head.file_nsec ||
+        file.file_ctime != head.file_ctime ||
+        file.file_cnsec != head.file_cnsec ||
+        file.file_ino != head.file_ino ||
+        fstat(fileno(fp), &st)) {
+        fclose(fp);
+        return NULL;
+    }
+    index_stat_copy(&st, &idx);
+    if (idx.file_time < file.file_ctime || (idx.file_time ==
+        file.file_ctime && idx.file_nsec <= file.file_cnsec)) {
+        fclose(fp);
+        return NULL;
+    }
+
+    index = (cgio_index *) calloc (1, sizeof(cgio_index));
+    if (index == NULL) {
+        fclose(fp);
+        return NULL;
+    }
+    index->head = head;
+    index->nodes = (cgio_index_node *) malloc (head.nnodes *
+                       sizeof(cgio_index_node));
+    index->ids = (double *) malloc (head.nnodes * sizeof(double));
+    index->keys = (cgio_index_key *) malloc (head.nnodes *
+                      sizeof(cgio_index_key));
+    if (index->nodes == NULL || index->ids == NULL || index->keys == NULL ||
+        fread(index->nodes, sizeof(cgio_index_node), head.nnodes, fp) !=
+            (size_t)head.nnodes) {
+        fclose(fp);
+        index_free(index);
+        return NULL;
+    }
+    fclose(fp);
+
+    /* the IDs depend on the file index, so regenerate them */
+    for (n = 0; n < head.nnodes; n++) {
+        if (index->nodes[n].children < 0 || index->nodes[n].nchildren < 0 ||
+            index->nodes[n].children + index->nodes[n].nchildren >
+                head.nnodes) {
+            index_free(index);
+            return NULL;
+        }
+        ADF_Get_Location_ID(cgio->rootid, index->nodes[n].block,
+            index->nodes[n].offset, &index->ids[n], &ierr);
+        if (ierr > 0) {
+            index_free(index);
+            return NULL;
+        }
+        index->keys[n].id = index->ids[n];
+        index->keys[n].node = n;
+    }
+    qsort(index->keys, head.nnodes, sizeof(cgio_index_key), index_compare);
+    return index;
+}
+
+/*---------------------------------------------------------*/
+
+/* walk the tree of an ADF file and collect the node headers */
+
+static cgio_index *index_build (cgns_io *cgio)
+{
+    int n, nc, num, ierr;
+    int nnodes = 1, maxnodes = 64;
+    char version[CGIO_MAX_VERSION_LENGTH+1];
+    char created[CGIO_MAX_DATE_LENGTH+1];
+    cgsize_t dims[CGIO_MAX_DIMENSIONS];
+    double *ids;
+    cgio_index_node *node;
+    cgio_index *index;
+
+    index = (cgio_index *) calloc (1, sizeof(cgio_index));
+    if (index == NULL) return NULL;
+    index->nodes = (cgio_index_node *) malloc (maxnodes *
+                       sizeof(cgio_index_node));
+    index->ids = (double *) malloc (maxnodes * sizeof(double));
+    if (index->nodes == NULL || index->ids == NULL) {
+        index_free(index);
+        return NULL;
+    }
+    ADF_Database_Version(cgio->rootid, version, created,
+        index->head.modified, &ierr);
+    if (ierr > 0) {
+        index_free(index);
+        return NULL;
+    }
+    index->ids[0] = cgio->rootid;
+
+    for (n = 0; n < nnodes; n++) {
+        node = &index->nodes[n];
+        memset(node, 0, sizeof(cgio_index_node));
+        ADF_Get_Node_Location(index->ids[n], &node->block,
+            &node->offset, &ierr);
+        if (ierr <= 0) ADF_Get_Name(index->ids[n], node->name, &ierr);
+        if (ierr <= 0) ADF_Is_Link(index->ids[n], &node->link_len, &ierr);
+        if (ierr > 0) break;
+        node->children = nnodes;
+
+        /* only the name of a link is kept, the rest is in another file */
+        if (node->link_len) continue;
+
+        ADF_Get_Label(index->ids[n], node->label, &ierr);
+        if (ierr <= 0) ADF_Get_Data_Type(index->ids[n], node->data_type, &ierr);
+        if (ierr <= 0) ADF_Get_Number_of_Dimensions(index->ids[n],
+                           &node->ndims, &ierr);
+        if (ierr <= 0 && node->ndims > 0) {
+            ADF_Get_Dimension_Values(index->ids[n], dims, &ierr);
+            for (nc = 0; nc < node->ndims; nc++)
+                node->dims[nc] = (cglong_t)dims[nc];
+        }
+        if (ierr <= 0) ADF_Number_of_Children(index->ids[n], &num, &ierr);
+        if (ierr > 0) break;
+        if (num < 1) continue;
+
+        if (nnodes + num > maxnodes) {
+            while (nnodes + num > maxnodes) maxnodes *= 2;
+            node = (cgio_index_node *) realloc (index->nodes,
+                       maxnodes * sizeof(cgio_index_node));
+            if (node == NULL) break;
+            index->nodes = node;
+            ids = (double *) realloc (index->ids, maxnodes * sizeof(double));
+            if (ids == NULL) break;
+            index->ids = ids;
+            node = &index->nodes[n];
+        }
+        ADF_Children_IDs(index->ids[n], 1, num, &nc, &index->ids[nnodes],
+            &ierr);
+        if (ierr > 0 || nc != num) break;
+        node->nchildren = num;
+        nnodes += num;
+    }
+    if (n < nnodes) {
+        index_free(index);
+        return NULL;
+    }
+    index->head.nnodes = nnodes;
+    return index;
+}
+
+/*---------------------------------------------------------*/
+
+/* write the index next to the file, once the file has been closed */
+
+static void index_write (const char *filename, cgio_index *index)
+{
+    int ok;
+    char *idxname, *tmpname;
+    FILE *fp;
+
+    strcpy(index->head.magic, INDEX_MAGIC);
+    index->head.byte_order = 1;
+    index->head.node_size = (int)sizeof(cgio_index_node);
+    if (index_stat(filename, &index->head)) return;
+
+    idxname = (char *) malloc (2 * strlen(filename) + 20);
+    if (idxname == NULL) return;
+    tmpname = idxname + strlen(filename) + 8;
+    sprintf(idxname, "%s%s", filename, INDEX_SUFFIX);
+    sprintf(tmpname, "%s%s.tmp", filename, INDEX_SUFFIX);
+
+    /* write to a temporary file so a reader never sees a partial index */
+    if ((fp = fopen(tmpname, "wb")) != NULL) {
+        ok = fwrite(&index->head, sizeof(cgio_index_head), 1, fp) == 1 &&
+             fwrite(index->nodes, sizeof(cgio_index_node),
+                 index->head.nnodes, fp) == (size_t)index->head.nnodes;
+        if (fclose(fp)) ok = 0;
+        if (ok && rename(tmpname, idxname)) {
+            UNLINK(idxname);
+            ok = rename(tmpname, idxname) == 0;
+        }
+        if (!ok) UNLINK(tmpname);
+    }
+    free(idxname);
+}
+
+/*---------------------------------------------------------*/
+
+static cgio_index_node *index_node (cgns_io *cgio, double id)
+{
+    cgio_index_key key, *found;
+
+    if (cgio->index == NULL) return NULL;
+    key.id = id;
+    found = (cgio_index_key *) bsearch(&key, cgio->index->keys,
+                cgio->index->head.nnodes, sizeof(cgio_index_key),
+                index_compare);
+    return found == NULL ? NULL : &cgio->index->nodes[found->node];
+}
+/*---------------------------------------------------------*/
+
 static cglong_t compute_data_size (const char *data_type,
     int ndims, const cgsize_t *dims)
 {
@@ -124,13 +736,435 @@ static cglong_t compute_data_size (const char *data_type,
 
 /*---------------------------------------------------------*/
 
+/* call statistics and trace. A call is timed from entry to return,
+   so calls made by another cgio call (cgio_copy_file, for one) are
+   counted both on their own and in the time of the outer call */
+
+static double stats_clock (void)
+{
+#ifdef _WIN32
+    return (double)clock() / (double)CLOCKS_PER_SEC;
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + 1.0e-9 * (double)ts.tv_nsec;
+#endif
+}
+
+/* the record of a call is one line: the entry point, the error code,
+   the arguments and, after a ';', what the call returned. Strings have
+   white space and '%' written as %XX, vectors are preceded by their
+   length, and file numbers and IDs are those of the recording run */
+
+static int record_grow (stats_call *call, size_t bytes)
+{
+    char *record;
+    size_t size;
+
+    if (call->record_len + bytes < call->record_size) return 0;
+    size = call->record_size + bytes + 256;
+    record = (char *) realloc (call->record, size);
+    if (record == NULL) {
+        call->recording = 0;
+        return 1;
+    }
+    call->record = record;
+    call->record_size = size;
+    return 0;
+}
+
+/* the format has one character per value: f is a file number, i an
+   int, l a cglong_t, d an ID, s a string, v an int count and that many
+   cgsize_t, and D an int count and that many IDs. The values after a
+   '>' are pointers to what the call returns: f an int, d an ID, and D
+   an int count and the IDs, written out when the call succeeds */
+
+static void record_args (stats_call *call, const char *format, ...)
+{
+    va_list args;
+    const char *s;
+    const cgsize_t *v = NULL;
+    const double *d = NULL;
+    int n, i;
+
+    if (!call->recording) return;
+    va_start(args, format);
+    for (; *format && *format != '>' && call->recording; format++) {
+        if (*format == 's') {
+            s = va_arg(args, const char *);
+            if (s == NULL) s = "";
+            if (record_grow(call, 3 * strlen(s) + 4)) break;
+            call->record[call->record_len++] = ' ';
+            if (!*s) call->record[call->record_len++] = '%';
+            for (; *s; s++) {
+                if (isgraph((unsigned char)*s) && *s != '%')
+                    call->record[call->record_len++] = *s;
+                else {
+                    sprintf(&call->record[call->record_len], "%%%02X",
+                        (unsigned char)*s);
+                    call->record_len += 3;
+                }
+            }
+            call->record[call->record_len] = 0;
+            continue;
+        }
+        if (*format == 'v' || *format == 'D') {
+            n = va_arg(args, int);
+            if (*format == 'v')
+                v = va_arg(args, const cgsize_t *);
+            else
+                d = va_arg(args, const double *);
+            if (n < 0 || (*format == 'v' ? (void *)v : (void *)d) == NULL)
+                n = 0;
+            if (record_grow(call, 26 * (size_t)(n + 1))) break;
+            call->record_len += sprintf(&call->record[call->record_len],
+                " %d", n);
+            if (*format == 'v') {
+                for (i = 0; i < n; i++)
+                    call->record_len += sprintf(&call->record[call->record_len],
+                        " %.0f", (double)v[i]);
+            }
+            else {
+                for (i = 0; i < n; i++)
+                    call->record_len += sprintf(&call->record[call->record_len],
+                        " %.17g", d[i]);
+            }
+            continue;
+        }
+        if (record_grow(call, 26)) break;
+        if (*format == 'd')
+            call->record_len += sprintf(&call->record[call->record_len],
+                " %.17g", va_arg(args, double));
+        else if (*format == 'l')
+            call->record_len += sprintf(&call->record[call->record_len],
+                " %.0f", (double)va_arg(args, cglong_t));
+        else
+            call->record_len += sprintf(&call->record[call->record_len],
+                " %d", va_arg(args, int));
+    }
+    if (*format == '>') {
+        call->out_type = *++format;
+        if (call->out_type == 'D')
+            call->out_num = va_arg(args, int *);
+        call->out = va_arg(args, void *);
+    }
+    va_end(args);
+    call->args_done = 1;
+}
+
+/* nothing is recorded from the write-behind thread, whose calls were
+   recorded as cgio_new_node_async */
+
+static int record_thread (void)
+{
+#ifdef CGIO_ASYNC_THREADS
+    if (async_running && pthread_equal(pthread_self(), async_thread))
+        return 0;
+#endif
+    return record_file != NULL;
+}
+
+static void stats_begin (stats_call *call, int op, int cgio_num)
+{
+    call->op = (stats_enabled || stats_trace != NULL ||
+                record_file != NULL) ? op : 0;
+    call->cgio_num = cgio_num;
+    call->bytes = 0;
+    call->nested = call->recording = call->args_done = 0;
+    call->record = NULL;
+    call->record_len = call->record_size = 0;
+    call->out_type = 0;
+    call->out_num = NULL;
+    if (!call->op) return;
+
+    /* only the outermost call is recorded, since replaying it repeats
+       the calls it makes */
+    if (record_thread()) {
+        call->nested = 1;
+        call->recording = (record_depth++ == 0);
+    }
+    call->start = stats_clock();
+}
+
+static void stats_add (cgio_stats_t *stats, double time,
+    cglong_t bytes, int ierr)
+{
+    int bin = 0;
+    double usec = 1.0e6 * time;
+
+    stats->calls++;
+    if (ierr) stats->errors++;
+    stats->bytes += bytes;
+    stats->time += time;
+    if (stats->max_time < time) stats->max_time = time;
+    while (usec >= 1.0 && bin < CGIO_STATS_BINS - 1) {
+        usec *= 0.5;
+        bin++;
+    }
+    stats->histogram[bin]++;
+}
+
+static int stats_end (stats_call *call, int ierr)
+{
+    double now, time;
+
+    if (!call->op) return ierr;
+    now = stats_clock();
+    time = now - call->start;
+#ifdef CGIO_ASYNC_THREADS
+    pthread_mutex_lock(&stats_mutex);
+#endif
+    if (stats_enabled) {
+        stats_add(&stats_ops[call->op-1], time, call->bytes, ierr);
+        if (call->cgio_num > 0 && call->cgio_num <= num_iolist &&
+            iolist[call->cgio_num-1].type != CGIO_FILE_NONE)
+            stats_add(&iolist[call->cgio_num-1].stats, time,
+                call->bytes, ierr);
+    }
+    if (stats_trace != NULL) {
+        fprintf(stats_trace, "%s{\"name\":\"%s\",\"cat\":\"cgio\","
+            "\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d,"
+            "\"args\":{\"bytes\":%.0f,\"err\":%d}}",
+            stats_events++ ? ",\n" : "[\n", stats_names[call->op-1],
+            1.0e6 * (call->start - stats_epoch), 1.0e6 * time,
+            call->cgio_num, (double)call->bytes, ierr);
+#ifdef MEM_DEBUG
+        fprintf(stats_trace, ",\n{\"name\":\"memory\",\"ph\":\"C\","
+            "\"ts\":%.3f,\"pid\":1,\"args\":{\"bytes\":%.0f}}",
+            1.0e6 * (now - stats_epoch), (double)cgmemnow());
+#endif
+    }
+    if (call->recording && call->args_done) {
+        if (ierr == CGIO_ERR_NONE && call->out_type == 'f')
+            record_args(call, "fd", *(int *)call->out,
+                iolist[*(int *)call->out-1].rootid);
+        else if (ierr == CGIO_ERR_NONE && call->out_type)
+            record_args(call, "D", call->out_num == NULL ? 1 :
+                *call->out_num, (double *)call->out);
+        fprintf(record_file, "%s %d%s\n", stats_names[call->op-1], ierr,
+            call->record_len ? call->record : "");
+    }
+#ifdef CGIO_ASYNC_THREADS
+    pthread_mutex_unlock(&stats_mutex);
+#endif
+    if (call->record != NULL) free(call->record);
+    if (call->nested) record_depth--;
+    return ierr;
+}
+
+/* bytes in count elements of a node, or in all its data if count < 0 */
+
+static cglong_t stats_bytes (cgns_io *cgio, double id, cglong_t count)
+{
+    int ierr = 0, ndims = 1;
+    char data_type[CGIO_MAX_NAME_LENGTH+1];
+    cgsize_t dims[CGIO_MAX_DIMENSIONS];
+    cgio_index_node *node;
+
+    dims[0] = (cgsize_t)count;
+    if ((node = index_node(cgio, id)) != NULL && !node->link_len) {
+        strcpy(data_type, node->data_type);
+        if (count < 0) {
+            for (ndims = 0; ndims < node->ndims; ndims++)
+                dims[ndims] = (cgsize_t)node->dims[ndims];
+        }
+    }
+    else if (IS_ADF(cgio->type)) {
+        ADF_Get_Data_Type(id, data_type, &ierr);
+        if (ierr <= 0 && count < 0) {
+            ADF_Get_Number_of_Dimensions(id, &ndims, &ierr);
+            if (ierr <= 0 && ndims > 0)
+                ADF_Get_Dimension_Values(id, dims, &ierr);
+        }
+    }
+#ifdef BUILD_HDF5
+    else if (cgio->type == CGIO_FILE_HDF5) {
+        ADFH_Get_Data_Type(id, data_type, &ierr);
+        if (ierr <= 0 && count < 0) {
+            ADFH_Get_Number_of_Dimensions(id, &ndims, &ierr);
+            if (ierr <= 0 && ndims > 0)
+                ADFH_Get_Dimension_Values(id, dims, &ierr);
+        }
+    }
+#endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Get_Data_Type(id, data_type, &ierr);
+        if (ierr <= 0 && count < 0) {
+            ADFM_Get_Number_of_Dimensions(id, &ndims, &ierr);
+            if (ierr <= 0 && ndims > 0)
+                ADFM_Get_Dimension_Values(id, dims, &ierr);
+        }
+    }
+    else
+        return 0;
+    if (ierr > 0 || ndims < 1) return 0;
+    return compute_data_size(data_type, ndims, dims);
+}
+
+/* number of elements in a memory hyperslab */
+
+static cglong_t stats_count (int ndims, const cgsize_t *start,
+    const cgsize_t *end, const cgsize_t *stride)
+{
+    int n;
+    cglong_t count = 1;
+
+    for (n = 0; n < ndims; n++) {
+        if (end[n] < start[n] || stride[n] < 1) return 0;
+        count *= (end[n] - start[n]) / stride[n] + 1;
+    }
+    return count;
+}
+
+/*---------------------------------------------------------*/
+
+/* the number of dimensions of a node, for recording a hyperslab */
+
+static int record_ndims (cgns_io *cgio, double id)
+{
+    int ierr = 0, ndims = 0;
+    cgio_index_node *node;
+
+    if ((node = index_node(cgio, id)) != NULL && !node->link_len)
+        return node->ndims;
+    if (IS_ADF(cgio->type))
+        ADF_Get_Number_of_Dimensions(id, &ndims, &ierr);
+#ifdef BUILD_HDF5
+    else if (cgio->type == CGIO_FILE_HDF5)
+        ADFH_Get_Number_of_Dimensions(id, &ndims, &ierr);
+#endif
+    else if (cgio->type == CGIO_FILE_MEMORY)
+        ADFM_Get_Number_of_Dimensions(id, &ndims, &ierr);
+    return ierr > 0 ? 0 : ndims;
+}
+
+/*---------------------------------------------------------*/
+
+/* the record of a data transfer ends with the size of the memory
+   buffer, so a replay can allocate it without asking for it */
+
+static void record_data (stats_call *call, cgns_io *cgio, double id,
+    const cgsize_t *s_start, const cgsize_t *s_end,
+    const cgsize_t *s_stride, int m_num_dims, const cgsize_t *m_dims,
+    const cgsize_t *m_start, const cgsize_t *m_end,
+    const cgsize_t *m_stride)
+{
+    int n, ndims = record_ndims(cgio, id);
+    cglong_t count = 1;
+
+    if (m_num_dims < 0 || m_num_dims > CGIO_MAX_DIMENSIONS) m_num_dims = 0;
+    for (n = 0; n < m_num_dims; n++)
+        count *= m_dims[n];
+    record_args(call, "fdvvvvvvvl", call->cgio_num, id, ndims, s_start,
+        ndims, s_end, ndims, s_stride, m_num_dims, m_dims, m_num_dims,
+        m_start, m_num_dims, m_end, m_num_dims, m_stride,
+        stats_bytes(cgio, id, count));
+}
+
+/* bytes returned by one read of a batch */
+
+static cglong_t batch_bytes (cgns_io *cgio, const cgio_read_t *read)
+{
+    if (read->b_start < 1) return stats_bytes(cgio, read->id, -1);
+    return stats_bytes(cgio, read->id, read->b_end - read->b_start + 1);
+}
+
+/* switch counting on or off; switching it on starts from zero */
+
+static void stats_enable (int enable)
+{
+    int n;
+
+#ifdef CGIO_ASYNC_THREADS
+    pthread_mutex_lock(&stats_mutex);
+#endif
+    if (enable && !stats_enabled) {
+        memset(stats_ops, 0, sizeof(stats_ops));
+        for (n = 0; n < num_iolist; n++)
+            memset(&iolist[n].stats, 0, sizeof(cgio_stats_t));
+        if (stats_trace == NULL) stats_epoch = stats_clock();
+    }
+    stats_enabled = enable;
+#ifdef CGIO_ASYNC_THREADS
+    pthread_mutex_unlock(&stats_mutex);
+#endif
+}
+
+/* close the trace file, and start a new one if a name is given */
+
+static int stats_open_trace (const char *filename)
+{
+    int ierr = CGIO_ERR_NONE;
+
+#ifdef CGIO_ASYNC_THREADS
+    pthread_mutex_lock(&stats_mutex);
+#endif
+    if (stats_trace != NULL) {
+        fputs(stats_events ? "\n]\n" : "[]\n", stats_trace);
+        fclose(stats_trace);
+        stats_trace = NULL;
+    }
+    if (filename != NULL && *filename) {
+        stats_trace = fopen(filename, "w");
+        if (stats_trace == NULL)
+            ierr = CGIO_ERR_FILE_OPEN;
+        stats_events = 0;
+        stats_epoch = stats_clock();
+    }
+#ifdef CGIO_ASYNC_THREADS
+    pthread_mutex_unlock(&stats_mutex);
+#endif
+    return ierr;
+}
+
+/*---------------------------------------------------------*/
+
+/* only calls made after the record is opened are written, so files
+   that are already open when it starts will be missing from it */
+
+static int record_open (const char *filename)
+{
+    int ierr = CGIO_ERR_NONE;
+
+#ifdef CGIO_ASYNC_THREADS
+    pthread_mutex_lock(&stats_mutex);
+#endif
+    if (record_file != NULL) {
+        fclose(record_file);
+        record_file = NULL;
+    }
+    if (filename != NULL && *filename) {
+        record_file = fopen(filename, "w");
+        if (record_file == NULL)
+            ierr = CGIO_ERR_FILE_OPEN;
+        else
+            fputs("# cgio record 1\n", record_file);
+        record_seq = 0;
+    }
+#ifdef CGIO_ASYNC_THREADS
+    pthread_mutex_unlock(&stats_mutex);
+#endif
+    return ierr;
+}
+
+/*---------------------------------------------------------*/
+
+/* copies the children of InputID to OutputID, and the data of InputID
+   too unless depth is 0. When link_size is more than 0, path is the path
+   of InputID in the input file, with room for CGIO_MAX_LINK_LENGTH
+   characters, and nodes with at least link_size bytes of data become
+   links to link_file instead of copies */
+
 static int recurse_nodes (int input, double InputID,
-    int output, double OutputID, int follow_links, int depth)
+    int output, double OutputID, int follow_links,
+    const char *link_file, cglong_t link_size, char *path, int depth)
 {
-    int n, nchild, cnt, name_len, file_len;
+    int n, nchild, cnt, name_len, file_len, path_len = 0, ierr;
     char name[CGIO_MAX_NAME_LENGTH+1];
-    char *link_name, *link_file;
+    char *link_name, *link_path;
     double childID, newID;
+    cglong_t data_size;
 
     /* Copy the data from the current input node to the output node */
 
@@ -141,6 +1175,7 @@ static int recurse_nodes (int input, double InputID,
 
     if (cgio_number_children(input, InputID, &nchild))
         return 1;
+    if (link_size > 0) path_len = (int)strlen(path);
     for (n = 1; n <= nchild; n++) {
         if (cgio_children_ids(input, InputID, n, 1, &cnt, &childID) ||
             cgio_get_name(input, childID, name) ||
@@ -151,29 +1186,51 @@ static int recurse_nodes (int input, double InputID,
                 return 1;
         }
         if (name_len && (file_len == 0 || follow_links == 0)) {
-            link_file = (char *) malloc (file_len + name_len + 2);
-            if (link_file == NULL) {
+            link_path = (char *) malloc (file_len + name_len + 2);
+            if (link_path == NULL) {
                 set_error(CGIO_ERR_MALLOC);
                 return 1;
             }
-            link_name = link_file + file_len + 1;
-            if (cgio_get_link(input, childID, link_file, link_name)) {
-                free (link_name);
+            link_name = link_path + file_len + 1;
+            if (cgio_get_link(input, childID, link_path, link_name)) {
+                free (link_path);
                 return 1;
             }
-            link_file[file_len] = 0;
+            link_path[file_len] = 0;
             link_name[name_len] = 0;
-            if (cgio_create_link(output, OutputID, name, link_file,
+            if (cgio_create_link(output, OutputID, name, link_path,
                     link_name, &newID)) {
-                free (link_file);
+                free (link_path);
                 return 1;
             }
-            free (link_file);
+            free (link_path);
+            continue;
+        }
+
+        if (link_size > 0 && path_len + (int)strlen(name) + 1 <=
+                CGIO_MAX_LINK_LENGTH) {
+            sprintf(&path[path_len], "/%s", name);
+            if (cgio_get_data_size(input, childID, &data_size)) {
+                path[path_len] = 0;
+                return 1;
+            }
+            if (data_size >= link_size) {
+                ierr = cgio_create_link(output, OutputID, name, link_file,
+                           path, &newID);
+            }
+            else {
+                ierr = cgio_create_node(output, OutputID, name, &newID) ||
+                       recurse_nodes(input, childID, output, newID,
+                           follow_links, link_file, link_size, path,
+                           depth + 1);
+            }
+            path[path_len] = 0;
+            if (ierr) return 1;
         }
         else {
             if (cgio_create_node(output, OutputID, name, &newID) ||
-                recurse_nodes(input, childID, output, newID,
-                    follow_links, ++depth))
+                recurse_nodes(input, childID, output, newID, follow_links,
+                    NULL, 0, NULL, depth + 1))
                 return 1;
         }
     }
@@ -235,7 +1292,8 @@ static int rewrite_file (int cginp, const char *filename)
     }
     output = get_cgnsio(cgout, 0);
 
-    ierr = recurse_nodes(cginp, input->rootid, cgout, output->rootid, 0, 0);
+    ierr = recurse_nodes(cginp, input->rootid, cgout, output->rootid, 0,
+               NULL, 0, NULL, 0);
     cgio_close_file (cgout);
 
     if (ierr) {
@@ -262,6 +1320,26 @@ static int rewrite_file (int cginp, const char *filename)
     return set_error(ierr);
 }
 
+/* reads a file into an in-memory database in one pass, following the
+   links to other files so that it does not depend on them */
+
+static int load_file (const char *filename, int file_type, int cgio_num)
+{
+    int cginp, mode, ierr;
+
+    if (cgio_open_file(filename, CGIO_MODE_READ, file_type, &cginp))
+        return get_error();
+    mode = iolist[cgio_num-1].mode;
+    iolist[cgio_num-1].mode = CGIO_MODE_MODIFY;
+    ierr = cgio_copy_file(cginp, cgio_num, 1);
+    iolist[cgio_num-1].mode = mode;
+    if (ierr) {
+        cgio_close_file(cginp);
+        return set_error(ierr);
+    }
+    return cgio_close_file(cginp);
+}
+
 /*=========================================================
  * paths for searching for linked-to files
  *=========================================================*/
@@ -340,7 +1418,7 @@ int cgio_find_file (const char *parentfile, const char *filename,
 #endif
     ) {
         if (cgio_check_file(filename, &type) == CGIO_ERR_NONE &&
-           (file_type == CGIO_FILE_NONE || file_type == type)) {
+           (file_type == CGIO_FILE_NONE || SAME_TYPE(file_type, type))) {
             strcpy(pathname, filename);
             return set_error(CGIO_ERR_NONE);
         }
@@ -363,7 +1441,7 @@ int cgio_find_file (const char *parentfile, const char *filename,
             if ((int)strlen(pathname) <= size) {
                 strcpy(p, filename);
                 if (cgio_check_file(pathname, &type) == CGIO_ERR_NONE &&
-                    (file_type == CGIO_FILE_NONE || file_type == type))
+                    (file_type == CGIO_FILE_NONE || SAME_TYPE(file_type, type)))
                     return set_error(CGIO_ERR_NONE);
             }
         }
@@ -372,7 +1450,7 @@ int cgio_find_file (const char *parentfile, const char *filename,
     /* check current directory */
 
     if (cgio_check_file(filename, &type) == CGIO_ERR_NONE &&
-       (file_type == CGIO_FILE_NONE || file_type == type)) {
+       (file_type == CGIO_FILE_NONE || SAME_TYPE(file_type, type))) {
         strcpy(pathname, filename);
         return set_error(CGIO_ERR_NONE);
     }
@@ -383,7 +1461,7 @@ int cgio_find_file (const char *parentfile, const char *filename,
 
     /* check file type environment variable */
 
-    if (file_type == CGIO_FILE_ADF || file_type == CGIO_FILE_ADF2)
+    if (IS_ADF(file_type))
         p = getenv ("ADF_LINK_PATH");
 #ifdef BUILD_HDF5
     else if (file_type == CGIO_FILE_HDF5)
@@ -413,7 +1491,7 @@ int cgio_find_file (const char *parentfile, const char *filename,
                 *p++ = '/';
             strcpy (p, filename);
             if (cgio_check_file(pathname, &type) == CGIO_ERR_NONE &&
-               (file_type == CGIO_FILE_NONE || file_type == type))
+               (file_type == CGIO_FILE_NONE || SAME_TYPE(file_type, type)))
                 return set_error(CGIO_ERR_NONE);
         }
         p = s;
@@ -444,7 +1522,7 @@ int cgio_find_file (const char *parentfile, const char *filename,
                 *p++ = '/';
             strcpy (p, filename);
             if (cgio_check_file(pathname, &type) == CGIO_ERR_NONE &&
-               (file_type == CGIO_FILE_NONE || file_type == type))
+               (file_type == CGIO_FILE_NONE || SAME_TYPE(file_type, type)))
                 return set_error(CGIO_ERR_NONE);
         }
         p = s;
@@ -475,7 +1553,7 @@ int cgio_find_file (const char *parentfile, const char *filename,
                     *p++ = '/';
                 strcpy (p, filename);
                 if (cgio_check_file(pathname, &type) == CGIO_ERR_NONE &&
-                   (file_type == CGIO_FILE_NONE || file_type == type))
+                   (file_type == CGIO_FILE_NONE || SAME_TYPE(file_type, type)))
                     return set_error(CGIO_ERR_NONE);
             }
             p = s;
@@ -491,7 +1569,8 @@ int cgio_find_file (const char *parentfile, const char *filename,
 
 int cgio_is_supported (int file_type)
 {
-    if (file_type == CGIO_FILE_ADF)
+    if (file_type == CGIO_FILE_ADF || file_type == CGIO_FILE_ADF3 ||
+        file_type == CGIO_FILE_MEMORY)
         return set_error(CGIO_ERR_NONE);
 #if CG_SIZEOF_SIZE == 32
     if (file_type == CGIO_FILE_ADF2)
@@ -511,22 +1590,67 @@ int cgio_configure (int what, void *value)
 {
     int ierr = CGIO_ERR_BAD_OPTION;
 
+    /* the I/O thread must not be inside the libraries when their
+       settings, or the trace and record files, change */
+    async_drain();
+
     if (what > 200) {
 #ifdef BUILD_HDF5
         ADFH_Configure(what-200, value, &ierr);
 #endif
     }
-/* nothing here yet
-    else if (what > 100) {
+    else if (what == CGIO_CONFIG_INDEX) {
+        index_files = (int)((size_t)value);
+        ierr = CGIO_ERR_NONE;
     }
-*/
-    return set_error(ierr);
+    else if (what == CGIO_CONFIG_ADF_SYNC) {
+        ADF_Set_Header_Sync((int)((size_t)value), &ierr);
+    }
+    else if (what == CGIO_CONFIG_ADF_MERGE) {
+        ADF_Set_Merge_Chunks((int)((size_t)value), &ierr);
+    }
+    else if (what == CGIO_CONFIG_ADF_DIRECT) {
+        ADF_Set_Direct_IO((cglong_t)((size_t)value), &ierr);
+    }
+    else if (what == CGIO_CONFIG_PREALLOCATE) {
+        ADF_Set_Preallocate((cglong_t)((size_t)value), &ierr);
+#ifdef BUILD_HDF5
+        if (ierr <= 0)
+            ADFH_Configure(ADFH_CONFIG_PREALLOCATE, value, &ierr);
+#endif
+    }
+    else if (what == CGIO_CONFIG_ADF_COMPRESS) {
+        ADF_Set_Compress((cglong_t)((size_t)value), &ierr);
+    }
+    else if (what == CGIO_CONFIG_ADF_QUEUE) {
+        ADF_Set_Queue_Depth((int)((size_t)value), &ierr);
+    }
+    else if (what == CGIO_CONFIG_STATS) {
+        stats_enable((int)((size_t)value));
+        ierr = CGIO_ERR_NONE;
+    }
+    else if (what == CGIO_CONFIG_TRACE) {
+        if (stats_open_trace((const char *)value))
+            return set_error(CGIO_ERR_FILE_OPEN);
+        ierr = CGIO_ERR_NONE;
+    }
+    else if (what == CGIO_CONFIG_RECORD) {
+        if (record_open((const char *)value))
+            return set_error(CGIO_ERR_FILE_OPEN);
+        ierr = CGIO_ERR_NONE;
+    }
+    /* ADF returns -1 (NO_ERROR) on success */
+    if (ierr > 0 || ierr == CGIO_ERR_BAD_OPTION)
+        return set_error(ierr);
+    return set_error(CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
 
 void cgio_cleanup ()
 {
+    int ierr;
+
     if (num_open) {
         int n;
         num_open++;
@@ -538,7 +1662,15 @@ void cgio_cleanup ()
         num_iolist = 0;
         num_open = 0;
     }
+#ifdef CGIO_ASYNC_THREADS
+    /* the closes above don't stop the I/O thread, since num_open
+       was raised to keep iolist until the end */
+    async_shutdown();
+#endif
     cgio_path_delete(NULL);
+    stats_open_trace(NULL);
+    record_open(NULL);
+    ADFM_Database_Delete(NULL, &ierr);
 }
 
 /*---------------------------------------------------------*/
@@ -551,6 +1683,14 @@ int cgio_check_file (const char *filename, int *file_type)
     static char *HDF5sig = "\211HDF\r\n\032\n";
     struct stat st;
 
+    /* an in-memory database hides a file of the same name */
+
+    ADFM_Database_Valid(filename, &n);
+    if (n <= 0) {
+        *file_type = CGIO_FILE_MEMORY;
+        return set_error(CGIO_ERR_NONE);
+    }
+
     if (ACCESS (filename, 0) || stat (filename, &st) ||
         S_IFREG != (st.st_mode & S_IFREG)) {
         last_err = CGIO_ERR_NOT_FOUND;
@@ -570,7 +1710,7 @@ int cgio_check_file (const char *filename, int *file_type)
     /* check for ADF */
 
     if (0 == strncmp (&buf[4], "ADF Database Version", 20)) {
-        *file_type = CGIO_FILE_ADF;
+        *file_type = buf[25] == 'C' ? CGIO_FILE_ADF3 : CGIO_FILE_ADF;
         return set_error(CGIO_ERR_NONE);
     }
 
@@ -657,18 +1797,25 @@ int cgio_copy_dimensions (int ndims, const cglong_t *dims64, cgsize_t *dims)
 int cgio_open_file (const char *filename, int file_mode,
     int file_type, int *cgio_num)
 {
-    int n, type, ierr;
+    int n, type, ierr, load = CGIO_FILE_NONE;
     char *fmode;
     double rootid;
+    stats_call call;
 
+    stats_begin(&call, STATS_OPEN_FILE, 0);
+    record_args(&call, "sii>f", filename, file_mode, file_type, cgio_num);
     *cgio_num = 0;
+    async_drain();
     switch(file_mode) {
         case CGIO_MODE_READ:
         case 'r':
         case 'R':
             if (cgio_check_file(filename, &type))
-                return get_error();
-            file_type = type;
+                return stats_end(&call, get_error());
+            if (file_type == CGIO_FILE_MEMORY && type != CGIO_FILE_MEMORY)
+                load = type;
+            else
+                file_type = type;
             file_mode = CGIO_MODE_READ;
             fmode = "READ_ONLY";
             break;
@@ -682,39 +1829,52 @@ int cgio_open_file (const char *filename, int file_mode,
         case 'm':
         case 'M':
             if (cgio_check_file(filename, &type))
-                return get_error();
-            file_type = type;
+                return stats_end(&call, get_error());
+            if (file_type == CGIO_FILE_MEMORY && type != CGIO_FILE_MEMORY)
+                load = type;
+            else
+                file_type = type;
             file_mode = CGIO_MODE_MODIFY;
             fmode = "OLD";
             break;
         default:
-            return set_error(CGIO_ERR_FILE_MODE);
+            return stats_end(&call, set_error(CGIO_ERR_FILE_MODE));
     }
     last_type = file_type;
     if (file_type == CGIO_FILE_NONE) {
         last_type = file_type = CGIO_FILE_ADF;
         ADF_Database_Open(filename, fmode, "NATIVE", &rootid, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #if CG_SIZEOF_SIZE == 32
     else if (file_type == CGIO_FILE_ADF || file_type == CGIO_FILE_ADF2) {
         ADF_Database_Open(filename, fmode, "LEGACY", &rootid, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #else
     else if (file_type == CGIO_FILE_ADF) {
         ADF_Database_Open(filename, fmode, "NATIVE", &rootid, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (file_type == CGIO_FILE_ADF3) {
+        ADF_Database_Open(filename, fmode, "COMPACT", &rootid, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
 #ifdef BUILD_HDF5
     else if (file_type == CGIO_FILE_HDF5) {
         ADFH_Database_Open(filename, fmode, "NATIVE", &rootid, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (file_type == CGIO_FILE_MEMORY) {
+        /* a file on disk is read into a scratch database */
+        if (load != CGIO_FILE_NONE) fmode = "SCRATCH";
+        ADFM_Database_Open(filename, fmode, &rootid, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
     if (num_iolist == 0) {
@@ -742,10 +1902,30 @@ int cgio_open_file (const char *filename, int file_mode,
     iolist[n].type = file_type;
     iolist[n].mode = file_mode;
     iolist[n].rootid = rootid;
+    iolist[n].async_err = CGIO_ERR_NONE;
+    iolist[n].filename = NULL;
+    iolist[n].index = NULL;
+    if (index_files && IS_ADF(file_type)) {
+        iolist[n].filename = (char *) malloc (strlen(filename) + 1);
+        if (iolist[n].filename != NULL) {
+            strcpy(iolist[n].filename, filename);
+            if (file_mode == CGIO_MODE_READ)
+                iolist[n].index = index_load(&iolist[n]);
+        }
+    }
+    memset(&iolist[n].stats, 0, sizeof(cgio_stats_t));
     *cgio_num = n + 1;
+    call.cgio_num = *cgio_num;
     num_open++;
 
-    return set_error(CGIO_ERR_NONE);
+    if (load != CGIO_FILE_NONE && load_file(filename, load, *cgio_num)) {
+        ierr = get_error();
+        cgio_close_file(*cgio_num);
+        *cgio_num = 0;
+        return stats_end(&call, set_error(ierr));
+    }
+
+    return stats_end(&call, set_error(CGIO_ERR_NONE));
 }
 
 /*---------------------------------------------------------*/
@@ -754,30 +1934,53 @@ int cgio_close_file (int cgio_num)
 {
     int ierr;
     cgns_io *cgio;
+    cgio_index *index = NULL;
+    stats_call call;
 
+    stats_begin(&call, STATS_CLOSE_FILE, cgio_num);
+    record_args(&call, "f", cgio_num);
     if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
+        /* (re)build the node index unless a valid one was used */
+        if (cgio->filename != NULL && cgio->index == NULL)
+            index = index_build(cgio);
         ADF_Database_Close(cgio->rootid, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) {
+            index_free(index);
+            return stats_end(&call, set_error(ierr));
+        }
+        if (index != NULL) {
+            index_write(cgio->filename, index);
+            index_free(index);
+        }
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Database_Close(cgio->rootid, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Database_Close(cgio->rootid, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
+    index_free(cgio->index);
+    if (cgio->filename != NULL) free(cgio->filename);
     cgio->type = CGIO_FILE_NONE;
     if (--num_open == 0) {
+#ifdef CGIO_ASYNC_THREADS
+        async_shutdown();
+#endif
         free(iolist);
         num_iolist = 0;
     }
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -786,15 +1989,18 @@ int cgio_compress_file (int cgio_num, const char *filename)
 {
     int ierr;
     cgns_io *cgio;
+    stats_call call;
 
+    stats_begin(&call, STATS_COMPRESS_FILE, cgio_num);
+    record_args(&call, "fs", cgio_num, filename);
     if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         if (rewrite_file (cgio_num, filename)) {
             ierr = get_error();
             cgio_close_file(cgio_num);
-            return set_error(ierr);
+            return stats_end(&call, set_error(ierr));
         }
     }
 #ifdef BUILD_HDF5
@@ -802,15 +2008,20 @@ int cgio_compress_file (int cgio_num, const char *filename)
         if (rewrite_file (cgio_num, filename)) {
             ierr = get_error();
             cgio_close_file(cgio_num);
-            return set_error(ierr);
+            return stats_end(&call, set_error(ierr));
         }
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        /* deleted nodes are reused, so there is no space to reclaim */
+        if (cgio_close_file(cgio_num))
+            return stats_end(&call, get_error());
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -819,17 +2030,20 @@ int cgio_copy_file (int cgio_num_inp, int cgio_num_out,
     int follow_links)
 {
     cgns_io *input, *output;
+    stats_call call;
 
+    stats_begin(&call, STATS_COPY_FILE, cgio_num_inp);
+    record_args(&call, "ffi", cgio_num_inp, cgio_num_out, follow_links);
     if ((input  = get_cgnsio(cgio_num_inp, 0)) == NULL ||
         (output = get_cgnsio(cgio_num_out, 1)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
     if (input->mode != CGIO_MODE_READ &&
         cgio_flush_to_disk(cgio_num_inp))
-        return get_error();
+        return stats_end(&call, get_error());
     if (recurse_nodes(cgio_num_inp, input->rootid,
-            cgio_num_out, output->rootid, follow_links, 0))
-        return get_error();
-    return CGIO_ERR_NONE;
+            cgio_num_out, output->rootid, follow_links, NULL, 0, NULL, 0))
+        return stats_end(&call, get_error());
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -838,26 +2052,32 @@ int cgio_flush_to_disk (int cgio_num)
 {
     int ierr;
     cgns_io *cgio;
+    stats_call call;
 
+    stats_begin(&call, STATS_FLUSH_TO_DISK, cgio_num);
+    record_args(&call, "f", cgio_num);
     if ((cgio = get_cgnsio(cgio_num, 1)) == NULL)
-        return get_error();
-    if (cgio->mode == CGIO_MODE_READ) return CGIO_ERR_NONE;
+        return stats_end(&call, get_error());
+    if (cgio->mode == CGIO_MODE_READ) return stats_end(&call, CGIO_ERR_NONE);
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Flush_to_Disk(cgio->rootid, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Flush_to_Disk(cgio->rootid, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        /* nothing to flush */
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*=========================================================
@@ -868,25 +2088,32 @@ int cgio_library_version (int cgio_num, char *version)
 {
     int ierr;
     cgns_io *cgio;
+    stats_call call;
 
+    stats_begin(&call, STATS_LIBRARY_VERSION, cgio_num);
+    record_args(&call, "f", cgio_num);
     if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Library_Version(version, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Library_Version(version, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Library_Version(version, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -896,27 +2123,35 @@ int cgio_file_version (int cgio_num, char *file_version,
 {
     int ierr;
     cgns_io *cgio;
+    stats_call call;
 
+    stats_begin(&call, STATS_FILE_VERSION, cgio_num);
+    record_args(&call, "f", cgio_num);
     if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Database_Version(cgio->rootid, file_version,
             creation_date, modified_date, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Database_Version(cgio->rootid, file_version,
             creation_date, modified_date, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Database_Version(cgio->rootid, file_version,
+            creation_date, modified_date, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -971,7 +2206,7 @@ int cgio_error_message (char *error_msg)
         else
             strcpy(msg, cgio_ErrorMessage[errcode]);
     }
-    else if (last_type == CGIO_FILE_ADF || last_type == CGIO_FILE_ADF2) {
+    else if (IS_ADF(last_type)) {
         ADF_Error_Message(last_err, msg);
     }
 #ifdef BUILD_HDF5
@@ -979,6 +2214,10 @@ int cgio_error_message (char *error_msg)
         ADFH_Error_Message(last_err, msg);
     }
 #endif
+    else if (last_type == CGIO_FILE_MEMORY) {
+        /* the in-memory database uses the ADF error codes */
+        ADF_Error_Message(last_err, msg);
+    }
     else {
         strcpy(msg, "unknown error message");
     }
@@ -1019,25 +2258,32 @@ int cgio_create_node (int cgio_num, double pid,
 {
     int ierr;
     cgns_io *cgio;
+    stats_call call;
 
+    stats_begin(&call, STATS_CREATE_NODE, cgio_num);
+    record_args(&call, "fds>d", cgio_num, pid, name, id);
     if ((cgio = get_cgnsio(cgio_num, 1)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Create(pid, name, id, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Create(pid, name, id, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Create(pid, name, id, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -1048,45 +2294,159 @@ int cgio_new_node (int cgio_num, double pid, const char *name,
 {
     int ierr;
     cgns_io *cgio;
+    stats_call call;
 
+    stats_begin(&call, STATS_NEW_NODE, cgio_num);
+    record_args(&call, "fdsssvi>d", cgio_num, pid, name, label,
+        data_type, ndims, dims, data != NULL, id);
     if ((cgio = get_cgnsio(cgio_num, 1)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Create(pid, name, id, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
         ADF_Set_Label(*id, label, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
         if (data_type != NULL && strcmp(data_type, "MT")) {
             ADF_Put_Dimension_Information(*id, data_type, ndims, dims, &ierr);
-            if (ierr > 0) return set_error(ierr);
+            if (ierr > 0) return stats_end(&call, set_error(ierr));
             if (data != NULL) {
                 ADF_Write_All_Data(*id, (const char *)data, &ierr);
-                if (ierr > 0) return set_error(ierr);
+                if (ierr > 0) return stats_end(&call, set_error(ierr));
             }
         }
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Create(pid, name, id, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
         ADFH_Set_Label(*id, label, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
         if (data_type != NULL && strcmp(data_type, "MT")) {
             ADFH_Put_Dimension_Information(*id, data_type, ndims, dims, &ierr);
-            if (ierr > 0) return set_error(ierr);
+            if (ierr > 0) return stats_end(&call, set_error(ierr));
             if (data != NULL) {
                 ADFH_Write_All_Data(*id, (const char *)data, &ierr);
-                if (ierr > 0) return set_error(ierr);
+                if (ierr > 0) return stats_end(&call, set_error(ierr));
             }
         }
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Create(pid, name, id, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+        ADFM_Set_Label(*id, label, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+        if (data_type != NULL && strcmp(data_type, "MT")) {
+            ADFM_Put_Dimension_Information(*id, data_type, ndims, dims, &ierr);
+            if (ierr > 0) return stats_end(&call, set_error(ierr));
+            if (data != NULL) {
+                ADFM_Write_All_Data(*id, (const char *)data, &ierr);
+                if (ierr > 0) return stats_end(&call, set_error(ierr));
+            }
+        }
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    if (data != NULL && data_type != NULL && strcmp(data_type, "MT"))
+        call.bytes = compute_data_size(data_type, ndims, dims);
+    return stats_end(&call, CGIO_ERR_NONE);
+}
+
+/*---------------------------------------------------------*/
+
+int cgio_new_node_async (int cgio_num, double pid, const char *name,
+    const char *label, const char *data_type, int ndims,
+    const cgsize_t *dims, void *data, void (*release)(void *),
+    double *id)
+{
+    int n;
+    cglong_t size;
+    cgio_request *req;
+    stats_call call;
+
+    stats_begin(&call, STATS_NEW_NODE_ASYNC, cgio_num);
+    record_args(&call, "fdsssvi", cgio_num, pid, name, label, data_type,
+        ndims, dims, data != NULL);
+    /* don't use get_cgnsio here, since that waits on the queue */
+    if (cgio_num < 1 || cgio_num > num_iolist ||
+        iolist[cgio_num-1].type == CGIO_FILE_NONE)
+        return stats_end(&call, set_error(CGIO_ERR_BAD_CGIO));
+    if (iolist[cgio_num-1].mode == CGIO_MODE_READ)
+        return stats_end(&call, set_error(CGIO_ERR_READ_ONLY));
+    if (ndims < 0 || ndims > CGIO_MAX_DIMENSIONS)
+        return stats_end(&call, set_error(CGIO_ERR_DIMENSIONS));
+    if (name == NULL || !*name || label == NULL || data_type == NULL)
+        return stats_end(&call, set_error(CGIO_ERR_NULL_STRING));
+
+    req = (cgio_request *) calloc (1, sizeof(cgio_request));
+    if (req == NULL) return stats_end(&call, set_error(CGIO_ERR_MALLOC));
+    req->cgio_num = cgio_num;
+    req->pid = pid;
+    strncpy(req->name, name, CGIO_MAX_NAME_LENGTH);
+    strncpy(req->label, label, CGIO_MAX_LABEL_LENGTH);
+    strncpy(req->data_type, data_type, CGIO_MAX_DATATYPE_LENGTH);
+    req->ndims = ndims;
+    for (n = 0; n < ndims; n++)
+        req->dims[n] = dims[n];
+    req->id = id;
+    if (call.recording) {
+        req->record_seq = ++record_seq;
+        record_args(&call, "i", req->record_seq);
+    }
+
+    /* take ownership of the buffer, or make a private copy */
+    if (data != NULL && release != NULL) {
+        req->data = data;
+        req->release = release;
+    }
+    else if (data != NULL) {
+        size = compute_data_size(data_type, ndims, dims);
+        req->data = malloc((size_t)(size > 0 ? size : 1));
+        if (req->data == NULL) {
+            free(req);
+            return stats_end(&call, set_error(CGIO_ERR_MALLOC));
+        }
+        memcpy(req->data, data, (size_t)size);
+    }
+
+#ifdef CGIO_ASYNC_THREADS
+    pthread_mutex_lock(&async_mutex);
+    if (!async_running) {
+        if (pthread_create(&async_thread, NULL, async_worker, NULL)) {
+            pthread_mutex_unlock(&async_mutex);
+            async_execute(req);
+            return stats_end(&call, set_error(iolist[cgio_num-1].async_err));
+        }
+        async_running = 1;
+    }
+#endif
+    if (async_tail == NULL)
+        async_head = req;
+    else
+        async_tail->next = req;
+    async_tail = req;
+#ifdef CGIO_ASYNC_THREADS
+    pthread_cond_signal(&async_work);
+    pthread_mutex_unlock(&async_mutex);
+#endif
+    return stats_end(&call, set_error(CGIO_ERR_NONE));
+}
+
+/*---------------------------------------------------------*/
+
+int cgio_wait (int cgio_num)
+{
+    int ierr;
+    cgns_io *cgio;
+
+    if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
+        return get_error();
+    ierr = cgio->async_err;
+    cgio->async_err = CGIO_ERR_NONE;
+    return set_error(ierr);
 }
 
 /*---------------------------------------------------------*/
@@ -1095,25 +2455,32 @@ int cgio_delete_node (int cgio_num, double pid, double id)
 {
     int ierr;
     cgns_io *cgio;
+    stats_call call;
 
+    stats_begin(&call, STATS_DELETE_NODE, cgio_num);
+    record_args(&call, "fdd", cgio_num, pid, id);
     if ((cgio = get_cgnsio(cgio_num, 1)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Delete(pid, id, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Delete(pid, id, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Delete(pid, id, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -1123,25 +2490,67 @@ int cgio_move_node (int cgio_num, double pid, double id,
 {
     int ierr;
     cgns_io *cgio;
+    stats_call call;
 
+    stats_begin(&call, STATS_MOVE_NODE, cgio_num);
+    record_args(&call, "fddd", cgio_num, pid, id, new_pid);
     if ((cgio = get_cgnsio(cgio_num, 1)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Move_Child(pid, id, new_pid, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Move_Child(pid, id, new_pid, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Move_Child(pid, id, new_pid, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
+}
+
+/*---------------------------------------------------------*/
+
+/* copies the data of a node in blocks of at most COPY_BLOCK_SIZE bytes.
+   The output node already has the dimensions of the input node */
+
+static int copy_data_blocks (int cgio_num_inp, double id_inp,
+    int cgio_num_out, double id_out, const char *data_type,
+    int ndims, const cgsize_t *dims)
+{
+    int size, ierr = CGIO_ERR_NONE;
+    cglong_t count, block;
+    cgsize_t start, end;
+    void *data;
+
+    size = cgio_compute_data_size(data_type, ndims, dims, &count);
+    if (size <= 0 || count <= 0) return CGIO_ERR_NONE;
+    block = COPY_BLOCK_SIZE / size;
+    if (block < 1) block = 1;
+    data = malloc((size_t)(block * size));
+    if (data == NULL) return set_error(CGIO_ERR_MALLOC);
+
+    ierr = cgio_reserve_data(cgio_num_out, id_out);
+    for (start = 1; ierr == CGIO_ERR_NONE && start <= count;
+         start += (cgsize_t)block) {
+        end = start + (cgsize_t)block - 1;
+        if (end > count) end = (cgsize_t)count;
+        ierr = cgio_read_block_data(cgio_num_inp, id_inp, start, end, data);
+        if (ierr == CGIO_ERR_NONE)
+            ierr = cgio_write_block_data(cgio_num_out, id_out,
+                       start, end, data);
+    }
+    free(data);
+    return ierr;
 }
 
 /*---------------------------------------------------------*/
@@ -1156,32 +2565,35 @@ int cgio_copy_node (int cgio_num_inp, double id_inp,
     cgsize_t dims[CGIO_MAX_DIMENSIONS];
     cglong_t data_size = 0;
     void *data = NULL;
+    stats_call call;
 
+    stats_begin(&call, STATS_COPY_NODE, cgio_num_inp);
+    record_args(&call, "fdfd", cgio_num_inp, id_inp, cgio_num_out, id_out);
     if ((input  = get_cgnsio(cgio_num_inp, 0)) == NULL ||
         (output = get_cgnsio(cgio_num_out, 1)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
 
     /* read the input node data */
 
-    if (input->type == CGIO_FILE_ADF || input->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(input->type)) {
         ADF_Get_Label(id_inp, label, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
         ADF_Get_Data_Type(id_inp, data_type, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
         ADF_Get_Number_of_Dimensions(id_inp, &ndims, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
         if (ndims > 0) {
             ADF_Get_Dimension_Values(id_inp, dims, &ierr);
-            if (ierr > 0) return set_error(ierr);
+            if (ierr > 0) return stats_end(&call, set_error(ierr));
 
             data_size = compute_data_size(data_type, ndims, dims);
-            if (data_size) {
+            if (data_size && data_size <= COPY_BLOCK_SIZE) {
                 data = malloc((size_t)data_size);
-                if (data == NULL) return set_error(CGIO_ERR_MALLOC);
+                if (data == NULL) return stats_end(&call, set_error(CGIO_ERR_MALLOC));
                 ADF_Read_All_Data(id_inp, (char *)data, &ierr);
                 if (ierr > 0) {
                     free(data);
-                    return set_error(ierr);
+                    return stats_end(&call, set_error(ierr));
                 }
             }
         }
@@ -1189,44 +2601,67 @@ int cgio_copy_node (int cgio_num_inp, double id_inp,
 #ifdef BUILD_HDF5
     else if (input->type == CGIO_FILE_HDF5) {
         ADFH_Get_Label(id_inp, label, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
         ADFH_Get_Data_Type(id_inp, data_type, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
         ADFH_Get_Number_of_Dimensions(id_inp, &ndims, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
         if (ndims > 0) {
             ADFH_Get_Dimension_Values(id_inp, dims, &ierr);
-            if (ierr > 0) return set_error(ierr);
+            if (ierr > 0) return stats_end(&call, set_error(ierr));
 
             data_size = compute_data_size(data_type, ndims, dims);
-            if (data_size) {
+            if (data_size && data_size <= COPY_BLOCK_SIZE) {
                 data = malloc((size_t)data_size);
-                if (data == NULL) return set_error(CGIO_ERR_MALLOC);
+                if (data == NULL) return stats_end(&call, set_error(CGIO_ERR_MALLOC));
                 ADFH_Read_All_Data(id_inp, (char *)data, &ierr);
                 if (ierr > 0) {
                     free(data);
-                    return set_error(ierr);
+                    return stats_end(&call, set_error(ierr));
                 }
             }
         }
     }
 #endif
+    else if (input->type == CGIO_FILE_MEMORY) {
+        ADFM_Get_Label(id_inp, label, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+        ADFM_Get_Data_Type(id_inp, data_type, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+        ADFM_Get_Number_of_Dimensions(id_inp, &ndims, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+        if (ndims > 0) {
+            ADFM_Get_Dimension_Values(id_inp, dims, &ierr);
+            if (ierr > 0) return stats_end(&call, set_error(ierr));
+
+            data_size = compute_data_size(data_type, ndims, dims);
+            if (data_size && data_size <= COPY_BLOCK_SIZE) {
+                data = malloc((size_t)data_size);
+                if (data == NULL) return stats_end(&call, set_error(CGIO_ERR_MALLOC));
+                ADFM_Read_All_Data(id_inp, (char *)data, &ierr);
+                if (ierr > 0) {
+                    free(data);
+                    return stats_end(&call, set_error(ierr));
+                }
+            }
+        }
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
     /* write data to output node */
 
-    if (output->type == CGIO_FILE_ADF || output->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(output->type)) {
         ADF_Set_Label(id_out, label, &ierr);
         if (ierr <= 0) {
             ADF_Put_Dimension_Information(id_out, data_type, ndims,
                 dims, &ierr);
-            if (ierr <= 0 && data_size)
+            if (ierr <= 0 && data != NULL)
                 ADF_Write_All_Data(id_out, (const char *)data, &ierr);
         }
-        if (data_size) free(data);
-        if (ierr > 0) return set_error(ierr);
+        if (data != NULL) free(data);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (output->type == CGIO_FILE_HDF5) {
@@ -1234,19 +2669,94 @@ int cgio_copy_node (int cgio_num_inp, double id_inp,
         if (ierr <= 0) {
             ADFH_Put_Dimension_Information(id_out, data_type, ndims,
                 dims, &ierr);
-            if (ierr <= 0 && data_size)
+            if (ierr <= 0 && data != NULL)
                 ADFH_Write_All_Data(id_out, (const char *)data, &ierr);
         }
-        if (data_size) free(data);
-        if (ierr > 0) return set_error(ierr);
+        if (data != NULL) free(data);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (output->type == CGIO_FILE_MEMORY) {
+        ADFM_Set_Label(id_out, label, &ierr);
+        if (ierr <= 0) {
+            ADFM_Put_Dimension_Information(id_out, data_type, ndims,
+                dims, &ierr);
+            if (ierr <= 0 && data != NULL)
+                ADFM_Write_All_Data(id_out, (const char *)data, &ierr);
+        }
+        if (data != NULL) free(data);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        if (data_size) free(data);
-        set_error(CGIO_ERR_FILE_TYPE);
+        if (data != NULL) free(data);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    /* large data is copied a block at a time */
+
+    if (data_size > COPY_BLOCK_SIZE &&
+        copy_data_blocks(cgio_num_inp, id_inp, cgio_num_out, id_out,
+            data_type, ndims, dims))
+        return stats_end(&call, get_error());
+
+    call.bytes = data_size;
+    return stats_end(&call, CGIO_ERR_NONE);
+}
+
+/*---------------------------------------------------------*/
+
+/* copies the node at path in the input file, with all its children,
+   to a new child of pid_out. When link_size is more than 0, nodes with
+   at least link_size bytes of data are written as links to the same
+   node in link_file, which should name the input file, instead */
+
+int cgio_extract_node (int cgio_num_inp, const char *path,
+    int cgio_num_out, double pid_out, int follow_links,
+    const char *link_file, cglong_t link_size, double *id_out)
+{
+    int ierr;
+    cgns_io *input, *output;
+    char name[CGIO_MAX_NAME_LENGTH+1];
+    char node_path[CGIO_MAX_LINK_LENGTH+1];
+    double id;
+    stats_call call;
+
+    stats_begin(&call, STATS_EXTRACT_NODE, cgio_num_inp);
+    record_args(&call, "fsfdisl>d", cgio_num_inp, path, cgio_num_out,
+        pid_out, follow_links, link_file, link_size, id_out);
+    if ((input  = get_cgnsio(cgio_num_inp, 0)) == NULL ||
+        (output = get_cgnsio(cgio_num_out, 1)) == NULL)
+        return stats_end(&call, get_error());
+    if (path == NULL || !*path)
+        return stats_end(&call, set_error(CGIO_ERR_NULL_PATH));
+    if (strlen(path) + 1 > CGIO_MAX_LINK_LENGTH)
+        return stats_end(&call, set_error(CGIO_ERR_TOO_SMALL));
+    if (link_size > 0 && (link_file == NULL || !*link_file))
+        return stats_end(&call, set_error(CGIO_ERR_NULL_FILE));
+    if (input->mode != CGIO_MODE_READ &&
+        cgio_flush_to_disk(cgio_num_inp))
+        return stats_end(&call, get_error());
+
+    /* links are made with the absolute path of the node */
+
+    if (*path == '/')
+        strcpy(node_path, path);
+    else
+        sprintf(node_path, "/%s", path);
+
+    if (cgio_get_node_id(cgio_num_inp, input->rootid, node_path, &id))
+        return stats_end(&call, get_error());
+    if (cgio_get_name(cgio_num_inp, id, name) ||
+        cgio_create_node(cgio_num_out, pid_out, name, id_out)) {
+        ierr = get_error();
+        cgio_release_id(cgio_num_inp, id);
+        return stats_end(&call, ierr);
+    }
+    ierr = recurse_nodes(cgio_num_inp, id, cgio_num_out, *id_out,
+               follow_links, link_file, link_size, node_path, 1);
+    cgio_release_id(cgio_num_inp, id);
+    if (ierr) return stats_end(&call, get_error());
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -1274,25 +2784,38 @@ int cgio_is_link (int cgio_num, double id, int *link_len)
 {
     int ierr;
     cgns_io *cgio;
+    cgio_index_node *node;
+    stats_call call;
 
+    stats_begin(&call, STATS_IS_LINK, cgio_num);
+    record_args(&call, "fd", cgio_num, id);
     if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
+
+    if ((node = index_node(cgio, id)) != NULL) {
+        *link_len = node->link_len;
+        return stats_end(&call, CGIO_ERR_NONE);
+    }
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Is_Link(id, link_len, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Is_Link(id, link_len, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Is_Link(id, link_len, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -1302,25 +2825,32 @@ int cgio_link_size (int cgio_num, double id, int *file_len,
 {
     int ierr;
     cgns_io *cgio;
+    stats_call call;
 
+    stats_begin(&call, STATS_LINK_SIZE, cgio_num);
+    record_args(&call, "fd", cgio_num, id);
     if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Link_Size(id, file_len, name_len, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Link_Size(id, file_len, name_len, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Link_Size(id, file_len, name_len, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -1330,25 +2860,33 @@ int cgio_create_link (int cgio_num, double pid, const char *name,
 {
     int ierr;
     cgns_io *cgio;
+    stats_call call;
 
+    stats_begin(&call, STATS_CREATE_LINK, cgio_num);
+    record_args(&call, "fdsss>d", cgio_num, pid, name, filename,
+        name_in_file, id);
     if ((cgio = get_cgnsio(cgio_num, 1)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Link(pid, name, filename, name_in_file, id, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Link(pid, name, filename, name_in_file, id, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Link(pid, name, filename, name_in_file, id, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -1358,25 +2896,32 @@ int cgio_get_link (int cgio_num, double id,
 {
     int ierr;
     cgns_io *cgio;
+    stats_call call;
 
+    stats_begin(&call, STATS_GET_LINK, cgio_num);
+    record_args(&call, "fd", cgio_num, id);
     if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Get_Link_Path(id, filename, name_in_file, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Get_Link_Path(id, filename, name_in_file, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Get_Link_Path(id, filename, name_in_file, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*=========================================================
@@ -1388,25 +2933,38 @@ int cgio_number_children (int cgio_num, double id,
 {
     int ierr;
     cgns_io *cgio;
+    cgio_index_node *node;
+    stats_call call;
 
+    stats_begin(&call, STATS_NUMBER_CHILDREN, cgio_num);
+    record_args(&call, "fd", cgio_num, id);
     if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
+
+    if ((node = index_node(cgio, id)) != NULL && !node->link_len) {
+        *num_children = node->nchildren;
+        return stats_end(&call, CGIO_ERR_NONE);
+    }
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Number_of_Children(id, num_children, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Number_of_Children(id, num_children, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Number_of_Children(id, num_children, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -1414,27 +2972,44 @@ int cgio_number_children (int cgio_num, double id,
 int cgio_children_ids (int cgio_num, double pid,
     int start, int max_ret, int *num_ret, double *ids)
 {
-    int ierr;
+    int n, ierr;
     cgns_io *cgio;
+    cgio_index_node *node;
+    stats_call call;
 
+    stats_begin(&call, STATS_CHILDREN_IDS, cgio_num);
+    record_args(&call, "fdii>D", cgio_num, pid, start, max_ret,
+        num_ret, ids);
     if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
+
+    if ((node = index_node(cgio, pid)) != NULL && !node->link_len &&
+        start > 0) {
+        for (n = 0; n < max_ret && start + n <= node->nchildren; n++)
+            ids[n] = cgio->index->ids[node->children + start + n - 1];
+        *num_ret = n;
+        return stats_end(&call, CGIO_ERR_NONE);
+    }
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Children_IDs(pid, start, max_ret, num_ret, ids, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Children_IDs(pid, start, max_ret, num_ret, ids, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Children_IDs(pid, start, max_ret, num_ret, ids, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -1442,29 +3017,49 @@ int cgio_children_ids (int cgio_num, double pid,
 int cgio_children_names (int cgio_num, double pid, int start, int max_ret,
     int name_len, int *num_ret, char *names)
 {
-    int ierr;
+    int n, ierr;
     cgns_io *cgio;
+    cgio_index_node *node;
+    stats_call call;
 
+    stats_begin(&call, STATS_CHILDREN_NAMES, cgio_num);
+    record_args(&call, "fdiii", cgio_num, pid, start, max_ret, name_len);
     if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
+
+    if ((node = index_node(cgio, pid)) != NULL && !node->link_len &&
+        start > 0 && name_len > 0) {
+        for (n = 0; n < max_ret && start + n <= node->nchildren; n++) {
+            strncpy(&names[n*name_len], cgio->index->nodes[node->children +
+                start + n - 1].name, name_len-1);
+            names[n*name_len+name_len-1] = 0;
+        }
+        *num_ret = n;
+        return stats_end(&call, CGIO_ERR_NONE);
+    }
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Children_Names(pid, start, max_ret, name_len-1,
             num_ret, names, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Children_Names(pid, start, max_ret, name_len,
             num_ret, names, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Children_Names(pid, start, max_ret, name_len,
+            num_ret, names, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*=========================================================
@@ -1474,27 +3069,45 @@ int cgio_children_names (int cgio_num, double pid, int start, int max_ret,
 int cgio_get_node_id (int cgio_num, double pid,
     const char *name, double *id)
 {
-    int ierr;
+    int n, ierr;
     cgns_io *cgio;
+    cgio_index_node *node;
+    stats_call call;
 
+    stats_begin(&call, STATS_GET_NODE_ID, cgio_num);
+    record_args(&call, "fds>d", cgio_num, pid, name, id);
     if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
+
+    if ((node = index_node(cgio, pid)) != NULL && !node->link_len &&
+        strchr(name, '/') == NULL) {
+        for (n = 0; n < node->nchildren; n++) {
+            if (0 == strcmp(name, cgio->index->nodes[node->children+n].name)) {
+                *id = cgio->index->ids[node->children+n];
+                return stats_end(&call, CGIO_ERR_NONE);
+            }
+        }
+    }
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Get_Node_ID(pid, name, id, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Get_Node_ID(pid, name, id, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Get_Node_ID(pid, name, id, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -1503,25 +3116,38 @@ int cgio_get_name (int cgio_num, double id, char *name)
 {
     int ierr;
     cgns_io *cgio;
+    cgio_index_node *node;
+    stats_call call;
 
+    stats_begin(&call, STATS_GET_NAME, cgio_num);
+    record_args(&call, "fd", cgio_num, id);
     if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if ((node = index_node(cgio, id)) != NULL) {
+        strcpy(name, node->name);
+        return stats_end(&call, CGIO_ERR_NONE);
+    }
+
+    if (IS_ADF(cgio->type)) {
         ADF_Get_Name(id, name, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Get_Name(id, name, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Get_Name(id, name, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -1530,25 +3156,38 @@ int cgio_get_label (int cgio_num, double id, char *label)
 {
     int ierr;
     cgns_io *cgio;
+    cgio_index_node *node;
+    stats_call call;
 
+    stats_begin(&call, STATS_GET_LABEL, cgio_num);
+    record_args(&call, "fd", cgio_num, id);
     if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
+
+    if ((node = index_node(cgio, id)) != NULL && !node->link_len) {
+        strcpy(label, node->label);
+        return stats_end(&call, CGIO_ERR_NONE);
+    }
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Get_Label(id, label, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Get_Label(id, label, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Get_Label(id, label, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -1557,25 +3196,38 @@ int cgio_get_data_type (int cgio_num, double id, char *data_type)
 {
     int ierr;
     cgns_io *cgio;
+    cgio_index_node *node;
+    stats_call call;
 
+    stats_begin(&call, STATS_GET_DATA_TYPE, cgio_num);
+    record_args(&call, "fd", cgio_num, id);
     if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
+
+    if ((node = index_node(cgio, id)) != NULL && !node->link_len) {
+        strcpy(data_type, node->data_type);
+        return stats_end(&call, CGIO_ERR_NONE);
+    }
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Get_Data_Type(id, data_type, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Get_Data_Type(id, data_type, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Get_Data_Type(id, data_type, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -1601,18 +3253,31 @@ int cgio_get_data_size (int cgio_num, double id, cglong_t *data_size)
 int cgio_get_dimensions (int cgio_num, double id,
     int *num_dims, cgsize_t *dims)
 {
-    int ierr;
+    int n, ierr;
     cgns_io *cgio;
+    cgio_index_node *node;
+    stats_call call;
 
+    stats_begin(&call, STATS_GET_DIMENSIONS, cgio_num);
+    record_args(&call, "fd", cgio_num, id);
     if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if ((node = index_node(cgio, id)) != NULL && !node->link_len) {
+        *num_dims = node->ndims;
+        if (NULL != dims) {
+            for (n = 0; n < node->ndims; n++)
+                dims[n] = (cgsize_t)node->dims[n];
+        }
+        return stats_end(&call, CGIO_ERR_NONE);
+    }
+
+    if (IS_ADF(cgio->type)) {
         ADF_Get_Number_of_Dimensions(id, num_dims, &ierr);
         if (NULL != dims && ierr <= 0 && *num_dims > 0) {
             ADF_Get_Dimension_Values(id, dims, &ierr);
         }
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
@@ -1620,14 +3285,21 @@ int cgio_get_dimensions (int cgio_num, double id,
         if (NULL != dims && ierr <= 0 && *num_dims > 0) {
             ADFH_Get_Dimension_Values(id, dims, &ierr);
         }
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Get_Number_of_Dimensions(id, num_dims, &ierr);
+        if (NULL != dims && ierr <= 0 && *num_dims > 0) {
+            ADFM_Get_Dimension_Values(id, dims, &ierr);
+        }
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -1636,25 +3308,34 @@ int cgio_read_all_data (int cgio_num, double id, void *data)
 {
     int ierr;
     cgns_io *cgio;
+    stats_call call;
 
+    stats_begin(&call, STATS_READ_ALL_DATA, cgio_num);
     if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
+    if (call.recording)
+        record_args(&call, "fdl", cgio_num, id, stats_bytes(cgio, id, -1));
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Read_All_Data(id, (char *)data, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Read_All_Data(id, (char *)data, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Read_All_Data(id, (char *)data, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    if (call.op) call.bytes = stats_bytes(cgio, id, -1);
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -1664,25 +3345,35 @@ int cgio_read_block_data (int cgio_num, double id,
 {
     int ierr;
     cgns_io *cgio;
+    stats_call call;
 
+    stats_begin(&call, STATS_READ_BLOCK_DATA, cgio_num);
     if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
+    if (call.recording)
+        record_args(&call, "fdlll", cgio_num, id, (cglong_t)b_start,
+            (cglong_t)b_end, stats_bytes(cgio, id, b_end - b_start + 1));
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Read_Block_Data(id, b_start, b_end, (char *)data, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Read_Block_Data(id, b_start, b_end, (char *)data, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Read_Block_Data(id, b_start, b_end, (char *)data, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    if (call.op) call.bytes = stats_bytes(cgio, id, b_end - b_start + 1);
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -1695,27 +3386,160 @@ int cgio_read_data (int cgio_num, double id,
 {
     int ierr;
     cgns_io *cgio;
+    stats_call call;
 
+    stats_begin(&call, STATS_READ_DATA, cgio_num);
     if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
+    if (call.recording)
+        record_data(&call, cgio, id, s_start, s_end, s_stride, m_num_dims,
+            m_dims, m_start, m_end, m_stride);
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Read_Data(id, s_start, s_end, s_stride, m_num_dims,
             m_dims, m_start, m_end, m_stride, (char *)data, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Read_Data(id, s_start, s_end, s_stride, m_num_dims,
             m_dims, m_start, m_end, m_stride, (char *)data, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Read_Data(id, s_start, s_end, s_stride, m_num_dims,
+            m_dims, m_start, m_end, m_stride, (char *)data, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    if (call.op) call.bytes = stats_bytes(cgio, id,
+        stats_count(m_num_dims, m_start, m_end, m_stride));
+    return stats_end(&call, CGIO_ERR_NONE);
+}
+
+/*---------------------------------------------------------*/
+
+int cgio_read_indices (int cgio_num, double id, cgsize_t num,
+    const cgsize_t *indices, void *data)
+{
+    int ierr;
+    cgns_io *cgio;
+    stats_call call;
+
+    stats_begin(&call, STATS_READ_INDICES, cgio_num);
+    if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
+        return stats_end(&call, get_error());
+    if (call.recording)
+        record_args(&call, "fdvl", cgio_num, id, (int)num, indices,
+            stats_bytes(cgio, id, num));
+
+    if (IS_ADF(cgio->type)) {
+        ADF_Read_Indices(id, num, indices, (char *)data, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
+#ifdef BUILD_HDF5
+    else if (cgio->type == CGIO_FILE_HDF5) {
+        ADFH_Read_Indices(id, num, indices, (char *)data, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
+#endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Read_Indices(id, num, indices, (char *)data, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
+    else {
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
+    }
+
+    if (call.op) call.bytes = stats_bytes(cgio, id, num);
+    return stats_end(&call, CGIO_ERR_NONE);
+}
+
+/*---------------------------------------------------------*/
+
+/* the reads are made in the order the backend finds best, which for
+   ADF is the order of the data in the file, with nearby data read
+   together. The error of each read is set in its err, and the first
+   of them is returned */
+
+int cgio_read_batch (int cgio_num, int count, cgio_read_t *reads)
+{
+    int n, ierr, *errs;
+    double *ids;
+    char **data;
+    cgsize_t *b_start, *b_end;
+    cgns_io *cgio;
+    stats_call call;
+
+    stats_begin(&call, STATS_READ_BATCH, cgio_num);
+    if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
+        return stats_end(&call, get_error());
+    if (count < 1) return stats_end(&call, CGIO_ERR_NONE);
+    if (call.recording) {
+        record_args(&call, "fi", cgio_num, count);
+        for (n = 0; n < count; n++)
+            record_args(&call, "dlll", reads[n].id,
+                (cglong_t)reads[n].b_start, (cglong_t)reads[n].b_end,
+                batch_bytes(cgio, &reads[n]));
+    }
+
+    if (IS_ADF(cgio->type)) {
+        ids = (double *) malloc (count * (sizeof(double) + sizeof(char *) +
+                  2 * sizeof(cgsize_t) + sizeof(int)));
+        if (ids == NULL) return stats_end(&call, set_error(CGIO_ERR_MALLOC));
+        data = (char **)(ids + count);
+        b_start = (cgsize_t *)(data + count);
+        b_end = b_start + count;
+        errs = (int *)(b_end + count);
+        for (n = 0; n < count; n++) {
+            ids[n] = reads[n].id;
+            data[n] = (char *)reads[n].data;
+            b_start[n] = reads[n].b_start;
+            b_end[n] = reads[n].b_end;
+        }
+        ADF_Read_Batch(count, ids, b_start, b_end, data, errs, &ierr);
+        for (n = 0; n < count; n++)
+            reads[n].err = errs[n] > 0 ? errs[n] : CGIO_ERR_NONE;
+        free(ids);
+    }
+#ifdef BUILD_HDF5
+    else if (cgio->type == CGIO_FILE_HDF5) {
+        for (n = 0; n < count; n++) {
+            if (reads[n].b_start > 0)
+                ADFH_Read_Block_Data(reads[n].id, reads[n].b_start,
+                    reads[n].b_end, (char *)reads[n].data, &ierr);
+            else
+                ADFH_Read_All_Data(reads[n].id, (char *)reads[n].data, &ierr);
+            reads[n].err = ierr > 0 ? ierr : CGIO_ERR_NONE;
+        }
+    }
+#endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        for (n = 0; n < count; n++) {
+            if (reads[n].b_start > 0)
+                ADFM_Read_Block_Data(reads[n].id, reads[n].b_start,
+                    reads[n].b_end, (char *)reads[n].data, &ierr);
+            else
+                ADFM_Read_All_Data(reads[n].id, (char *)reads[n].data, &ierr);
+            reads[n].err = ierr > 0 ? ierr : CGIO_ERR_NONE;
+        }
+    }
+    else {
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
+    }
+
+    for (n = 0; n < count; n++) {
+        if (reads[n].err) return stats_end(&call, set_error(reads[n].err));
+    }
+    if (call.op) {
+        for (n = 0; n < count; n++)
+            call.bytes += batch_bytes(cgio, &reads[n]);
+    }
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*=========================================================
@@ -1727,25 +3551,32 @@ int cgio_set_name (int cgio_num, double pid, double id,
 {
     int ierr;
     cgns_io *cgio;
+    stats_call call;
 
+    stats_begin(&call, STATS_SET_NAME, cgio_num);
+    record_args(&call, "fdds", cgio_num, pid, id, name);
     if ((cgio = get_cgnsio(cgio_num, 1)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Put_Name(pid, id, name, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Put_Name(pid, id, name, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Put_Name(pid, id, name, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -1754,25 +3585,32 @@ int cgio_set_label (int cgio_num, double id, const char *label)
 {
     int ierr;
     cgns_io *cgio;
+    stats_call call;
 
+    stats_begin(&call, STATS_SET_LABEL, cgio_num);
+    record_args(&call, "fds", cgio_num, id, label);
     if ((cgio = get_cgnsio(cgio_num, 1)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Set_Label(id, label, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Set_Label(id, label, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Set_Label(id, label, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -1782,53 +3620,101 @@ int cgio_set_dimensions (int cgio_num, double id,
 {
     int ierr;
     cgns_io *cgio;
+    stats_call call;
 
+    stats_begin(&call, STATS_SET_DIMENSIONS, cgio_num);
+    record_args(&call, "fdsv", cgio_num, id, data_type, num_dims, dims);
     if ((cgio = get_cgnsio(cgio_num, 1)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Put_Dimension_Information(id, data_type, num_dims, dims, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Put_Dimension_Information(id, data_type, num_dims, dims, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Put_Dimension_Information(id, data_type, num_dims, dims, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
 
+int cgio_reserve_data (int cgio_num, double id)
+{
+    int ierr;
+    cgns_io *cgio;
+    stats_call call;
+
+    stats_begin(&call, STATS_RESERVE_DATA, cgio_num);
+    record_args(&call, "fd", cgio_num, id);
+    if ((cgio = get_cgnsio(cgio_num, 1)) == NULL)
+        return stats_end(&call, get_error());
+
+    if (IS_ADF(cgio->type)) {
+        ADF_Reserve_Data(id, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
+#ifdef BUILD_HDF5
+    else if (cgio->type == CGIO_FILE_HDF5) {
+        ADFH_Reserve_Data(id, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
+#endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Reserve_Data(id, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
+    else {
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
+    }
+
+    return stats_end(&call, CGIO_ERR_NONE);
+}
+
 int cgio_write_all_data (int cgio_num, double id,
     const void *data)
 {
     int ierr;
     cgns_io *cgio;
+    stats_call call;
 
+    stats_begin(&call, STATS_WRITE_ALL_DATA, cgio_num);
     if ((cgio = get_cgnsio(cgio_num, 1)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
+    if (call.recording)
+        record_args(&call, "fdl", cgio_num, id, stats_bytes(cgio, id, -1));
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Write_All_Data(id, (const char *)data, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Write_All_Data(id, (const char *)data, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Write_All_Data(id, (const char *)data, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    if (call.op) call.bytes = stats_bytes(cgio, id, -1);
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -1838,25 +3724,35 @@ int cgio_write_block_data (int cgio_num, double id,
 {
     int ierr;
     cgns_io *cgio;
+    stats_call call;
 
+    stats_begin(&call, STATS_WRITE_BLOCK_DATA, cgio_num);
     if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
+    if (call.recording)
+        record_args(&call, "fdlll", cgio_num, id, (cglong_t)b_start,
+            (cglong_t)b_end, stats_bytes(cgio, id, b_end - b_start + 1));
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Write_Block_Data(id, b_start, b_end, (char *)data, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Write_Block_Data(id, b_start, b_end, (char *)data, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Write_Block_Data(id, b_start, b_end, (char *)data, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
     }
 
-    return CGIO_ERR_NONE;
+    if (call.op) call.bytes = stats_bytes(cgio, id, b_end - b_start + 1);
+    return stats_end(&call, CGIO_ERR_NONE);
 }
 
 /*---------------------------------------------------------*/
@@ -1869,26 +3765,131 @@ int cgio_write_data (int cgio_num, double id,
 {
     int ierr;
     cgns_io *cgio;
+    stats_call call;
 
+    stats_begin(&call, STATS_WRITE_DATA, cgio_num);
     if ((cgio = get_cgnsio(cgio_num, 1)) == NULL)
-        return get_error();
+        return stats_end(&call, get_error());
+    if (call.recording)
+        record_data(&call, cgio, id, s_start, s_end, s_stride, m_num_dims,
+            m_dims, m_start, m_end, m_stride);
 
-    if (cgio->type == CGIO_FILE_ADF || cgio->type == CGIO_FILE_ADF2) {
+    if (IS_ADF(cgio->type)) {
         ADF_Write_Data(id, s_start, s_end, s_stride, m_num_dims,
             m_dims, m_start, m_end, m_stride, (const char *)data, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #ifdef BUILD_HDF5
     else if (cgio->type == CGIO_FILE_HDF5) {
         ADFH_Write_Data(id, s_start, s_end, s_stride, m_num_dims,
             m_dims, m_start, m_end, m_stride, (const char *)data, &ierr);
-        if (ierr > 0) return set_error(ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
+#endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Write_Data(id, s_start, s_end, s_stride, m_num_dims,
+            m_dims, m_start, m_end, m_stride, (const char *)data, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
+    else {
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
+    }
+
+    if (call.op) call.bytes = stats_bytes(cgio, id,
+        stats_count(m_num_dims, m_start, m_end, m_stride));
+    return stats_end(&call, CGIO_ERR_NONE);
+}
+
+/*---------------------------------------------------------*/
+
+int cgio_write_indices (int cgio_num, double id, cgsize_t num,
+    const cgsize_t *indices, const void *data)
+{
+    int ierr;
+    cgns_io *cgio;
+    stats_call call;
+
+    stats_begin(&call, STATS_WRITE_INDICES, cgio_num);
+    if ((cgio = get_cgnsio(cgio_num, 1)) == NULL)
+        return stats_end(&call, get_error());
+    if (call.recording)
+        record_args(&call, "fdvl", cgio_num, id, (int)num, indices,
+            stats_bytes(cgio, id, num));
+
+    if (IS_ADF(cgio->type)) {
+        ADF_Write_Indices(id, num, indices, (const char *)data, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
+#ifdef BUILD_HDF5
+    else if (cgio->type == CGIO_FILE_HDF5) {
+        ADFH_Write_Indices(id, num, indices, (const char *)data, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
     }
 #endif
+    else if (cgio->type == CGIO_FILE_MEMORY) {
+        ADFM_Write_Indices(id, num, indices, (const char *)data, &ierr);
+        if (ierr > 0) return stats_end(&call, set_error(ierr));
+    }
     else {
-        return set_error(CGIO_ERR_FILE_TYPE);
+        return stats_end(&call, set_error(CGIO_ERR_FILE_TYPE));
+    }
+
+    if (call.op) call.bytes = stats_bytes(cgio, id, num);
+    return stats_end(&call, CGIO_ERR_NONE);
+}
+
+/*=========================================================
+ * call statistics
+ *=========================================================*/
+
+int cgio_stats_number (int *num_ops)
+{
+    *num_ops = STATS_NUM_OPS;
+    return set_error(CGIO_ERR_NONE);
+}
+
+/*---------------------------------------------------------*/
+
+int cgio_stats_read (int op, char *name, cgio_stats_t *stats)
+{
+    if (op < 1 || op > STATS_NUM_OPS)
+        return set_error(CGIO_ERR_BAD_OPTION);
+    if (name != NULL)
+        strcpy(name, stats_names[op-1]);
+    if (stats != NULL) {
+#ifdef CGIO_ASYNC_THREADS
+        pthread_mutex_lock(&stats_mutex);
+#endif
+        *stats = stats_ops[op-1];
+#ifdef CGIO_ASYNC_THREADS
+        pthread_mutex_unlock(&stats_mutex);
+#endif
     }
+    return set_error(CGIO_ERR_NONE);
+}
+
+/*---------------------------------------------------------*/
+
+int cgio_stats_file (int cgio_num, cgio_stats_t *stats)
+{
+    cgns_io *cgio;
 
+    if ((cgio = get_cgnsio(cgio_num, 0)) == NULL)
+        return get_error();
+    *stats = cgio->stats;
     return CGIO_ERR_NONE;
 }
 
+/*---------------------------------------------------------*/
+
+int cgio_stats_memory (cglong_t *mem_now, cglong_t *mem_max)
+{
+    /* only the cgmalloc family in cg_malloc.c keeps count */
+#ifdef MEM_DEBUG
+    *mem_now = (cglong_t)cgmemnow();
+    *mem_max = (cglong_t)cgmemmax();
+#else
+    *mem_now = *mem_max = -1;
+#endif
+    return set_error(CGIO_ERR_NONE);
+}
@@ -40,6 +40,21 @@ freely, subject to the following restrictions:
 #define CGIO_FILE_ADF    1
 #define CGIO_FILE_HDF5   2
 #define CGIO_FILE_ADF2   3
+#define CGIO_FILE_ADF3   4
+#define CGIO_FILE_MEMORY 5
+
+/* cgio configuration options (cgio_configure) */
+
+#define CGIO_CONFIG_INDEX 101
+#define CGIO_CONFIG_ADF_SYNC 102
+#define CGIO_CONFIG_ADF_MERGE 103
+#define CGIO_CONFIG_ADF_DIRECT 104
+#define CGIO_CONFIG_PREALLOCATE 105
+#define CGIO_CONFIG_ADF_COMPRESS 106
+#define CGIO_CONFIG_STATS 107
+#define CGIO_CONFIG_TRACE 108
+#define CGIO_CONFIG_RECORD 109
+#define CGIO_CONFIG_ADF_QUEUE 110
 
 /* currently these are the same as for ADF */
 
@@ -74,6 +89,33 @@ freely, subject to the following restrictions:
 #define CGIO_ERR_TOO_MANY    -15
 #define CGIO_ERR_DIMENSIONS  -16
 
+/* call statistics (CGIO_CONFIG_STATS), one set per entry point and
+   one per open file. Bin n of the histogram counts the calls that
+   took less than 2^n microseconds, and more than the bin before. */
+
+#define CGIO_STATS_BINS 32
+
+typedef struct {
+    cglong_t calls;
+    cglong_t errors;
+    cglong_t bytes;
+    double time;
+    double max_time;
+    cglong_t histogram[CGIO_STATS_BINS];
+} cgio_stats_t;
+
+/* one read of a batch (cgio_read_batch): all the data of the node when
+   b_start is less than 1, otherwise the block b_start to b_end. err is
+   set to the error of the read */
+
+typedef struct {
+    double id;
+    cgsize_t b_start;
+    cgsize_t b_end;
+    void *data;
+    int err;
+} cgio_read_t;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -224,6 +266,23 @@ CGEXTERN int cgio_new_node (
     double *id
 );
 
+CGEXTERN int cgio_new_node_async (
+    int cgio_num,
+    double pid,
+    const char *name,
+    const char *label,
+    const char *data_type,
+    int num_dims,
+    const cgsize_t *dim_vals,
+    void *data,
+    void (*release)(void *),
+    double *id
+);
+
+CGEXTERN int cgio_wait (
+    int cgio_num
+);
+
 CGEXTERN int cgio_delete_node (
     int cgio_num,
     double pid,
@@ -244,6 +303,17 @@ CGEXTERN int cgio_copy_node (
     double id_out
 );
 
+CGEXTERN int cgio_extract_node (
+    int cgio_num_inp,
+    const char *path,
+    int cgio_num_out,
+    double pid_out,
+    int follow_links,
+    const char *link_file,
+    cglong_t link_size,
+    double *id_out
+);
+
 CGEXTERN int cgio_release_id (
     int cgio_num,
     double id
@@ -375,6 +445,20 @@ CGEXTERN int cgio_read_data (
     void *data
 );
 
+CGEXTERN int cgio_read_indices (
+    int cgio_num,
+    double id,
+    cgsize_t num,
+    const cgsize_t *indices,
+    void *data
+);
+
+CGEXTERN int cgio_read_batch (
+    int cgio_num,
+    int count,
+    cgio_read_t *reads
+);
+
 /*---------------------------------------------------------*/
 
 CGEXTERN int cgio_set_name (
@@ -398,6 +482,11 @@ CGEXTERN int cgio_set_dimensions (
     const cgsize_t *dims
 );
 
+CGEXTERN int cgio_reserve_data (
+    int cgio_num,
+    double id
+);
+
 CGEXTERN int cgio_write_all_data (
     int cgio_num,
     double id,
@@ -426,6 +515,36 @@ CGEXTERN int cgio_write_data (
     const void *data
 );
 
+CGEXTERN int cgio_write_indices (
+    int cgio_num,
+    double id,
+    cgsize_t num,
+    const cgsize_t *indices,
+    const void *data
+);
+
+/*---------------------------------------------------------*/
+
+CGEXTERN int cgio_stats_number (
+    int *num_ops
+);
+
+CGEXTERN int cgio_stats_read (
+    int op,
+    char *name,
+    cgio_stats_t *stats
+);
+
+CGEXTERN int cgio_stats_file (
+    int cgio_num,
+    cgio_stats_t *stats
+);
+
+CGEXTERN int cgio_stats_memory (
+    cglong_t *mem_now,
+    cglong_t *mem_max
+);
+
 #ifdef __cplusplus
 }
 #endif
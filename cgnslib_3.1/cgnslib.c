@@ -91,6 +91,7 @@ cgns_posit *posit = 0;
 int posit_file, posit_base, posit_zone;
 int CGNSLibVersion=CGNS_VERSION;/* Version of the CGNSLibrary*1000  */
 int cgns_compress = -1;
+int cgns_async_write = 0;
 int cgns_filetype = CG_FILE_NONE;
 
 extern void (*cgns_error_handler)(int, char *);
@@ -271,7 +272,7 @@ int cg_is_cgns(const char *filename, int *file_type)
 
 int cg_open(const char * filename, int mode, int *file_number)
 {
-    int not_found, cgio;
+    int not_found, cgio, type;
     cgsize_t dim_vals;
     double dummy_id;
     float FileVersion;
@@ -286,6 +287,14 @@ int cg_open(const char * filename, int mode, int *file_number)
 
     not_found = ACCESS(filename, F_OK) ;
 
+    /* set default file type if not done */
+    if (cgns_filetype == CG_FILE_NONE)
+        cg_set_file_type(CG_FILE_NONE);
+
+    /* an in-memory file is not on disk */
+    if (not_found)
+        not_found = cgio_check_file(filename, &type) != CG_OK;
+
     /* check file mode */
     switch(mode) {
         case CG_MODE_READ:
@@ -295,7 +304,7 @@ int cg_open(const char * filename, int mode, int *file_number)
             }
             break;
         case CG_MODE_WRITE:
-            if (!not_found) {
+            if (!not_found && cgns_filetype != CG_FILE_MEMORY) {
                 UNLINK(filename);
                 /*cgi_error("Error opening file: '%s' already exists!", filename);
                         return CG_ERROR;
@@ -303,6 +312,7 @@ int cg_open(const char * filename, int mode, int *file_number)
             }
             break;
         case CG_MODE_MODIFY:
+        case CG_MODE_APPEND:
             if (not_found) {
                 cgi_error("Error opening file: '%s' not found!", filename);
                 return CG_ERROR;
@@ -313,12 +323,9 @@ int cg_open(const char * filename, int mode, int *file_number)
             return CG_ERROR;
     }
 
-    /* set default file type if not done */
-    if (cgns_filetype == CG_FILE_NONE)
-        cg_set_file_type(CG_FILE_NONE);
-
-    /* Open CGNS file */
-    if (cgio_open_file(filename, mode, cgns_filetype, &cgio)) {
+    /* Open CGNS file; append mode is modify mode for the I/O layer */
+    if (cgio_open_file(filename, mode == CG_MODE_APPEND ? CG_MODE_MODIFY :
+            mode, cgns_filetype, &cgio)) {
         cg_io_error("cgio_open_file");
         return CG_ERROR;
     }
@@ -346,6 +353,7 @@ int cg_open(const char * filename, int mode, int *file_number)
     cg->version = 0;
     cg->deleted = 0;
     cg->added = 0;
+    cg->async = 0;
 
      /* CGNS-Library Version */
     if (mode == CG_MODE_WRITE) {
@@ -397,12 +405,13 @@ int cg_open(const char * filename, int mode, int *file_number)
         return CG_ERROR;
     }
 
-    /* read CGNS file */
-    if (mode == CG_MODE_READ || mode == CG_MODE_MODIFY) {
+    /* read CGNS file (only a lightweight index in append mode) */
+    if (mode == CG_MODE_READ || mode == CG_MODE_MODIFY ||
+        mode == CG_MODE_APPEND) {
         if (cgi_read()) return CG_ERROR;
 
         /* update version number in modify mode */
-        if (cg->version < CGNSLibVersion && mode == CG_MODE_MODIFY && 
+        if (cg->version < CGNSLibVersion && mode != CG_MODE_READ && 
             (cgns_filetype!=CG_FILE_ADF2 || cg->version < CGNS_COMPATVERSION)) {
             int nnod;
             double *id;
@@ -531,6 +540,7 @@ int cg_close(int file_number)
         cgns_file_size, cgmemnow(), cgmemmax());
 #endif
 
+    /* CG_MODE_APPEND never rewrites the file on close */
     if (cgns_compress && cg->mode == CG_MODE_MODIFY &&
        (cg->deleted || cgns_compress == 1)) {
         if (cgio_compress_file (cg->cgio, cg->filename)) {
@@ -568,6 +578,19 @@ int cg_close(int file_number)
     return CG_OK;
 }
 
+int cg_flush(int file_number)
+{
+     /* cgi_get_file waits for any write-behind arrays */
+    cg = cgi_get_file(file_number);
+    if (cg == 0) return CG_ERROR;
+
+    if (cg->mode != CG_MODE_READ && cgio_flush_to_disk(cg->cgio)) {
+        cg_io_error("cgio_flush_to_disk");
+        return CG_ERROR;
+    }
+    return CG_OK;
+}
+
 int cg_save_as(int file_number, const char *filename, int file_type,
                int follow_links)
 {
@@ -597,6 +620,176 @@ int cg_save_as(int file_number, const char *filename, int file_type,
     return CG_OK;
 }
 
+/* copies the nodes of a base to the output file, except the zones that
+   are not selected. Nodes with at least link_size bytes of data are
+   written as links to the input file instead, when link_size > 0 */
+
+static int extract_base(int output, cgns_base *base, int nzones,
+                        const int *zones, cgsize_t link_size)
+{
+    int n, z, cnt, nchild;
+    double root_id, base_id, child_id, id;
+    char name[CGIO_MAX_NAME_LENGTH+1], label[CGIO_MAX_LABEL_LENGTH+1];
+    char path[2*CGIO_MAX_NAME_LENGTH+3];
+
+    if (cgio_get_root_id(output, &root_id) ||
+        cgio_create_node(output, root_id, base->name, &base_id) ||
+        cgio_copy_node(cg->cgio, base->id, output, base_id) ||
+        cgio_number_children(cg->cgio, base->id, &nchild)) {
+        cg_io_error("cgio_copy_node");
+        return CG_ERROR;
+    }
+    for (n = 1; n <= nchild; n++) {
+        if (cgio_children_ids(cg->cgio, base->id, n, 1, &cnt, &child_id)) {
+            cg_io_error("cgio_children_ids");
+            return CG_ERROR;
+        }
+        if (cgio_get_name(cg->cgio, child_id, name) ||
+            cgio_get_label(cg->cgio, child_id, label)) {
+            cgio_release_id(cg->cgio, child_id);
+            cg_io_error("cgio_get_label");
+            return CG_ERROR;
+        }
+        cgio_release_id(cg->cgio, child_id);
+        if (0 == strcmp(label, "Zone_t")) {
+            for (z = 0; z < nzones; z++) {
+                if (0 == strcmp(name, base->zone[zones[z]-1].name)) break;
+            }
+            if (z == nzones) continue;
+        }
+        sprintf(path, "/%s/%s", base->name, name);
+        if (cgio_extract_node(cg->cgio, path, output, base_id, 0,
+                cg->filename, (cglong_t)link_size, &id)) {
+            cg_io_error("cgio_extract_node");
+            return CG_ERROR;
+        }
+    }
+    return CG_OK;
+}
+
+int cg_extract_zones(int file_number, int B, int nzones, const int *zones,
+                     const char *filename, int file_type, cgsize_t link_size)
+{
+    int n, z, cnt, nchild, output, type, ierr = CG_OK;
+    double root_id, child_id, id;
+    char name[CGIO_MAX_NAME_LENGTH+1], label[CGIO_MAX_LABEL_LENGTH+1];
+    char path[CGIO_MAX_NAME_LENGTH+2];
+    cgns_base *base;
+
+    cg = cgi_get_file(file_number);
+    if (cg == 0) return CG_ERROR;
+
+    base = cgi_get_base(cg, B);
+    if (base == 0) return CG_ERROR;
+
+    if (nzones < 1 || zones == NULL) {
+        cgi_error("no zones given to extract");
+        return CG_ERROR;
+    }
+    for (z = 0; z < nzones; z++) {
+        if (zones[z] < 1 || zones[z] > base->nzones) {
+            cgi_error("Zone number %d invalid", zones[z]);
+            return CG_ERROR;
+        }
+    }
+
+    if (file_type == CG_FILE_NONE)
+        file_type = cgns_filetype;
+    if (cgio_is_supported(file_type)) {
+        cgi_error("file type unknown or not supported");
+        return CG_ERROR;
+    }
+
+    /* a link can only be followed into a file of the same kind */
+
+    if (link_size > 0) {
+        if (cgio_get_file_type(cg->cgio, &type)) {
+            cg_io_error("cgio_get_file_type");
+            return CG_ERROR;
+        }
+        if (type == CG_FILE_MEMORY || file_type == CG_FILE_MEMORY ||
+            (type == CG_FILE_HDF5) != (file_type == CG_FILE_HDF5)) {
+            cgi_error("links need the output file type to match the input");
+            return CG_ERROR;
+        }
+    }
+    if (cgio_open_file(filename, CG_MODE_WRITE, file_type, &output)) {
+        cg_io_error ("cgio_open_file");
+        return CG_ERROR;
+    }
+
+    /* the top level nodes, other than the bases, are all copied */
+
+    if (cgio_get_root_id(cg->cgio, &root_id) ||
+        cgio_number_children(cg->cgio, root_id, &nchild)) {
+        cg_io_error("cgio_number_children");
+        cgio_close_file(output);
+        return CG_ERROR;
+    }
+    for (n = 1; n <= nchild && ierr == CG_OK; n++) {
+        if (cgio_children_ids(cg->cgio, root_id, n, 1, &cnt, &child_id)) {
+            cg_io_error("cgio_children_ids");
+            ierr = CG_ERROR;
+            break;
+        }
+        if (cgio_get_name(cg->cgio, child_id, name) ||
+            cgio_get_label(cg->cgio, child_id, label)) {
+            cg_io_error("cgio_get_label");
+            ierr = CG_ERROR;
+        }
+        cgio_release_id(cg->cgio, child_id);
+        if (ierr == CG_OK && 0 != strcmp(label, "CGNSBase_t")) {
+            sprintf(path, "/%s", name);
+            if (cgio_get_root_id(output, &id) ||
+                cgio_extract_node(cg->cgio, path, output, id, 0,
+                    cg->filename, (cglong_t)link_size, &id)) {
+                cg_io_error("cgio_extract_node");
+                ierr = CG_ERROR;
+            }
+        }
+    }
+    if (ierr == CG_OK)
+        ierr = extract_base(output, base, nzones, zones, link_size);
+
+    if (cgio_close_file(output) && ierr == CG_OK) {
+        cg_io_error("cgio_close_file");
+        ierr = CG_ERROR;
+    }
+    return ierr;
+}
+
+int cg_extract_family(int file_number, int B, const char *family_name,
+                      const char *filename, int file_type, cgsize_t link_size)
+{
+    int z, nzones = 0, ierr, *zones;
+    cgns_base *base;
+
+    cg = cgi_get_file(file_number);
+    if (cg == 0) return CG_ERROR;
+
+    base = cgi_get_base(cg, B);
+    if (base == 0) return CG_ERROR;
+
+    if (base->nzones == 0) {
+        cgi_error("no zones in family %s", family_name);
+        return CG_ERROR;
+    }
+    zones = CGNS_NEW(int, base->nzones);
+    for (z = 0; z < base->nzones; z++) {
+        if (0 == strcmp(base->zone[z].family_name, family_name))
+            zones[nzones++] = z + 1;
+    }
+    if (nzones == 0) {
+        cgi_error("no zones in family %s", family_name);
+        CGNS_FREE(zones);
+        return CG_ERROR;
+    }
+    ierr = cg_extract_zones(file_number, B, nzones, zones, filename,
+                            file_type, link_size);
+    CGNS_FREE(zones);
+    return ierr;
+}
+
 int cg_set_file_type(int file_type)
 {
     if (file_type == CG_FILE_NONE) {
@@ -622,6 +815,13 @@ int cg_set_file_type(int file_type)
             cgns_filetype = CG_FILE_ADF2;
 #endif
 	}
+	else if (*type == '4' || *type == 'c' || *type == 'C' ||
+                 ((*type == 'a' || *type == 'A') && strchr(type, '3') != NULL)) {
+            cgns_filetype = CG_FILE_ADF3;
+        }
+	else if (*type == '5' || *type == 'm' || *type == 'M') {
+            cgns_filetype = CG_FILE_MEMORY;
+        }
         else
             cgns_filetype = CG_FILE_ADF;
     }
@@ -696,6 +896,10 @@ int cg_configure(int what, void *value)
     else if (what == CG_CONFIG_FILE_TYPE) {
         return cg_set_file_type((int)((size_t)value));
     }
+    /* write-behind of coordinate and solution arrays */
+    else if (what == CG_CONFIG_ASYNC_WRITE) {
+        cgns_async_write = (int)((size_t)value);
+    }
     else {
         cgi_error("unknown config setting");
         return CG_ERROR;
@@ -865,7 +1069,7 @@ int cg_nbases(int file_number, int *nbases)
     cg = cgi_get_file(file_number);
     if (cg == 0) return CG_ERROR;
 
-    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_READ)) return CG_ERROR;
+    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_APPEND)) return CG_ERROR;
 
     *nbases = cg->nbases;
     return CG_OK;
@@ -879,7 +1083,7 @@ int cg_base_read(int file_number, int B, char *basename, int *cell_dim,
     cg = cgi_get_file(file_number);
     if (cg == 0) return CG_ERROR;
 
-    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_READ)) return CG_ERROR;
+    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_APPEND)) return CG_ERROR;
 
     base = cgi_get_base(cg, B);
     if (base==0) return CG_ERROR;
@@ -898,7 +1102,7 @@ int cg_base_id(int file_number, int B, double *base_id)
     cg = cgi_get_file(file_number);
     if (cg == 0) return CG_ERROR;
 
-    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_READ)) return CG_ERROR;
+    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_APPEND)) return CG_ERROR;
 
     base = cgi_get_base(cg, B);
     if (base==0) return CG_ERROR;
@@ -1000,7 +1204,7 @@ int cg_nzones(int file_number, int B, int *nzones)
     cg = cgi_get_file(file_number);
     if (cg == 0) return CG_ERROR;
 
-    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_READ)) return CG_ERROR;
+    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_APPEND)) return CG_ERROR;
 
     base = cgi_get_base(cg, B);
     if (base==0) return CG_ERROR;
@@ -1016,7 +1220,7 @@ int cg_zone_type(int file_number, int B, int Z, CGNS_ENUMT(ZoneType_t) *type)
     cg = cgi_get_file(file_number);
     if (cg == 0) return CG_ERROR;
 
-    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_READ)) return CG_ERROR;
+    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_APPEND)) return CG_ERROR;
 
     zone = cgi_get_zone(cg, B, Z);
     if (zone==0) return CG_ERROR;
@@ -1033,7 +1237,7 @@ int cg_zone_read(int file_number, int B, int Z, char *zonename, cgsize_t *nijk)
     cg = cgi_get_file(file_number);
     if (cg == 0) return CG_ERROR;
 
-    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_READ)) return CG_ERROR;
+    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_APPEND)) return CG_ERROR;
 
     zone = cgi_get_zone(cg, B, Z);
     if (zone==0) return CG_ERROR;
@@ -1052,7 +1256,7 @@ int cg_zone_id(int file_number, int B, int Z, double *zone_id)
     cg = cgi_get_file(file_number);
     if (cg == 0) return CG_ERROR;
 
-    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_READ)) return CG_ERROR;
+    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_APPEND)) return CG_ERROR;
 
     zone = cgi_get_zone(cg, B, Z);
     if (zone==0) return CG_ERROR;
@@ -1093,6 +1297,13 @@ int cg_zone_write(int file_number, int B, const char *zonename, const cgsize_t *
      /* verify input */
     if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_WRITE)) return CG_ERROR;
 
+     /* CG_MODE_APPEND only indexes solutions; a new zone couldn't be completed */
+    if (cg->mode == CG_MODE_APPEND) {
+        cgi_error("File %s opened in append mode; use modify mode to add zones",
+            cg->filename);
+        return CG_ERROR;
+    }
+
      /* get memory address for base */
     base = cgi_get_base(cg, B);
     if (base==0) return CG_ERROR;
@@ -2086,6 +2297,94 @@ int cg_coord_read(int file_number, int B, int Z, const char * coordname,
     return ierr ? CG_ERROR : CG_OK;
 }
 
+int cg_coord_general_read(int file_number, int B, int Z,
+                          const char *coordname, CGNS_ENUMT(DataType_t) type,
+                          const cgsize_t *s_rmin, const cgsize_t *s_rmax,
+                          const cgsize_t *s_stride, int m_numdim,
+                          const cgsize_t *m_dimvals, const cgsize_t *m_rmin,
+                          const cgsize_t *m_rmax, const cgsize_t *m_stride,
+                          void *coord_ptr)
+{
+    cgns_zcoor *zcoor;
+    cgns_array *coord;
+    int c;
+
+     /* verify input */
+    if (type != CGNS_ENUMV(RealSingle) && type != CGNS_ENUMV(RealDouble)) {
+        cgi_error("Invalid data type for coord. array: %d",type);
+        return CG_ERROR;
+    }
+     /* find address */
+    cg = cgi_get_file(file_number);
+    if (cg == 0) return CG_ERROR;
+
+    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_READ)) return CG_ERROR;
+
+     /* Get memory address for node "GridCoordinates" */
+    zcoor = cgi_get_zcoorGC(cg, B, Z);
+    if (zcoor==0) return CG_ERROR;
+
+     /* find the coord address in the database */
+    coord = 0;
+    for (c=0; c<zcoor->ncoords; c++) {
+        if (strcmp(zcoor->coord[c].name, coordname)==0) {
+            coord = &zcoor->coord[c];
+            break;
+        }
+    }
+    if (coord==0) {
+        cgi_error("Coordinate %s not found.",coordname);
+        return CG_NODE_NOT_FOUND;
+    }
+
+    if (cgi_array_general_read(coord, type, s_rmin, s_rmax, s_stride,
+            m_numdim, m_dimvals, m_rmin, m_rmax, m_stride, coord_ptr))
+        return CG_ERROR;
+    return CG_OK;
+}
+
+int cg_coord_read_indexed(int file_number, int B, int Z,
+                          const char *coordname, CGNS_ENUMT(DataType_t) type,
+                          cgsize_t num, const cgsize_t *indices,
+                          void *coord_ptr)
+{
+    cgns_zcoor *zcoor;
+    cgns_array *coord;
+    int c;
+
+     /* verify input */
+    if (type != CGNS_ENUMV(RealSingle) && type != CGNS_ENUMV(RealDouble)) {
+        cgi_error("Invalid data type for coord. array: %d",type);
+        return CG_ERROR;
+    }
+     /* find address */
+    cg = cgi_get_file(file_number);
+    if (cg == 0) return CG_ERROR;
+
+    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_READ)) return CG_ERROR;
+
+     /* Get memory address for node "GridCoordinates" */
+    zcoor = cgi_get_zcoorGC(cg, B, Z);
+    if (zcoor==0) return CG_ERROR;
+
+     /* find the coord address in the database */
+    coord = 0;
+    for (c=0; c<zcoor->ncoords; c++) {
+        if (strcmp(zcoor->coord[c].name, coordname)==0) {
+            coord = &zcoor->coord[c];
+            break;
+        }
+    }
+    if (coord==0) {
+        cgi_error("Coordinate %s not found.",coordname);
+        return CG_NODE_NOT_FOUND;
+    }
+
+    if (cgi_array_indexed_read(coord, type, num, indices, coord_ptr))
+        return CG_ERROR;
+    return CG_OK;
+}
+
 int cg_coord_id(int file_number, int B, int Z, int C, double *coord_id)
 {
     cgns_zcoor *zcoor;
@@ -2122,8 +2421,9 @@ int cg_coord_write(int file_number, int B, int Z, CGNS_ENUMT(DataType_t) type,
         cgi_error("Invalid datatype for coord. array:  %d", type);
         return CG_ERROR;
     }
-     /* get memory address for file */
-    cg = cgi_get_file(file_number);
+     /* get memory address for file (don't wait on queued writes) */
+    cg = cgns_async_write ? cgi_find_file(file_number) :
+                            cgi_get_file(file_number);
     if (cg == 0) return CG_ERROR;
 
     if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_WRITE)) return CG_ERROR;
@@ -2148,6 +2448,7 @@ int cg_coord_write(int file_number, int B, int Z, CGNS_ENUMT(DataType_t) type,
             }
 
              /* overwrite an existing coordinate vector */
+            if (cg->async && cgi_async_wait(cg)) return CG_ERROR;
             if (type==cgi_datatype(coord->data_type)) {
                 if (cgio_write_all_data(cg->cgio, coord->id, coord_ptr)) {
                     cg_io_error("cgio_write_all_data");
@@ -2187,8 +2488,13 @@ int cg_coord_write(int file_number, int B, int Z, CGNS_ENUMT(DataType_t) type,
         if (cgi_new_node(zone->id, "GridCoordinates", "GridCoordinates_t",
             &zcoor->id, "MT", 0, 0, 0)) return CG_ERROR;
     }
-     /* Create DataArray_t node on disk */
-    if (cgi_new_node(zcoor->id, coord->name, "DataArray_t", &coord->id,
+     /* Create DataArray_t node on disk, or queue it */
+    if (cgns_async_write) {
+        if (cgi_new_node_async(B, Z, 0, *C, zcoor->id, coord->name,
+            "DataArray_t", coord->data_type, index_dim, coord->dim_vals,
+            coord_ptr)) return CG_ERROR;
+    }
+    else if (cgi_new_node(zcoor->id, coord->name, "DataArray_t", &coord->id,
         coord->data_type, index_dim, coord->dim_vals, coord_ptr)) return CG_ERROR;
 
     return CG_OK;
@@ -2285,17 +2591,181 @@ int cg_coord_partial_write(int file_number, int B, int Z,
      /* save coord. data in memory */
     strcpy(coord->data_type,cgi_adf_datatype(type));
     strcpy(coord->name,coordname);
-    coord->id=0;        /* initialize */
-    coord->link=0;
-    for (n = 0; n < index_dim; n++)
-        coord->dim_vals[n] = dims[n];
-    coord->data_dim=index_dim;
-    coord->data=0;
-    coord->ndescr=0;
-    coord->data_class=CGNS_ENUMV( DataClassNull );
-    coord->units=0;
-    coord->exponents=0;
-    coord->convert=0;
+    coord->id=0;        /* initialize */
+    coord->link=0;
+    for (n = 0; n < index_dim; n++)
+        coord->dim_vals[n] = dims[n];
+    coord->data_dim=index_dim;
+    coord->data=0;
+    coord->ndescr=0;
+    coord->data_class=CGNS_ENUMV( DataClassNull );
+    coord->units=0;
+    coord->exponents=0;
+    coord->convert=0;
+
+     /* Create GridCoodinates_t node if not already created */
+    if (zcoor->id == 0) {
+        if (cgi_new_node(zone->id, "GridCoordinates", "GridCoordinates_t",
+            &zcoor->id, "MT", 0, 0, 0)) return CG_ERROR;
+    }
+
+     /* Create DataArray_t node on disk */
+    if (cgi_new_node_partial(zcoor->id, coord->name, "DataArray_t", &coord->id,
+        coord->data_type, index_dim, coord->dim_vals, rmin, rmax,
+	coord_ptr))
+	return CG_ERROR;
+
+    return CG_OK;
+}
+
+int cg_coord_general_write(int file_number, int B, int Z,
+                           CGNS_ENUMT(DataType_t) type, const char *coordname,
+                           const cgsize_t *s_rmin, const cgsize_t *s_rmax,
+                           const cgsize_t *s_stride, int m_numdim,
+                           const cgsize_t *m_dimvals, const cgsize_t *m_rmin,
+                           const cgsize_t *m_rmax, const cgsize_t *m_stride,
+                           const void *coord_ptr, int *C)
+{
+    cgns_zone *zone;
+    cgns_zcoor *zcoor;
+    cgns_array *coord;
+    int n, index;
+
+     /* verify input */
+    if (cgi_check_strlen(coordname)) return CG_ERROR;
+    if (type!=CGNS_ENUMV( RealSingle ) && type!=CGNS_ENUMV( RealDouble )) {
+        cgi_error("Invalid datatype for coord. array:  %d", type);
+        return CG_ERROR;
+    }
+
+     /* get memory address for file */
+    cg = cgi_get_file(file_number);
+    if (cg == 0) return CG_ERROR;
+
+    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_WRITE)) return CG_ERROR;
+
+     /* get memory address for zone */
+    zone = cgi_get_zone(cg, B, Z);
+    if (zone==0) return CG_ERROR;
+
+     /* Get memory address for node "GridCoordinates" */
+    zcoor = cgi_get_zcoorGC(cg, B, Z);
+    if (zcoor==0) return CG_ERROR;
+
+     /* Overwrite a DataArray_t Node of same name and data-type: */
+    for (index=0; index<zcoor->ncoords; index++) {
+        if (strcmp(coordname, zcoor->coord[index].name)==0) {
+            coord = &(zcoor->coord[index]);
+            /* data type must be the same */
+            if (strcmp(coord->data_type,cgi_adf_datatype(type))) {
+                cgi_error("Mismatch in data types.");
+                return CG_ERROR;
+            }
+            if (cgi_array_general_write(zcoor->id, coord, s_rmin, s_rmax,
+                    s_stride, m_numdim, m_dimvals, m_rmin, m_rmax,
+                    m_stride, coord_ptr)) return CG_ERROR;
+            (*C) = index+1;
+            return CG_OK;
+        }
+    }
+
+     /* add a DataArray_t Node: */
+    if (zcoor->ncoords == 0) {
+        zcoor->coord = CGNS_NEW(cgns_array, zcoor->ncoords+1);
+    } else {
+        zcoor->coord = CGNS_RENEW(cgns_array, zcoor->ncoords+1, zcoor->coord);
+    }
+    coord = &(zcoor->coord[zcoor->ncoords]);
+    zcoor->ncoords++;
+    (*C) = zcoor->ncoords;
+
+     /* save coord. data in memory */
+    memset(coord, 0, sizeof(cgns_array));
+    strcpy(coord->data_type,cgi_adf_datatype(type));
+    strcpy(coord->name,coordname);
+    coord->data_dim = zone->index_dim;
+    for (n = 0; n < zone->index_dim; n++)
+        coord->dim_vals[n] = zone->nijk[n] + zcoor->rind_planes[2*n] +
+                                             zcoor->rind_planes[2*n+1];
+
+     /* Create GridCoodinates_t node if not already created */
+    if (zcoor->id == 0) {
+        if (cgi_new_node(zone->id, "GridCoordinates", "GridCoordinates_t",
+            &zcoor->id, "MT", 0, 0, 0)) return CG_ERROR;
+    }
+
+     /* Create DataArray_t node on disk and write the hyperslab */
+    if (cgi_array_general_write(zcoor->id, coord, s_rmin, s_rmax, s_stride,
+            m_numdim, m_dimvals, m_rmin, m_rmax, m_stride, coord_ptr))
+        return CG_ERROR;
+    return CG_OK;
+}
+
+int cg_coord_reserve(int file_number, int B, int Z,
+                     CGNS_ENUMT(DataType_t) type, const char *coordname,
+                     int *C)
+{
+    cgns_zone *zone;
+    cgns_zcoor *zcoor;
+    cgns_array *coord;
+    int n, index;
+
+     /* verify input */
+    if (cgi_check_strlen(coordname)) return CG_ERROR;
+    if (type!=CGNS_ENUMV( RealSingle ) && type!=CGNS_ENUMV( RealDouble )) {
+        cgi_error("Invalid datatype for coord. array:  %d", type);
+        return CG_ERROR;
+    }
+
+     /* get memory address for file */
+    cg = cgi_get_file(file_number);
+    if (cg == 0) return CG_ERROR;
+
+    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_WRITE)) return CG_ERROR;
+
+     /* get memory address for zone */
+    zone = cgi_get_zone(cg, B, Z);
+    if (zone==0) return CG_ERROR;
+
+     /* Get memory address for node "GridCoordinates" */
+    zcoor = cgi_get_zcoorGC(cg, B, Z);
+    if (zcoor==0) return CG_ERROR;
+
+     /* an existing array keeps its data, only the type must match */
+    for (index=0; index<zcoor->ncoords; index++) {
+        if (strcmp(coordname, zcoor->coord[index].name)==0) {
+            coord = &(zcoor->coord[index]);
+            if (strcmp(coord->data_type,cgi_adf_datatype(type))) {
+                cgi_error("Mismatch in data types.");
+                return CG_ERROR;
+            }
+            if (cgio_reserve_data(cg->cgio, coord->id)) {
+                cg_io_error("cgio_reserve_data");
+                return CG_ERROR;
+            }
+            (*C) = index+1;
+            return CG_OK;
+        }
+    }
+
+     /* add a DataArray_t Node: */
+    if (zcoor->ncoords == 0) {
+        zcoor->coord = CGNS_NEW(cgns_array, zcoor->ncoords+1);
+    } else {
+        zcoor->coord = CGNS_RENEW(cgns_array, zcoor->ncoords+1, zcoor->coord);
+    }
+    coord = &(zcoor->coord[zcoor->ncoords]);
+    zcoor->ncoords++;
+    (*C) = zcoor->ncoords;
+
+     /* save coord. data in memory */
+    memset(coord, 0, sizeof(cgns_array));
+    strcpy(coord->data_type,cgi_adf_datatype(type));
+    strcpy(coord->name,coordname);
+    coord->data_dim = zone->index_dim;
+    for (n = 0; n < zone->index_dim; n++)
+        coord->dim_vals[n] = zone->nijk[n] + zcoor->rind_planes[2*n] +
+                                             zcoor->rind_planes[2*n+1];
 
      /* Create GridCoodinates_t node if not already created */
     if (zcoor->id == 0) {
@@ -2303,12 +2773,14 @@ int cg_coord_partial_write(int file_number, int B, int Z,
             &zcoor->id, "MT", 0, 0, 0)) return CG_ERROR;
     }
 
-     /* Create DataArray_t node on disk */
-    if (cgi_new_node_partial(zcoor->id, coord->name, "DataArray_t", &coord->id,
-        coord->data_type, index_dim, coord->dim_vals, rmin, rmax,
-	coord_ptr))
-	return CG_ERROR;
-
+     /* Create DataArray_t node on disk, with space for the data */
+    if (cgi_new_node(zcoor->id, coord->name, "DataArray_t", &coord->id,
+        coord->data_type, coord->data_dim, coord->dim_vals, NULL))
+        return CG_ERROR;
+    if (cgio_reserve_data(cg->cgio, coord->id)) {
+        cg_io_error("cgio_reserve_data");
+        return CG_ERROR;
+    }
     return CG_OK;
 }
 
@@ -3728,7 +4200,7 @@ int cg_nsols(int file_number, int B, int Z, int *nsols)
     cg = cgi_get_file(file_number);
     if (cg == 0) return CG_ERROR;
 
-    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_READ)) return CG_ERROR;
+    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_APPEND)) return CG_ERROR;
 
     zone = cgi_get_zone(cg, B, Z);
     if (zone==0) return CG_ERROR;
@@ -3745,7 +4217,7 @@ int cg_sol_info(int file_number, int B, int Z, int S, char *solname,
     cg = cgi_get_file(file_number);
     if (cg == 0) return CG_ERROR;
 
-    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_READ)) return CG_ERROR;
+    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_APPEND)) return CG_ERROR;
 
     sol = cgi_get_sol(cg, B, Z, S);
     if (sol==0) return CG_ERROR;
@@ -3762,7 +4234,7 @@ int cg_sol_id(int file_number, int B, int Z, int S, double *sol_id)
     cg = cgi_get_file(file_number);
     if (cg == 0) return CG_ERROR;
 
-    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_READ)) return CG_ERROR;
+    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_APPEND)) return CG_ERROR;
 
     sol = cgi_get_sol(cg, B, Z, S);
     if (sol==0) return CG_ERROR;
@@ -4165,6 +4637,88 @@ int cg_field_read(int file_number, int B, int Z, int S, const char *fieldname,
     return ierr ? CG_ERROR : CG_OK;
 }
 
+int cg_field_general_read(int file_number, int B, int Z, int S,
+                          const char *fieldname, CGNS_ENUMT(DataType_t) type,
+                          const cgsize_t *s_rmin, const cgsize_t *s_rmax,
+                          const cgsize_t *s_stride, int m_numdim,
+                          const cgsize_t *m_dimvals, const cgsize_t *m_rmin,
+                          const cgsize_t *m_rmax, const cgsize_t *m_stride,
+                          void *field_ptr)
+{
+    cgns_sol *sol;
+    cgns_array *field;
+    int f;
+
+     /* verify input */
+    if (type<0 || type>=NofValidDataTypes) {
+        cgi_error("Invalid data type requested for flow solution: %d",type);
+        return CG_ERROR;
+    }
+    cg = cgi_get_file(file_number);
+    if (cg == 0) return CG_ERROR;
+
+    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_READ)) return CG_ERROR;
+
+    sol = cgi_get_sol(cg, B, Z, S);
+    if (sol==0) return CG_ERROR;
+    field = 0;
+    for (f=0; f<sol->nfields; f++) {
+        if (strcmp(sol->field[f].name, fieldname)==0) {
+            field = cgi_get_field(cg, B, Z, S, f+1);
+            if (field==0) return CG_ERROR;
+            break;
+        }
+    }
+    if (field==0) {
+        cgi_error("Flow solution array %s not found",fieldname);
+        return CG_NODE_NOT_FOUND;
+    }
+
+    if (cgi_array_general_read(field, type, s_rmin, s_rmax, s_stride,
+            m_numdim, m_dimvals, m_rmin, m_rmax, m_stride, field_ptr))
+        return CG_ERROR;
+    return CG_OK;
+}
+
+int cg_field_read_indexed(int file_number, int B, int Z, int S,
+                          const char *fieldname, CGNS_ENUMT(DataType_t) type,
+                          cgsize_t num, const cgsize_t *indices,
+                          void *field_ptr)
+{
+    cgns_sol *sol;
+    cgns_array *field;
+    int f;
+
+     /* verify input */
+    if (type<0 || type>=NofValidDataTypes) {
+        cgi_error("Invalid data type requested for flow solution: %d",type);
+        return CG_ERROR;
+    }
+    cg = cgi_get_file(file_number);
+    if (cg == 0) return CG_ERROR;
+
+    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_READ)) return CG_ERROR;
+
+    sol = cgi_get_sol(cg, B, Z, S);
+    if (sol==0) return CG_ERROR;
+    field = 0;
+    for (f=0; f<sol->nfields; f++) {
+        if (strcmp(sol->field[f].name, fieldname)==0) {
+            field = cgi_get_field(cg, B, Z, S, f+1);
+            if (field==0) return CG_ERROR;
+            break;
+        }
+    }
+    if (field==0) {
+        cgi_error("Flow solution array %s not found",fieldname);
+        return CG_NODE_NOT_FOUND;
+    }
+
+    if (cgi_array_indexed_read(field, type, num, indices, field_ptr))
+        return CG_ERROR;
+    return CG_OK;
+}
+
 int cg_field_id(int file_number, int B, int Z, int S, int F, double *field_id)
 {
     cgns_array *field;
@@ -4196,8 +4750,9 @@ int cg_field_write(int file_number, int B, int Z, int S, CGNS_ENUMT(DataType_t)
         cgi_error("Invalid datatype for solution array %s: %d",fieldname, type);
         return CG_ERROR;
     }
-     /* get memory addresses */
-    cg = cgi_get_file(file_number);
+     /* get memory addresses (don't wait on queued writes) */
+    cg = cgns_async_write ? cgi_find_file(file_number) :
+                            cgi_get_file(file_number);
     if (cg == 0) return CG_ERROR;
 
     if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_WRITE)) return CG_ERROR;
@@ -4220,6 +4775,7 @@ int cg_field_write(int file_number, int B, int Z, int S, CGNS_ENUMT(DataType_t)
             }
 
              /* overwrite an existing solution */
+            if (cg->async && cgi_async_wait(cg)) return CG_ERROR;
             if (type==cgi_datatype(field->data_type)) {
                 if (cgio_write_all_data(cg->cgio, field->id, field_ptr)) {
                     cg_io_error("cgio_write_all_data");
@@ -4257,8 +4813,13 @@ int cg_field_write(int file_number, int B, int Z, int S, CGNS_ENUMT(DataType_t)
         field->dim_vals[0] = sol->ptset->size_of_patch;
     }
 
-     /* Save DataArray_t node on disk: */
-    if (cgi_new_node(sol->id, field->name, "DataArray_t", &field->id,
+     /* Save DataArray_t node on disk, or queue it: */
+    if (cgns_async_write) {
+        if (cgi_new_node_async(B, Z, S, *F, sol->id, field->name,
+            "DataArray_t", field->data_type, field->data_dim,
+            field->dim_vals, field_ptr)) return CG_ERROR;
+    }
+    else if (cgi_new_node(sol->id, field->name, "DataArray_t", &field->id,
         field->data_type, field->data_dim, field->dim_vals, field_ptr))
         return CG_ERROR;
 
@@ -4381,6 +4942,202 @@ int cg_field_partial_write(int file_number, int B, int Z, int S,
     return CG_OK;
 }
 
+int cg_field_general_write(int file_number, int B, int Z, int S,
+                           CGNS_ENUMT(DataType_t) type, const char *fieldname,
+                           const cgsize_t *s_rmin, const cgsize_t *s_rmax,
+                           const cgsize_t *s_stride, int m_numdim,
+                           const cgsize_t *m_dimvals, const cgsize_t *m_rmin,
+                           const cgsize_t *m_rmax, const cgsize_t *m_stride,
+                           const void *field_ptr, int *F)
+{
+    cgns_zone *zone;
+    cgns_sol *sol;
+    cgns_array *field;
+    int index;
+
+     /* verify input */
+    if (cgi_check_strlen(fieldname)) return CG_ERROR;
+    if (type!=CGNS_ENUMV( RealSingle ) && type!=CGNS_ENUMV( RealDouble ) &&
+        type!=CGNS_ENUMV( Integer ) && type!=CGNS_ENUMV( LongInteger )) {
+        cgi_error("Invalid datatype for solution array %s: %d",fieldname, type);
+        return CG_ERROR;
+    }
+
+     /* get memory addresses */
+    cg = cgi_get_file(file_number);
+    if (cg == 0) return CG_ERROR;
+
+    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_WRITE)) return CG_ERROR;
+
+    zone = cgi_get_zone(cg, B, Z);
+    if (zone==0) return CG_ERROR;
+
+    sol = cgi_get_sol(cg, B, Z, S);
+    if (sol==0) return CG_ERROR;
+
+     /* Overwrite a DataArray_t  Node: */
+    for (index=0; index<sol->nfields; index++) {
+        if (strcmp(fieldname, sol->field[index].name)==0) {
+            field = &(sol->field[index]);
+            /* data type must be the same */
+            if (strcmp(field->data_type, cgi_adf_datatype(type))) {
+                cgi_error("Mismatch in data types.");
+                return CG_ERROR;
+            }
+            if (cgi_array_general_write(sol->id, field, s_rmin, s_rmax,
+                    s_stride, m_numdim, m_dimvals, m_rmin, m_rmax,
+                    m_stride, field_ptr)) return CG_ERROR;
+            (*F) = index+1;
+            return CG_OK;
+        }
+    }
+
+     /* add a DataArray_t Node: */
+    if (sol->nfields == 0) {
+        sol->field = CGNS_NEW(cgns_array, sol->nfields+1);
+    } else {
+        sol->field = CGNS_RENEW(cgns_array, sol->nfields+1, sol->field);
+    }
+    field = &(sol->field[sol->nfields]);
+    sol->nfields++;
+    (*F) = sol->nfields;
+
+     /* save data in memory */
+    memset(field, 0, sizeof(cgns_array));
+    strcpy(field->data_type, cgi_adf_datatype(type));
+    strcpy(field->name, fieldname);
+    if (sol->ptset == NULL) {
+        field->data_dim = zone->index_dim;
+        if (cgi_datasize(zone->index_dim, zone->nijk, sol->location,
+                sol->rind_planes, field->dim_vals)) return CG_ERROR;
+    } else {
+        field->data_dim = 1;
+        field->dim_vals[0] = sol->ptset->size_of_patch;
+    }
+
+     /* Save DataArray_t node on disk and write the hyperslab */
+    if (cgi_array_general_write(sol->id, field, s_rmin, s_rmax, s_stride,
+            m_numdim, m_dimvals, m_rmin, m_rmax, m_stride, field_ptr))
+        return CG_ERROR;
+    return CG_OK;
+}
+
+int cg_field_reserve(int file_number, int B, int Z, int S,
+                     CGNS_ENUMT(DataType_t) type, const char *fieldname,
+                     int *F)
+{
+    cgns_zone *zone;
+    cgns_sol *sol;
+    cgns_array *field;
+    int index;
+
+     /* verify input */
+    if (cgi_check_strlen(fieldname)) return CG_ERROR;
+    if (type != CGNS_ENUMV(RealSingle) && type != CGNS_ENUMV(RealDouble) &&
+        type != CGNS_ENUMV(Integer) && type != CGNS_ENUMV(LongInteger)) {
+        cgi_error("Invalid datatype for solution array %s: %d",fieldname, type);
+        return CG_ERROR;
+    }
+
+     /* get memory addresses */
+    cg = cgi_get_file(file_number);
+    if (cg == 0) return CG_ERROR;
+
+    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_WRITE)) return CG_ERROR;
+
+    zone = cgi_get_zone(cg, B, Z);
+    if (zone==0) return CG_ERROR;
+
+    sol = cgi_get_sol(cg, B, Z, S);
+    if (sol==0) return CG_ERROR;
+
+     /* an existing array keeps its data, only the type must match */
+    for (index=0; index<sol->nfields; index++) {
+        if (strcmp(fieldname, sol->field[index].name)==0) {
+            field = &(sol->field[index]);
+            if (strcmp(field->data_type, cgi_adf_datatype(type))) {
+                cgi_error("Mismatch in data types.");
+                return CG_ERROR;
+            }
+            if (cgio_reserve_data(cg->cgio, field->id)) {
+                cg_io_error("cgio_reserve_data");
+                return CG_ERROR;
+            }
+            (*F) = index+1;
+            return CG_OK;
+        }
+    }
+
+     /* add a DataArray_t Node: */
+    if (sol->nfields == 0) {
+        sol->field = CGNS_NEW(cgns_array, sol->nfields+1);
+    } else {
+        sol->field = CGNS_RENEW(cgns_array, sol->nfields+1, sol->field);
+    }
+    field = &(sol->field[sol->nfields]);
+    sol->nfields++;
+    (*F) = sol->nfields;
+
+     /* save data in memory */
+    memset(field, 0, sizeof(cgns_array));
+    strcpy(field->data_type, cgi_adf_datatype(type));
+    strcpy(field->name, fieldname);
+    if (sol->ptset == NULL) {
+        field->data_dim = zone->index_dim;
+        if (cgi_datasize(zone->index_dim, zone->nijk, sol->location,
+                sol->rind_planes, field->dim_vals)) return CG_ERROR;
+    } else {
+        field->data_dim = 1;
+        field->dim_vals[0] = sol->ptset->size_of_patch;
+    }
+
+     /* Save DataArray_t node on disk, with space for the data */
+    if (cgi_new_node(sol->id, field->name, "DataArray_t", &field->id,
+        field->data_type, field->data_dim, field->dim_vals, NULL))
+        return CG_ERROR;
+    if (cgio_reserve_data(cg->cgio, field->id)) {
+        cg_io_error("cgio_reserve_data");
+        return CG_ERROR;
+    }
+    return CG_OK;
+}
+
+int cg_zone_reserve(int file_number, int B, int Z,
+                    CGNS_ENUMT(DataType_t) type, int S, int nfields,
+                    const char * const *fieldnames)
+{
+    static const char *coordnames[3] = {
+        "CoordinateX", "CoordinateY", "CoordinateZ"
+    };
+    cgns_base *base;
+    int n, index;
+
+     /* verify input */
+    if (nfields < 0 || (nfields > 0 && fieldnames == NULL)) {
+        cgi_error("Invalid field names for zone %d", Z);
+        return CG_ERROR;
+    }
+
+    cg = cgi_get_file(file_number);
+    if (cg == 0) return CG_ERROR;
+
+    base = cgi_get_base(cg, B);
+    if (base==0) return CG_ERROR;
+
+     /* the Cartesian coordinates for the physical dimension ... */
+    for (n = 0; n < base->phys_dim && n < 3; n++) {
+        if (cg_coord_reserve(file_number, B, Z, type, coordnames[n], &index))
+            return CG_ERROR;
+    }
+
+     /* ... and the fields of solution S */
+    for (n = 0; n < nfields; n++) {
+        if (cg_field_reserve(file_number, B, Z, S, type, fieldnames[n],
+                &index)) return CG_ERROR;
+    }
+    return CG_OK;
+}
+
 /*************************************************************************\
  *      Read and write ZoneSubRegion_t Nodes                             *
 \*************************************************************************/
@@ -6701,7 +7458,7 @@ int cg_biter_read(int file_number, int B, char *bitername, int *nsteps)
     cg = cgi_get_file(file_number);
     if (cg == 0) return CG_ERROR;
 
-    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_READ)) return CG_ERROR;
+    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_APPEND)) return CG_ERROR;
 
     biter = cgi_get_biter(cg, B);
     if (biter==0) return CG_NODE_NOT_FOUND;
@@ -6776,7 +7533,7 @@ int cg_ziter_read(int file_number, int B, int Z, char *zitername)
     cg = cgi_get_file(file_number);
     if (cg == 0) return CG_ERROR;
 
-    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_READ)) return CG_ERROR;
+    if (cgi_check_mode(cg->filename, cg->mode, CG_MODE_APPEND)) return CG_ERROR;
 
     ziter = cgi_get_ziter(cg, B, Z);
     if (ziter==0) return CG_NODE_NOT_FOUND;
@@ -10603,7 +11360,7 @@ int cg_delete_node(const char *node_name)
     char_33 node_label;
 
      /* verify input */
-    if (cg->mode != CG_MODE_MODIFY) {
+    if (cg->mode != CG_MODE_MODIFY && cg->mode != CG_MODE_APPEND) {
         cgi_error("File %s must be opened in mode modify to delete a node", cg->filename);
         return CG_ERROR;
     }
@@ -77,6 +77,7 @@ freely, subject to the following restrictions:
 #define CG_MODE_WRITE	1
 #define CG_MODE_MODIFY  2
 #define CG_MODE_CLOSED  3
+#define CG_MODE_APPEND  4
 
 /* file types */
 
@@ -84,6 +85,8 @@ freely, subject to the following restrictions:
 #define CG_FILE_ADF  1
 #define CG_FILE_HDF5 2
 #define CG_FILE_ADF2 3
+#define CG_FILE_ADF3 4
+#define CG_FILE_MEMORY 5
 
 /* function return codes */
 
@@ -109,8 +112,20 @@ freely, subject to the following restrictions:
 #define CG_CONFIG_SET_PATH  3
 #define CG_CONFIG_ADD_PATH  4
 #define CG_CONFIG_FILE_TYPE 5
-
+#define CG_CONFIG_ASYNC_WRITE 6
+
+#define CG_CONFIG_INDEX           101
+#define CG_CONFIG_ADF_SYNC        102
+#define CG_CONFIG_ADF_MERGE       103
+#define CG_CONFIG_ADF_DIRECT      104
+#define CG_CONFIG_PREALLOCATE     105
+#define CG_CONFIG_ADF_COMPRESS    106
+#define CG_CONFIG_STATS           107
+#define CG_CONFIG_TRACE           108
+#define CG_CONFIG_RECORD          109
+#define CG_CONFIG_ADF_QUEUE       110
 #define CG_CONFIG_HDF5_COMPRESS   201
+#define CG_CONFIG_HDF5_META       204
 
 #ifdef __cplusplus
 extern "C" {
@@ -649,8 +664,13 @@ CGNSDLL int cg_is_cgns(const char *filename, int *file_type);
 CGNSDLL int cg_open(const char * filename, int mode, int *fn);
 CGNSDLL int cg_version(int fn, float *FileVersion);
 CGNSDLL int cg_close(int fn);
+CGNSDLL int cg_flush(int fn);
 CGNSDLL int cg_save_as(int fn, const char *filename, int file_type,
 	int follow_links);
+CGNSDLL int cg_extract_zones(int fn, int B, int nzones, const int *zones,
+	const char *filename, int file_type, cgsize_t link_size);
+CGNSDLL int cg_extract_family(int fn, int B, const char *family_name,
+	const char *filename, int file_type, cgsize_t link_size);
 
 CGNSDLL int cg_set_file_type(int file_type);
 CGNSDLL int cg_get_file_type(int fn, int *file_type);
@@ -789,6 +809,15 @@ CGNSDLL int cg_coord_info(int fn, int B, int Z, int C,
 CGNSDLL int cg_coord_read(int fn, int B, int Z, const char * coordname,
 	CGNS_ENUMT(DataType_t) type, const cgsize_t * rmin,
 	const cgsize_t * rmax, void *coord);
+CGNSDLL int cg_coord_general_read(int fn, int B, int Z,
+	const char * coordname, CGNS_ENUMT(DataType_t) type,
+	const cgsize_t *s_rmin, const cgsize_t *s_rmax,
+	const cgsize_t *s_stride, int m_numdim, const cgsize_t *m_dimvals,
+	const cgsize_t *m_rmin, const cgsize_t *m_rmax,
+	const cgsize_t *m_stride, void *coord);
+CGNSDLL int cg_coord_read_indexed(int fn, int B, int Z,
+	const char * coordname, CGNS_ENUMT(DataType_t) type,
+	cgsize_t num, const cgsize_t *indices, void *coord);
 CGNSDLL int cg_coord_id(int fn, int B, int Z, int C, double *coord_id);
 CGNSDLL int cg_coord_write(int fn, int B, int Z,
 	CGNS_ENUMT(DataType_t) type, const char * coordname,
@@ -798,6 +827,14 @@ CGNSDLL int cg_coord_partial_write(int fn, int B, int Z,
 	CGNS_ENUMT(DataType_t) type, const char * coordname,
         const cgsize_t *rmin, const cgsize_t *rmax,
         const void * coord_ptr, int *C);
+CGNSDLL int cg_coord_general_write(int fn, int B, int Z,
+	CGNS_ENUMT(DataType_t) type, const char * coordname,
+	const cgsize_t *s_rmin, const cgsize_t *s_rmax,
+	const cgsize_t *s_stride, int m_numdim, const cgsize_t *m_dimvals,
+	const cgsize_t *m_rmin, const cgsize_t *m_rmax,
+	const cgsize_t *m_stride, const void * coord_ptr, int *C);
+CGNSDLL int cg_coord_reserve(int fn, int B, int Z,
+	CGNS_ENUMT(DataType_t) type, const char * coordname, int *C);
 
 /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - *\
  *      Read and write Elements_t Nodes                                  *
@@ -866,6 +903,15 @@ CGNSDLL int cg_field_info(int fn,int B,int Z,int S, int F,
 CGNSDLL int cg_field_read(int fn, int B, int Z, int S, const char *fieldname,
 	CGNS_ENUMT(DataType_t) type, const cgsize_t *rmin,
         const cgsize_t *rmax, void *field_ptr);
+CGNSDLL int cg_field_general_read(int fn, int B, int Z, int S,
+	const char *fieldname, CGNS_ENUMT(DataType_t) type,
+	const cgsize_t *s_rmin, const cgsize_t *s_rmax,
+	const cgsize_t *s_stride, int m_numdim, const cgsize_t *m_dimvals,
+	const cgsize_t *m_rmin, const cgsize_t *m_rmax,
+	const cgsize_t *m_stride, void *field_ptr);
+CGNSDLL int cg_field_read_indexed(int fn, int B, int Z, int S,
+	const char *fieldname, CGNS_ENUMT(DataType_t) type,
+	cgsize_t num, const cgsize_t *indices, void *field_ptr);
 CGNSDLL int cg_field_id(int fn, int B, int Z,int S, int F, double *field_id);
 CGNSDLL int cg_field_write(int fn,int B,int Z,int S,
 	CGNS_ENUMT(DataType_t) type, const char * fieldname,
@@ -875,6 +921,17 @@ CGNSDLL int cg_field_partial_write(int fn, int B, int Z, int S,
 	CGNS_ENUMT(DataType_t) type, const char * fieldname,
 	const cgsize_t *rmin, const cgsize_t *rmax,
         const void * field_ptr, int *F);
+CGNSDLL int cg_field_general_write(int fn, int B, int Z, int S,
+	CGNS_ENUMT(DataType_t) type, const char * fieldname,
+	const cgsize_t *s_rmin, const cgsize_t *s_rmax,
+	const cgsize_t *s_stride, int m_numdim, const cgsize_t *m_dimvals,
+	const cgsize_t *m_rmin, const cgsize_t *m_rmax,
+	const cgsize_t *m_stride, const void * field_ptr, int *F);
+CGNSDLL int cg_field_reserve(int fn, int B, int Z, int S,
+	CGNS_ENUMT(DataType_t) type, const char * fieldname, int *F);
+CGNSDLL int cg_zone_reserve(int fn, int B, int Z,
+	CGNS_ENUMT(DataType_t) type, int S, int nfields,
+	const char * const *fieldnames);
 
 /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - *\
  *      Read and write ZoneSubRegion_t Nodes                             *
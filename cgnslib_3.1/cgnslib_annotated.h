@@ -31,12 +31,12 @@ freely, subject to the following restrictions:
 /*%default_strfree cg_free */
 /*%default_retlast 1 */
 /*%default_retname ierr */
-/*%enumdef CG_MODE_READ, CG_MODE_WRITE, CG_MODE_MODIFY, CG_MODE_CLOSED */
-/*%enumdef CG_FILE_NONE, CG_FILE_ADF, CG_FILE_HDF5, CG_FILE_ADF2 */
+/*%enumdef CG_MODE_READ, CG_MODE_WRITE, CG_MODE_MODIFY, CG_MODE_CLOSED, CG_MODE_APPEND */
+/*%enumdef CG_FILE_NONE, CG_FILE_ADF, CG_FILE_HDF5, CG_FILE_ADF2, CG_FILE_ADF3, CG_FILE_MEMORY */
 /*%enumdef CG_OK,CG_ERROR, CG_NODE_NOT_FOUND, CG_INCORRECT_PATH, CG_NO_INDEX_DIM */
 /*%enumdef CG_Null, CG_UserDefined */
 /*%enumdef CG_MAX_GOTO_DEPTH */
-/*%enumdef CG_CONFIG_ERROR, CG_CONFIG_COMPRESS, CG_CONFIG_SET_PATH, CG_CONFIG_ADD_PATH, CG_CONFIG_FILE_TYPE, CG_CONFIG_HDF5_COMPRESS */
+/*%enumdef CG_CONFIG_ERROR, CG_CONFIG_COMPRESS, CG_CONFIG_SET_PATH, CG_CONFIG_ADD_PATH, CG_CONFIG_FILE_TYPE, CG_CONFIG_ASYNC_WRITE, CG_CONFIG_INDEX, CG_CONFIG_ADF_SYNC, CG_CONFIG_ADF_MERGE, CG_CONFIG_ADF_DIRECT, CG_CONFIG_PREALLOCATE, CG_CONFIG_ADF_COMPRESS, CG_CONFIG_STATS, CG_CONFIG_TRACE, CG_CONFIG_RECORD, CG_CONFIG_ADF_QUEUE, CG_CONFIG_HDF5_COMPRESS, CG_CONFIG_HDF5_META */
 
 #ifndef CGNSLIB_H
 #define CGNSLIB_H
@@ -101,6 +101,7 @@ typedef ptrdiff_t cgsize_t;
 #define CG_MODE_WRITE	1
 #define CG_MODE_MODIFY  2
 #define CG_MODE_CLOSED  3
+#define CG_MODE_APPEND  4
 
 /* file types */
 
@@ -108,6 +109,8 @@ typedef ptrdiff_t cgsize_t;
 #define CG_FILE_ADF  1
 #define CG_FILE_HDF5 2
 #define CG_FILE_ADF2 3
+#define CG_FILE_ADF3 4
+#define CG_FILE_MEMORY 5
 
 /* function return codes */
 
@@ -133,8 +136,20 @@ typedef ptrdiff_t cgsize_t;
 #define CG_CONFIG_SET_PATH  3
 #define CG_CONFIG_ADD_PATH  4
 #define CG_CONFIG_FILE_TYPE 5
-
+#define CG_CONFIG_ASYNC_WRITE 6
+
+#define CG_CONFIG_INDEX           101
+#define CG_CONFIG_ADF_SYNC        102
+#define CG_CONFIG_ADF_MERGE       103
+#define CG_CONFIG_ADF_DIRECT      104
+#define CG_CONFIG_PREALLOCATE     105
+#define CG_CONFIG_ADF_COMPRESS    106
+#define CG_CONFIG_STATS           107
+#define CG_CONFIG_TRACE           108
+#define CG_CONFIG_RECORD          109
+#define CG_CONFIG_ADF_QUEUE       110
 #define CG_CONFIG_HDF5_COMPRESS   201
+#define CG_CONFIG_HDF5_META       204
 
 #ifdef __cplusplus
 extern "C" {
@@ -681,9 +696,18 @@ CGNSDLL int cg_version(int fn, float *FileVersion);
 /*%url http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/fileops.html */
 CGNSDLL int cg_close(int fn);
 /*%url http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/fileops.html */
+CGNSDLL int cg_flush(int fn);
+/*%url http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/fileops.html */
 CGNSDLL int cg_save_as(int fn, const char *filename, int file_type,
 	int follow_links);
 /*%url http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/fileops.html */
+CGNSDLL int cg_extract_zones(int fn, int B, int nzones, const int *zones,
+	const char *filename, int file_type, cgsize_t link_size);
+/*%input zones(nzones) */
+/*%url http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/fileops.html */
+CGNSDLL int cg_extract_family(int fn, int B, const char *family_name,
+	const char *filename, int file_type, cgsize_t link_size);
+/*%url http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/fileops.html */
 CGNSDLL int cg_set_file_type(int file_type);
 /*%url http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/fileops.html */
 CGNSDLL int cg_get_file_type(int fn, int *file_type);
@@ -926,6 +950,23 @@ CGNSDLL int cg_coord_read(int fn, int B, int Z, const char * coordname,
 /*%input rmin(:), rmax(:) */
 /*%url http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/grid.html */
 
+CGNSDLL int cg_coord_general_read(int fn, int B, int Z,
+	const char * coordname, CGNS_ENUMT(DataType_t) type,
+	const cgsize_t *s_rmin, const cgsize_t *s_rmax,
+	const cgsize_t *s_stride, int m_numdim, const cgsize_t *m_dimvals,
+	const cgsize_t *m_rmin, const cgsize_t *m_rmax,
+	const cgsize_t *m_stride, void *coord);
+/*%typecast coord:type */
+/*%input s_rmin(:), s_rmax(:), s_stride(:), m_dimvals(:), m_rmin(:), m_rmax(:), m_stride(:) */
+/*%url http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/grid.html */
+
+CGNSDLL int cg_coord_read_indexed(int fn, int B, int Z,
+	const char * coordname, CGNS_ENUMT(DataType_t) type,
+	cgsize_t num, const cgsize_t *indices, void *coord);
+/*%typecast coord:type */
+/*%input indices(num) */
+/*%url http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/grid.html */
+
 CGNSDLL int cg_coord_id(int fn, int B, int Z, int C, double *coord_id);
 /*%output coord_id */
 CGNSDLL int cg_coord_write(int fn, int B, int Z,
@@ -945,6 +986,22 @@ CGNSDLL int cg_coord_partial_write(int fn, int B, int Z,
 /*%output C */
 /*%url http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/grid.html */
 
+CGNSDLL int cg_coord_general_write(int fn, int B, int Z,
+	CGNS_ENUMT(DataType_t) type, const char * coordname,
+	const cgsize_t *s_rmin, const cgsize_t *s_rmax,
+	const cgsize_t *s_stride, int m_numdim, const cgsize_t *m_dimvals,
+	const cgsize_t *m_rmin, const cgsize_t *m_rmax,
+	const cgsize_t *m_stride, const void * coord_ptr, int *C);
+/*%typecast coord_ptr:type */
+/*%input s_rmin(:), s_rmax(:), s_stride(:), m_dimvals(:), m_rmin(:), m_rmax(:), m_stride(:) */
+/*%output C */
+/*%url http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/grid.html */
+
+CGNSDLL int cg_coord_reserve(int fn, int B, int Z,
+	CGNS_ENUMT(DataType_t) type, const char * coordname, int *C);
+/*%output C */
+/*%url http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/grid.html */
+
 
 /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - *\
  *      Read and write Elements_t Nodes                                  *
@@ -1070,6 +1127,23 @@ CGNSDLL int cg_field_read(int fn, int B, int Z, int S, const char *fieldname,
 /*%input rmin(:), rmax(:) */
 /*%url http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/solution.html */
 
+CGNSDLL int cg_field_general_read(int fn, int B, int Z, int S,
+	const char *fieldname, CGNS_ENUMT(DataType_t) type,
+	const cgsize_t *s_rmin, const cgsize_t *s_rmax,
+	const cgsize_t *s_stride, int m_numdim, const cgsize_t *m_dimvals,
+	const cgsize_t *m_rmin, const cgsize_t *m_rmax,
+	const cgsize_t *m_stride, void *field_ptr);
+/*%typecast field_ptr:type */
+/*%input s_rmin(:), s_rmax(:), s_stride(:), m_dimvals(:), m_rmin(:), m_rmax(:), m_stride(:) */
+/*%url http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/solution.html */
+
+CGNSDLL int cg_field_read_indexed(int fn, int B, int Z, int S,
+	const char *fieldname, CGNS_ENUMT(DataType_t) type,
+	cgsize_t num, const cgsize_t *indices, void *field_ptr);
+/*%typecast field_ptr:type */
+/*%input indices(num) */
+/*%url http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/solution.html */
+
 CGNSDLL int cg_field_id(int fn, int B, int Z,int S, int F, double *field_id);
 /*%output field_id */
 /*%url http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/solution.html */
@@ -1091,6 +1165,29 @@ CGNSDLL int cg_field_partial_write(int fn, int B, int Z, int S,
 /*%output F */
 /*%url http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/solution.html */
 
+CGNSDLL int cg_field_general_write(int fn, int B, int Z, int S,
+	CGNS_ENUMT(DataType_t) type, const char * fieldname,
+	const cgsize_t *s_rmin, const cgsize_t *s_rmax,
+	const cgsize_t *s_stride, int m_numdim, const cgsize_t *m_dimvals,
+	const cgsize_t *m_rmin, const cgsize_t *m_rmax,
+	const cgsize_t *m_stride, const void * field_ptr, int *F);
+/*%typecast field_ptr:type */
+/*%input s_rmin(:), s_rmax(:), s_stride(:), m_dimvals(:), m_rmin(:), m_rmax(:), m_stride(:) */
+/*%output F */
+/*%url http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/solution.html */
+
+CGNSDLL int cg_field_reserve(int fn, int B, int Z, int S,
+	CGNS_ENUMT(DataType_t) type, const char * fieldname, int *F);
+/*%output F */
+/*%url http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/solution.html */
+
+CGNSDLL int cg_zone_reserve(int fn, int B, int Z,
+	CGNS_ENUMT(DataType_t) type, int S, int nfields,
+	const char * const *fieldnames);
+/*%external */
+/*%input fieldnames(nfields) */
+/*%url http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/solution.html */
+
 /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - *\
  *      Read and write ZoneSubRegion_t Nodes                             *
 \* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
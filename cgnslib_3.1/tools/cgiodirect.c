@@ -0,0 +1,253 @@
+/*-------------------------------------------------------------------------
+This software is provided 'as-is', without any express or implied warranty.
+In no event will the authors be held liable for any damages arising from
+the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+
+2. Altered source versions must be plainly marked as such, and must not
+   be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------*/
+
+/*
+ * cgiodirect - compares the throughput of buffered and direct I/O
+ * (CGIO_CONFIG_ADF_DIRECT) for large ADF arrays.
+ *
+ * Each run writes a number of R8 arrays to an ADF file with
+ * cgio_new_node, syncs the file to storage, drops its pages from the
+ * page cache and reads the arrays back with cgio_read_all_data. The
+ * write time includes the sync, so both modes are timed to storage,
+ * and the read always starts from a cold cache. Dropping the pages of
+ * one file needs no privileges, so the numbers can be reproduced by
+ * any user. The runs alternate between the two modes, and the best
+ * and worst rate of each are reported.
+ *
+ * There is no build rule for the tool. From the cgnslib_3.1 directory:
+ *
+ *   cc -O2 -I. -Iadf -o cgiodirect tools/cgiodirect.c cgns_io.c \
+ *      cg_malloc.c adf/ADF_interface.c adf/ADF_internals.c adfm/ADFM.c \
+ *      -lpthread -lm
+ *
+ * For a library built with HDF5, add -DBUILD_HDF5, the HDF5 include
+ * and library paths, adfh/ADFH.c and -lhdf5 -lz, as for cgioreplay.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifndef _WIN32
+# include <fcntl.h>
+# include <unistd.h>
+# include <sys/time.h>
+#endif
+
+#include "cgns_io.h"
+
+static char *usgmsg[] = {
+    "usage  : cgiodirect [options] scratchfile",
+    "options:",
+    "   -s MB    : size of each array in MB (default 256)",
+    "   -n num   : number of arrays in the file (default 2)",
+    "   -r num   : number of runs in each mode (default 3)",
+    "   -t bytes : direct I/O threshold (default 1048576)",
+    NULL
+};
+
+static int array_mb = 256;
+static int num_arrays = 2;
+static int num_runs = 3;
+static cglong_t threshold = 1048576;
+
+typedef struct {
+    double write_min, write_max;
+    double read_min, read_max;
+} RATES;
+
+/*-------------------------------------------------------------------*/
+
+static void print_usage (char *errmsg)
+{
+    int n;
+
+    if (errmsg != NULL && *errmsg)
+        fprintf(stderr, "%s\n", errmsg);
+    for (n = 0; usgmsg[n] != NULL; n++)
+        fprintf(stderr, "%s\n", usgmsg[n]);
+    exit(errmsg != NULL);
+}
+
+/*-------------------------------------------------------------------*/
+
+static void cgio_exit (char *what)
+{
+    char msg[CGIO_MAX_ERROR_LENGTH+1];
+
+    cgio_error_message(msg);
+    fprintf(stderr, "%s: %s\n", what, msg);
+    exit(1);
+}
+
+/*-------------------------------------------------------------------*/
+
+static double wall_clock (void)
+{
+#ifndef _WIN32
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec + 1.0e-6 * (double)tv.tv_usec;
+#else
+    return (double)clock() / (double)CLOCKS_PER_SEC;
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+
+/* write the file to storage, then drop it from the page cache */
+
+static void sync_and_drop (const char *fname)
+{
+#ifndef _WIN32
+    int fd = open(fname, O_RDONLY);
+
+    if (fd < 0) return;
+    fsync(fd);
+# ifdef POSIX_FADV_DONTNEED
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+# endif
+    close(fd);
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+
+static void run_once (const char *fname, cglong_t direct, double *data,
+    cgsize_t count, double *write_rate, double *read_rate)
+{
+    int cgio, n;
+    double root, id, start, mb;
+    char name[CGIO_MAX_NAME_LENGTH+1];
+
+    if (cgio_configure(CGIO_CONFIG_ADF_DIRECT, (void *)((size_t)direct)))
+        cgio_exit("cgio_configure");
+    mb = (double)num_arrays * (double)count * sizeof(double) / 1048576.0;
+
+    remove(fname);
+    start = wall_clock();
+    if (cgio_open_file(fname, CGIO_MODE_WRITE, CGIO_FILE_ADF, &cgio))
+        cgio_exit("cgio_open_file");
+    cgio_get_root_id(cgio, &root);
+    for (n = 0; n < num_arrays; n++) {
+        sprintf(name, "Array%d", n + 1);
+        if (cgio_new_node(cgio, root, name, "DataArray_t", "R8", 1,
+                &count, data, &id))
+            cgio_exit("cgio_new_node");
+    }
+    if (cgio_close_file(cgio)) cgio_exit("cgio_close_file");
+    sync_and_drop(fname);
+    *write_rate = mb / (wall_clock() - start);
+
+    memset(data, 0, (size_t)count * sizeof(double));
+    start = wall_clock();
+    if (cgio_open_file(fname, CGIO_MODE_READ, CGIO_FILE_ADF, &cgio))
+        cgio_exit("cgio_open_file");
+    cgio_get_root_id(cgio, &root);
+    for (n = 0; n < num_arrays; n++) {
+        sprintf(name, "Array%d", n + 1);
+        if (cgio_get_node_id(cgio, root, name, &id) ||
+            cgio_read_all_data(cgio, id, data))
+            cgio_exit("cgio_read_all_data");
+    }
+    if (cgio_close_file(cgio)) cgio_exit("cgio_close_file");
+    *read_rate = mb / (wall_clock() - start);
+    sync_and_drop(fname);
+
+    if (data[0] != 0.0 || data[count-1] != 0.5 * (double)(count - 1)) {
+        fprintf(stderr, "data read back does not match\n");
+        exit(1);
+    }
+}
+
+/*-------------------------------------------------------------------*/
+
+static void add_rates (RATES *r, int first, double write_rate,
+    double read_rate)
+{
+    if (first || write_rate < r->write_min) r->write_min = write_rate;
+    if (first || write_rate > r->write_max) r->write_max = write_rate;
+    if (first || read_rate < r->read_min) r->read_min = read_rate;
+    if (first || read_rate > r->read_max) r->read_max = read_rate;
+}
+
+/*-------------------------------------------------------------------*/
+
+int main (int argc, char *argv[])
+{
+    int n;
+    char *p, *fname = NULL;
+    double *data, write_rate, read_rate;
+    cgsize_t i, count;
+    RATES buffered, direct;
+
+    for (n = 1; n < argc; n++) {
+        p = argv[n];
+        if (*p != '-') {
+            if (fname != NULL) print_usage("only one scratch file");
+            fname = p;
+            continue;
+        }
+        if (n + 1 >= argc) print_usage("option needs a value");
+        if (!strcmp(p, "-s")) array_mb = atoi(argv[++n]);
+        else if (!strcmp(p, "-n")) num_arrays = atoi(argv[++n]);
+        else if (!strcmp(p, "-r")) num_runs = atoi(argv[++n]);
+        else if (!strcmp(p, "-t")) threshold = (cglong_t)atol(argv[++n]);
+        else
+            print_usage("unknown option");
+    }
+    if (fname == NULL) print_usage("scratch file not given");
+    if (array_mb < 1 || num_arrays < 1 || num_runs < 1 || threshold < 1)
+        print_usage("sizes and counts must be positive");
+
+    memset(&buffered, 0, sizeof(RATES));
+    memset(&direct, 0, sizeof(RATES));
+    count = (cgsize_t)array_mb * 131072;
+    data = (double *)malloc((size_t)count * sizeof(double));
+    if (data == NULL) {
+        fprintf(stderr, "malloc failed\n");
+        exit(1);
+    }
+
+    for (n = 0; n < num_runs; n++) {
+        for (i = 0; i < count; i++)
+            data[i] = 0.5 * (double)i;
+        run_once(fname, 0, data, count, &write_rate, &read_rate);
+        add_rates(&buffered, n == 0, write_rate, read_rate);
+        for (i = 0; i < count; i++)
+            data[i] = 0.5 * (double)i;
+        run_once(fname, threshold, data, count, &write_rate, &read_rate);
+        add_rates(&direct, n == 0, write_rate, read_rate);
+    }
+    remove(fname);
+    free(data);
+
+    printf("arrays       : %d x %d MB R8, %d runs in each mode\n",
+        num_arrays, array_mb, num_runs);
+    printf("buffered     : write %.0f-%.0f MB/s, read %.0f-%.0f MB/s\n",
+        buffered.write_min, buffered.write_max,
+        buffered.read_min, buffered.read_max);
+    printf("direct       : write %.0f-%.0f MB/s, read %.0f-%.0f MB/s "
+        "(threshold %.0f bytes)\n", direct.write_min, direct.write_max,
+        direct.read_min, direct.read_max, (double)threshold);
+
+    cgio_cleanup();
+    return 0;
+}
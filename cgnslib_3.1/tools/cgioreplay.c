@@ -0,0 +1,1159 @@
+/*-------------------------------------------------------------------------
+This software is provided 'as-is', without any express or implied warranty.
+In no event will the authors be held liable for any damages arising from
+the use of this software.
+
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it
+freely, subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not
+   claim that you wrote the original software. If you use this software
+   in a product, an acknowledgment in the product documentation would be
+   appreciated but is not required.
+
+2. Altered source versions must be plainly marked as such, and must not
+   be misrepresented as being the original software.
+
+3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------*/
+
+/*
+ * cgioreplay - replays a record of cgio calls and reports how long
+ * they took, and the system calls and bytes they cost.
+ *
+ * The record is written by the library while an application runs,
+ * after cgio_configure(CGIO_CONFIG_RECORD, filename), or from MATLAB
+ * with cg_configure(CG_CONFIG_RECORD, filename). The replay only needs
+ * cgns_io.h, so the same record can be run against any of the backends
+ * to compare them, or against a new build to catch regressions.
+ *
+ * Files written by the record are created as <name>.replay, files that
+ * are modified are copied to <name>.replay first, and files that are
+ * read are converted to <name>.replay when a different file type is
+ * asked for. These are removed when the replay is done, unless -k is
+ * given. Data written is a fixed byte pattern of the recorded size.
+ * With -M the files are loaded into memory before the clock starts,
+ * which leaves only the cost of the library itself.
+ *
+ * There is no build rule for the tool. From the cgnslib_3.1 directory,
+ * with HDF5 (include and library paths as installed by Debian/Ubuntu):
+ *
+ *   cc -O2 -DBUILD_HDF5 -I. -Iadf -Iadfh -I/usr/include/hdf5/serial \
+ *      -o cgioreplay tools/cgioreplay.c cgns_io.c cg_malloc.c \
+ *      adf/ADF_interface.c adf/ADF_internals.c adfh/ADFH.c adfm/ADFM.c \
+ *      -L/usr/lib/x86_64-linux-gnu/hdf5/serial -lhdf5 -lz -lpthread -lm
+ *
+ * Without HDF5, leave out -DBUILD_HDF5, the hdf5 paths, adfh/ADFH.c and
+ * -lhdf5 -lz; -h is then reported as not supported.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#ifndef _WIN32
+# include <unistd.h>
+# include <sys/time.h>
+# include <sys/resource.h>
+#endif
+
+#include "cgns_io.h"
+
+static char *usgmsg[] = {
+    "usage  : cgioreplay [options] recordfile",
+    "options:",
+    "   -a       : replay against ADF files",
+    "   -2       : replay against ADF2 files",
+    "   -3       : replay against ADF3 files",
+    "   -h       : replay against HDF5 files",
+    "   -M       : replay against in-memory files",
+    "   -m old=new : use file new where the record has file old",
+    "   -k       : keep the .replay files",
+    "   -v       : print the statistics of each cgio entry point",
+    NULL
+};
+
+/* the entry points in the record, in the order of cgio_stats_read */
+
+enum {
+    OP_OPEN_FILE = 1,
+    OP_CLOSE_FILE,
+    OP_COMPRESS_FILE,
+    OP_COPY_FILE,
+    OP_FLUSH_TO_DISK,
+    OP_LIBRARY_VERSION,
+    OP_FILE_VERSION,
+    OP_CREATE_NODE,
+    OP_NEW_NODE,
+    OP_NEW_NODE_ASYNC,
+    OP_DELETE_NODE,
+    OP_MOVE_NODE,
+    OP_COPY_NODE,
+    OP_IS_LINK,
+    OP_LINK_SIZE,
+    OP_CREATE_LINK,
+    OP_GET_LINK,
+    OP_NUMBER_CHILDREN,
+    OP_CHILDREN_IDS,
+    OP_CHILDREN_NAMES,
+    OP_GET_NODE_ID,
+    OP_GET_NAME,
+    OP_GET_LABEL,
+    OP_GET_DATA_TYPE,
+    OP_GET_DIMENSIONS,
+    OP_READ_ALL_DATA,
+    OP_READ_BLOCK_DATA,
+    OP_READ_DATA,
+    OP_READ_INDICES,
+    OP_SET_NAME,
+    OP_SET_LABEL,
+    OP_SET_DIMENSIONS,
+    OP_RESERVE_DATA,
+    OP_WRITE_ALL_DATA,
+    OP_WRITE_BLOCK_DATA,
+    OP_WRITE_DATA,
+    OP_WRITE_INDICES,
+    OP_READ_BATCH,
+    OP_EXTRACT_NODE,
+    OP_ASYNC_ID
+};
+
+static const char *op_names[] = {
+    "cgio_open_file",
+    "cgio_close_file",
+    "cgio_compress_file",
+    "cgio_copy_file",
+    "cgio_flush_to_disk",
+    "cgio_library_version",
+    "cgio_file_version",
+    "cgio_create_node",
+    "cgio_new_node",
+    "cgio_new_node_async",
+    "cgio_delete_node",
+    "cgio_move_node",
+    "cgio_copy_node",
+    "cgio_is_link",
+    "cgio_link_size",
+    "cgio_create_link",
+    "cgio_get_link",
+    "cgio_number_children",
+    "cgio_children_ids",
+    "cgio_children_names",
+    "cgio_get_node_id",
+    "cgio_get_name",
+    "cgio_get_label",
+    "cgio_get_data_type",
+    "cgio_get_dimensions",
+    "cgio_read_all_data",
+    "cgio_read_block_data",
+    "cgio_read_data",
+    "cgio_read_indices",
+    "cgio_set_name",
+    "cgio_set_label",
+    "cgio_set_dimensions",
+    "cgio_reserve_data",
+    "cgio_write_all_data",
+    "cgio_write_block_data",
+    "cgio_write_data",
+    "cgio_write_indices",
+    "cgio_read_batch",
+    "cgio_extract_node",
+    "async_id",
+    NULL
+};
+
+/* a line of the record, split into the entry point, the recorded
+   return code and the arguments that follow */
+
+typedef struct {
+    int op;
+    int err;
+    char *args;
+} LINE;
+
+static int num_lines = 0;
+static LINE *lines;
+
+/* the files of the record, by recorded file number */
+
+typedef struct {
+    int cgio_num;
+} REPLAY_FILE;
+
+static int num_files = 0;
+static REPLAY_FILE *files = NULL;
+
+/* file names as given in the record, and what replays them */
+
+typedef struct {
+    char *name;
+    char *replay;
+    int remove;
+} FILE_MAP;
+
+static int num_names = 0;
+static FILE_MAP *names = NULL;
+
+/* recorded IDs and the IDs of the replay. A node created with
+   cgio_new_node_async has slot > 0 until the write is done */
+
+typedef struct {
+    double key;
+    double id;
+    int slot;
+    int used;
+} ID_MAP;
+
+static size_t map_size = 0;
+static size_t map_used = 0;
+static ID_MAP *id_map = NULL;
+
+static int num_slots = 0;
+static double *slot_ids = NULL;
+static double *slot_keys = NULL;
+static int *slot_files = NULL;
+
+static int file_type = CGIO_FILE_NONE;
+static int keep_files = 0;
+
+static cglong_t num_calls = 0;
+static cglong_t num_skipped = 0;
+static cglong_t num_mismatch = 0;
+
+/*-------------------------------------------------------------------*/
+
+static void print_usage (char *errmsg)
+{
+    int n;
+
+    if (errmsg != NULL && *errmsg)
+        fprintf(stderr, "%s\n", errmsg);
+    for (n = 0; usgmsg[n] != NULL; n++)
+        fprintf(stderr, "%s\n", usgmsg[n]);
+    exit(errmsg != NULL);
+}
+
+/*-------------------------------------------------------------------*/
+
+static void error_exit (char *msg)
+{
+    fprintf(stderr, "%s\n", msg);
+    exit(1);
+}
+
+/*-------------------------------------------------------------------*/
+
+static void *xmalloc (size_t size)
+{
+    void *p = calloc(size ? size : 1, 1);
+    if (p == NULL) error_exit("malloc failed");
+    return p;
+}
+
+/*-------------------------------------------------------------------*/
+
+static char *xstrdup (const char *s)
+{
+    char *p = (char *)xmalloc(strlen(s) + 1);
+    return strcpy(p, s);
+}
+
+/*-------------------------------------------------------------------*/
+
+static double wall_clock (void)
+{
+#ifndef _WIN32
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (double)tv.tv_sec + 1.0e-6 * (double)tv.tv_usec;
+#else
+    return (double)clock() / (double)CLOCKS_PER_SEC;
+#endif
+}
+
+/*===================================================================
+ * reading the record
+ *===================================================================*/
+
+static void read_record (char *recfile)
+{
+    FILE *fp;
+    long size;
+    char *buff, *p, *next, *name;
+    int n, max_lines;
+
+    if ((fp = fopen(recfile, "rb")) == NULL) {
+        fprintf(stderr, "can't open %s\n", recfile);
+        exit(1);
+    }
+    fseek(fp, 0, SEEK_END);
+    size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    buff = (char *)xmalloc((size_t)size + 1);
+    if (fread(buff, 1, (size_t)size, fp) != (size_t)size)
+        error_exit("error reading the record");
+    fclose(fp);
+    buff[size] = 0;
+    if (strncmp(buff, "# cgio record 1", 15))
+        error_exit("not a cgio record");
+
+    max_lines = 1;
+    for (p = buff; *p; p++) {
+        if (*p == '\n') max_lines++;
+    }
+    lines = (LINE *)xmalloc(max_lines * sizeof(LINE));
+
+    for (p = buff; p != NULL && *p; p = next) {
+        next = strchr(p, '\n');
+        if (next != NULL) *next++ = 0;
+        if (*p == '#' || !*p) continue;
+        name = p;
+        while (*p && !isspace((unsigned char)*p)) p++;
+        if (*p) *p++ = 0;
+        for (n = 0; op_names[n] != NULL; n++) {
+            if (!strcmp(name, op_names[n])) break;
+        }
+        if (op_names[n] == NULL) {
+            fprintf(stderr, "unknown entry point %s in record\n", name);
+            num_skipped++;
+            continue;
+        }
+        lines[num_lines].op = n + 1;
+        lines[num_lines].err = (int)strtol(p, &p, 10);
+        lines[num_lines].args = p;
+        num_lines++;
+    }
+}
+
+/*-------------------------------------------------------------------*/
+
+/* the arguments of a line are read one at a time */
+
+static char *arg_ptr;
+
+static double next_number (void)
+{
+    char *p;
+    double val = strtod(arg_ptr, &p);
+    if (p == arg_ptr) return 0.0;
+    arg_ptr = p;
+    return val;
+}
+
+static int next_int (void)
+{
+    return (int)next_number();
+}
+
+static cglong_t next_long (void)
+{
+    return (cglong_t)next_number();
+}
+
+/* strings have white space and '%' written as %XX, and an empty
+   string is a lone '%' */
+
+static char *next_string (char *str, int max_len)
+{
+    int n = 0;
+    char hex[3];
+
+    while (isspace((unsigned char)*arg_ptr)) arg_ptr++;
+    if (*arg_ptr == '%' && (!arg_ptr[1] || isspace((unsigned char)arg_ptr[1]))) {
+        arg_ptr++;
+        *str = 0;
+        return str;
+    }
+    while (*arg_ptr && !isspace((unsigned char)*arg_ptr)) {
+        if (*arg_ptr == '%' && arg_ptr[1] && arg_ptr[2]) {
+            hex[0] = arg_ptr[1];
+            hex[1] = arg_ptr[2];
+            hex[2] = 0;
+            if (n < max_len) str[n++] = (char)strtol(hex, NULL, 16);
+            arg_ptr += 3;
+        }
+        else {
+            if (n < max_len) str[n++] = *arg_ptr;
+            arg_ptr++;
+        }
+    }
+    str[n] = 0;
+    return str;
+}
+
+/* vectors are a count followed by the values */
+
+typedef struct {
+    int size;
+    cgsize_t *values;
+} VECTOR;
+
+static VECTOR vectors[8];
+
+static int next_vector (int n)
+{
+    int i, count = next_int();
+
+    if (count > vectors[n].size) {
+        free(vectors[n].values);
+        vectors[n].size = count;
+        vectors[n].values = (cgsize_t *)xmalloc(count * sizeof(cgsize_t));
+    }
+    for (i = 0; i < count; i++)
+        vectors[n].values[i] = (cgsize_t)next_number();
+    return count;
+}
+
+/*-------------------------------------------------------------------*/
+
+/* the buffer for data, filled with a pattern that doesn't compress
+   any better than real data would */
+
+static cglong_t data_size = 0;
+static unsigned char *data_buff = NULL;
+
+static void *data_buffer (cglong_t bytes)
+{
+    cglong_t n;
+
+    if (bytes > data_size) {
+        free(data_buff);
+        data_size = bytes;
+        data_buff = (unsigned char *)xmalloc((size_t)bytes);
+        for (n = 0; n < bytes; n++)
+            data_buff[n] = (unsigned char)((n * 2654435761UL) >> 13);
+    }
+    return data_buff;
+}
+
+/*===================================================================
+ * file and ID maps
+ *===================================================================*/
+
+static size_t hash_id (double key)
+{
+    unsigned char bytes[sizeof(double)];
+    size_t n, hash = 5381;
+
+    memcpy(bytes, &key, sizeof(double));
+    for (n = 0; n < sizeof(double); n++)
+        hash = hash * 33 + bytes[n];
+    return hash;
+}
+
+/*-------------------------------------------------------------------*/
+
+static ID_MAP *find_id (double key, int create)
+{
+    size_t n, size;
+    ID_MAP *old;
+
+    if (create && 2 * (map_used + 1) > map_size) {
+        old = id_map;
+        size = map_size;
+        map_size = size ? 2 * size : 1024;
+        id_map = (ID_MAP *)xmalloc(map_size * sizeof(ID_MAP));
+        map_used = 0;
+        for (n = 0; n < size; n++) {
+            if (old[n].used) *find_id(old[n].key, 1) = old[n];
+        }
+        free(old);
+    }
+    if (map_size == 0) return NULL;
+    for (n = hash_id(key) % map_size; id_map[n].used;
+         n = (n + 1) % map_size) {
+        if (id_map[n].key == key) return &id_map[n];
+    }
+    if (!create) return NULL;
+    id_map[n].used = 1;
+    id_map[n].key = key;
+    map_used++;
+    return &id_map[n];
+}
+
+/*-------------------------------------------------------------------*/
+
+static void map_id (double key, double id)
+{
+    ID_MAP *entry = find_id(key, 1);
+    entry->id = id;
+    entry->slot = 0;
+}
+
+/*-------------------------------------------------------------------*/
+
+/* returns 0 if the recorded ID was never seen */
+
+static int replay_id (double key, double *id)
+{
+    ID_MAP *entry = find_id(key, 0);
+
+    if (entry == NULL) return 0;
+    if (entry->slot) {
+        cgio_wait(slot_files[entry->slot]);
+        entry->id = slot_ids[entry->slot];
+        entry->slot = 0;
+    }
+    *id = entry->id;
+    return 1;
+}
+
+/*-------------------------------------------------------------------*/
+
+static int replay_file (int num)
+{
+    if (num < 1 || num > num_files) return 0;
+    return files[num-1].cgio_num;
+}
+
+/*-------------------------------------------------------------------*/
+
+/* the reads of a batch are an ID, a block and the bytes read, and
+   share one data buffer. Returns NULL if an ID was never seen */
+
+static int batch_size = 0;
+static cgio_read_t *batch = NULL;
+
+static cgio_read_t *next_batch (int count)
+{
+    int n;
+    cglong_t bytes = 0;
+    char *args = arg_ptr, *buff;
+
+    if (count > batch_size) {
+        free(batch);
+        batch_size = count;
+        batch = (cgio_read_t *)xmalloc(count * sizeof(cgio_read_t));
+    }
+    for (n = 0; n < count; n++) {
+        next_number();
+        next_long();
+        next_long();
+        bytes += next_long();
+    }
+    buff = (char *)data_buffer(bytes);
+    arg_ptr = args;
+    for (n = 0; n < count; n++) {
+        if (!replay_id(next_number(), &batch[n].id)) return NULL;
+        batch[n].b_start = (cgsize_t)next_long();
+        batch[n].b_end = (cgsize_t)next_long();
+        batch[n].data = buff;
+        buff += next_long();
+    }
+    return batch;
+}
+
+/*-------------------------------------------------------------------*/
+
+static FILE_MAP *find_name (const char *name)
+{
+    int n;
+
+    for (n = 0; n < num_names; n++) {
+        if (!strcmp(name, names[n].name)) return &names[n];
+    }
+    return NULL;
+}
+
+/*-------------------------------------------------------------------*/
+
+static FILE_MAP *add_name (const char *name, const char *replay)
+{
+    names = (FILE_MAP *)realloc(names, (num_names + 1) * sizeof(FILE_MAP));
+    if (names == NULL) error_exit("malloc failed");
+    names[num_names].name = xstrdup(name);
+    names[num_names].replay = xstrdup(replay);
+    names[num_names].remove = 0;
+    return &names[num_names++];
+}
+
+/*-------------------------------------------------------------------*/
+
+/* copies a file as it is, or through cgio when the type changes */
+
+static void copy_file (const char *inpfile, const char *outfile,
+    int type_out)
+{
+    int type_inp, cgio_inp, cgio_out;
+    FILE *inp, *out;
+    char buff[8192];
+    size_t n;
+
+    if (cgio_check_file(inpfile, &type_inp))
+        cgio_error_exit(inpfile);
+    if (type_out == CGIO_FILE_NONE || type_out == type_inp) {
+        if ((inp = fopen(inpfile, "rb")) == NULL ||
+            (out = fopen(outfile, "wb")) == NULL) {
+            fprintf(stderr, "can't copy %s to %s\n", inpfile, outfile);
+            exit(1);
+        }
+        while ((n = fread(buff, 1, sizeof(buff), inp)) > 0) {
+            if (fwrite(buff, 1, n, out) != n) {
+                fprintf(stderr, "error writing %s\n", outfile);
+                exit(1);
+            }
+        }
+        fclose(inp);
+        fclose(out);
+        return;
+    }
+    if (cgio_open_file(inpfile, CGIO_MODE_READ, CGIO_FILE_NONE, &cgio_inp) ||
+        cgio_open_file(outfile, CGIO_MODE_WRITE, type_out, &cgio_out) ||
+        cgio_copy_file(cgio_inp, cgio_out, 0) ||
+        cgio_close_file(cgio_inp) || cgio_close_file(cgio_out))
+        cgio_error_exit(inpfile);
+}
+
+/*-------------------------------------------------------------------*/
+
+static int file_mode (int mode)
+{
+    if (mode == 'r' || mode == 'R') return CGIO_MODE_READ;
+    if (mode == 'w' || mode == 'W') return CGIO_MODE_WRITE;
+    if (mode == 'm' || mode == 'M' || mode == 'a' || mode == 'A')
+        return CGIO_MODE_MODIFY;
+    return mode;
+}
+
+/*-------------------------------------------------------------------*/
+
+/* decides the file each open of the record replays against, and
+   makes the copies and conversions it needs before the clock starts */
+
+static void prepare_files (void)
+{
+    int n, mode, type, seq, num;
+    char name[CGIO_MAX_FILE_LENGTH+1];
+    char replay[CGIO_MAX_FILE_LENGTH+16];
+    double id;
+    FILE_MAP *map;
+
+    for (n = 0; n < num_lines; n++) {
+        arg_ptr = lines[n].args;
+        if (lines[n].op == OP_ASYNC_ID) {
+            seq = next_int();
+            if (seq > num_slots) num_slots = seq;
+            continue;
+        }
+        if (lines[n].op != OP_OPEN_FILE) continue;
+        next_string(name, CGIO_MAX_FILE_LENGTH);
+        mode = file_mode(next_int());
+        type = next_int();
+        num = next_int();
+        if (lines[n].err || num < 1) continue;
+        if (num > num_files) {
+            files = (REPLAY_FILE *)realloc(files, num * sizeof(REPLAY_FILE));
+            if (files == NULL) error_exit("malloc failed");
+            memset(&files[num_files], 0,
+                (num - num_files) * sizeof(REPLAY_FILE));
+            num_files = num;
+        }
+        if (find_name(name) != NULL) continue;
+
+        sprintf(replay, "%s.replay", name);
+        if (mode == CGIO_MODE_WRITE) {
+            map = add_name(name, replay);
+            map->remove = !keep_files;
+        }
+        else if (cgio_check_file(name, &type)) {
+            fprintf(stderr, "can't replay %s: ", name);
+            cgio_error_exit(NULL);
+        }
+        else if (mode == CGIO_MODE_MODIFY ||
+                 (file_type != CGIO_FILE_NONE && file_type != type)) {
+            copy_file(name, replay, file_type);
+            map = add_name(name, replay);
+            map->remove = !keep_files;
+        }
+        else
+            add_name(name, name);
+    }
+
+    if (num_slots) {
+        slot_ids = (double *)xmalloc((num_slots + 1) * sizeof(double));
+        slot_keys = (double *)xmalloc((num_slots + 1) * sizeof(double));
+        slot_files = (int *)xmalloc((num_slots + 1) * sizeof(int));
+        for (n = 0; n < num_lines; n++) {
+            if (lines[n].op != OP_ASYNC_ID) continue;
+            arg_ptr = lines[n].args;
+            seq = next_int();
+            id = next_number();
+            if (seq > 0) slot_keys[seq] = id;
+        }
+    }
+}
+
+/*-------------------------------------------------------------------*/
+
+static void remove_files (void)
+{
+    int n;
+
+    for (n = 0; n < num_names; n++) {
+        if (names[n].remove) remove(names[n].replay);
+    }
+}
+
+/*===================================================================
+ * the replay
+ *===================================================================*/
+
+/* looks up the file and IDs of a call, and skips the call when one
+   of them is not known, which happens when a file was opened before
+   the record was started, or the call that made the ID failed */
+
+#define GET_FILE(N) if ((N = replay_file(next_int())) == 0) return -1
+#define GET_ID(ID) if (!replay_id(next_number(), &ID)) return -1
+
+static int replay_line (LINE *line)
+{
+    int n, cnum, cnum2, mode, type, ndims, start, max_ret, len, num_ret;
+    int hasdata, seq, nv[8];
+    cglong_t bytes, b_start, b_end;
+    double id, pid, id2, *ids;
+    cgsize_t *vec[8];
+    char name[CGIO_MAX_FILE_LENGTH+1];
+    char label[CGIO_MAX_NAME_LENGTH+1];
+    char data_type[CGIO_MAX_DATATYPE_LENGTH+1];
+    char link_file[CGIO_MAX_FILE_LENGTH+1];
+    char link_name[CGIO_MAX_LINK_LENGTH+1];
+    char replay[CGIO_MAX_FILE_LENGTH+16];
+    char date1[CGIO_MAX_DATE_LENGTH+1], date2[CGIO_MAX_DATE_LENGTH+1];
+    cgsize_t dims[CGIO_MAX_DIMENSIONS];
+    FILE_MAP *map;
+    ID_MAP *entry;
+    cgio_read_t *reads;
+
+    arg_ptr = line->args;
+    switch (line->op) {
+        case OP_OPEN_FILE:
+            next_string(name, CGIO_MAX_FILE_LENGTH);
+            mode = file_mode(next_int());
+            type = next_int();
+            if (line->err) return 0;
+            n = next_int();
+            id = next_number();
+            if ((map = find_name(name)) == NULL) return -1;
+            if (file_type != CGIO_FILE_NONE) type = file_type;
+            if (cgio_open_file(map->replay, mode, type, &cnum)) return 1;
+            files[n-1].cgio_num = cnum;
+            if (cgio_get_root_id(cnum, &pid)) return 1;
+            map_id(id, pid);
+            return 0;
+        case OP_CLOSE_FILE:
+            n = next_int();
+            if ((cnum = replay_file(n)) == 0) return -1;
+            files[n-1].cgio_num = 0;
+            return cgio_close_file(cnum);
+        case OP_COMPRESS_FILE:
+            n = next_int();
+            if ((cnum = replay_file(n)) == 0) return -1;
+            files[n-1].cgio_num = 0;
+            next_string(name, CGIO_MAX_FILE_LENGTH);
+            if ((map = find_name(name)) == NULL) {
+                sprintf(replay, "%s.replay", name);
+                map = add_name(name, replay);
+                map->remove = !keep_files;
+            }
+            return cgio_compress_file(cnum, map->replay);
+        case OP_COPY_FILE:
+            GET_FILE(cnum);
+            GET_FILE(cnum2);
+            return cgio_copy_file(cnum, cnum2, next_int());
+        case OP_FLUSH_TO_DISK:
+            GET_FILE(cnum);
+            return cgio_flush_to_disk(cnum);
+        case OP_LIBRARY_VERSION:
+            GET_FILE(cnum);
+            return cgio_library_version(cnum, name);
+        case OP_FILE_VERSION:
+            GET_FILE(cnum);
+            return cgio_file_version(cnum, name, date1, date2);
+        case OP_CREATE_NODE:
+            GET_FILE(cnum);
+            GET_ID(pid);
+            next_string(name, CGIO_MAX_NAME_LENGTH);
+            if (cgio_create_node(cnum, pid, name, &id)) return 1;
+            if (!line->err && next_int() == 1) map_id(next_number(), id);
+            return 0;
+        case OP_NEW_NODE:
+        case OP_NEW_NODE_ASYNC:
+            GET_FILE(cnum);
+            GET_ID(pid);
+            next_string(name, CGIO_MAX_NAME_LENGTH);
+            next_string(label, CGIO_MAX_NAME_LENGTH);
+            next_string(data_type, CGIO_MAX_DATATYPE_LENGTH);
+            ndims = next_vector(0);
+            hasdata = next_int();
+            if (ndims > CGIO_MAX_DIMENSIONS) return 1;
+            for (n = 0; n < ndims; n++)
+                dims[n] = vectors[0].values[n];
+            bytes = 0;
+            if (hasdata)
+                bytes = cgio_compute_data_size(data_type, ndims, dims,
+                    &b_end) * b_end;
+            if (line->op == OP_NEW_NODE) {
+                if (cgio_new_node(cnum, pid, name, label, data_type, ndims,
+                        dims, hasdata ? data_buffer(bytes) : NULL, &id))
+                    return 1;
+                if (!line->err && next_int() == 1)
+                    map_id(next_number(), id);
+                return 0;
+            }
+            seq = line->err ? 0 : next_int();
+            if (seq < 1 || seq > num_slots) seq = 0;
+            if (cgio_new_node_async(cnum, pid, name, label, data_type,
+                    ndims, dims, hasdata ? data_buffer(bytes) : NULL, NULL,
+                    seq ? &slot_ids[seq] : &id))
+                return 1;
+            if (seq) {
+                entry = find_id(slot_keys[seq], 1);
+                entry->slot = seq;
+                slot_files[seq] = cnum;
+            }
+            return 0;
+        case OP_DELETE_NODE:
+            GET_FILE(cnum);
+            GET_ID(pid);
+            GET_ID(id);
+            return cgio_delete_node(cnum, pid, id);
+        case OP_MOVE_NODE:
+            GET_FILE(cnum);
+            GET_ID(pid);
+            GET_ID(id);
+            GET_ID(id2);
+            return cgio_move_node(cnum, pid, id, id2);
+        case OP_COPY_NODE:
+            GET_FILE(cnum);
+            GET_ID(id);
+            GET_FILE(cnum2);
+            GET_ID(id2);
+            return cgio_copy_node(cnum, id, cnum2, id2);
+        case OP_EXTRACT_NODE:
+            GET_FILE(cnum);
+            next_string(link_name, CGIO_MAX_LINK_LENGTH);
+            GET_FILE(cnum2);
+            GET_ID(pid);
+            len = next_int();
+            next_string(link_file, CGIO_MAX_FILE_LENGTH);
+            bytes = next_long();
+            if ((map = find_name(link_file)) != NULL)
+                strcpy(link_file, map->replay);
+            if (cgio_extract_node(cnum, link_name, cnum2, pid, len,
+                    link_file, bytes, &id))
+                return 1;
+            if (!line->err && next_int() == 1) map_id(next_number(), id);
+            return 0;
+        case OP_IS_LINK:
+            GET_FILE(cnum);
+            GET_ID(id);
+            return cgio_is_link(cnum, id, &len);
+        case OP_LINK_SIZE:
+            GET_FILE(cnum);
+            GET_ID(id);
+            return cgio_link_size(cnum, id, &len, &n);
+        case OP_CREATE_LINK:
+            GET_FILE(cnum);
+            GET_ID(pid);
+            next_string(name, CGIO_MAX_NAME_LENGTH);
+            next_string(link_file, CGIO_MAX_FILE_LENGTH);
+            next_string(link_name, CGIO_MAX_LINK_LENGTH);
+            if ((map = find_name(link_file)) != NULL)
+                strcpy(link_file, map->replay);
+            if (cgio_create_link(cnum, pid, name, link_file, link_name, &id))
+                return 1;
+            if (!line->err && next_int() == 1) map_id(next_number(), id);
+            return 0;
+        case OP_GET_LINK:
+            GET_FILE(cnum);
+            GET_ID(id);
+            return cgio_get_link(cnum, id, link_file, link_name);
+        case OP_NUMBER_CHILDREN:
+            GET_FILE(cnum);
+            GET_ID(id);
+            return cgio_number_children(cnum, id, &n);
+        case OP_CHILDREN_IDS:
+            GET_FILE(cnum);
+            GET_ID(pid);
+            start = next_int();
+            max_ret = next_int();
+            if (max_ret < 1) max_ret = 1;
+            ids = (double *)data_buffer(max_ret * sizeof(double));
+            if (cgio_children_ids(cnum, pid, start, max_ret, &num_ret, ids))
+                return 1;
+            if (!line->err) {
+                len = next_int();
+                for (n = 0; n < len && n < num_ret; n++)
+                    map_id(next_number(), ids[n]);
+            }
+            return 0;
+        case OP_CHILDREN_NAMES:
+            GET_FILE(cnum);
+            GET_ID(pid);
+            start = next_int();
+            max_ret = next_int();
+            len = next_int();
+            if (max_ret < 1 || len < 1) return 1;
+            return cgio_children_names(cnum, pid, start, max_ret, len,
+                &num_ret, (char *)data_buffer((cglong_t)max_ret * len));
+        case OP_GET_NODE_ID:
+            GET_FILE(cnum);
+            GET_ID(pid);
+            next_string(link_name, CGIO_MAX_LINK_LENGTH);
+            if (cgio_get_node_id(cnum, pid, link_name, &id)) return 1;
+            if (!line->err && next_int() == 1) map_id(next_number(), id);
+            return 0;
+        case OP_GET_NAME:
+            GET_FILE(cnum);
+            GET_ID(id);
+            return cgio_get_name(cnum, id, name);
+        case OP_GET_LABEL:
+            GET_FILE(cnum);
+            GET_ID(id);
+            return cgio_get_label(cnum, id, label);
+        case OP_GET_DATA_TYPE:
+            GET_FILE(cnum);
+            GET_ID(id);
+            return cgio_get_data_type(cnum, id, data_type);
+        case OP_GET_DIMENSIONS:
+            GET_FILE(cnum);
+            GET_ID(id);
+            return cgio_get_dimensions(cnum, id, &ndims, dims);
+        case OP_READ_ALL_DATA:
+        case OP_WRITE_ALL_DATA:
+            GET_FILE(cnum);
+            GET_ID(id);
+            bytes = next_long();
+            if (line->op == OP_READ_ALL_DATA)
+                return cgio_read_all_data(cnum, id, data_buffer(bytes));
+            return cgio_write_all_data(cnum, id, data_buffer(bytes));
+        case OP_READ_BLOCK_DATA:
+        case OP_WRITE_BLOCK_DATA:
+            GET_FILE(cnum);
+            GET_ID(id);
+            b_start = next_long();
+            b_end = next_long();
+            bytes = next_long();
+            if (line->op == OP_READ_BLOCK_DATA)
+                return cgio_read_block_data(cnum, id, (cgsize_t)b_start,
+                    (cgsize_t)b_end, data_buffer(bytes));
+            return cgio_write_block_data(cnum, id, (cgsize_t)b_start,
+                (cgsize_t)b_end, data_buffer(bytes));
+        case OP_READ_DATA:
+        case OP_WRITE_DATA:
+            GET_FILE(cnum);
+            GET_ID(id);
+            for (n = 0; n < 7; n++) {
+                nv[n] = next_vector(n);
+                vec[n] = vectors[n].values;
+            }
+            bytes = next_long();
+            if (line->op == OP_READ_DATA)
+                return cgio_read_data(cnum, id, vec[0], vec[1], vec[2],
+                    nv[3], vec[3], vec[4], vec[5], vec[6],
+                    data_buffer(bytes));
+            return cgio_write_data(cnum, id, vec[0], vec[1], vec[2],
+                nv[3], vec[3], vec[4], vec[5], vec[6], data_buffer(bytes));
+        case OP_READ_INDICES:
+        case OP_WRITE_INDICES:
+            GET_FILE(cnum);
+            GET_ID(id);
+            n = next_vector(0);
+            bytes = next_long();
+            if (line->op == OP_READ_INDICES)
+                return cgio_read_indices(cnum, id, (cgsize_t)n,
+                    vectors[0].values, data_buffer(bytes));
+            return cgio_write_indices(cnum, id, (cgsize_t)n,
+                vectors[0].values, data_buffer(bytes));
+        case OP_READ_BATCH:
+            GET_FILE(cnum);
+            n = next_int();
+            if ((reads = next_batch(n)) == NULL) return -1;
+            return cgio_read_batch(cnum, n, reads);
+        case OP_SET_NAME:
+            GET_FILE(cnum);
+            GET_ID(pid);
+            GET_ID(id);
+            next_string(name, CGIO_MAX_NAME_LENGTH);
+            return cgio_set_name(cnum, pid, id, name);
+        case OP_SET_LABEL:
+            GET_FILE(cnum);
+            GET_ID(id);
+            next_string(label, CGIO_MAX_NAME_LENGTH);
+            return cgio_set_label(cnum, id, label);
+        case OP_SET_DIMENSIONS:
+            GET_FILE(cnum);
+            GET_ID(id);
+            next_string(data_type, CGIO_MAX_DATATYPE_LENGTH);
+            ndims = next_vector(0);
+            return cgio_set_dimensions(cnum, id, data_type, ndims,
+                vectors[0].values);
+        case OP_RESERVE_DATA:
+            GET_FILE(cnum);
+            GET_ID(id);
+            return cgio_reserve_data(cnum, id);
+    }
+    return -1;
+}
+
+/*-------------------------------------------------------------------*/
+
+/* the I/O counters of the process, from /proc/self/io where there
+   is one, and from the block counts of getrusage otherwise */
+
+typedef struct {
+    int have_proc;
+    cglong_t rchar, wchar, syscr, syscw, read_bytes, write_bytes;
+} IO_COUNTERS;
+
+static void io_counters (IO_COUNTERS *io)
+{
+    FILE *fp;
+    char key[64];
+    double val;
+#ifndef _WIN32
+    struct rusage usage;
+#endif
+
+    memset(io, 0, sizeof(IO_COUNTERS));
+    if ((fp = fopen("/proc/self/io", "r")) != NULL) {
+        while (fscanf(fp, "%63[^:]: %lf\n", key, &val) == 2) {
+            if (!strcmp(key, "rchar")) io->rchar = (cglong_t)val;
+            else if (!strcmp(key, "wchar")) io->wchar = (cglong_t)val;
+            else if (!strcmp(key, "syscr")) io->syscr = (cglong_t)val;
+            else if (!strcmp(key, "syscw")) io->syscw = (cglong_t)val;
+            else if (!strcmp(key, "read_bytes"))
+                io->read_bytes = (cglong_t)val;
+            else if (!strcmp(key, "write_bytes"))
+                io->write_bytes = (cglong_t)val;
+        }
+        fclose(fp);
+        io->have_proc = 1;
+        return;
+    }
+#ifndef _WIN32
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        io->read_bytes = (cglong_t)usage.ru_inblock * 512;
+        io->write_bytes = (cglong_t)usage.ru_oublock * 512;
+    }
+#endif
+}
+
+/*-------------------------------------------------------------------*/
+
+static void print_stats (int verbose, double wall_time)
+{
+    int n, num_ops;
+    char name[64];
+    cgio_stats_t stats;
+    cglong_t calls = 0, errors = 0, rbytes = 0, wbytes = 0;
+    double time = 0.0;
+
+    if (cgio_stats_number(&num_ops)) return;
+    if (verbose)
+        printf("\n%-22s %10s %7s %14s %10s %10s\n", "entry point", "calls",
+            "errors", "bytes", "time (s)", "max (ms)");
+    for (n = 1; n <= num_ops; n++) {
+        if (cgio_stats_read(n, name, &stats) || stats.calls == 0)
+            continue;
+        calls += stats.calls;
+        errors += stats.errors;
+        time += stats.time;
+        if (!strncmp(name, "cgio_read_", 10))
+            rbytes += stats.bytes;
+        else
+            wbytes += stats.bytes;
+        if (verbose)
+            printf("%-22s %10.0f %7.0f %14.0f %10.4f %10.3f\n", name,
+                (double)stats.calls, (double)stats.errors,
+                (double)stats.bytes, stats.time, 1.0e3 * stats.max_time);
+    }
+    if (verbose) printf("\n");
+    printf("cgio calls   : %.0f (%.0f failed)\n", (double)calls,
+        (double)errors);
+    printf("time in cgio : %.4f s of %.4f s\n", time, wall_time);
+    printf("data bytes   : %.0f read, %.0f written\n", (double)rbytes,
+        (double)wbytes);
+}
+
+/*-------------------------------------------------------------------*/
+
+int main (int argc, char *argv[])
+{
+    int n, ierr, verbose = 0;
+    char *p, *recfile = NULL;
+    double start, wall_time;
+    IO_COUNTERS io_start, io_end;
+
+    for (n = 1; n < argc; n++) {
+        p = argv[n];
+        if (*p != '-') {
+            if (recfile != NULL) print_usage("only one record file");
+            recfile = p;
+            continue;
+        }
+        if (!strcmp(p, "-a")) file_type = CGIO_FILE_ADF;
+        else if (!strcmp(p, "-2")) file_type = CGIO_FILE_ADF2;
+        else if (!strcmp(p, "-3")) file_type = CGIO_FILE_ADF3;
+        else if (!strcmp(p, "-h")) file_type = CGIO_FILE_HDF5;
+        else if (!strcmp(p, "-M")) file_type = CGIO_FILE_MEMORY;
+        else if (!strcmp(p, "-k")) keep_files = 1;
+        else if (!strcmp(p, "-v")) verbose = 1;
+        else if (!strcmp(p, "-m") && n + 1 < argc) {
+            p = argv[++n];
+            if ((recfile = strchr(p, '=')) == NULL)
+                print_usage("-m needs old=new");
+            *recfile++ = 0;
+            add_name(p, recfile);
+            recfile = NULL;
+        }
+        else
+            print_usage("unknown option");
+    }
+    if (recfile == NULL) print_usage("record file not given");
+    if (file_type != CGIO_FILE_NONE && cgio_is_supported(file_type))
+        error_exit("file type is not supported by this library");
+
+    read_record(recfile);
+    prepare_files();
+
+    cgio_configure(CGIO_CONFIG_STATS, (void *)1);
+    io_counters(&io_start);
+    start = wall_clock();
+    for (n = 0; n < num_lines; n++) {
+        if (lines[n].op == OP_ASYNC_ID) continue;
+        num_calls++;
+        ierr = replay_line(&lines[n]);
+        if (ierr < 0)
+            num_skipped++;
+        else if ((ierr != 0) != (lines[n].err != 0))
+            num_mismatch++;
+    }
+    for (n = 0; n < num_files; n++) {
+        if (files[n].cgio_num) cgio_close_file(files[n].cgio_num);
+    }
+    wall_time = wall_clock() - start;
+    io_counters(&io_end);
+
+    printf("record       : %s, %.0f calls (%.0f skipped, %.0f with "
+        "a different outcome)\n", recfile, (double)num_calls,
+        (double)num_skipped, (double)num_mismatch);
+    print_stats(verbose, wall_time);
+    if (io_end.have_proc) {
+        printf("system calls : %.0f read, %.0f write\n",
+            (double)(io_end.syscr - io_start.syscr),
+            (double)(io_end.syscw - io_start.syscw));
+        printf("bytes moved  : %.0f read, %.0f written\n",
+            (double)(io_end.rchar - io_start.rchar),
+            (double)(io_end.wchar - io_start.wchar));
+    }
+    printf("storage      : %.0f read, %.0f written\n",
+        (double)(io_end.read_bytes - io_start.read_bytes),
+        (double)(io_end.write_bytes - io_start.write_bytes));
+
+    cgio_cleanup();
+    remove_files();
+    return 0;
+}
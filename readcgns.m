@@ -1,9 +1,9 @@
 function [ps, elems, typestr, var_nodes, var_cells] = ...
-    readcgns(filename, node_var_list, elem_var_list)
+    readcgns(filename, node_var_list, elem_var_list, zones, index_base)
 %READCGNS Read an unstructured grid CGNS file.
-% READCGNS(FILENAME, NODE_VAR_LIST, ELEM_VAR_LIST) Reads a file in
-% CGNS format via CGNS mid-library. Inputs and Outputs, as well as examples
-% provided below.
+% READCGNS(FILENAME, NODE_VAR_LIST, ELEM_VAR_LIST, ZONES, BASE) Reads a file
+% in CGNS format via CGNS mid-library. Inputs and Outputs, as well as
+% examples provided below.
 %
 % Input arguments:
 %   FILENAME is a character string, specifying the input file.
@@ -14,6 +14,10 @@ function [ps, elems, typestr, var_nodes, var_cells] = ...
 %        If not present or is empty, then all nodal variables are read.
 %   ELEM_VAR_LIST is analogous to NODE_VAR_LIST but is for elemental values.
 %
+%   ZONES, if present, is a list of zone indices to be read. If not present
+%        or is empty, then all zones of the base are read.
+%   BASE is the index of the base to be read. Default is 1.
+%
 % Output arguments:
 %   XS is nxd array containing nodal coordinates, where d is the dimension
 %       of the space (in general d is 2 or 3).
@@ -43,6 +47,10 @@ function [ps, elems, typestr, var_nodes, var_cells] = ...
 %
 %   VAR_CELLS is a MATLAB structure containing elemental values to be
 %       read. Its usage is similar to VAR_NODES.
+%   If more than one zone is read, then each output argument is a 1xn cell
+%       array, with one entry per zone in the order given by ZONES. If an
+%       unstructured zone has more than one element section, then ELEMS and
+%       TYPESTR of that zone are cell arrays with one entry per section.
 %
 % Example usage
 %     % Read only node-centered variables
@@ -54,6 +62,10 @@ function [ps, elems, typestr, var_nodes, var_cells] = ...
 %     % Read node-centered and cell-centered variables
 %     [xs, elems, etype, var_nodes, var_cells] = readcgns( 'test.cgns');
 %
+%     % Read all zones of a multi-block file
+%     [xs, elems, etype] = readcgns( 'blocks.cgns', '-', '-');
+%     for z=1:length(xs), disp(size(xs{z})); end
+%
 % See also WRITECGNS
 
 % Note: This function will be generalized to support structured meshes in
@@ -78,19 +90,63 @@ elseif (nargin<2)
 elseif (nargin<3)
     elem_var_list = [];
 end
+if (nargin<4)
+    zones = [];
+end
+if (nargin<5)
+    index_base = 1;
+end
 
 % Open the CGNS file
 [index_file,ierr] = cg_open(filename, CG_MODE_READ); chk_error(ierr);
 
 % Get dimension of element(icelldim) and vertex(iphysdim)
-index_base=1;  %assume there is only one base
 basename = char(zeros(1,32));
 [basename,icelldim,iphysdim,ierr] = cg_base_read(index_file,index_base,...
     basename); chk_error(ierr);
 assert(~isempty(deblank(basename)))
 
+% Read the coordinates of all requested zones in one call
+if isempty(zones)
+    [nzones,ierr] = cg_nzones(index_file,index_base); chk_error(ierr);
+    zones = 1:nzones;
+end
+[coords,ierr] = cg_zones_coord_read(index_file,index_base,zones);
+chk_error(ierr);
+
+nz = length(zones);
+ps = coords;
+elems = cell(1,nz);
+typestr = cell(1,nz);
+var_nodes = cell(1,nz);
+var_cells = cell(1,nz);
+for ii=1:nz
+    [elems{ii}, typestr{ii}, var_nodes{ii}, var_cells{ii}] = read_zone( ...
+        index_file, index_base, zones(ii), icelldim, iphysdim, ps{ii}, ...
+        node_var_list, elem_var_list, nargin, nargout);
+end
+
+% Close CGNS file
+ierr = cg_close(index_file); chk_error(ierr);
+
+% A single zone is returned as is
+if (nz == 1)
+    ps = ps{1};
+    elems = elems{1};
+    typestr = typestr{1};
+    var_nodes = var_nodes{1};
+    var_cells = var_cells{1};
+end
+
+end
+
+function [elems, typestr, var_nodes, var_cells] = read_zone(index_file, ...
+    index_base, index_zone, icelldim, iphysdim, ps, node_var_list, ...
+    elem_var_list, nargin_main, nargout_main)
+% Read the elements and variables of a single zone. The grid coordinates
+% PS have been read already by cg_zones_coord_read.
+
 % Get zone type */
-index_zone=1;  % assume there is only one zone
 [zonetype,ierr] = cg_zone_type(index_file,index_base,index_zone);
 chk_error(ierr);
 
@@ -104,45 +160,12 @@ if (zonetype == 2) % Structured
     end
     
     % Get zone size (and name - although not needed here) */
-    index_zone=1;  % assume there is only one zone
     size = zeros(1,9);
     zonename = char(zeros(1,32));
     [zonename,size,ierr] = cg_zone_read(index_file,index_base,index_zone, ...
         zonename, size); chk_error(ierr);
     assert(~isempty(deblank(zonename)))
     
-    % Define the range of vertices
-    if (iphysdim ==2)
-        rmin = [1 1];  % lower range index of vertices
-        rmax = zeros(1,2);
-        rmax(1,1:2) = size(1,1:2);  % upper range index of vertices
-    elseif (iphysdim == 3)
-        rmin = [1 1 1];  % lower range index of vertices
-        rmax = zeros(1,3);
-        rmax(1,1:3) = size(1,1:3);  % upper range index of vertices
-    else
-        error('physical dimension not supported');
-    end
-    
-    % Read grid coordinates (must use SIDS-standard names here)
-    if (iphysdim == 2)
-        ps = zeros(rmax(1,1),rmax(1,2),iphysdim);
-        [ps(:,:,1),ierr] = cg_coord_read(index_file,index_base,index_zone,...
-            'CoordinateX', RealDouble,rmin,rmax, ps(:,:,1)); chk_error(ierr);
-        [ps(:,:,2),ierr] = cg_coord_read(index_file,index_base,index_zone,...
-            'CoordinateY', RealDouble,rmin,rmax, ps(:,:,2)); chk_error(ierr);
-    elseif (iphysdim == 3)
-        ps = zeros(rmax(1,1),rmax(1,2),rmax(1,3),iphysdim);
-        [ps(:,:,:,1),ierr] = cg_coord_read(index_file,index_base,index_zone,...
-            'CoordinateX', RealDouble,rmin,rmax, ps(:,:,:,1)); chk_error(ierr);
-        [ps(:,:,:,2),ierr] = cg_coord_read(index_file,index_base,index_zone,...
-            'CoordinateY', RealDouble,rmin,rmax, ps(:,:,:,2)); chk_error(ierr);
-        [ps(:,:,:,3),ierr ]= cg_coord_read(index_file,index_base,index_zone,...
-            'CoordinateZ', RealDouble,rmin,rmax, ps(:,:,:,3)); chk_error(ierr);
-    else
-        error('physical dimension not supported');
-    end
-    
     % Define the range of elements
     if (iphysdim == 2)
         elem_start = [1 1]; % lower range index of elements
@@ -215,7 +238,7 @@ if (zonetype == 2) % Structured
     
     if (n_sol>0)
         [var_nodes, var_cells,after_struct] = convert_field_name(before_struct,...
-            node_var_list, elem_var_list,nargin,nargout);
+            node_var_list, elem_var_list,nargin_main,nargout_main);
     end
     
     % get the number of variables to read
@@ -248,7 +271,6 @@ if (zonetype == 2) % Structured
 elseif (zonetype == 3) % Unstructured
     
     % Get zone size (and name - although not needed here) */
-    index_zone=1;  % assume there is only one zone
     size = zeros(1,9);
     zonename = char(zeros(1,32));
     [zonename,size,ierr] = cg_zone_read(index_file,index_base,index_zone, ...
@@ -259,77 +281,22 @@ elseif (zonetype == 3) % Unstructured
     rmin = 1;      % lower range index of vertices
     rmax = size(1);  % upper range index of vertices
     
-    % Read grid coordinates (must use SIDS-standard names here)
-    ps = zeros(rmax(1),iphysdim);
-    [ps(:,1),ierr] = cg_coord_read(index_file,index_base,index_zone,...
-        'CoordinateX', RealDouble,rmin,rmax, ps(:,1)); chk_error(ierr);
-    [ps(:,2),ierr] = cg_coord_read(index_file,index_base,index_zone,...
-        'CoordinateY', RealDouble,rmin,rmax, ps(:,2)); chk_error(ierr);
-    
-    if (iphysdim == 3)
-        [ps(:,3),ierr ]= cg_coord_read(index_file,index_base,index_zone,...
-            'CoordinateZ', RealDouble,rmin,rmax, ps(:,3)); chk_error(ierr);
-    end
-    
-    % Get element connectivity and element type
-    index_sect = 1;    % assume there is only one section
-    sectionname = char(zeros(1,32));
-    [sectionname,itype,istart,iend, nbndry, pflag, ierr] = cg_section_read(index_file, ...
-        index_base,index_zone,index_sect,sectionname); chk_error(ierr); %#ok<*ASGLU>
-    assert(~isempty(deblank(sectionname)))
-    
-    % Define the range of elements
-    elem_start = istart;  % lower range index of elements
-    elem_end = iend;     % upper range index of elements
-    
-    [npe, typestr] = get_elemtype_string( itype, icelldim);
-    
-    % Get element connectivity
-    [size_ielem,ierr] = cg_ElementDataSize(index_file,index_base,index_zone, ...
-        index_sect); chk_error(ierr);
-    num_elems = size_ielem / npe;   % number of elements (except for MIXED)
-    elems = zeros(npe, num_elems);  % Element connectivity is permuted in CGNS
-    parent_data = [];
-    [elems, parent_data,ierr] = cg_elements_read(index_file,index_base,index_zone,...
-        index_sect,elems,parent_data); chk_error(ierr);
-    elems = elems';                 % Permute the connectivity back
-    
-    element_type = elems(1);
-    % If element type is MIXED, change leading type to number of nodes for
-    % every element in the element connectivity
-    
-    if (itype == MIXED)
-        elems = inverse_mixed_elements(elems);
-    end
-    
-    nelems = number_of_elements( elems);    % number of elements (MIXED element type)
-    
-    if (itype ~= MIXED) && (num_elems ~= nelems )
-        error('Error: Incorrectly reading element connectivity.');
-    end
-    
-    if (itype == MIXED)
-        % Check that mesh is indeed MIXED
-        num_type = elems(1);
-        for ii = 2:nelems
-            if num_type~=elems(1+(num_type+1)*(ii-1))
-                num_type = 0;
-                break;
-            end
-        end
-        
-        % Convert MIXED2 and MIXED3 types to actual types, if they have been
-        % mislabeled.  Additionally change ELEMS so that it is the correct type of
-        % output matrix.
-        
-        if num_type ~= 0
-            new_elems = zeros(nelems,num_type);
-            for ii = 1:nelems
-                new_elems(ii,:) = elems((num_type+1)*(ii-1)+2:(num_type+1)*(ii-1)+(num_type+1));
-            end
-            [npe, typestr] = get_elemtype_string( element_type, icelldim);
-            elems = new_elems;
+    % Get element connectivity and element type of every section
+    [nsections,ierr] = cg_nsections(index_file,index_base,index_zone);
+    chk_error(ierr);
+    if (nsections == 1)
+        [elems, typestr, elem_start, elem_end] = read_section(index_file, ...
+            index_base, index_zone, 1, icelldim);
+    else
+        elems = cell(1,nsections);
+        typestr = cell(1,nsections);
+        for index_sect = 1:nsections
+            [elems{index_sect}, typestr{index_sect}] = read_section( ...
+                index_file, index_base, index_zone, index_sect, icelldim);
         end
+        % Cell-centered variables cover all the elements of the zone
+        elem_start = 1;
+        elem_end = size(2);
     end
     
     % Get variables. First read in the field names, datatypes, etc.
@@ -369,7 +336,7 @@ elseif (zonetype == 3) % Unstructured
     
     if (n_sol>0)
         [var_nodes, var_cells,after_struct] = convert_field_name(before_struct,...
-            node_var_list, elem_var_list,nargin,nargout);
+            node_var_list, elem_var_list,nargin_main,nargout_main);
     end
     
     % get the number of variables to read
@@ -402,8 +369,70 @@ else
     error('zonetype not recognized');
 end
 
-% Close CGNS file
-ierr = cg_close(index_file); chk_error(ierr);
+end
+
+function [elems, typestr, elem_start, elem_end] = read_section(index_file, ...
+    index_base, index_zone, index_sect, icelldim)
+% Read element connectivity and element type of a single section
+
+sectionname = char(zeros(1,32));
+[sectionname,itype,istart,iend, nbndry, pflag, ierr] = cg_section_read(index_file, ...
+    index_base,index_zone,index_sect,sectionname); chk_error(ierr); %#ok<*ASGLU>
+assert(~isempty(deblank(sectionname)))
+
+% Define the range of elements
+elem_start = istart;  % lower range index of elements
+elem_end = iend;     % upper range index of elements
+
+[npe, typestr] = get_elemtype_string( itype, icelldim);
+
+% Get element connectivity
+[size_ielem,ierr] = cg_ElementDataSize(index_file,index_base,index_zone, ...
+    index_sect); chk_error(ierr);
+num_elems = size_ielem / npe;   % number of elements (except for MIXED)
+elems = zeros(npe, num_elems);  % Element connectivity is permuted in CGNS
+parent_data = [];
+[elems, parent_data,ierr] = cg_elements_read(index_file,index_base,index_zone,...
+    index_sect,elems,parent_data); chk_error(ierr);
+elems = elems';                 % Permute the connectivity back
+
+element_type = elems(1);
+% If element type is MIXED, change leading type to number of nodes for
+% every element in the element connectivity
+
+if (itype == MIXED)
+    elems = inverse_mixed_elements(elems);
+end
+
+nelems = number_of_elements( elems);    % number of elements (MIXED element type)
+
+if (itype ~= MIXED) && (num_elems ~= nelems )
+    error('Error: Incorrectly reading element connectivity.');
+end
+
+if (itype == MIXED)
+    % Check that mesh is indeed MIXED
+    num_type = elems(1);
+    for ii = 2:nelems
+        if num_type~=elems(1+(num_type+1)*(ii-1))
+            num_type = 0;
+            break;
+        end
+    end
+    
+    % Convert MIXED2 and MIXED3 types to actual types, if they have been
+    % mislabeled.  Additionally change ELEMS so that it is the correct type of
+    % output matrix.
+    
+    if num_type ~= 0
+        new_elems = zeros(nelems,num_type);
+        for ii = 1:nelems
+            new_elems(ii,:) = elems((num_type+1)*(ii-1)+2:(num_type+1)*(ii-1)+(num_type+1));
+        end
+        [npe, typestr] = get_elemtype_string( element_type, icelldim);
+        elems = new_elems;
+    end
+end
 
 end
 
@@ -1045,3 +1074,69 @@ end
 
 %! delete test1_tri.h5;
 %! delete test1_mixed.h5;
+
+%% Test that a file changed in the same second as its .cgidx index was
+%% written is not read through the stale index
+%!test
+%! nodal_vars = struct('aaaa', xs(:,1));
+%! cg_configure(CG_CONFIG_INDEX, 1);
+%! writecgns( 'test1_idx.adf', xs, tris, [], nodal_vars);
+%! [xs1,tris1,typestr,var_nodes] = readcgns('test1_idx.adf');
+%! % rewrite it without the index, so the index is left as it was
+%! cg_configure(CG_CONFIG_INDEX, 0);
+%! nodal_vars = struct('bbbb', xs(:,1));
+%! writecgns( 'test1_idx.adf', xs, tris, [], nodal_vars);
+%! cg_configure(CG_CONFIG_INDEX, 1);
+%! [xs1,tris1,typestr,var_nodes] = readcgns('test1_idx.adf');
+%! cg_configure(CG_CONFIG_INDEX, 0);
+%! delete test1_idx.adf test1_idx.adf.cgidx;
+%! if(~isequal(nodal_vars,var_nodes))
+%!     error('Error: read a stale node index');
+%! end
+
+%% Test to append a solution step to an existing file
+%!test
+%! writecgns( 'test1_append.adf', xs, tris, [], struct('aaaa', xs(:,1)));
+%! [fn,ierr] = cg_open('test1_append.adf', CG_MODE_APPEND); assert(ierr==0);
+%! [nsols,ierr] = cg_nsols(fn, 1, 1); assert(ierr==0 && nsols==1);
+%! % new zones are not supported in append mode
+%! [Z,ierr] = cg_zone_write(fn, 1, 'Zone2', [4 2 0], CG_Unstructured); assert(ierr~=0);
+%! [S,ierr] = cg_sol_write(fn, 1, 1, 'Step2', CG_Vertex); assert(ierr==0);
+%! [F,ierr] = cg_field_write(fn, 1, 1, S, CG_RealDouble, 'cccc', xs(:,2)); assert(ierr==0);
+%! ierr = cg_biter_write(fn, 1, 'BaseIterativeData', 2); assert(ierr==0);
+%! ierr = cg_close(fn); assert(ierr==0);
+%! [fn,ierr] = cg_open('test1_append.adf', CG_MODE_APPEND); assert(ierr==0);
+%! [nsols,ierr] = cg_nsols(fn, 1, 1); assert(ierr==0 && nsols==2);
+%! [bitername,nsteps,ierr] = cg_biter_read(fn, 1, char(zeros(1,32))); assert(ierr==0 && nsteps==2);
+%! ierr = cg_close(fn); assert(ierr==0);
+%! [xs1,tris1,typestr,var_nodes] = readcgns('test1_append.adf');
+%! delete test1_append.adf;
+%! if(~isequal(xs,xs1) || ~isequal(struct('aaaa', xs(:,1), 'cccc', xs(:,2)),var_nodes))
+%!     error('Error: incorrectly appended a solution');
+%! end
+
+%% Test the strided field wrappers with only the required arguments
+%!test
+%! writecgns( 'test1_general.adf', xs, tris, [], struct('aaaa', xs(:,1)));
+%! [fn,ierr] = cg_open('test1_general.adf', CG_MODE_MODIFY); assert(ierr==0);
+%! [F,ierr] = cg_field_general_write(fn, 1, 1, 1, CG_RealDouble, 'aaaa', ...
+%!     1, 4, 1, [4; 3; 2; 1]); assert(ierr==0);
+%! [vals,ierr] = cg_field_general_read(fn, 1, 1, 1, 'aaaa', CG_RealDouble, ...
+%!     1, 4, 2); assert(ierr==0);
+%! ierr = cg_close(fn); assert(ierr==0);
+%! delete test1_general.adf;
+%! if(~isequal(vals, [4; 2]))
+%!     error('Error: incorrectly read or wrote a strided field');
+%! end
+
+%% Test that ten or more zones are read back in the order written
+%!test
+%! nz = 12;
+%! xss = cell(1,nz); triss = cell(1,nz);
+%! for z=1:nz; xss{z} = xs + z; triss{z} = tris; end
+%! writecgns( 'test1_zones.cgns', xss, triss);
+%! [xs1,tris1] = readcgns('test1_zones.cgns');
+%! delete test1_zones.cgns;
+%! if(~isequal(xss,xs1) || ~isequal(triss,tris1))
+%!     error('Error: zones of a multi-zone mesh read back out of order');
+%! end
@@ -1,9 +1,9 @@
 function [ps, elems, typestr, var_nodes, var_cells] = ...
-    readcgns_unstr(filename, node_var_list, elem_var_list)
+    readcgns_unstr(filename, node_var_list, elem_var_list, zones, index_base)
 %READCGNS_UNSTR Read an unstructured grid CGNS file.
-% READCGNS_UNSTR(FILENAME, NODE_VAR_LIST, ELEM_VAR_LIST) Reads a file in
-% CGNS format via CGNS mid-library. Inputs and Outputs, as well as examples
-% provided below.
+% READCGNS_UNSTR(FILENAME, NODE_VAR_LIST, ELEM_VAR_LIST, ZONES, BASE) Reads
+% a file in CGNS format via CGNS mid-library. Inputs and Outputs, as well
+% as examples provided below.
 %
 % Input arguments:
 %   FILENAME is a character string, specifying the input file.
@@ -14,6 +14,10 @@ function [ps, elems, typestr, var_nodes, var_cells] = ...
 %        If not present or is empty, then all nodal variables are read.
 %   ELEM_VAR_LIST is analogous to NODE_VAR_LIST but is for elemental values.
 %
+%   ZONES, if present, is a list of zone indices to be read. If not present
+%        or is empty, then all zones of the base are read.
+%   BASE is the index of the base to be read. Default is 1.
+%
 % Output arguments:
 %   XS is nxd array containing nodal coordinates, where d is the dimension
 %       of the space (in general d is 2 or 3).
@@ -35,6 +39,10 @@ function [ps, elems, typestr, var_nodes, var_cells] = ...
 %
 %   VAR_CELLS is a MATLAB structure containing elemental values to be
 %       read. Its usage is similar to VAR_NODES.
+%   If more than one zone is read, then each output argument is a 1xn cell
+%       array, with one entry per zone in the order given by ZONES. If a
+%       zone has more than one element section, then ELEMS and TYPESTR of
+%       that zone are cell arrays with one entry per section.
 %
 % Example usage
 %     % Read only node-centered variables
@@ -46,6 +54,10 @@ function [ps, elems, typestr, var_nodes, var_cells] = ...
 %     % Read node-centered and cell-centered variables
 %     [xs, elems, etype, var_nodes, var_cells] = readcgns_unstr( 'test.cgns');
 %
+%     % Read all zones of a multi-zone file
+%     [xs, elems, etype] = readcgns_unstr( 'zones.cgns', '-', '-');
+%     for z=1:length(xs), disp(size(xs{z})); end
+%
 % See also WRITECGNS_UNSTR
 
 % Note: This function will be generalized to support structured meshes in 
@@ -70,97 +82,94 @@ elseif (nargin<3)
     elem_var_list = [];
 end
 
+if (nargin<4)
+    zones = [];
+end
+if (nargin<5)
+    index_base = 1;
+end
+
 % Open the CGNS file
 [index_file,ierr] = cg_open(filename, CG_MODE_READ); chk_error(ierr); 
 
 % Get dimension of element(icelldim) and vertex(iphysdim)
-index_base=1;  %assume there is only one base
 basename = char(zeros(1,32));
 [basename,icelldim,iphysdim,ierr] = cg_base_read(index_file,index_base,...
     basename); chk_error(ierr); %#ok<*ASGLU>
 assert(~isempty(deblank(basename)));
-% Get zone size (and name - although not needed here) */
-index_zone=1;  % assume there is only one zone
-size = zeros(1,9);
-zonename = char(zeros(1,32));
-[zonename,size,ierr] = cg_zone_read(index_file,index_base,index_zone, ...
-    zonename, size); chk_error(ierr);
-assert(~isempty(deblank(zonename)))
-
-% Define the range of vertices
-rmin = 1;      % lower range index of vertices
-rmax = size(1);  % upper range index of vertices
 
-% Read grid coordinates (must use SIDS-standard names here)
-ps = zeros(rmax(1),iphysdim);
-[ps(:,1),ierr] = cg_coord_read(index_file,index_base,index_zone,...
-    'CoordinateX', RealDouble,rmin,rmax, ps(:,1)); chk_error(ierr);
-[ps(:,2),ierr] = cg_coord_read(index_file,index_base,index_zone,...
-    'CoordinateY', RealDouble,rmin,rmax, ps(:,2)); chk_error(ierr);
-
-if (iphysdim == 3)
-    [ps(:,3),ierr ]= cg_coord_read(index_file,index_base,index_zone,...
-        'CoordinateZ', RealDouble,rmin,rmax, ps(:,3)); chk_error(ierr);
+% Read the coordinates of all requested zones in one call
+if isempty(zones)
+    [nzones,ierr] = cg_nzones(index_file,index_base); chk_error(ierr);
+    zones = 1:nzones;
 end
+[coords,ierr] = cg_zones_coord_read(index_file,index_base,zones);
+chk_error(ierr);
 
-% Get element connectivity and element type
-index_sect = 1;    % assume there is only one section
-sectionname = char(zeros(1,32));
-[sectionname,itype,istart,iend, nbndry, pflag, ierr] = cg_section_read(index_file, ...
-    index_base,index_zone,index_sect,sectionname); chk_error(ierr); %#ok<*ASGLU>
-assert(~isempty(deblank(sectionname)))
-
-% Define the range of elements
-elem_start = istart;  % lower range index of elements
-elem_end = iend;     % upper range index of elements
-
-[npe, typestr] = get_elemtype_string( itype, icelldim);
+nz = length(zones);
+ps = coords;
+elems = cell(1,nz);
+typestr = cell(1,nz);
+var_nodes = cell(1,nz);
+var_cells = cell(1,nz);
+for ii=1:nz
+    [elems{ii}, typestr{ii}, var_nodes{ii}, var_cells{ii}] = read_zone( ...
+        index_file, index_base, zones(ii), icelldim, node_var_list, ...
+        elem_var_list, nargin, nargout);
+end
 
-% Get element connectivity
-[size_ielem,ierr] = cg_ElementDataSize(index_file,index_base,index_zone, ...
-    index_sect); chk_error(ierr);
-num_elems = size_ielem / npe;   % number of elements (except for MIXED)
-elems = zeros(npe, num_elems);  % Element connectivity is permuted in CGNS
-parent_data = [];
-[elems, parent_data,ierr] = cg_elements_read(index_file,index_base,index_zone,...
-    index_sect,elems,parent_data); chk_error(ierr);
-elems = elems';                 % Permute the connectivity back
+% Close CGNS file
+ierr = cg_close(index_file); chk_error(ierr);
 
-element_type = elems(1);
-% If element type is MIXED, change leading type to number of nodes for
-% every element in the element connectivity
-if (itype == MIXED)
-    elems = inverse_mixed_elements(elems);
+% A single zone is returned as is
+if (nz == 1)
+    ps = ps{1};
+    elems = elems{1};
+    typestr = typestr{1};
+    var_nodes = var_nodes{1};
+    var_cells = var_cells{1};
+end
 end
 
-nelems = number_of_elements( elems);    % number of elements (MIXED element type)
+function [elems, typestr, var_nodes, var_cells] = read_zone(index_file, ...
+    index_base, index_zone, icelldim, node_var_list, elem_var_list, ...
+    nargin_main, nargout_main)
+% Read the elements and variables of a single zone. The grid coordinates
+% have been read already by cg_zones_coord_read.
 
-if (itype ~= MIXED) && (num_elems ~= nelems )
-    error('Error: Incorrectly reading element connectivity.');
+[zonetype,ierr] = cg_zone_type(index_file,index_base,index_zone);
+chk_error(ierr);
+if (zonetype ~= Unstructured)
+    error('Zone %d is not an unstructured zone; use readcgns instead', index_zone);
 end
 
-if (itype == MIXED)
-    % Check that mesh is indeed MIXED
-    num_type = elems(1);
-    for ii = 2:nelems
-        if num_type~=elems(1+(num_type+1)*(ii-1))
-            num_type = 0;
-            break;
-        end
-    end
+% Get zone size (and name - although not needed here) */
+size = zeros(1,9);
+zonename = char(zeros(1,32));
+[zonename,size,ierr] = cg_zone_read(index_file,index_base,index_zone, ...
+    zonename, size); chk_error(ierr);
+assert(~isempty(deblank(zonename)))
 
-    % Convert MIXED2 and MIXED3 types to actual types, if they have been
-    % mislabeled.  Additionally change ELEMS so that it is the correct type of
-    % output matrix.
+% Define the range of vertices
+rmin = 1;      % lower range index of vertices
+rmax = size(1);  % upper range index of vertices
 
-    if num_type ~= 0
-        new_elems = zeros(nelems,num_type);
-        for ii = 1:nelems
-            new_elems(ii,:) = elems((num_type+1)*(ii-1)+2:(num_type+1)*(ii-1)+(num_type+1));
-        end
-        [npe, typestr] = get_elemtype_string( element_type, icelldim);
-        elems = new_elems;
+% Get element connectivity and element type of every section
+[nsections,ierr] = cg_nsections(index_file,index_base,index_zone);
+chk_error(ierr);
+if (nsections == 1)
+    [elems, typestr, elem_start, elem_end] = read_section(index_file, ...
+        index_base, index_zone, 1, icelldim);
+else
+    elems = cell(1,nsections);
+    typestr = cell(1,nsections);
+    for index_sect = 1:nsections
+        [elems{index_sect}, typestr{index_sect}] = read_section( ...
+            index_file, index_base, index_zone, index_sect, icelldim);
     end
+    % Cell-centered variables cover all the elements of the zone
+    elem_start = 1;
+    elem_end = size(2);
 end
 
 % Get variables. First read in the field names, datatypes, etc.
@@ -199,7 +208,7 @@ after_struct = [];
 
 if (n_sol>0)
     [var_nodes, var_cells,after_struct] = convert_field_name(before_struct,...
-        node_var_list, elem_var_list,nargin,nargout);
+        node_var_list, elem_var_list,nargin_main,nargout_main);
 end
 
 % get the number of variables to read
@@ -227,9 +236,69 @@ if(n_vf ~= 0)
     var_cells = read_variables(index_file,index_base,index_zone,...
         after_struct,var_cells,elem_start,elem_end, CellCenter);
 end
+end
 
-% Close CGNS file
-ierr = cg_close(index_file); chk_error(ierr);
+function [elems, typestr, elem_start, elem_end] = read_section(index_file, ...
+    index_base, index_zone, index_sect, icelldim)
+% Read element connectivity and element type of a single section
+
+sectionname = char(zeros(1,32));
+[sectionname,itype,istart,iend, nbndry, pflag, ierr] = cg_section_read(index_file, ...
+    index_base,index_zone,index_sect,sectionname); chk_error(ierr);
+assert(~isempty(deblank(sectionname)))
+
+% Define the range of elements
+elem_start = istart;  % lower range index of elements
+elem_end = iend;     % upper range index of elements
+
+[npe, typestr] = get_elemtype_string( itype, icelldim);
+
+% Get element connectivity
+[size_ielem,ierr] = cg_ElementDataSize(index_file,index_base,index_zone, ...
+    index_sect); chk_error(ierr);
+num_elems = size_ielem / npe;   % number of elements (except for MIXED)
+elems = zeros(npe, num_elems);  % Element connectivity is permuted in CGNS
+parent_data = [];
+[elems, parent_data,ierr] = cg_elements_read(index_file,index_base,index_zone,...
+    index_sect,elems,parent_data); chk_error(ierr);
+elems = elems';                 % Permute the connectivity back
+
+element_type = elems(1);
+% If element type is MIXED, change leading type to number of nodes for
+% every element in the element connectivity
+if (itype == MIXED)
+    elems = inverse_mixed_elements(elems);
+end
+
+nelems = number_of_elements( elems);    % number of elements (MIXED element type)
+
+if (itype ~= MIXED) && (num_elems ~= nelems )
+    error('Error: Incorrectly reading element connectivity.');
+end
+
+if (itype == MIXED)
+    % Check that mesh is indeed MIXED
+    num_type = elems(1);
+    for ii = 2:nelems
+        if num_type~=elems(1+(num_type+1)*(ii-1))
+            num_type = 0;
+            break;
+        end
+    end
+
+    % Convert MIXED2 and MIXED3 types to actual types, if they have been
+    % mislabeled.  Additionally change ELEMS so that it is the correct type of
+    % output matrix.
+
+    if num_type ~= 0
+        new_elems = zeros(nelems,num_type);
+        for ii = 1:nelems
+            new_elems(ii,:) = elems((num_type+1)*(ii-1)+2:(num_type+1)*(ii-1)+(num_type+1));
+        end
+        [npe, typestr] = get_elemtype_string( element_type, icelldim);
+        elems = new_elems;
+    end
+end
 end
 
 function nelems = number_of_elements( elems)
@@ -774,3 +843,34 @@ end
 
 %! delete test1_tri.h5;
 %! delete test1_mixed.h5;
+
+%% Test to write and read several zones
+%!test
+%! nodal_vars.sca = xs(:,1);
+%! writecgns_unstr( 'test1_zones.cgns', {xs, xs}, {tris, elems}, ...
+%!     {[], 'MIXED2'}, {nodal_vars, nodal_vars});
+%! [xs1,elems1,typestr,var_nodes] = readcgns_unstr('test1_zones.cgns');
+%! if(~iscell(xs1) || length(xs1)~=2 || ~isequal(xs,xs1{1}) || ~isequal(xs,xs1{2}) || ...
+%!         ~isequal(tris, elems1{1}) || ~isequal(tris, elems1{2}) || ...
+%!         ~isequal(nodal_vars,var_nodes{1}) || ~isequal(nodal_vars,var_nodes{2}))
+%!     error('Error: incorrectly read a multi-zone mesh');
+%! end
+%!
+%! % Test reading a selected zone
+%! [xs1,elems1,typestr] = readcgns_unstr('test1_zones.cgns', [], [], 2, 1);
+%! if(~isequal(xs,xs1) || ~isequal(tris, elems1))
+%!     error('Error: incorrectly read a selected zone');
+%! end
+%! delete test1_zones.cgns;
+
+%% Test that ten or more zones are read back in the order written
+%!test
+%! nz = 12;
+%! xss = cell(1,nz); triss = cell(1,nz);
+%! for z=1:nz; xss{z} = xs + z; triss{z} = tris; end
+%! writecgns_unstr( 'test1_zones.cgns', xss, triss);
+%! [xs1,tris1] = readcgns_unstr('test1_zones.cgns');
+%! delete test1_zones.cgns;
+%! if(~isequal(xss,xs1) || ~isequal(triss,tris1))
+%!     error('Error: zones of a multi-zone mesh read back out of order');
+%! end
@@ -0,0 +1,3 @@
+function val = CG_CONFIG_ADF_COMPRESS
+%% Value 106 of enumeration type 
+val = int32(106);
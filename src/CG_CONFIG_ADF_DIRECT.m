@@ -0,0 +1,3 @@
+function val = CG_CONFIG_ADF_DIRECT
+%% Value 104 of enumeration type 
+val = int32(104);
@@ -0,0 +1,3 @@
+function val = CG_CONFIG_ADF_MERGE
+%% Value 103 of enumeration type 
+val = int32(103);
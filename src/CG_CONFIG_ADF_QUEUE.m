@@ -0,0 +1,3 @@
+function val = CG_CONFIG_ADF_QUEUE
+%% Value 110 of enumeration type 
+val = int32(110);
@@ -0,0 +1,3 @@
+function val = CG_CONFIG_ADF_SYNC
+%% Value 102 of enumeration type 
+val = int32(102);
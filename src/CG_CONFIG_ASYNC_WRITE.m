@@ -0,0 +1,3 @@
+function val = CG_CONFIG_ASYNC_WRITE
+%% Value 6 of enumeration type 
+val = int32(6);
@@ -0,0 +1,3 @@
+function val = CG_CONFIG_HDF5_META
+%% Value 204 of enumeration type 
+val = int32(204);
@@ -0,0 +1,3 @@
+function val = CG_CONFIG_INDEX
+%% Value 101 of enumeration type 
+val = int32(101);
@@ -0,0 +1,3 @@
+function val = CG_CONFIG_PREALLOCATE
+%% Value 105 of enumeration type 
+val = int32(105);
@@ -0,0 +1,3 @@
+function val = CG_CONFIG_RECORD
+%% Value 109 of enumeration type 
+val = int32(109);
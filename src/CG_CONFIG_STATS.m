@@ -0,0 +1,3 @@
+function val = CG_CONFIG_STATS
+%% Value 107 of enumeration type 
+val = int32(107);
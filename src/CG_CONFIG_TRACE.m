@@ -0,0 +1,3 @@
+function val = CG_CONFIG_TRACE
+%% Value 108 of enumeration type 
+val = int32(108);
@@ -0,0 +1,3 @@
+function val = CG_FILE_ADF3
+%% Value 4 of enumeration type 
+val = int32(4);
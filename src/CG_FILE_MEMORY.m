@@ -0,0 +1,3 @@
+function val = CG_FILE_MEMORY
+%% Value 5 of enumeration type 
+val = int32(5);
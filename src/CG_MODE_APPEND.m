@@ -0,0 +1,3 @@
+function val = CG_MODE_APPEND
+%% Value 4 of enumeration type 
+val = int32(4);
@@ -0,0 +1,3 @@
+function func_id = MEX_CGIO_STATS
+% Function ID for MEX_CGIO_STATS
+func_id = int32(256);
@@ -0,0 +1,3 @@
+function func_id = MEX_CG_COORD_RESERVE
+% Function ID for MEX_CG_COORD_RESERVE
+func_id = int32(251);
@@ -0,0 +1,3 @@
+function func_id = MEX_CG_EXTRACT_FAMILY
+% Function ID for MEX_CG_EXTRACT_FAMILY
+func_id = int32(258);
@@ -0,0 +1,3 @@
+function func_id = MEX_CG_EXTRACT_ZONES
+% Function ID for MEX_CG_EXTRACT_ZONES
+func_id = int32(257);
@@ -0,0 +1,3 @@
+function func_id = MEX_CG_FIELD_READ_INDEXED
+% Function ID for MEX_CG_FIELD_READ_INDEXED
+func_id = int32(254);
@@ -0,0 +1,4 @@
+
+function func_id = MEX_CG_ZONES_COORD_READ
+% Function ID for MEX_CG_ZONES_COORD_READ
+func_id = int32(249);
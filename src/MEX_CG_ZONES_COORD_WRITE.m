@@ -0,0 +1,4 @@
+
+function func_id = MEX_CG_ZONES_COORD_WRITE
+% Function ID for MEX_CG_ZONES_COORD_WRITE
+func_id = int32(250);
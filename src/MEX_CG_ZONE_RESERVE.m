@@ -0,0 +1,3 @@
+function func_id = MEX_CG_ZONE_RESERVE
+% Function ID for MEX_CG_ZONE_RESERVE
+func_id = int32(253);
@@ -0,0 +1,68 @@
+function [out_C, ierr] = cg_coord_general_write(in_fn, in_B, in_Z, in_type, in_coordname, in_s_rmin, in_s_rmax, in_s_stride, in_coord_ptr, in_m_rmin, in_m_rmax, in_m_stride)
+% Gateway function for C function cg_coord_general_write.
+%
+% [C, ierr] = cg_coord_general_write(fn, B, Z, type, coordname, s_rmin, s_rmax, s_stride, coord_ptr, m_rmin, m_rmax, m_stride)
+%
+% Input arguments (required; type is auto-casted):
+%              fn: 32-bit integer (int32), scalar
+%               B: 32-bit integer (int32), scalar
+%               Z: 32-bit integer (int32), scalar
+%            type: 32-bit integer (int32), scalar
+%       coordname: character string
+%          s_rmin: 64-bit or 32-bit integer (platform dependent), array
+%          s_rmax: 64-bit or 32-bit integer (platform dependent), array
+%        s_stride: 64-bit or 32-bit integer (platform dependent), array
+%       coord_ptr: dynamic type based on type
+%
+% Input arguments (optional; type is auto-casted):
+%          m_rmin: 64-bit or 32-bit integer (platform dependent), array
+%          m_rmax: 64-bit or 32-bit integer (platform dependent), array
+%        m_stride: 64-bit or 32-bit integer (platform dependent), array
+%
+% Output arguments (optional):
+%               C: 32-bit integer (int32), scalar
+%            ierr: 32-bit integer (int32), scalar
+%
+% The points s_rmin:s_stride:s_rmax of the file array are written from
+% the points m_rmin:m_stride:m_rmax of coord_ptr; the memory range defaults
+% to the whole of coord_ptr.
+%
+% The original C function is:
+% int cg_coord_general_write( int fn, int B, int Z, CG_DataType_t type, const char * coordname, const ptrdiff_t * s_rmin, const ptrdiff_t * s_rmax, const ptrdiff_t * s_stride, int m_numdim, const ptrdiff_t * m_dimvals, const ptrdiff_t * m_rmin, const ptrdiff_t * m_rmax, const ptrdiff_t * m_stride, const void * coord_ptr, int * C);
+%
+% For detail, see <a href="http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/grid.html">online documentation</a>.
+%
+if (nargin < 9); 
+    error('Incorrect number of input or output arguments.');
+end
+
+% The memory array is described by the dimensions of coord_ptr
+m_dimvals = size(in_coord_ptr);
+if nargin<10
+    m_numdim = length(m_dimvals);
+    in_m_rmin = ones(1, m_numdim);
+else
+    m_numdim = max(length(m_dimvals), length(in_m_rmin));
+end
+m_dimvals(end+1:m_numdim) = 1;
+if nargin<11; in_m_rmax = m_dimvals(1:m_numdim); end
+if nargin<12; in_m_stride = ones(1, m_numdim); end
+
+% Perform dynamic type casting
+datatype = in_type;
+switch (datatype)
+    case 2 % CG_Integer
+        in_coord_ptr = int32(in_coord_ptr);
+    case 3 % CG_RealSingle
+        in_coord_ptr = single(in_coord_ptr);
+    case 4 % CG_RealDouble
+        in_coord_ptr = double(in_coord_ptr);
+    case 6 % CG_LongInteger
+        in_coord_ptr = int64(in_coord_ptr);
+    otherwise
+        error('Unknown data type %d', in_type);
+end
+
+
+% Invoke the actual MEX-function.
+[out_C, ierr] =  cgnslib_mex(int32(246), in_fn, in_B, in_Z, in_type, in_coordname, in_s_rmin, in_s_rmax, in_s_stride, int32(m_numdim), m_dimvals, in_m_rmin, in_m_rmax, in_m_stride, in_coord_ptr);
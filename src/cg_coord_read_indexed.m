@@ -0,0 +1,60 @@
+function [io_coord, ierr] = cg_coord_read_indexed(in_fn, in_B, in_Z, in_coordname, in_type, in_indices, io_coord)
+% Gateway function for C function cg_coord_read_indexed.
+%
+% [coord, ierr] = cg_coord_read_indexed(fn, B, Z, coordname, type, indices, coord)
+%
+% Input arguments (required; type is auto-casted):
+%              fn: 32-bit integer (int32), scalar
+%               B: 32-bit integer (int32), scalar
+%               Z: 32-bit integer (int32), scalar
+%       coordname: character string
+%            type: 32-bit integer (int32), scalar
+%         indices: 64-bit or 32-bit integer (platform dependent), array
+%
+% In&Out argument (required as output; optional as input; type is auto-casted):
+%           coord: dynamic type based on type
+%
+% Output argument (optional): 
+%            ierr: 32-bit integer (int32), scalar
+%
+% The points at the 1-based linear indices of the stored array, counted
+% in Fortran order including any rind, are read into the first
+% numel(indices) entries of coord.  If coord is not given, it is
+% allocated with the shape of indices.  Only the points asked for are read
+% from the file, so probing a few points of a large array is cheap.
+%
+% The original C function is:
+% int cg_coord_read_indexed( int fn, int B, int Z, const char * coordname, CG_DataType_t type, ptrdiff_t num, const ptrdiff_t * indices, void * coord);
+%
+% For detail, see <a href="http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/grid.html">online documentation</a>.
+%
+if ( nargout < 1 || nargin < 6); 
+    error('Incorrect number of input or output arguments.');
+end
+num = numel(in_indices);
+if nargin<7 || isempty(io_coord)
+    io_coord = zeros(size(in_indices));
+elseif numel(io_coord) < num
+    error('coord must have at least numel(indices) elements.');
+end
+
+% Perform dynamic type casting
+datatype = in_type;
+switch (datatype)
+    case 2 % CG_Integer
+        io_coord = int32(io_coord);
+    case 3 % CG_RealSingle
+        io_coord = single(io_coord);
+    case 4 % CG_RealDouble
+        io_coord = double(io_coord);
+    case 6 % CG_LongInteger
+        io_coord = int64(io_coord);
+    otherwise
+        error('Unknown data type %d', in_type);
+end
+% Write to it to avoid sharing memory with other variables
+if ~isempty(io_coord); t=io_coord(1); io_coord(1)=t; end
+
+
+% Invoke the actual MEX-function.
+ierr =  cgnslib_mex(MEX_CG_COORD_READ_INDEXED, in_fn, in_B, in_Z, in_coordname, in_type, num, in_indices, io_coord);
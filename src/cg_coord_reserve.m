@@ -0,0 +1,31 @@
+function [out_C, ierr] = cg_coord_reserve(in_fn, in_B, in_Z, in_type, in_coordname)
+% Gateway function for C function cg_coord_reserve.
+%
+% [C, ierr] = cg_coord_reserve(fn, B, Z, type, coordname)
+%
+% Input arguments (required; type is auto-casted):
+%              fn: 32-bit integer (int32), scalar
+%               B: 32-bit integer (int32), scalar
+%               Z: 32-bit integer (int32), scalar
+%            type: 32-bit integer (int32), scalar
+%       coordname: character string
+%
+% Output arguments (optional):
+%               C: 32-bit integer (int32), scalar
+%            ierr: 32-bit integer (int32), scalar
+%
+% The original C function is:
+% int cg_coord_reserve( int fn, int B, int Z, CG_DataType_t type, const char * coordname, int * C);
+%
+% Creates the coordinate array with its full size and reserves the file
+% space for it, to be filled in later with cg_coord_partial_write or
+% cg_coord_general_write.
+%
+% For detail, see <a href="http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/grid.html">online documentation</a>.
+%
+if (nargin < 5); 
+    error('Incorrect number of input or output arguments.');
+end
+
+% Invoke the actual MEX-function.
+[out_C, ierr] =  cgnslib_mex(MEX_CG_COORD_RESERVE, in_fn, in_B, in_Z, in_type, in_coordname);
@@ -0,0 +1,30 @@
+function ierr = cg_extract_family(in_fn, in_B, in_family_name, in_filename, in_file_type, in_link_size)
+% Gateway function for C function cg_extract_family.
+%
+% ierr = cg_extract_family(fn, B, family_name, filename, file_type, link_size)
+%
+% Input arguments (required; type is auto-casted):
+%              fn: 32-bit integer (int32), scalar
+%               B: 32-bit integer (int32), scalar
+%     family_name: character string
+%        filename: character string
+%       file_type: 32-bit integer (int32), scalar
+%       link_size: 64-bit or 32-bit integer (platform dependent), scalar
+%
+% Output argument (optional): 
+%            ierr: 32-bit integer (int32), scalar
+%
+% Same as cg_extract_zones, with the zones of base B that belong to the
+% family family_name.
+%
+% The original C function is:
+% int cg_extract_family( int fn, int B, const char * family_name, const char * filename, int file_type, ptrdiff_t link_size);
+%
+% For detail, see <a href="http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/fileops.html">online documentation</a>.
+%
+if (nargin < 6); 
+    error('Incorrect number of input or output arguments.');
+end
+
+% Invoke the actual MEX-function.
+ierr =  cgnslib_mex(MEX_CG_EXTRACT_FAMILY, in_fn, in_B, in_family_name, in_filename, in_file_type, in_link_size);
@@ -0,0 +1,34 @@
+function ierr = cg_extract_zones(in_fn, in_B, in_zones, in_filename, in_file_type, in_link_size)
+% Gateway function for C function cg_extract_zones.
+%
+% ierr = cg_extract_zones(fn, B, zones, filename, file_type, link_size)
+%
+% Input arguments (required; type is auto-casted):
+%              fn: 32-bit integer (int32), scalar
+%               B: 32-bit integer (int32), scalar
+%           zones: 32-bit integer (int32), array
+%        filename: character string
+%       file_type: 32-bit integer (int32), scalar
+%       link_size: 64-bit or 32-bit integer (platform dependent), scalar
+%
+% Output argument (optional): 
+%            ierr: 32-bit integer (int32), scalar
+%
+% Writes base B with only the given zones, and the rest of the file
+% except the other bases, to a new file.  Arrays are copied a block at a
+% time.  When link_size is more than 0, nodes with at least link_size
+% bytes of data are written as links to the open file instead, which
+% needs file_type to be of the same kind as that file.
+%
+% The original C function is:
+% int cg_extract_zones( int fn, int B, int nzones, const int * zones, const char * filename, int file_type, ptrdiff_t link_size);
+%
+% For detail, see <a href="http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/fileops.html">online documentation</a>.
+%
+if (nargin < 6); 
+    error('Incorrect number of input or output arguments.');
+end
+nzones = numel(in_zones);
+
+% Invoke the actual MEX-function.
+ierr =  cgnslib_mex(MEX_CG_EXTRACT_ZONES, in_fn, in_B, nzones, in_zones, in_filename, in_file_type, in_link_size);
@@ -0,0 +1,77 @@
+function [io_field_ptr, ierr] = cg_field_general_read(in_fn, in_B, in_Z, in_S, in_fieldname, in_type, in_s_rmin, in_s_rmax, in_s_stride, io_field_ptr, in_m_rmin, in_m_rmax, in_m_stride)
+% Gateway function for C function cg_field_general_read.
+%
+% [field_ptr, ierr] = cg_field_general_read(fn, B, Z, S, fieldname, type, s_rmin, s_rmax, s_stride, field_ptr, m_rmin, m_rmax, m_stride)
+%
+% Input arguments (required; type is auto-casted):
+%              fn: 32-bit integer (int32), scalar
+%               B: 32-bit integer (int32), scalar
+%               Z: 32-bit integer (int32), scalar
+%               S: 32-bit integer (int32), scalar
+%       fieldname: character string
+%            type: 32-bit integer (int32), scalar
+%          s_rmin: 64-bit or 32-bit integer (platform dependent), array
+%          s_rmax: 64-bit or 32-bit integer (platform dependent), array
+%        s_stride: 64-bit or 32-bit integer (platform dependent), array
+%
+% Input arguments (optional; type is auto-casted):
+%          m_rmin: 64-bit or 32-bit integer (platform dependent), array
+%          m_rmax: 64-bit or 32-bit integer (platform dependent), array
+%        m_stride: 64-bit or 32-bit integer (platform dependent), array
+%
+% In&Out argument (required as output; optional as input; type is auto-casted):
+%       field_ptr: dynamic type based on type
+%
+% Output argument (optional): 
+%            ierr: 32-bit integer (int32), scalar
+%
+% The points s_rmin:s_stride:s_rmax of the file array are read into the
+% points m_rmin:m_stride:m_rmax of field_ptr.  If field_ptr is not given, it is
+% allocated to hold just the selected points, so that, for example,
+% s_stride=[4 4 4] reads every 4th point of a structured block.
+%
+% The original C function is:
+% int cg_field_general_read( int fn, int B, int Z, int S, const char * fieldname, CG_DataType_t type, const ptrdiff_t * s_rmin, const ptrdiff_t * s_rmax, const ptrdiff_t * s_stride, int m_numdim, const ptrdiff_t * m_dimvals, const ptrdiff_t * m_rmin, const ptrdiff_t * m_rmax, const ptrdiff_t * m_stride, void * field_ptr);
+%
+% For detail, see <a href="http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/solution.html">online documentation</a>.
+%
+if ( nargout < 1 || nargin < 9); 
+    error('Incorrect number of input or output arguments.');
+end
+if nargin<10 || isempty(io_field_ptr)
+    io_field_ptr = zeros([floor((double(in_s_rmax(:)')-double(in_s_rmin(:)'))./ ...
+        double(in_s_stride(:)'))+1, 1]);
+end
+
+% The memory array is described by the dimensions of field_ptr
+m_dimvals = size(io_field_ptr);
+if nargin<11
+    m_numdim = length(m_dimvals);
+    in_m_rmin = ones(1, m_numdim);
+else
+    m_numdim = max(length(m_dimvals), length(in_m_rmin));
+end
+m_dimvals(end+1:m_numdim) = 1;
+if nargin<12; in_m_rmax = m_dimvals(1:m_numdim); end
+if nargin<13; in_m_stride = ones(1, m_numdim); end
+
+% Perform dynamic type casting
+datatype = in_type;
+switch (datatype)
+    case 2 % CG_Integer
+        io_field_ptr = int32(io_field_ptr);
+    case 3 % CG_RealSingle
+        io_field_ptr = single(io_field_ptr);
+    case 4 % CG_RealDouble
+        io_field_ptr = double(io_field_ptr);
+    case 6 % CG_LongInteger
+        io_field_ptr = int64(io_field_ptr);
+    otherwise
+        error('Unknown data type %d', in_type);
+end
+% Write to it to avoid sharing memory with other variables
+if ~isempty(io_field_ptr); t=io_field_ptr(1); io_field_ptr(1)=t; end
+
+
+% Invoke the actual MEX-function.
+ierr =  cgnslib_mex(int32(247), in_fn, in_B, in_Z, in_S, in_fieldname, in_type, in_s_rmin, in_s_rmax, in_s_stride, int32(m_numdim), m_dimvals, in_m_rmin, in_m_rmax, in_m_stride, io_field_ptr);
@@ -0,0 +1,69 @@
+function [out_F, ierr] = cg_field_general_write(in_fn, in_B, in_Z, in_S, in_type, in_fieldname, in_s_rmin, in_s_rmax, in_s_stride, in_field_ptr, in_m_rmin, in_m_rmax, in_m_stride)
+% Gateway function for C function cg_field_general_write.
+%
+% [F, ierr] = cg_field_general_write(fn, B, Z, S, type, fieldname, s_rmin, s_rmax, s_stride, field_ptr, m_rmin, m_rmax, m_stride)
+%
+% Input arguments (required; type is auto-casted):
+%              fn: 32-bit integer (int32), scalar
+%               B: 32-bit integer (int32), scalar
+%               Z: 32-bit integer (int32), scalar
+%               S: 32-bit integer (int32), scalar
+%            type: 32-bit integer (int32), scalar
+%       fieldname: character string
+%          s_rmin: 64-bit or 32-bit integer (platform dependent), array
+%          s_rmax: 64-bit or 32-bit integer (platform dependent), array
+%        s_stride: 64-bit or 32-bit integer (platform dependent), array
+%       field_ptr: dynamic type based on type
+%
+% Input arguments (optional; type is auto-casted):
+%          m_rmin: 64-bit or 32-bit integer (platform dependent), array
+%          m_rmax: 64-bit or 32-bit integer (platform dependent), array
+%        m_stride: 64-bit or 32-bit integer (platform dependent), array
+%
+% Output arguments (optional):
+%               F: 32-bit integer (int32), scalar
+%            ierr: 32-bit integer (int32), scalar
+%
+% The points s_rmin:s_stride:s_rmax of the file array are written from
+% the points m_rmin:m_stride:m_rmax of field_ptr; the memory range defaults
+% to the whole of field_ptr.
+%
+% The original C function is:
+% int cg_field_general_write( int fn, int B, int Z, int S, CG_DataType_t type, const char * fieldname, const ptrdiff_t * s_rmin, const ptrdiff_t * s_rmax, const ptrdiff_t * s_stride, int m_numdim, const ptrdiff_t * m_dimvals, const ptrdiff_t * m_rmin, const ptrdiff_t * m_rmax, const ptrdiff_t * m_stride, const void * field_ptr, int * F);
+%
+% For detail, see <a href="http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/solution.html">online documentation</a>.
+%
+if (nargin < 10); 
+    error('Incorrect number of input or output arguments.');
+end
+
+% The memory array is described by the dimensions of field_ptr
+m_dimvals = size(in_field_ptr);
+if nargin<11
+    m_numdim = length(m_dimvals);
+    in_m_rmin = ones(1, m_numdim);
+else
+    m_numdim = max(length(m_dimvals), length(in_m_rmin));
+end
+m_dimvals(end+1:m_numdim) = 1;
+if nargin<12; in_m_rmax = m_dimvals(1:m_numdim); end
+if nargin<13; in_m_stride = ones(1, m_numdim); end
+
+% Perform dynamic type casting
+datatype = in_type;
+switch (datatype)
+    case 2 % CG_Integer
+        in_field_ptr = int32(in_field_ptr);
+    case 3 % CG_RealSingle
+        in_field_ptr = single(in_field_ptr);
+    case 4 % CG_RealDouble
+        in_field_ptr = double(in_field_ptr);
+    case 6 % CG_LongInteger
+        in_field_ptr = int64(in_field_ptr);
+    otherwise
+        error('Unknown data type %d', in_type);
+end
+
+
+% Invoke the actual MEX-function.
+[out_F, ierr] =  cgnslib_mex(int32(248), in_fn, in_B, in_Z, in_S, in_type, in_fieldname, in_s_rmin, in_s_rmax, in_s_stride, int32(m_numdim), m_dimvals, in_m_rmin, in_m_rmax, in_m_stride, in_field_ptr);
@@ -0,0 +1,61 @@
+function [io_field_ptr, ierr] = cg_field_read_indexed(in_fn, in_B, in_Z, in_S, in_fieldname, in_type, in_indices, io_field_ptr)
+% Gateway function for C function cg_field_read_indexed.
+%
+% [field_ptr, ierr] = cg_field_read_indexed(fn, B, Z, S, fieldname, type, indices, field_ptr)
+%
+% Input arguments (required; type is auto-casted):
+%              fn: 32-bit integer (int32), scalar
+%               B: 32-bit integer (int32), scalar
+%               Z: 32-bit integer (int32), scalar
+%               S: 32-bit integer (int32), scalar
+%       fieldname: character string
+%            type: 32-bit integer (int32), scalar
+%         indices: 64-bit or 32-bit integer (platform dependent), array
+%
+% In&Out argument (required as output; optional as input; type is auto-casted):
+%       field_ptr: dynamic type based on type
+%
+% Output argument (optional): 
+%            ierr: 32-bit integer (int32), scalar
+%
+% The points at the 1-based linear indices of the stored array, counted
+% in Fortran order including any rind, are read into the first
+% numel(indices) entries of field_ptr.  If field_ptr is not given, it is
+% allocated with the shape of indices.  Only the points asked for are read
+% from the file, so probing a few points of a large array is cheap.
+%
+% The original C function is:
+% int cg_field_read_indexed( int fn, int B, int Z, int S, const char * fieldname, CG_DataType_t type, ptrdiff_t num, const ptrdiff_t * indices, void * field_ptr);
+%
+% For detail, see <a href="http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/solution.html">online documentation</a>.
+%
+if ( nargout < 1 || nargin < 7); 
+    error('Incorrect number of input or output arguments.');
+end
+num = numel(in_indices);
+if nargin<8 || isempty(io_field_ptr)
+    io_field_ptr = zeros(size(in_indices));
+elseif numel(io_field_ptr) < num
+    error('field_ptr must have at least numel(indices) elements.');
+end
+
+% Perform dynamic type casting
+datatype = in_type;
+switch (datatype)
+    case 2 % CG_Integer
+        io_field_ptr = int32(io_field_ptr);
+    case 3 % CG_RealSingle
+        io_field_ptr = single(io_field_ptr);
+    case 4 % CG_RealDouble
+        io_field_ptr = double(io_field_ptr);
+    case 6 % CG_LongInteger
+        io_field_ptr = int64(io_field_ptr);
+    otherwise
+        error('Unknown data type %d', in_type);
+end
+% Write to it to avoid sharing memory with other variables
+if ~isempty(io_field_ptr); t=io_field_ptr(1); io_field_ptr(1)=t; end
+
+
+% Invoke the actual MEX-function.
+ierr =  cgnslib_mex(MEX_CG_FIELD_READ_INDEXED, in_fn, in_B, in_Z, in_S, in_fieldname, in_type, num, in_indices, io_field_ptr);
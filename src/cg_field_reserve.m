@@ -0,0 +1,32 @@
+function [out_F, ierr] = cg_field_reserve(in_fn, in_B, in_Z, in_S, in_type, in_fieldname)
+% Gateway function for C function cg_field_reserve.
+%
+% [F, ierr] = cg_field_reserve(fn, B, Z, S, type, fieldname)
+%
+% Input arguments (required; type is auto-casted):
+%              fn: 32-bit integer (int32), scalar
+%               B: 32-bit integer (int32), scalar
+%               Z: 32-bit integer (int32), scalar
+%               S: 32-bit integer (int32), scalar
+%            type: 32-bit integer (int32), scalar
+%       fieldname: character string
+%
+% Output arguments (optional):
+%               F: 32-bit integer (int32), scalar
+%            ierr: 32-bit integer (int32), scalar
+%
+% The original C function is:
+% int cg_field_reserve( int fn, int B, int Z, int S, CG_DataType_t type, const char * fieldname, int * F);
+%
+% Creates the solution array with its full size and reserves the file
+% space for it, to be filled in later with cg_field_partial_write or
+% cg_field_general_write.
+%
+% For detail, see <a href="http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/solution.html">online documentation</a>.
+%
+if (nargin < 6); 
+    error('Incorrect number of input or output arguments.');
+end
+
+% Invoke the actual MEX-function.
+[out_F, ierr] =  cgnslib_mex(MEX_CG_FIELD_RESERVE, in_fn, in_B, in_Z, in_S, in_type, in_fieldname);
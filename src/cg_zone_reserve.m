@@ -0,0 +1,34 @@
+function ierr = cg_zone_reserve(varargin)
+% Gateway function for C function cg_zone_reserve.
+%
+% ierr = cg_zone_reserve(fn, B, Z, type)
+% ierr = cg_zone_reserve(fn, B, Z, type, S, fieldnames)
+%
+% Input arguments (required; type is auto-casted):
+%              fn: 32-bit integer (int32), scalar
+%               B: 32-bit integer (int32), scalar
+%               Z: 32-bit integer (int32), scalar
+%            type: 32-bit integer (int32), scalar
+%
+% Input arguments (optional; type is auto-casted):
+%               S: 32-bit integer (int32), scalar
+%      fieldnames: cell array of character strings
+%
+% Output argument (optional): 
+%            ierr: 32-bit integer (int32), scalar
+%
+% The original C function is:
+% int cg_zone_reserve( int fn, int B, int Z, CG_DataType_t type, int S, int nfields, const char * const * fieldnames);
+%
+% Creates the Cartesian coordinates of the zone (CoordinateX, CoordinateY
+% and CoordinateZ, up to the physical dimension of the base) and the given
+% fields of flow solution S, and reserves the file space for all of them,
+% so a planned sequence of partial writes fills in space that is already
+% allocated.
+%
+% For detail, see <a href="http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/solution.html">online documentation</a>.
+% 
+% See also cg_coord_reserve, cg_field_reserve, cg_coord_partial_write,
+% cg_field_partial_write.
+
+ierr = cgnslib_mex(MEX_CG_ZONE_RESERVE,varargin{:});
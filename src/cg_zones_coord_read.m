@@ -0,0 +1,30 @@
+function [out_coords, ierr] = cg_zones_coord_read(varargin)
+% Gateway function for reading the coordinates of several zones at once.
+%
+% [coords, ierr] = cg_zones_coord_read(fn, B, zones)
+%
+% Input arguments (required; type is auto-casted):
+%              fn: 32-bit integer (int32), scalar
+%               B: 32-bit integer (int32), scalar
+%
+% Input argument (optional; type is auto-casted):
+%           zones: 32-bit integer (int32), array. If not present or empty,
+%                  all zones of base B are read.
+%
+% Output arguments (optional):
+%          coords: cell of double array, one entry per zone. For a
+%                  structured zone the array is ni x nj (x nk) x d, and for
+%                  an unstructured zone it is nv x d, where d is the
+%                  physical dimension of the base. The columns hold
+%                  CoordinateX, CoordinateY and CoordinateZ.
+%            ierr: 32-bit integer (int32), scalar
+%
+% There is no corresponding C function; this gateway loops over the zones
+% calling cg_zone_read and cg_coord_read, writing directly into the
+% MATLAB arrays.
+%
+% For detail, see <a href="http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/grid.html">online documentation</a>.
+% 
+% See also cg_zones_coord_write, cg_coord_read.
+
+[out_coords, ierr] = cgnslib_mex(MEX_CG_ZONES_COORD_READ,varargin{:});
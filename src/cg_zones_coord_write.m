@@ -0,0 +1,24 @@
+function ierr = cg_zones_coord_write(varargin)
+% Gateway function for writing the coordinates of several zones at once.
+%
+% ierr = cg_zones_coord_write(fn, B, zones, coords)
+%
+% Input arguments (required; type is auto-casted):
+%              fn: 32-bit integer (int32), scalar
+%               B: 32-bit integer (int32), scalar
+%           zones: 32-bit integer (int32), array. If empty, coords
+%                  holds one entry for every zone of base B.
+%          coords: cell of double array, laid out as returned by
+%                  cg_zones_coord_read. The zones must already exist.
+%
+% Output argument (optional): 
+%            ierr: 32-bit integer (int32), scalar
+%
+% There is no corresponding C function; this gateway loops over the zones
+% calling cg_coord_write for CoordinateX, CoordinateY and CoordinateZ.
+%
+% For detail, see <a href="http://www.grc.nasa.gov/WWW/cgns/CGNS_docs_current/midlevel/grid.html">online documentation</a>.
+% 
+% See also cg_zones_coord_read, cg_coord_write.
+
+ierr = cgnslib_mex(MEX_CG_ZONES_COORD_WRITE,varargin{:});
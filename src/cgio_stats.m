@@ -0,0 +1,34 @@
+function [out_stats, out_memory, ierr] = cgio_stats(varargin)
+% Gateway function for the cgio call statistics.
+%
+% [stats, memory, ierr] = cgio_stats
+% [stats, memory, ierr] = cgio_stats(fn)
+%
+% Input argument (optional; type is auto-casted):
+%              fn: 32-bit integer (int32), scalar
+%
+% Output arguments (optional):
+%           stats: struct array with fields name, calls, errors, bytes,
+%                  time, max_time and histogram
+%          memory: double, [current peak] bytes, -1 if not counted
+%            ierr: 32-bit integer (int32), scalar
+%
+% The original C functions are:
+% int cgio_stats_number( int * num_ops);
+% int cgio_stats_read( int op, char * name, cgio_stats_t * stats);
+% int cgio_stats_file( int cgio_num, cgio_stats_t * stats);
+% int cgio_stats_memory( cglong_t * mem_now, cglong_t * mem_max);
+%
+% Without fn, stats has one entry per cgio entry point; with fn, one
+% entry with the totals for that open file. Times are in seconds, and
+% histogram(n) counts the calls that took less than 2^(n-1) microseconds
+% and more than those in histogram(n-1). Counting is switched on with
+% cg_configure(CG_CONFIG_STATS, 1), which starts from zero, and a chrome
+% trace (chrome://tracing) of every call is written with
+% cg_configure(CG_CONFIG_TRACE, filename) and closed with
+% cg_configure(CG_CONFIG_TRACE, ''). Memory is only counted when the
+% library is built with MEM_DEBUG.
+%
+% See also cg_configure.
+
+[out_stats, out_memory, ierr] = cgnslib_mex(MEX_CGIO_STATS, varargin{:});
@@ -9,14 +9,20 @@ function out_DataType = cgns_configure_type(in_what)
 % Output arguments:
 %        DataType: 32-bit integer (int32), scalar
 %
-% Currently supported options include CG_CONFIG_COMPRESS, 
-% CG_CONFIG_SET_PATH, CG_CONFIG_ADD_PATH, CG_CONFIG_FILE, and
-% CG_CONFIG_ERROR.
+% Currently supported options include CG_CONFIG_COMPRESS, CG_CONFIG_ASYNC_WRITE,
+% CG_CONFIG_INDEX, CG_CONFIG_ADF_SYNC, CG_CONFIG_ADF_MERGE, CG_CONFIG_ADF_DIRECT,
+% CG_CONFIG_PREALLOCATE, CG_CONFIG_ADF_COMPRESS, CG_CONFIG_ADF_QUEUE,
+% CG_CONFIG_STATS, CG_CONFIG_HDF5_META, CG_CONFIG_TRACE, CG_CONFIG_RECORD,
+% CG_CONFIG_SET_PATH, CG_CONFIG_ADD_PATH, CG_CONFIG_FILE, and CG_CONFIG_ERROR.
 
 switch in_what
-    case {CG_CONFIG_COMPRESS,CG_CONFIG_FILE_TYPE}
+    case {CG_CONFIG_COMPRESS,CG_CONFIG_FILE_TYPE,CG_CONFIG_ASYNC_WRITE,...
+            CG_CONFIG_INDEX,CG_CONFIG_ADF_SYNC,CG_CONFIG_ADF_MERGE,...
+            CG_CONFIG_ADF_DIRECT,CG_CONFIG_PREALLOCATE,CG_CONFIG_ADF_COMPRESS,...
+            CG_CONFIG_ADF_QUEUE,CG_CONFIG_STATS,CG_CONFIG_HDF5_META}
         out_DataType = Integer;
-    case {CG_CONFIG_ERROR,CG_CONFIG_SET_PATH,CG_CONFIG_ADD_PATH}
+    case {CG_CONFIG_ERROR,CG_CONFIG_TRACE,CG_CONFIG_RECORD,CG_CONFIG_SET_PATH,...
+            CG_CONFIG_ADD_PATH}
         out_DataType = Character;
     otherwise
         error('Unsupported option.');
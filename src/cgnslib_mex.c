@@ -391,7 +391,11 @@ EXTERN_C void cg_configure_MeX(int nlhs, mxArray *plhs[],
         mexErrMsgTxt("Error in dimension of argument what");
     in_what = _get_numeric_scalar_int32(prhs[0]);
 
-    in_value = mxGetData( prhs[1]);
+    /* integer options are passed by value, the others by pointer */
+    if (mxIsInt32(prhs[1]))
+        in_value = (void *)((size_t)_get_numeric_scalar_int32(prhs[1]));
+    else
+        in_value = mxGetData( prhs[1]);
 
     /******** Invoke computational function ********/
     ierr = cg_configure(in_what, in_value);
@@ -12349,6 +12353,1495 @@ EXTERN_C void cg_error_print_MeX(int nlhs, mxArray *plhs[],
 
 }
 
+/* Gateway function 
+ * ierr = cg_flush(in_fn) 
+ *
+ * The original C interface is 
+ * int cg_flush( int fn);
+ */
+EXTERN_C void cg_flush_MeX(int nlhs, mxArray *plhs[],
+    int nrhs, const mxArray *prhs[])
+{
+    int in_fn;
+    int ierr;
+
+    /******** Check number of input and output arguments. ********/ 
+    if (nlhs > 1 || nrhs != 1)
+        mexErrMsgTxt("Wrong number of arguments to function ");
+
+    /******** Obtain input arguments ********/
+    if (_n_dims(prhs[0]) > 0)
+        mexErrMsgTxt("Error in dimension of argument fn");
+    in_fn = _get_numeric_scalar_int32(prhs[0]);
+
+
+    /******** Invoke computational function ********/
+    ierr = cg_flush(in_fn);
+
+
+    /******** Process output arguments ********/
+    plhs[0] = mxCreateNumericMatrix(1, 1, mxINT32_CLASS, mxREAL);
+    *(int*)mxGetData(plhs[0]) = ierr;
+}
+
+/* Gateway function 
+ * ierr = cg_coord_general_read(in_fn, in_B, in_Z, in_coordname, in_type, in_s_rmin, in_s_rmax, in_s_stride, in_m_numdim, in_m_dimvals, in_m_rmin, in_m_rmax, in_m_stride, io_coord) 
+ *
+ * The original C interface is 
+ * int cg_coord_general_read( int fn, int B, int Z, const char * coordname, CG_DataType_t type, const ptrdiff_t * s_rmin, const ptrdiff_t * s_rmax, const ptrdiff_t * s_stride, int m_numdim, const ptrdiff_t * m_dimvals, const ptrdiff_t * m_rmin, const ptrdiff_t * m_rmax, const ptrdiff_t * m_stride, void * coord);
+ */
+EXTERN_C void cg_coord_general_read_MeX(int nlhs, mxArray *plhs[],
+    int nrhs, const mxArray *prhs[])
+{
+    int in_fn;
+    int in_B;
+    int in_Z;
+    char * in_coordname;
+    CG_DataType_t in_type;
+    ptrdiff_t * in_s_rmin;
+    ptrdiff_t * in_s_rmax;
+    ptrdiff_t * in_s_stride;
+    int in_m_numdim;
+    ptrdiff_t * in_m_dimvals;
+    ptrdiff_t * in_m_rmin;
+    ptrdiff_t * in_m_rmax;
+    ptrdiff_t * in_m_stride;
+    void * io_coord;
+    int ierr;
+
+    /******** Check number of input and output arguments. ********/ 
+    if (nlhs > 1 || nrhs != 14)
+        mexErrMsgTxt("Wrong number of arguments to function ");
+
+    /******** Obtain input arguments ********/
+    if (_n_dims(prhs[0]) > 0)
+        mexErrMsgTxt("Error in dimension of argument fn");
+    in_fn = _get_numeric_scalar_int32(prhs[0]);
+
+    if (_n_dims(prhs[1]) > 0)
+        mexErrMsgTxt("Error in dimension of argument B");
+    in_B = _get_numeric_scalar_int32(prhs[1]);
+
+    if (_n_dims(prhs[2]) > 0)
+        mexErrMsgTxt("Error in dimension of argument Z");
+    in_Z = _get_numeric_scalar_int32(prhs[2]);
+
+    in_coordname = _mxGetString(prhs[3], NULL);
+
+    if (_n_dims(prhs[4]) > 0)
+        mexErrMsgTxt("Error in dimension of argument type");
+    in_type = _get_numeric_scalar_int32(prhs[4]);
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[5]) || mxIsUint64(prhs[5]))
+            in_s_rmin = (ptrdiff_t*)mxGetData(prhs[5]);
+        else {
+            in_s_rmin = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[5]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[5], (int64*)in_s_rmin))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_rmin");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[5]) || mxIsUint32(prhs[5]))
+            in_s_rmin = (ptrdiff_t*)mxGetData(prhs[5]);
+        else {
+            in_s_rmin = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[5]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[5], (int32*)in_s_rmin))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_rmin");
+        }
+    }
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[6]) || mxIsUint64(prhs[6]))
+            in_s_rmax = (ptrdiff_t*)mxGetData(prhs[6]);
+        else {
+            in_s_rmax = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[6]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[6], (int64*)in_s_rmax))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_rmax");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[6]) || mxIsUint32(prhs[6]))
+            in_s_rmax = (ptrdiff_t*)mxGetData(prhs[6]);
+        else {
+            in_s_rmax = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[6]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[6], (int32*)in_s_rmax))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_rmax");
+        }
+    }
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[7]) || mxIsUint64(prhs[7]))
+            in_s_stride = (ptrdiff_t*)mxGetData(prhs[7]);
+        else {
+            in_s_stride = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[7]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[7], (int64*)in_s_stride))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_stride");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[7]) || mxIsUint32(prhs[7]))
+            in_s_stride = (ptrdiff_t*)mxGetData(prhs[7]);
+        else {
+            in_s_stride = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[7]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[7], (int32*)in_s_stride))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_stride");
+        }
+    }
+
+    if (_n_dims(prhs[8]) > 0)
+        mexErrMsgTxt("Error in dimension of argument m_numdim");
+    in_m_numdim = _get_numeric_scalar_int32(prhs[8]);
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[9]) || mxIsUint64(prhs[9]))
+            in_m_dimvals = (ptrdiff_t*)mxGetData(prhs[9]);
+        else {
+            in_m_dimvals = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[9]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[9], (int64*)in_m_dimvals))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_dimvals");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[9]) || mxIsUint32(prhs[9]))
+            in_m_dimvals = (ptrdiff_t*)mxGetData(prhs[9]);
+        else {
+            in_m_dimvals = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[9]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[9], (int32*)in_m_dimvals))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_dimvals");
+        }
+    }
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[10]) || mxIsUint64(prhs[10]))
+            in_m_rmin = (ptrdiff_t*)mxGetData(prhs[10]);
+        else {
+            in_m_rmin = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[10]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[10], (int64*)in_m_rmin))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_rmin");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[10]) || mxIsUint32(prhs[10]))
+            in_m_rmin = (ptrdiff_t*)mxGetData(prhs[10]);
+        else {
+            in_m_rmin = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[10]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[10], (int32*)in_m_rmin))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_rmin");
+        }
+    }
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[11]) || mxIsUint64(prhs[11]))
+            in_m_rmax = (ptrdiff_t*)mxGetData(prhs[11]);
+        else {
+            in_m_rmax = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[11]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[11], (int64*)in_m_rmax))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_rmax");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[11]) || mxIsUint32(prhs[11]))
+            in_m_rmax = (ptrdiff_t*)mxGetData(prhs[11]);
+        else {
+            in_m_rmax = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[11]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[11], (int32*)in_m_rmax))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_rmax");
+        }
+    }
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[12]) || mxIsUint64(prhs[12]))
+            in_m_stride = (ptrdiff_t*)mxGetData(prhs[12]);
+        else {
+            in_m_stride = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[12]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[12], (int64*)in_m_stride))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_stride");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[12]) || mxIsUint32(prhs[12]))
+            in_m_stride = (ptrdiff_t*)mxGetData(prhs[12]);
+        else {
+            in_m_stride = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[12]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[12], (int32*)in_m_stride))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_stride");
+        }
+    }
+
+    io_coord = mxGetData( prhs[13]);
+
+    /******** Invoke computational function ********/
+    ierr = cg_coord_general_read(in_fn, in_B, in_Z, in_coordname, in_type, in_s_rmin, in_s_rmax, in_s_stride, in_m_numdim, in_m_dimvals, in_m_rmin, in_m_rmax, in_m_stride, io_coord);
+
+
+    /******** Free up input buffers. ********/
+    _mxFreeString(in_coordname);
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[5]) && !mxIsUint64(prhs[5]))
+            mxFree(in_s_rmin);
+    } else {
+        if (!mxIsInt32(prhs[5]) && !mxIsUint32(prhs[5]))
+            mxFree(in_s_rmin);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[6]) && !mxIsUint64(prhs[6]))
+            mxFree(in_s_rmax);
+    } else {
+        if (!mxIsInt32(prhs[6]) && !mxIsUint32(prhs[6]))
+            mxFree(in_s_rmax);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[7]) && !mxIsUint64(prhs[7]))
+            mxFree(in_s_stride);
+    } else {
+        if (!mxIsInt32(prhs[7]) && !mxIsUint32(prhs[7]))
+            mxFree(in_s_stride);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[9]) && !mxIsUint64(prhs[9]))
+            mxFree(in_m_dimvals);
+    } else {
+        if (!mxIsInt32(prhs[9]) && !mxIsUint32(prhs[9]))
+            mxFree(in_m_dimvals);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[10]) && !mxIsUint64(prhs[10]))
+            mxFree(in_m_rmin);
+    } else {
+        if (!mxIsInt32(prhs[10]) && !mxIsUint32(prhs[10]))
+            mxFree(in_m_rmin);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[11]) && !mxIsUint64(prhs[11]))
+            mxFree(in_m_rmax);
+    } else {
+        if (!mxIsInt32(prhs[11]) && !mxIsUint32(prhs[11]))
+            mxFree(in_m_rmax);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[12]) && !mxIsUint64(prhs[12]))
+            mxFree(in_m_stride);
+    } else {
+        if (!mxIsInt32(prhs[12]) && !mxIsUint32(prhs[12]))
+            mxFree(in_m_stride);
+    }
+
+    /******** Process output arguments ********/
+    plhs[0] = mxCreateNumericMatrix(1, 1, mxINT32_CLASS, mxREAL);
+    *(int*)mxGetData(plhs[0]) = ierr;
+}
+
+/* Gateway function 
+ * [out_C, ierr] = cg_coord_general_write(in_fn, in_B, in_Z, in_type, in_coordname, in_s_rmin, in_s_rmax, in_s_stride, in_m_numdim, in_m_dimvals, in_m_rmin, in_m_rmax, in_m_stride, in_coord_ptr) 
+ *
+ * The original C interface is 
+ * int cg_coord_general_write( int fn, int B, int Z, CG_DataType_t type, const char * coordname, const ptrdiff_t * s_rmin, const ptrdiff_t * s_rmax, const ptrdiff_t * s_stride, int m_numdim, const ptrdiff_t * m_dimvals, const ptrdiff_t * m_rmin, const ptrdiff_t * m_rmax, const ptrdiff_t * m_stride, const void * coord_ptr, int * C);
+ */
+EXTERN_C void cg_coord_general_write_MeX(int nlhs, mxArray *plhs[],
+    int nrhs, const mxArray *prhs[])
+{
+    int in_fn;
+    int in_B;
+    int in_Z;
+    CG_DataType_t in_type;
+    char * in_coordname;
+    ptrdiff_t * in_s_rmin;
+    ptrdiff_t * in_s_rmax;
+    ptrdiff_t * in_s_stride;
+    int in_m_numdim;
+    ptrdiff_t * in_m_dimvals;
+    ptrdiff_t * in_m_rmin;
+    ptrdiff_t * in_m_rmax;
+    ptrdiff_t * in_m_stride;
+    const void * in_coord_ptr;
+    int out_C;
+    int ierr;
+
+    /******** Check number of input and output arguments. ********/ 
+    if (nlhs > 2 || nrhs != 14)
+        mexErrMsgTxt("Wrong number of arguments to function ");
+
+    /******** Obtain input arguments ********/
+    if (_n_dims(prhs[0]) > 0)
+        mexErrMsgTxt("Error in dimension of argument fn");
+    in_fn = _get_numeric_scalar_int32(prhs[0]);
+
+    if (_n_dims(prhs[1]) > 0)
+        mexErrMsgTxt("Error in dimension of argument B");
+    in_B = _get_numeric_scalar_int32(prhs[1]);
+
+    if (_n_dims(prhs[2]) > 0)
+        mexErrMsgTxt("Error in dimension of argument Z");
+    in_Z = _get_numeric_scalar_int32(prhs[2]);
+
+    if (_n_dims(prhs[3]) > 0)
+        mexErrMsgTxt("Error in dimension of argument type");
+    in_type = _get_numeric_scalar_int32(prhs[3]);
+
+    in_coordname = _mxGetString(prhs[4], NULL);
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[5]) || mxIsUint64(prhs[5]))
+            in_s_rmin = (ptrdiff_t*)mxGetData(prhs[5]);
+        else {
+            in_s_rmin = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[5]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[5], (int64*)in_s_rmin))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_rmin");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[5]) || mxIsUint32(prhs[5]))
+            in_s_rmin = (ptrdiff_t*)mxGetData(prhs[5]);
+        else {
+            in_s_rmin = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[5]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[5], (int32*)in_s_rmin))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_rmin");
+        }
+    }
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[6]) || mxIsUint64(prhs[6]))
+            in_s_rmax = (ptrdiff_t*)mxGetData(prhs[6]);
+        else {
+            in_s_rmax = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[6]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[6], (int64*)in_s_rmax))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_rmax");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[6]) || mxIsUint32(prhs[6]))
+            in_s_rmax = (ptrdiff_t*)mxGetData(prhs[6]);
+        else {
+            in_s_rmax = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[6]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[6], (int32*)in_s_rmax))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_rmax");
+        }
+    }
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[7]) || mxIsUint64(prhs[7]))
+            in_s_stride = (ptrdiff_t*)mxGetData(prhs[7]);
+        else {
+            in_s_stride = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[7]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[7], (int64*)in_s_stride))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_stride");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[7]) || mxIsUint32(prhs[7]))
+            in_s_stride = (ptrdiff_t*)mxGetData(prhs[7]);
+        else {
+            in_s_stride = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[7]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[7], (int32*)in_s_stride))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_stride");
+        }
+    }
+
+    if (_n_dims(prhs[8]) > 0)
+        mexErrMsgTxt("Error in dimension of argument m_numdim");
+    in_m_numdim = _get_numeric_scalar_int32(prhs[8]);
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[9]) || mxIsUint64(prhs[9]))
+            in_m_dimvals = (ptrdiff_t*)mxGetData(prhs[9]);
+        else {
+            in_m_dimvals = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[9]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[9], (int64*)in_m_dimvals))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_dimvals");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[9]) || mxIsUint32(prhs[9]))
+            in_m_dimvals = (ptrdiff_t*)mxGetData(prhs[9]);
+        else {
+            in_m_dimvals = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[9]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[9], (int32*)in_m_dimvals))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_dimvals");
+        }
+    }
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[10]) || mxIsUint64(prhs[10]))
+            in_m_rmin = (ptrdiff_t*)mxGetData(prhs[10]);
+        else {
+            in_m_rmin = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[10]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[10], (int64*)in_m_rmin))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_rmin");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[10]) || mxIsUint32(prhs[10]))
+            in_m_rmin = (ptrdiff_t*)mxGetData(prhs[10]);
+        else {
+            in_m_rmin = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[10]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[10], (int32*)in_m_rmin))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_rmin");
+        }
+    }
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[11]) || mxIsUint64(prhs[11]))
+            in_m_rmax = (ptrdiff_t*)mxGetData(prhs[11]);
+        else {
+            in_m_rmax = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[11]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[11], (int64*)in_m_rmax))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_rmax");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[11]) || mxIsUint32(prhs[11]))
+            in_m_rmax = (ptrdiff_t*)mxGetData(prhs[11]);
+        else {
+            in_m_rmax = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[11]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[11], (int32*)in_m_rmax))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_rmax");
+        }
+    }
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[12]) || mxIsUint64(prhs[12]))
+            in_m_stride = (ptrdiff_t*)mxGetData(prhs[12]);
+        else {
+            in_m_stride = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[12]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[12], (int64*)in_m_stride))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_stride");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[12]) || mxIsUint32(prhs[12]))
+            in_m_stride = (ptrdiff_t*)mxGetData(prhs[12]);
+        else {
+            in_m_stride = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[12]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[12], (int32*)in_m_stride))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_stride");
+        }
+    }
+
+    in_coord_ptr = mxGetData( prhs[13]);
+
+    /******** Invoke computational function ********/
+    ierr = cg_coord_general_write(in_fn, in_B, in_Z, in_type, in_coordname, in_s_rmin, in_s_rmax, in_s_stride, in_m_numdim, in_m_dimvals, in_m_rmin, in_m_rmax, in_m_stride, in_coord_ptr, &out_C);
+
+
+    /******** Free up input buffers. ********/
+    _mxFreeString(in_coordname);
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[5]) && !mxIsUint64(prhs[5]))
+            mxFree(in_s_rmin);
+    } else {
+        if (!mxIsInt32(prhs[5]) && !mxIsUint32(prhs[5]))
+            mxFree(in_s_rmin);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[6]) && !mxIsUint64(prhs[6]))
+            mxFree(in_s_rmax);
+    } else {
+        if (!mxIsInt32(prhs[6]) && !mxIsUint32(prhs[6]))
+            mxFree(in_s_rmax);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[7]) && !mxIsUint64(prhs[7]))
+            mxFree(in_s_stride);
+    } else {
+        if (!mxIsInt32(prhs[7]) && !mxIsUint32(prhs[7]))
+            mxFree(in_s_stride);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[9]) && !mxIsUint64(prhs[9]))
+            mxFree(in_m_dimvals);
+    } else {
+        if (!mxIsInt32(prhs[9]) && !mxIsUint32(prhs[9]))
+            mxFree(in_m_dimvals);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[10]) && !mxIsUint64(prhs[10]))
+            mxFree(in_m_rmin);
+    } else {
+        if (!mxIsInt32(prhs[10]) && !mxIsUint32(prhs[10]))
+            mxFree(in_m_rmin);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[11]) && !mxIsUint64(prhs[11]))
+            mxFree(in_m_rmax);
+    } else {
+        if (!mxIsInt32(prhs[11]) && !mxIsUint32(prhs[11]))
+            mxFree(in_m_rmax);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[12]) && !mxIsUint64(prhs[12]))
+            mxFree(in_m_stride);
+    } else {
+        if (!mxIsInt32(prhs[12]) && !mxIsUint32(prhs[12]))
+            mxFree(in_m_stride);
+    }
+
+    /******** Process output arguments ********/
+    plhs[0] = mxCreateNumericMatrix(1, 1, mxINT32_CLASS, mxREAL);
+    *(int*)mxGetData(plhs[0]) = out_C;
+    if (nlhs > 1) {
+        plhs[1] = mxCreateNumericMatrix(1, 1, mxINT32_CLASS, mxREAL);
+        *(int*)mxGetData(plhs[1]) = ierr;
+    }
+}
+
+/* Gateway function 
+ * ierr = cg_field_general_read(in_fn, in_B, in_Z, in_S, in_fieldname, in_type, in_s_rmin, in_s_rmax, in_s_stride, in_m_numdim, in_m_dimvals, in_m_rmin, in_m_rmax, in_m_stride, io_field_ptr) 
+ *
+ * The original C interface is 
+ * int cg_field_general_read( int fn, int B, int Z, int S, const char * fieldname, CG_DataType_t type, const ptrdiff_t * s_rmin, const ptrdiff_t * s_rmax, const ptrdiff_t * s_stride, int m_numdim, const ptrdiff_t * m_dimvals, const ptrdiff_t * m_rmin, const ptrdiff_t * m_rmax, const ptrdiff_t * m_stride, void * field_ptr);
+ */
+EXTERN_C void cg_field_general_read_MeX(int nlhs, mxArray *plhs[],
+    int nrhs, const mxArray *prhs[])
+{
+    int in_fn;
+    int in_B;
+    int in_Z;
+    int in_S;
+    char * in_fieldname;
+    CG_DataType_t in_type;
+    ptrdiff_t * in_s_rmin;
+    ptrdiff_t * in_s_rmax;
+    ptrdiff_t * in_s_stride;
+    int in_m_numdim;
+    ptrdiff_t * in_m_dimvals;
+    ptrdiff_t * in_m_rmin;
+    ptrdiff_t * in_m_rmax;
+    ptrdiff_t * in_m_stride;
+    void * io_field_ptr;
+    int ierr;
+
+    /******** Check number of input and output arguments. ********/ 
+    if (nlhs > 1 || nrhs != 15)
+        mexErrMsgTxt("Wrong number of arguments to function ");
+
+    /******** Obtain input arguments ********/
+    if (_n_dims(prhs[0]) > 0)
+        mexErrMsgTxt("Error in dimension of argument fn");
+    in_fn = _get_numeric_scalar_int32(prhs[0]);
+
+    if (_n_dims(prhs[1]) > 0)
+        mexErrMsgTxt("Error in dimension of argument B");
+    in_B = _get_numeric_scalar_int32(prhs[1]);
+
+    if (_n_dims(prhs[2]) > 0)
+        mexErrMsgTxt("Error in dimension of argument Z");
+    in_Z = _get_numeric_scalar_int32(prhs[2]);
+
+    if (_n_dims(prhs[3]) > 0)
+        mexErrMsgTxt("Error in dimension of argument S");
+    in_S = _get_numeric_scalar_int32(prhs[3]);
+
+    in_fieldname = _mxGetString(prhs[4], NULL);
+
+    if (_n_dims(prhs[5]) > 0)
+        mexErrMsgTxt("Error in dimension of argument type");
+    in_type = _get_numeric_scalar_int32(prhs[5]);
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[6]) || mxIsUint64(prhs[6]))
+            in_s_rmin = (ptrdiff_t*)mxGetData(prhs[6]);
+        else {
+            in_s_rmin = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[6]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[6], (int64*)in_s_rmin))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_rmin");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[6]) || mxIsUint32(prhs[6]))
+            in_s_rmin = (ptrdiff_t*)mxGetData(prhs[6]);
+        else {
+            in_s_rmin = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[6]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[6], (int32*)in_s_rmin))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_rmin");
+        }
+    }
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[7]) || mxIsUint64(prhs[7]))
+            in_s_rmax = (ptrdiff_t*)mxGetData(prhs[7]);
+        else {
+            in_s_rmax = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[7]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[7], (int64*)in_s_rmax))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_rmax");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[7]) || mxIsUint32(prhs[7]))
+            in_s_rmax = (ptrdiff_t*)mxGetData(prhs[7]);
+        else {
+            in_s_rmax = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[7]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[7], (int32*)in_s_rmax))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_rmax");
+        }
+    }
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[8]) || mxIsUint64(prhs[8]))
+            in_s_stride = (ptrdiff_t*)mxGetData(prhs[8]);
+        else {
+            in_s_stride = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[8]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[8], (int64*)in_s_stride))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_stride");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[8]) || mxIsUint32(prhs[8]))
+            in_s_stride = (ptrdiff_t*)mxGetData(prhs[8]);
+        else {
+            in_s_stride = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[8]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[8], (int32*)in_s_stride))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_stride");
+        }
+    }
+
+    if (_n_dims(prhs[9]) > 0)
+        mexErrMsgTxt("Error in dimension of argument m_numdim");
+    in_m_numdim = _get_numeric_scalar_int32(prhs[9]);
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[10]) || mxIsUint64(prhs[10]))
+            in_m_dimvals = (ptrdiff_t*)mxGetData(prhs[10]);
+        else {
+            in_m_dimvals = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[10]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[10], (int64*)in_m_dimvals))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_dimvals");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[10]) || mxIsUint32(prhs[10]))
+            in_m_dimvals = (ptrdiff_t*)mxGetData(prhs[10]);
+        else {
+            in_m_dimvals = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[10]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[10], (int32*)in_m_dimvals))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_dimvals");
+        }
+    }
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[11]) || mxIsUint64(prhs[11]))
+            in_m_rmin = (ptrdiff_t*)mxGetData(prhs[11]);
+        else {
+            in_m_rmin = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[11]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[11], (int64*)in_m_rmin))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_rmin");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[11]) || mxIsUint32(prhs[11]))
+            in_m_rmin = (ptrdiff_t*)mxGetData(prhs[11]);
+        else {
+            in_m_rmin = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[11]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[11], (int32*)in_m_rmin))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_rmin");
+        }
+    }
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[12]) || mxIsUint64(prhs[12]))
+            in_m_rmax = (ptrdiff_t*)mxGetData(prhs[12]);
+        else {
+            in_m_rmax = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[12]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[12], (int64*)in_m_rmax))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_rmax");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[12]) || mxIsUint32(prhs[12]))
+            in_m_rmax = (ptrdiff_t*)mxGetData(prhs[12]);
+        else {
+            in_m_rmax = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[12]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[12], (int32*)in_m_rmax))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_rmax");
+        }
+    }
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[13]) || mxIsUint64(prhs[13]))
+            in_m_stride = (ptrdiff_t*)mxGetData(prhs[13]);
+        else {
+            in_m_stride = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[13]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[13], (int64*)in_m_stride))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_stride");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[13]) || mxIsUint32(prhs[13]))
+            in_m_stride = (ptrdiff_t*)mxGetData(prhs[13]);
+        else {
+            in_m_stride = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[13]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[13], (int32*)in_m_stride))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_stride");
+        }
+    }
+
+    io_field_ptr = mxGetData( prhs[14]);
+
+    /******** Invoke computational function ********/
+    ierr = cg_field_general_read(in_fn, in_B, in_Z, in_S, in_fieldname, in_type, in_s_rmin, in_s_rmax, in_s_stride, in_m_numdim, in_m_dimvals, in_m_rmin, in_m_rmax, in_m_stride, io_field_ptr);
+
+
+    /******** Free up input buffers. ********/
+    _mxFreeString(in_fieldname);
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[6]) && !mxIsUint64(prhs[6]))
+            mxFree(in_s_rmin);
+    } else {
+        if (!mxIsInt32(prhs[6]) && !mxIsUint32(prhs[6]))
+            mxFree(in_s_rmin);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[7]) && !mxIsUint64(prhs[7]))
+            mxFree(in_s_rmax);
+    } else {
+        if (!mxIsInt32(prhs[7]) && !mxIsUint32(prhs[7]))
+            mxFree(in_s_rmax);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[8]) && !mxIsUint64(prhs[8]))
+            mxFree(in_s_stride);
+    } else {
+        if (!mxIsInt32(prhs[8]) && !mxIsUint32(prhs[8]))
+            mxFree(in_s_stride);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[10]) && !mxIsUint64(prhs[10]))
+            mxFree(in_m_dimvals);
+    } else {
+        if (!mxIsInt32(prhs[10]) && !mxIsUint32(prhs[10]))
+            mxFree(in_m_dimvals);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[11]) && !mxIsUint64(prhs[11]))
+            mxFree(in_m_rmin);
+    } else {
+        if (!mxIsInt32(prhs[11]) && !mxIsUint32(prhs[11]))
+            mxFree(in_m_rmin);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[12]) && !mxIsUint64(prhs[12]))
+            mxFree(in_m_rmax);
+    } else {
+        if (!mxIsInt32(prhs[12]) && !mxIsUint32(prhs[12]))
+            mxFree(in_m_rmax);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[13]) && !mxIsUint64(prhs[13]))
+            mxFree(in_m_stride);
+    } else {
+        if (!mxIsInt32(prhs[13]) && !mxIsUint32(prhs[13]))
+            mxFree(in_m_stride);
+    }
+
+    /******** Process output arguments ********/
+    plhs[0] = mxCreateNumericMatrix(1, 1, mxINT32_CLASS, mxREAL);
+    *(int*)mxGetData(plhs[0]) = ierr;
+}
+
+/* Gateway function 
+ * [out_F, ierr] = cg_field_general_write(in_fn, in_B, in_Z, in_S, in_type, in_fieldname, in_s_rmin, in_s_rmax, in_s_stride, in_m_numdim, in_m_dimvals, in_m_rmin, in_m_rmax, in_m_stride, in_field_ptr) 
+ *
+ * The original C interface is 
+ * int cg_field_general_write( int fn, int B, int Z, int S, CG_DataType_t type, const char * fieldname, const ptrdiff_t * s_rmin, const ptrdiff_t * s_rmax, const ptrdiff_t * s_stride, int m_numdim, const ptrdiff_t * m_dimvals, const ptrdiff_t * m_rmin, const ptrdiff_t * m_rmax, const ptrdiff_t * m_stride, const void * field_ptr, int * F);
+ */
+EXTERN_C void cg_field_general_write_MeX(int nlhs, mxArray *plhs[],
+    int nrhs, const mxArray *prhs[])
+{
+    int in_fn;
+    int in_B;
+    int in_Z;
+    int in_S;
+    CG_DataType_t in_type;
+    char * in_fieldname;
+    ptrdiff_t * in_s_rmin;
+    ptrdiff_t * in_s_rmax;
+    ptrdiff_t * in_s_stride;
+    int in_m_numdim;
+    ptrdiff_t * in_m_dimvals;
+    ptrdiff_t * in_m_rmin;
+    ptrdiff_t * in_m_rmax;
+    ptrdiff_t * in_m_stride;
+    const void * in_field_ptr;
+    int out_F;
+    int ierr;
+
+    /******** Check number of input and output arguments. ********/ 
+    if (nlhs > 2 || nrhs != 15)
+        mexErrMsgTxt("Wrong number of arguments to function ");
+
+    /******** Obtain input arguments ********/
+    if (_n_dims(prhs[0]) > 0)
+        mexErrMsgTxt("Error in dimension of argument fn");
+    in_fn = _get_numeric_scalar_int32(prhs[0]);
+
+    if (_n_dims(prhs[1]) > 0)
+        mexErrMsgTxt("Error in dimension of argument B");
+    in_B = _get_numeric_scalar_int32(prhs[1]);
+
+    if (_n_dims(prhs[2]) > 0)
+        mexErrMsgTxt("Error in dimension of argument Z");
+    in_Z = _get_numeric_scalar_int32(prhs[2]);
+
+    if (_n_dims(prhs[3]) > 0)
+        mexErrMsgTxt("Error in dimension of argument S");
+    in_S = _get_numeric_scalar_int32(prhs[3]);
+
+    if (_n_dims(prhs[4]) > 0)
+        mexErrMsgTxt("Error in dimension of argument type");
+    in_type = _get_numeric_scalar_int32(prhs[4]);
+
+    in_fieldname = _mxGetString(prhs[5], NULL);
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[6]) || mxIsUint64(prhs[6]))
+            in_s_rmin = (ptrdiff_t*)mxGetData(prhs[6]);
+        else {
+            in_s_rmin = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[6]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[6], (int64*)in_s_rmin))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_rmin");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[6]) || mxIsUint32(prhs[6]))
+            in_s_rmin = (ptrdiff_t*)mxGetData(prhs[6]);
+        else {
+            in_s_rmin = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[6]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[6], (int32*)in_s_rmin))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_rmin");
+        }
+    }
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[7]) || mxIsUint64(prhs[7]))
+            in_s_rmax = (ptrdiff_t*)mxGetData(prhs[7]);
+        else {
+            in_s_rmax = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[7]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[7], (int64*)in_s_rmax))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_rmax");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[7]) || mxIsUint32(prhs[7]))
+            in_s_rmax = (ptrdiff_t*)mxGetData(prhs[7]);
+        else {
+            in_s_rmax = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[7]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[7], (int32*)in_s_rmax))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_rmax");
+        }
+    }
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[8]) || mxIsUint64(prhs[8]))
+            in_s_stride = (ptrdiff_t*)mxGetData(prhs[8]);
+        else {
+            in_s_stride = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[8]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[8], (int64*)in_s_stride))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_stride");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[8]) || mxIsUint32(prhs[8]))
+            in_s_stride = (ptrdiff_t*)mxGetData(prhs[8]);
+        else {
+            in_s_stride = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[8]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[8], (int32*)in_s_stride))
+                mexErrMsgTxt("Expecting numeric matrix for argument s_stride");
+        }
+    }
+
+    if (_n_dims(prhs[9]) > 0)
+        mexErrMsgTxt("Error in dimension of argument m_numdim");
+    in_m_numdim = _get_numeric_scalar_int32(prhs[9]);
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[10]) || mxIsUint64(prhs[10]))
+            in_m_dimvals = (ptrdiff_t*)mxGetData(prhs[10]);
+        else {
+            in_m_dimvals = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[10]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[10], (int64*)in_m_dimvals))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_dimvals");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[10]) || mxIsUint32(prhs[10]))
+            in_m_dimvals = (ptrdiff_t*)mxGetData(prhs[10]);
+        else {
+            in_m_dimvals = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[10]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[10], (int32*)in_m_dimvals))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_dimvals");
+        }
+    }
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[11]) || mxIsUint64(prhs[11]))
+            in_m_rmin = (ptrdiff_t*)mxGetData(prhs[11]);
+        else {
+            in_m_rmin = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[11]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[11], (int64*)in_m_rmin))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_rmin");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[11]) || mxIsUint32(prhs[11]))
+            in_m_rmin = (ptrdiff_t*)mxGetData(prhs[11]);
+        else {
+            in_m_rmin = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[11]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[11], (int32*)in_m_rmin))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_rmin");
+        }
+    }
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[12]) || mxIsUint64(prhs[12]))
+            in_m_rmax = (ptrdiff_t*)mxGetData(prhs[12]);
+        else {
+            in_m_rmax = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[12]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[12], (int64*)in_m_rmax))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_rmax");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[12]) || mxIsUint32(prhs[12]))
+            in_m_rmax = (ptrdiff_t*)mxGetData(prhs[12]);
+        else {
+            in_m_rmax = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[12]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[12], (int32*)in_m_rmax))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_rmax");
+        }
+    }
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[13]) || mxIsUint64(prhs[13]))
+            in_m_stride = (ptrdiff_t*)mxGetData(prhs[13]);
+        else {
+            in_m_stride = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[13]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[13], (int64*)in_m_stride))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_stride");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[13]) || mxIsUint32(prhs[13]))
+            in_m_stride = (ptrdiff_t*)mxGetData(prhs[13]);
+        else {
+            in_m_stride = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[13]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[13], (int32*)in_m_stride))
+                mexErrMsgTxt("Expecting numeric matrix for argument m_stride");
+        }
+    }
+
+    in_field_ptr = mxGetData( prhs[14]);
+
+    /******** Invoke computational function ********/
+    ierr = cg_field_general_write(in_fn, in_B, in_Z, in_S, in_type, in_fieldname, in_s_rmin, in_s_rmax, in_s_stride, in_m_numdim, in_m_dimvals, in_m_rmin, in_m_rmax, in_m_stride, in_field_ptr, &out_F);
+
+
+    /******** Free up input buffers. ********/
+    _mxFreeString(in_fieldname);
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[6]) && !mxIsUint64(prhs[6]))
+            mxFree(in_s_rmin);
+    } else {
+        if (!mxIsInt32(prhs[6]) && !mxIsUint32(prhs[6]))
+            mxFree(in_s_rmin);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[7]) && !mxIsUint64(prhs[7]))
+            mxFree(in_s_rmax);
+    } else {
+        if (!mxIsInt32(prhs[7]) && !mxIsUint32(prhs[7]))
+            mxFree(in_s_rmax);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[8]) && !mxIsUint64(prhs[8]))
+            mxFree(in_s_stride);
+    } else {
+        if (!mxIsInt32(prhs[8]) && !mxIsUint32(prhs[8]))
+            mxFree(in_s_stride);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[10]) && !mxIsUint64(prhs[10]))
+            mxFree(in_m_dimvals);
+    } else {
+        if (!mxIsInt32(prhs[10]) && !mxIsUint32(prhs[10]))
+            mxFree(in_m_dimvals);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[11]) && !mxIsUint64(prhs[11]))
+            mxFree(in_m_rmin);
+    } else {
+        if (!mxIsInt32(prhs[11]) && !mxIsUint32(prhs[11]))
+            mxFree(in_m_rmin);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[12]) && !mxIsUint64(prhs[12]))
+            mxFree(in_m_rmax);
+    } else {
+        if (!mxIsInt32(prhs[12]) && !mxIsUint32(prhs[12]))
+            mxFree(in_m_rmax);
+    }
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[13]) && !mxIsUint64(prhs[13]))
+            mxFree(in_m_stride);
+    } else {
+        if (!mxIsInt32(prhs[13]) && !mxIsUint32(prhs[13]))
+            mxFree(in_m_stride);
+    }
+
+    /******** Process output arguments ********/
+    plhs[0] = mxCreateNumericMatrix(1, 1, mxINT32_CLASS, mxREAL);
+    *(int*)mxGetData(plhs[0]) = out_F;
+    if (nlhs > 1) {
+        plhs[1] = mxCreateNumericMatrix(1, 1, mxINT32_CLASS, mxREAL);
+        *(int*)mxGetData(plhs[1]) = ierr;
+    }
+}
+
+/* External gateway function */
+EXTERN void cg_zones_coord_read_MeX(int nlhs, mxArray *plhs[], 
+    int nrhs, const mxArray *prhs[]);
+
+/* External gateway function */
+EXTERN void cg_zones_coord_write_MeX(int nlhs, mxArray *plhs[], 
+    int nrhs, const mxArray *prhs[]);
+
+/* Gateway function 
+ * [out_C, ierr] = cg_coord_reserve(in_fn, in_B, in_Z, in_type, in_coordname) 
+ *
+ * The original C interface is 
+ * int cg_coord_reserve( int fn, int B, int Z, CG_DataType_t type, const char * coordname, int * C);
+ */
+EXTERN_C void cg_coord_reserve_MeX(int nlhs, mxArray *plhs[],
+    int nrhs, const mxArray *prhs[])
+{
+    int in_fn;
+    int in_B;
+    int in_Z;
+    CG_DataType_t in_type;
+    char * in_coordname;
+    int out_C;
+    int ierr;
+
+    /******** Check number of input and output arguments. ********/ 
+    if (nlhs > 2 || nrhs != 5)
+        mexErrMsgTxt("Wrong number of arguments to function ");
+
+    /******** Obtain input arguments ********/
+    if (_n_dims(prhs[0]) > 0)
+        mexErrMsgTxt("Error in dimension of argument fn");
+    in_fn = _get_numeric_scalar_int32(prhs[0]);
+
+    if (_n_dims(prhs[1]) > 0)
+        mexErrMsgTxt("Error in dimension of argument B");
+    in_B = _get_numeric_scalar_int32(prhs[1]);
+
+    if (_n_dims(prhs[2]) > 0)
+        mexErrMsgTxt("Error in dimension of argument Z");
+    in_Z = _get_numeric_scalar_int32(prhs[2]);
+
+    if (_n_dims(prhs[3]) > 0)
+        mexErrMsgTxt("Error in dimension of argument type");
+    in_type = _get_numeric_scalar_int32(prhs[3]);
+
+    in_coordname = _mxGetString(prhs[4], NULL);
+
+    /******** Invoke computational function ********/
+    ierr = cg_coord_reserve(in_fn, in_B, in_Z, in_type, in_coordname, &out_C);
+
+
+    /******** Free up input buffers. ********/
+    _mxFreeString(in_coordname);
+
+    /******** Process output arguments ********/
+    plhs[0] = mxCreateNumericMatrix(1, 1, mxINT32_CLASS, mxREAL);
+    *(int*)mxGetData(plhs[0]) = out_C;
+    if (nlhs > 1) {
+        plhs[1] = mxCreateNumericMatrix(1, 1, mxINT32_CLASS, mxREAL);
+        *(int*)mxGetData(plhs[1]) = ierr;
+    }
+}
+
+/* Gateway function 
+ * [out_F, ierr] = cg_field_reserve(in_fn, in_B, in_Z, in_S, in_type, in_fieldname) 
+ *
+ * The original C interface is 
+ * int cg_field_reserve( int fn, int B, int Z, int S, CG_DataType_t type, const char * fieldname, int * F);
+ */
+EXTERN_C void cg_field_reserve_MeX(int nlhs, mxArray *plhs[],
+    int nrhs, const mxArray *prhs[])
+{
+    int in_fn;
+    int in_B;
+    int in_Z;
+    int in_S;
+    CG_DataType_t in_type;
+    char * in_fieldname;
+    int out_F;
+    int ierr;
+
+    /******** Check number of input and output arguments. ********/ 
+    if (nlhs > 2 || nrhs != 6)
+        mexErrMsgTxt("Wrong number of arguments to function ");
+
+    /******** Obtain input arguments ********/
+    if (_n_dims(prhs[0]) > 0)
+        mexErrMsgTxt("Error in dimension of argument fn");
+    in_fn = _get_numeric_scalar_int32(prhs[0]);
+
+    if (_n_dims(prhs[1]) > 0)
+        mexErrMsgTxt("Error in dimension of argument B");
+    in_B = _get_numeric_scalar_int32(prhs[1]);
+
+    if (_n_dims(prhs[2]) > 0)
+        mexErrMsgTxt("Error in dimension of argument Z");
+    in_Z = _get_numeric_scalar_int32(prhs[2]);
+
+    if (_n_dims(prhs[3]) > 0)
+        mexErrMsgTxt("Error in dimension of argument S");
+    in_S = _get_numeric_scalar_int32(prhs[3]);
+
+    if (_n_dims(prhs[4]) > 0)
+        mexErrMsgTxt("Error in dimension of argument type");
+    in_type = _get_numeric_scalar_int32(prhs[4]);
+
+    in_fieldname = _mxGetString(prhs[5], NULL);
+
+    /******** Invoke computational function ********/
+    ierr = cg_field_reserve(in_fn, in_B, in_Z, in_S, in_type, in_fieldname, &out_F);
+
+
+    /******** Free up input buffers. ********/
+    _mxFreeString(in_fieldname);
+
+    /******** Process output arguments ********/
+    plhs[0] = mxCreateNumericMatrix(1, 1, mxINT32_CLASS, mxREAL);
+    *(int*)mxGetData(plhs[0]) = out_F;
+    if (nlhs > 1) {
+        plhs[1] = mxCreateNumericMatrix(1, 1, mxINT32_CLASS, mxREAL);
+        *(int*)mxGetData(plhs[1]) = ierr;
+    }
+}
+
+/* Gateway function 
+ * ierr = cg_field_read_indexed(in_fn, in_B, in_Z, in_S, in_fieldname, in_type, in_num, in_indices, io_field_ptr) 
+ *
+ * The original C interface is 
+ * int cg_field_read_indexed( int fn, int B, int Z, int S, const char * fieldname, CG_DataType_t type, ptrdiff_t num, const ptrdiff_t * indices, void * field_ptr);
+ */
+EXTERN_C void cg_field_read_indexed_MeX(int nlhs, mxArray *plhs[],
+    int nrhs, const mxArray *prhs[])
+{
+    int in_fn;
+    int in_B;
+    int in_Z;
+    int in_S;
+    char * in_fieldname;
+    CG_DataType_t in_type;
+    ptrdiff_t in_num;
+    ptrdiff_t * in_indices;
+    void * io_field_ptr;
+    int ierr;
+
+    /******** Check number of input and output arguments. ********/ 
+    if (nlhs > 1 || nrhs != 9)
+        mexErrMsgTxt("Wrong number of arguments to function ");
+
+    /******** Obtain input arguments ********/
+    if (_n_dims(prhs[0]) > 0)
+        mexErrMsgTxt("Error in dimension of argument fn");
+    in_fn = _get_numeric_scalar_int32(prhs[0]);
+
+    if (_n_dims(prhs[1]) > 0)
+        mexErrMsgTxt("Error in dimension of argument B");
+    in_B = _get_numeric_scalar_int32(prhs[1]);
+
+    if (_n_dims(prhs[2]) > 0)
+        mexErrMsgTxt("Error in dimension of argument Z");
+    in_Z = _get_numeric_scalar_int32(prhs[2]);
+
+    if (_n_dims(prhs[3]) > 0)
+        mexErrMsgTxt("Error in dimension of argument S");
+    in_S = _get_numeric_scalar_int32(prhs[3]);
+
+    in_fieldname = _mxGetString(prhs[4], NULL);
+
+    if (_n_dims(prhs[5]) > 0)
+        mexErrMsgTxt("Error in dimension of argument type");
+    in_type = _get_numeric_scalar_int32(prhs[5]);
+
+    if (_n_dims(prhs[6]) > 0)
+        mexErrMsgTxt("Error in dimension of argument num");
+    if (sizeof(ptrdiff_t)==8) 
+        in_num = _get_numeric_scalar_int64(prhs[6]);
+    else
+        in_num = _get_numeric_scalar_int32(prhs[6]);
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[7]) || mxIsUint64(prhs[7]))
+            in_indices = (ptrdiff_t*)mxGetData(prhs[7]);
+        else {
+            in_indices = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[7]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[7], (int64*)in_indices))
+                mexErrMsgTxt("Expecting numeric matrix for argument indices");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[7]) || mxIsUint32(prhs[7]))
+            in_indices = (ptrdiff_t*)mxGetData(prhs[7]);
+        else {
+            in_indices = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[7]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[7], (int32*)in_indices))
+                mexErrMsgTxt("Expecting numeric matrix for argument indices");
+        }
+    }
+
+    io_field_ptr = mxGetData( prhs[8]);
+
+    /******** Invoke computational function ********/
+    ierr = cg_field_read_indexed(in_fn, in_B, in_Z, in_S, in_fieldname, in_type, in_num, in_indices, io_field_ptr);
+
+
+    /******** Free up input buffers. ********/
+    _mxFreeString(in_fieldname);
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[7]) && !mxIsUint64(prhs[7]))
+            mxFree(in_indices);
+    } else {
+        if (!mxIsInt32(prhs[7]) && !mxIsUint32(prhs[7]))
+            mxFree(in_indices);
+    }
+
+    /******** Process output arguments ********/
+    plhs[0] = mxCreateNumericMatrix(1, 1, mxINT32_CLASS, mxREAL);
+    *(int*)mxGetData(plhs[0]) = ierr;
+}
+
+/* Gateway function 
+ * ierr = cg_coord_read_indexed(in_fn, in_B, in_Z, in_coordname, in_type, in_num, in_indices, io_coord) 
+ *
+ * The original C interface is 
+ * int cg_coord_read_indexed( int fn, int B, int Z, const char * coordname, CG_DataType_t type, ptrdiff_t num, const ptrdiff_t * indices, void * coord);
+ */
+EXTERN_C void cg_coord_read_indexed_MeX(int nlhs, mxArray *plhs[],
+    int nrhs, const mxArray *prhs[])
+{
+    int in_fn;
+    int in_B;
+    int in_Z;
+    char * in_coordname;
+    CG_DataType_t in_type;
+    ptrdiff_t in_num;
+    ptrdiff_t * in_indices;
+    void * io_coord;
+    int ierr;
+
+    /******** Check number of input and output arguments. ********/ 
+    if (nlhs > 1 || nrhs != 8)
+        mexErrMsgTxt("Wrong number of arguments to function ");
+
+    /******** Obtain input arguments ********/
+    if (_n_dims(prhs[0]) > 0)
+        mexErrMsgTxt("Error in dimension of argument fn");
+    in_fn = _get_numeric_scalar_int32(prhs[0]);
+
+    if (_n_dims(prhs[1]) > 0)
+        mexErrMsgTxt("Error in dimension of argument B");
+    in_B = _get_numeric_scalar_int32(prhs[1]);
+
+    if (_n_dims(prhs[2]) > 0)
+        mexErrMsgTxt("Error in dimension of argument Z");
+    in_Z = _get_numeric_scalar_int32(prhs[2]);
+
+    in_coordname = _mxGetString(prhs[3], NULL);
+
+    if (_n_dims(prhs[4]) > 0)
+        mexErrMsgTxt("Error in dimension of argument type");
+    in_type = _get_numeric_scalar_int32(prhs[4]);
+
+    if (_n_dims(prhs[5]) > 0)
+        mexErrMsgTxt("Error in dimension of argument num");
+    if (sizeof(ptrdiff_t)==8) 
+        in_num = _get_numeric_scalar_int64(prhs[5]);
+    else
+        in_num = _get_numeric_scalar_int32(prhs[5]);
+
+    if (sizeof(ptrdiff_t)==8) {
+        if (mxIsInt64(prhs[6]) || mxIsUint64(prhs[6]))
+            in_indices = (ptrdiff_t*)mxGetData(prhs[6]);
+        else {
+            in_indices = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[6]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int64(prhs[6], (int64*)in_indices))
+                mexErrMsgTxt("Expecting numeric matrix for argument indices");
+        }
+    }
+    else {
+        if (mxIsInt32(prhs[6]) || mxIsUint32(prhs[6]))
+            in_indices = (ptrdiff_t*)mxGetData(prhs[6]);
+        else {
+            in_indices = (ptrdiff_t*)mxCalloc(mxGetNumberOfElements(prhs[6]), sizeof (ptrdiff_t));
+            if (!_get_numeric_array_int32(prhs[6], (int32*)in_indices))
+                mexErrMsgTxt("Expecting numeric matrix for argument indices");
+        }
+    }
+
+    io_coord = mxGetData( prhs[7]);
+
+    /******** Invoke computational function ********/
+    ierr = cg_coord_read_indexed(in_fn, in_B, in_Z, in_coordname, in_type, in_num, in_indices, io_coord);
+
+
+    /******** Free up input buffers. ********/
+    _mxFreeString(in_coordname);
+    if (sizeof(ptrdiff_t)==8) {
+        if (!mxIsInt64(prhs[6]) && !mxIsUint64(prhs[6]))
+            mxFree(in_indices);
+    } else {
+        if (!mxIsInt32(prhs[6]) && !mxIsUint32(prhs[6]))
+            mxFree(in_indices);
+    }
+
+    /******** Process output arguments ********/
+    plhs[0] = mxCreateNumericMatrix(1, 1, mxINT32_CLASS, mxREAL);
+    *(int*)mxGetData(plhs[0]) = ierr;
+}
+
+/* Gateway function 
+ * ierr = cg_extract_zones(in_fn, in_B, in_nzones, in_zones, in_filename, in_file_type, in_link_size) 
+ *
+ * The original C interface is 
+ * int cg_extract_zones( int fn, int B, int nzones, const int * zones, const char * filename, int file_type, ptrdiff_t link_size);
+ */
+EXTERN_C void cg_extract_zones_MeX(int nlhs, mxArray *plhs[],
+    int nrhs, const mxArray *prhs[])
+{
+    int in_fn;
+    int in_B;
+    int in_nzones;
+    int * in_zones;
+    char * in_filename;
+    int in_file_type;
+    ptrdiff_t in_link_size;
+    int ierr;
+
+    /******** Check number of input and output arguments. ********/ 
+    if (nlhs > 1 || nrhs != 7)
+        mexErrMsgTxt("Wrong number of arguments to function ");
+
+    /******** Obtain input arguments ********/
+    if (_n_dims(prhs[0]) > 0)
+        mexErrMsgTxt("Error in dimension of argument fn");
+    in_fn = _get_numeric_scalar_int32(prhs[0]);
+
+    if (_n_dims(prhs[1]) > 0)
+        mexErrMsgTxt("Error in dimension of argument B");
+    in_B = _get_numeric_scalar_int32(prhs[1]);
+
+    if (_n_dims(prhs[2]) > 0)
+        mexErrMsgTxt("Error in dimension of argument nzones");
+    in_nzones = _get_numeric_scalar_int32(prhs[2]);
+
+    if (mxGetNumberOfElements(prhs[3]) < (int) (in_nzones) || _n_dims(prhs[3]) > 1)
+        mexErrMsgTxt("Error in dimension of argument zones");
+    if (mxIsInt32(prhs[3]) || mxIsUint32(prhs[3]))
+        in_zones = (int*)mxGetData(prhs[3]);
+    else {
+        in_zones = (int*)mxCalloc(mxGetNumberOfElements(prhs[3]), sizeof (int));
+        if (!_get_numeric_array_int32(prhs[3], in_zones))
+            mexErrMsgTxt("Expecting numeric matrix for argument zones");
+    }
+
+    in_filename = _mxGetString(prhs[4], NULL);
+
+    if (_n_dims(prhs[5]) > 0)
+        mexErrMsgTxt("Error in dimension of argument file_type");
+    in_file_type = _get_numeric_scalar_int32(prhs[5]);
+
+    if (_n_dims(prhs[6]) > 0)
+        mexErrMsgTxt("Error in dimension of argument link_size");
+    if (sizeof(ptrdiff_t)==8) 
+        in_link_size = _get_numeric_scalar_int64(prhs[6]);
+    else
+        in_link_size = _get_numeric_scalar_int32(prhs[6]);
+
+
+    /******** Invoke computational function ********/
+    ierr = cg_extract_zones(in_fn, in_B, in_nzones, in_zones, in_filename, in_file_type, in_link_size);
+
+
+    /******** Free up input buffers. ********/
+    if (!mxIsInt32(prhs[3]) && !mxIsUint32(prhs[3]))
+        mxFree(in_zones);
+    _mxFreeString(in_filename);
+
+    /******** Process output arguments ********/
+    plhs[0] = mxCreateNumericMatrix(1, 1, mxINT32_CLASS, mxREAL);
+    *(int*)mxGetData(plhs[0]) = ierr;
+}
+
+/* Gateway function 
+ * ierr = cg_extract_family(in_fn, in_B, in_family_name, in_filename, in_file_type, in_link_size) 
+ *
+ * The original C interface is 
+ * int cg_extract_family( int fn, int B, const char * family_name, const char * filename, int file_type, ptrdiff_t link_size);
+ */
+EXTERN_C void cg_extract_family_MeX(int nlhs, mxArray *plhs[],
+    int nrhs, const mxArray *prhs[])
+{
+    int in_fn;
+    int in_B;
+    char * in_family_name;
+    char * in_filename;
+    int in_file_type;
+    ptrdiff_t in_link_size;
+    int ierr;
+
+    /******** Check number of input and output arguments. ********/ 
+    if (nlhs > 1 || nrhs != 6)
+        mexErrMsgTxt("Wrong number of arguments to function ");
+
+    /******** Obtain input arguments ********/
+    if (_n_dims(prhs[0]) > 0)
+        mexErrMsgTxt("Error in dimension of argument fn");
+    in_fn = _get_numeric_scalar_int32(prhs[0]);
+
+    if (_n_dims(prhs[1]) > 0)
+        mexErrMsgTxt("Error in dimension of argument B");
+    in_B = _get_numeric_scalar_int32(prhs[1]);
+
+    in_family_name = _mxGetString(prhs[2], NULL);
+
+    in_filename = _mxGetString(prhs[3], NULL);
+
+    if (_n_dims(prhs[4]) > 0)
+        mexErrMsgTxt("Error in dimension of argument file_type");
+    in_file_type = _get_numeric_scalar_int32(prhs[4]);
+
+    if (_n_dims(prhs[5]) > 0)
+        mexErrMsgTxt("Error in dimension of argument link_size");
+    if (sizeof(ptrdiff_t)==8) 
+        in_link_size = _get_numeric_scalar_int64(prhs[5]);
+    else
+        in_link_size = _get_numeric_scalar_int32(prhs[5]);
+
+
+    /******** Invoke computational function ********/
+    ierr = cg_extract_family(in_fn, in_B, in_family_name, in_filename, in_file_type, in_link_size);
+
+
+    /******** Free up input buffers. ********/
+    _mxFreeString(in_family_name);
+    _mxFreeString(in_filename);
+
+    /******** Process output arguments ********/
+    plhs[0] = mxCreateNumericMatrix(1, 1, mxINT32_CLASS, mxREAL);
+    *(int*)mxGetData(plhs[0]) = ierr;
+}
+
+/* External gateway function */
+EXTERN void cg_zone_reserve_MeX(int nlhs, mxArray *plhs[], 
+    int nrhs, const mxArray *prhs[]);
+EXTERN void cgio_stats_MeX(int nlhs, mxArray *plhs[], 
+    int nrhs, const mxArray *prhs[]);
+
 #include "cgnslib_mex_ext.c"
 
 /* Main gateway function */
@@ -12604,7 +14097,22 @@ EXTERN_C void mexFunction(int nlhs, mxArray *plhs[],
         /* 240 */ cg_delete_node_MeX,
         /* 241 */ cg_get_error_MeX,
         /* 242 */ cg_error_exit_MeX,
-        /* 243 */ cg_error_print_MeX
+        /* 243 */ cg_error_print_MeX,
+        /* 244 */ cg_flush_MeX,
+        /* 245 */ cg_coord_general_read_MeX,
+        /* 246 */ cg_coord_general_write_MeX,
+        /* 247 */ cg_field_general_read_MeX,
+        /* 248 */ cg_field_general_write_MeX,
+        /* 249 */ cg_zones_coord_read_MeX,
+        /* 250 */ cg_zones_coord_write_MeX,
+        /* 251 */ cg_coord_reserve_MeX,
+        /* 252 */ cg_field_reserve_MeX,
+        /* 253 */ cg_zone_reserve_MeX,
+        /* 254 */ cg_field_read_indexed_MeX,
+        /* 255 */ cg_coord_read_indexed_MeX,
+        /* 256 */ cgio_stats_MeX,
+        /* 257 */ cg_extract_zones_MeX,
+        /* 258 */ cg_extract_family_MeX
     };
 
     /******** Check function selector argument. ********/ 
@@ -12613,7 +14121,7 @@ EXTERN_C void mexFunction(int nlhs, mxArray *plhs[],
 
     func_id = *(int*)mxGetData( prhs[0]);
 
-    if (func_id < 1 || func_id > 243)
+    if (func_id < 1 || func_id > 258)
         mexErrMsgTxt("Function selector out of bound.\n");
     
     /******** Invoke the function. ********/ 
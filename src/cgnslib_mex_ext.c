@@ -7,6 +7,7 @@
 #include "c2mex.h"   /* This includes "mex.h". */
 
 #include "cgnslib_3.1/cgnslib.h"
+#include "cgnslib_3.1/cgns_io.h"
 #include <string.h>
 #include <assert.h>
 
@@ -414,3 +415,342 @@ EXTERN_C void cg_golist_MeX(int nlhs, mxArray *plhs[], int nrhs,
     plhs[0] = mxCreateNumericMatrix(1, 1, mxINT32_CLASS, mxREAL);
     *(int*)mxGetData(plhs[0]) = ierr;
 }
+
+/*
+ * Helpers for the multi-zone gateways below. The zone list is taken from
+ * prhs (all zones of the base if it is empty), and the coordinate array of
+ * a zone has the vertex dimensions of the zone plus one trailing dimension
+ * for CoordinateX, CoordinateY and CoordinateZ.
+ */
+static int *_get_zone_list(int fn, int B, const mxArray *zones, int *nzones)
+{
+    int *list, i;
+
+    if (zones != NULL && !mxIsEmpty(zones)) {
+        *nzones = (int)mxGetNumberOfElements(zones);
+        list = (int*)mxCalloc(*nzones, sizeof(int));
+        if (!_get_numeric_array_int32(zones, (int32*)list))
+            mexErrMsgTxt("Expecting numeric matrix for argument zones");
+        return list;
+    }
+    if (cg_nzones(fn, B, nzones)) return NULL;
+    list = (int*)mxCalloc(*nzones > 0 ? *nzones : 1, sizeof(int));
+    for (i=0; i<*nzones; ++i) list[i] = i+1;
+    return list;
+}
+
+static int _zone_coord_dims(int fn, int B, int Z, int phys_dim,
+    cgsize_t *rmax, mwSize *dims, int *ndims, cgsize_t *npts)
+{
+    char zonename[33];
+    cgsize_t size[9];
+    CG_ZoneType_t zonetype;
+    int n, index_dim;
+
+    if (cg_zone_type(fn, B, Z, &zonetype) ||
+        cg_index_dim(fn, B, Z, &index_dim) ||
+        cg_zone_read(fn, B, Z, zonename, size)) return CG_ERROR;
+
+    if (zonetype != CG_Structured) index_dim = 1;
+    *npts = 1;
+    for (n=0; n<index_dim; ++n) {
+        rmax[n] = size[n];
+        dims[n] = (mwSize)size[n];
+        *npts *= size[n];
+    }
+    dims[index_dim] = phys_dim;
+    *ndims = index_dim+1;
+    return CG_OK;
+}
+
+static const char *_coord_names[3] = {
+    "CoordinateX", "CoordinateY", "CoordinateZ"
+};
+
+/* Gateway function 
+ * [out_coords, ierr] = cg_zones_coord_read(in_fn, in_B, in_zones)
+ *
+ * Reads the coordinates of all the given zones in one call and returns
+ * them as a cell array with one entry per zone. The arrays are created
+ * up front and the library fills them in place, zone after zone (the
+ * library is not re-entrant, so the reads themselves are not overlapped).
+ */
+EXTERN_C void cg_zones_coord_read_MeX(int nlhs, mxArray *plhs[], 
+    int nrhs, const mxArray *prhs[])
+{
+    int in_fn;
+    int in_B;
+    int *zones, nzones, cell_dim, phys_dim, ndims, i, c;
+    char basename[33];
+    cgsize_t rmin[3] = {1, 1, 1}, rmax[3], npts;
+    mwSize dims[4];
+    mxArray *coord;
+    double *data;
+    int ierr;
+
+    /******** Check number of input and output arguments. ********/ 
+    if (nlhs > 2 || nrhs < 2 || nrhs > 3)
+        mexErrMsgTxt("Wrong number of arguments to function ");
+
+    /******** Obtain input arguments ********/
+    if (_n_dims(prhs[0]) > 0)
+        mexErrMsgTxt("Error in dimension of argument fn");
+    in_fn = _get_numeric_scalar_int32(prhs[0]);
+
+    if (_n_dims(prhs[1]) > 0)
+        mexErrMsgTxt("Error in dimension of argument B");
+    in_B = _get_numeric_scalar_int32(prhs[1]);
+
+    /******** Invoke computational function ********/
+    nzones = 0;
+    ierr = cg_base_read(in_fn, in_B, basename, &cell_dim, &phys_dim);
+    zones = ierr ? NULL : _get_zone_list(in_fn, in_B,
+                                         nrhs > 2 ? prhs[2] : NULL, &nzones);
+    if (zones == NULL) {
+        ierr = CG_ERROR;
+        nzones = 0;
+    }
+    if (phys_dim > 3) phys_dim = 3;
+
+    plhs[0] = mxCreateCellMatrix(1, nzones);
+    for (i=0; i<nzones && !ierr; ++i) {
+        ierr = _zone_coord_dims(in_fn, in_B, zones[i], phys_dim,
+                                rmax, dims, &ndims, &npts);
+        if (ierr) break;
+        coord = mxCreateNumericArray(ndims, dims, mxDOUBLE_CLASS, mxREAL);
+        data = (double*)mxGetData(coord);
+        for (c=0; c<phys_dim && !ierr; ++c)
+            ierr = cg_coord_read(in_fn, in_B, zones[i], _coord_names[c],
+                                 CG_RealDouble, rmin, rmax, data + c*npts);
+        mxSetCell(plhs[0], i, coord);
+    }
+
+    /******** Free up input buffers. ********/
+    if (zones != NULL) mxFree(zones);
+
+    /******** Process output arguments ********/
+    if (nlhs > 1) {
+        plhs[1] = mxCreateNumericMatrix(1, 1, mxINT32_CLASS, mxREAL);
+        *(int*)mxGetData(plhs[1]) = ierr;
+    }
+}
+
+/* Gateway function 
+ * ierr = cg_zones_coord_write(in_fn, in_B, in_zones, in_coords)
+ *
+ * Writes the coordinates of the given (existing) zones from a cell array
+ * laid out as returned by cg_zones_coord_read.
+ */
+EXTERN_C void cg_zones_coord_write_MeX(int nlhs, mxArray *plhs[], 
+    int nrhs, const mxArray *prhs[])
+{
+    int in_fn;
+    int in_B;
+    int *zones, nzones, cell_dim, phys_dim, ndims, i, c, C;
+    char basename[33];
+    cgsize_t rmax[3], npts;
+    mwSize dims[4];
+    const mxArray *coord;
+    const double *data;
+    int ierr;
+
+    /******** Check number of input and output arguments. ********/ 
+    if (nlhs > 1 || nrhs != 4)
+        mexErrMsgTxt("Wrong number of arguments to function ");
+
+    /******** Obtain input arguments ********/
+    if (_n_dims(prhs[0]) > 0)
+        mexErrMsgTxt("Error in dimension of argument fn");
+    in_fn = _get_numeric_scalar_int32(prhs[0]);
+
+    if (_n_dims(prhs[1]) > 0)
+        mexErrMsgTxt("Error in dimension of argument B");
+    in_B = _get_numeric_scalar_int32(prhs[1]);
+
+    if (!mxIsCell(prhs[3]))
+        mexErrMsgTxt("Expecting cell array for argument coords");
+
+    /******** Invoke computational function ********/
+    nzones = 0;
+    ierr = cg_base_read(in_fn, in_B, basename, &cell_dim, &phys_dim);
+    zones = ierr ? NULL : _get_zone_list(in_fn, in_B, prhs[2], &nzones);
+    if (zones == NULL)
+        ierr = CG_ERROR;
+    else if (nzones != (int)mxGetNumberOfElements(prhs[3]))
+        mexErrMsgTxt("Number of zones and coordinate arrays differ");
+    if (phys_dim > 3) phys_dim = 3;
+
+    for (i=0; i<nzones && !ierr; ++i) {
+        ierr = _zone_coord_dims(in_fn, in_B, zones[i], phys_dim,
+                                rmax, dims, &ndims, &npts);
+        if (ierr) break;
+        coord = mxGetCell(prhs[3], i);
+        if (coord == NULL || !mxIsDouble(coord) ||
+            mxGetNumberOfElements(coord) != (mwSize)(npts*phys_dim))
+            mexErrMsgTxt("Coordinate array does not match the zone size");
+        data = (const double*)mxGetData(coord);
+        for (c=0; c<phys_dim && !ierr; ++c)
+            ierr = cg_coord_write(in_fn, in_B, zones[i], CG_RealDouble,
+                                  _coord_names[c], data + c*npts, &C);
+    }
+
+    /******** Free up input buffers. ********/
+    if (zones != NULL) mxFree(zones);
+
+    /******** Process output arguments ********/
+    plhs[0] = mxCreateNumericMatrix(1, 1, mxINT32_CLASS, mxREAL);
+    *(int*)mxGetData(plhs[0]) = ierr;
+}
+
+/* Gateway function 
+ * ierr = cg_zone_reserve(in_fn, in_B, in_Z, in_type, in_S, in_fieldnames) 
+ *
+ * The original C interface is 
+ * int cg_zone_reserve( int fn, int B, int Z, CG_DataType_t type, int S, int nfields, const char * const * fieldnames);
+ *
+ * fieldnames is a cell array of strings (nfields is its length), and may
+ * be left out along with S to reserve only the coordinates.
+ */
+EXTERN_C void cg_zone_reserve_MeX(int nlhs, mxArray *plhs[], 
+    int nrhs, const mxArray *prhs[])
+{
+    int in_fn;
+    int in_B;
+    int in_Z;
+    CG_DataType_t in_type;
+    int in_S = 0;
+    int in_nfields = 0;
+    char ** in_fieldnames = NULL;
+    int i, ierr;
+
+    /******** Check number of input and output arguments. ********/ 
+    if (nlhs > 1 || (nrhs != 4 && nrhs != 6))
+        mexErrMsgTxt("Wrong number of arguments to function ");
+
+    /******** Obtain input arguments ********/
+    if (_n_dims(prhs[0]) > 0)
+        mexErrMsgTxt("Error in dimension of argument fn");
+    in_fn = _get_numeric_scalar_int32(prhs[0]);
+
+    if (_n_dims(prhs[1]) > 0)
+        mexErrMsgTxt("Error in dimension of argument B");
+    in_B = _get_numeric_scalar_int32(prhs[1]);
+
+    if (_n_dims(prhs[2]) > 0)
+        mexErrMsgTxt("Error in dimension of argument Z");
+    in_Z = _get_numeric_scalar_int32(prhs[2]);
+
+    if (_n_dims(prhs[3]) > 0)
+        mexErrMsgTxt("Error in dimension of argument type");
+    in_type = _get_numeric_scalar_int32(prhs[3]);
+
+    if (nrhs == 6) {
+        if (_n_dims(prhs[4]) > 0)
+            mexErrMsgTxt("Error in dimension of argument S");
+        in_S = _get_numeric_scalar_int32(prhs[4]);
+
+        if (!mxIsCell(prhs[5]))
+            mexErrMsgTxt("Expecting cell array for argument fieldnames");
+        in_nfields = (int)mxGetNumberOfElements(prhs[5]);
+        if (in_nfields > 0)
+            in_fieldnames = (char**)mxCalloc(in_nfields, sizeof(char*));
+        for (i=0; i<in_nfields; ++i) {
+            if (mxGetCell(prhs[5], i) == NULL ||
+                !mxIsChar(mxGetCell(prhs[5], i)))
+                mexErrMsgTxt("Expecting strings in argument fieldnames");
+            in_fieldnames[i] = _mxGetString(mxGetCell(prhs[5], i), NULL);
+        }
+    }
+
+    /******** Invoke computational function ********/
+    ierr = cg_zone_reserve(in_fn, in_B, in_Z, in_type, in_S, in_nfields,
+                           (const char * const *)in_fieldnames);
+
+    /******** Free up input buffers. ********/
+    for (i=0; i<in_nfields; ++i)
+        _mxFreeString(in_fieldnames[i]);
+    if (in_fieldnames != NULL) mxFree(in_fieldnames);
+
+    /******** Process output arguments ********/
+    plhs[0] = mxCreateNumericMatrix(1, 1, mxINT32_CLASS, mxREAL);
+    *(int*)mxGetData(plhs[0]) = ierr;
+}
+
+/* Gateway function 
+ * [out_stats, out_memory, ierr] = cgio_stats(in_fn)
+ *
+ * The original C interfaces are 
+ * int cgio_stats_number( int * num_ops);
+ * int cgio_stats_read( int op, char * name, cgio_stats_t * stats);
+ * int cgio_stats_file( int cgio_num, cgio_stats_t * stats);
+ * int cgio_stats_memory( cglong_t * mem_now, cglong_t * mem_max);
+ */
+EXTERN_C void cgio_stats_MeX(int nlhs, mxArray *plhs[], 
+    int nrhs, const mxArray *prhs[])
+{
+    static const char *fields[] = {"name", "calls", "errors", "bytes",
+                                   "time", "max_time", "histogram"};
+    int in_fn = 0;
+    int num_ops = 1, cgio_num, i, j, ierr;
+    char name[CGIO_MAX_NAME_LENGTH+1];
+    cgio_stats_t stats;
+    cglong_t mem_now, mem_max;
+    double *hist;
+
+    /******** Check number of input and output arguments. ********/ 
+    if (nlhs > 3 || nrhs > 1)
+        mexErrMsgTxt("Wrong number of arguments to function ");
+
+    /******** Obtain input arguments ********/
+    if (nrhs == 1) {
+        if (_n_dims(prhs[0]) > 0)
+            mexErrMsgTxt("Error in dimension of argument fn");
+        in_fn = _get_numeric_scalar_int32(prhs[0]);
+    }
+
+    /******** Invoke computational function ********/
+    if (in_fn)
+        ierr = cg_get_cgio(in_fn, &cgio_num);
+    else
+        ierr = cgio_stats_number(&num_ops);
+
+    /******** Process output arguments ********/
+    plhs[0] = mxCreateStructMatrix(num_ops, 1, 7, fields);
+    for (i = 0; i < num_ops && !ierr; i++) {
+        if (in_fn) {
+            strcpy(name, "file");
+            ierr = cgio_stats_file(cgio_num, &stats);
+        }
+        else
+            ierr = cgio_stats_read(i+1, name, &stats);
+        if (ierr) break;
+
+        mxSetField(plhs[0], i, "name", mxCreateString(name));
+        mxSetField(plhs[0], i, "calls",
+                   mxCreateDoubleScalar((double)stats.calls));
+        mxSetField(plhs[0], i, "errors",
+                   mxCreateDoubleScalar((double)stats.errors));
+        mxSetField(plhs[0], i, "bytes",
+                   mxCreateDoubleScalar((double)stats.bytes));
+        mxSetField(plhs[0], i, "time", mxCreateDoubleScalar(stats.time));
+        mxSetField(plhs[0], i, "max_time",
+                   mxCreateDoubleScalar(stats.max_time));
+        mxSetField(plhs[0], i, "histogram",
+                   mxCreateDoubleMatrix(1, CGIO_STATS_BINS, mxREAL));
+        hist = mxGetPr(mxGetField(plhs[0], i, "histogram"));
+        for (j = 0; j < CGIO_STATS_BINS; j++)
+            hist[j] = (double)stats.histogram[j];
+    }
+
+    if (nlhs > 1) {
+        cgio_stats_memory(&mem_now, &mem_max);
+        plhs[1] = mxCreateDoubleMatrix(1, 2, mxREAL);
+        mxGetPr(plhs[1])[0] = (double)mem_now;
+        mxGetPr(plhs[1])[1] = (double)mem_max;
+    }
+
+    if (nlhs > 2) {
+        plhs[2] = mxCreateNumericMatrix(1, 1, mxINT32_CLASS, mxREAL);
+        *(int*)mxGetData(plhs[2]) = ierr;
+    }
+}
@@ -45,6 +45,12 @@ function writecgns( file_name, ps, elems, typestr, var_nodes, var_cells)
 %
 %   VAR_CELLS is a MATLAB structure containing elemental values to be
 %       written. Its usage is similar to VAR_NODES.
+%   To write several zones into a single base, pass XS and ELEMS as 1xn
+%       cell arrays with one entry per zone. TYPESTR, VAR_NODES and
+%       VAR_CELLS may then be cell arrays as well, or a single value that
+%       is used for every zone. The dimensions of the base are taken from
+%       the first zone.
+%
 %
 % Example usage
 %     var_nodes.vdisp = disp;   % Define two nodal variables
@@ -56,6 +62,8 @@ function writecgns( file_name, ps, elems, typestr, var_nodes, var_cells)
 %     writecgns( 'test.cgns', xs, elems, '', var_nodes);
 %     % Write out only elemental variables
 %     writecgns( 'test.cgns', xs, elems, '', [], var_cells);
+%     % Write out two blocks in one file
+%     writecgns( 'blocks.cgns', {xs1, xs2}, {elems1, elems2}, 'STRUCT3');
 %
 % Note that a field in VAR_NODES (and similarly in VAR_CELLS) is
 % an nxd matrix with d>=1. If d>1, each column of the field will
@@ -87,13 +95,76 @@ if nargin<4; typestr = []; end
 if nargin<5; var_nodes = []; end
 if nargin<6; var_cells = []; end
 
+% A single zone is written as a one-entry multi-zone file
+if ~iscell(ps)
+    ps = {ps};
+    elems = {elems};
+end
+nz = length(ps);
+if ~iscell(typestr); typestr = repmat({typestr},1,nz); end
+if ~iscell(var_nodes); var_nodes = repmat({var_nodes},1,nz); end
+if ~iscell(var_cells); var_cells = repmat({var_cells},1,nz); end
+
+% Determine the zone sizes and element types up front
+zones = cell(1,nz);
+for z=1:nz
+    zones{z} = get_zone_info( ps{z}, elems{z}, typestr{z});
+end
+
+% Set file type to HDF5 or ADF
+if strcmp(file_name(end-2:end),'.adf')
+    ierr = cg_set_file_type(CG_FILE_ADF); chk_error(ierr);
+else
+    ierr = cg_set_file_type(CG_FILE_HDF5); chk_error(ierr);
+end
+
+% Open the CGNS file.
+[index_file,ierr] = cg_open(file_name,CG_MODE_WRITE); chk_error(ierr);
+
+% Create base
+[index_base,ierr] = cg_base_write(index_file,'Base',zones{1}.icelldim,...
+    zones{1}.iphysdim); chk_error(ierr);
+
+% Create zones. The library sorts zones by name, so the numbers are
+% zero-padded to keep them in the order given
+index_zones = zeros(1,nz);
+ndigits = length(sprintf('%d',nz));
+for z=1:nz
+    if zones{z}.structured
+        [index_zones(z),ierr] = cg_zone_write(index_file,index_base,...
+            sprintf('Zone %0*d',ndigits,z),zones{z}.isize,Structured); chk_error(ierr);
+    else
+        [index_zones(z),ierr] = cg_zone_write(index_file,index_base,...
+            sprintf('Zone%0*d',ndigits,z),zones{z}.isize,Unstructured); chk_error(ierr);
+    end
+    ps{z} = double(ps{z});
+end
+
+% Write grid coordinates of all zones in one call (SIDS-standard names)
+ierr = cg_zones_coord_write(index_file,index_base,index_zones,ps);
+chk_error(ierr);
+
+% Write element connectivity and variables
+for z=1:nz
+    write_zone( index_file, index_base, index_zones(z), zones{z}, ...
+        var_nodes{z}, var_cells{z});
+end
+
+% Close the CGNS file.
+ierr = cg_close(index_file); chk_error(ierr);
+end
+
+function zone = get_zone_info( ps, elems, typestr)
+% Obtain the dimensions, the zone size and the element type of a zone
+
 if strcmp(typestr,'struct2') || strcmp(typestr,'Struct2')
     typestr = 'STRUCT2';
 elseif strcmp(typestr,'struct3') || strcmp(typestr,'Struct3')
     typestr = 'STRUCT3';
 end
 
-if strcmp(typestr,'STRUCT2') || strcmp(typestr,'STRUCT3') % Structured
+zone.structured = strcmp(typestr,'STRUCT2') || strcmp(typestr,'STRUCT3');
+if zone.structured
     
     % Determine physical dimension
     if elems(3)==0
@@ -112,93 +183,9 @@ if strcmp(typestr,'STRUCT2') || strcmp(typestr,'STRUCT3') % Structured
         error('physical dimension must be 2 or 3')
     end
     
-    % Set file type to HDF5 or ADF
-    if strcmp(file_name(end-2:end),'.adf')
-        ierr = cg_set_file_type(CG_FILE_ADF); chk_error(ierr);
-    else
-        ierr = cg_set_file_type(CG_FILE_HDF5); chk_error(ierr);
-    end
-    
-    % WRITE X, Y, Z GRID POINTS TO CGNS FILE
-    % Open the CGNS file.
-    [index_file,ierr] = cg_open(file_name,CG_MODE_WRITE); chk_error(ierr);
-    
-    % Set cell dimension
-    if iphysdim==3
-        icelldim=3;
-    elseif iphysdim==2
-        icelldim=2;
-    else
-        error('physical dimension must be 2 or 3')
-    end
-    
-    % Create base
-    [index_base,ierr] = cg_base_write(index_file,'Base',icelldim,iphysdim); chk_error(ierr);
-    
-    % Create isize
-    isize = [ni, nj, nk, ni-1, nj-1, nk-1, 0, 0, 0];
-    
-    % Create zone
-    [index_zone,ierr] = cg_zone_write(index_file,index_base,'Zone 1',isize,Structured); chk_error(ierr);
-    
-    %write grid coordinates (user must use SIDS-standard names here)
-    if iphysdim==3
-        xs = ps(:,:,:,1);
-        ys = ps(:,:,:,2);
-        zs = ps(:,:,:,3);
-    elseif iphysdim==2
-        xs = ps(:,:,1);
-        ys = ps(:,:,2);
-    else
-        error('physical dimension must be 2 or 3')
-    end
-    
-    if iphysdim==3
-        [index_coor, ierr] = cg_coord_write(index_file,index_base,index_zone,...
-            RealDouble,'CoordinateX',xs(:,:,:)); chk_error(ierr);
-        [index_coor, ierr] = cg_coord_write(index_file,index_base,index_zone,...
-            RealDouble,'CoordinateY',ys(:,:,:)); chk_error(ierr);
-        [index_coor, ierr] = cg_coord_write(index_file,index_base,index_zone,...
-            RealDouble,'CoordinateZ',zs(:,:,:)); chk_error(ierr);
-    elseif iphysdim==2
-        [index_coor, ierr] = cg_coord_write(index_file,index_base,index_zone,...
-            RealDouble,'CoordinateX',xs(:,:)); chk_error(ierr);
-        [index_coor, ierr] = cg_coord_write(index_file,index_base,index_zone,...
-            RealDouble,'CoordinateY',ys(:,:)); chk_error(ierr);
-    else
-        error('physical dimension must be 2 or 3')
-    end
-    
-    % get number of variables
-    if isempty(var_nodes)
-        n_vn = 0;
-    else
-        n_vn = length(fieldnames(var_nodes));
-    end
-    
-    if isempty(var_cells)
-        n_vf = 0;
-    else
-        n_vf = length(fieldnames(var_cells));
-    end
-    
-    % Write node-centered variables
-    if (n_vn ~= 0)
-        solname = 'NodeCenteredSolutions';
-        [index_sol,ierr] = cg_sol_write(index_file, index_base, index_zone, ...
-            solname, Vertex); chk_error(ierr);
-        
-        write_variables_struct( index_file, index_base, index_zone, index_sol, var_nodes, iphysdim);
-    end
-    
-    % Write cell-centered variables
-    if(n_vf ~= 0)
-        solname = 'CellCenteredSolutions';
-        [index_sol,ierr] = cg_sol_write(index_file, index_base, index_zone, ...
-            solname, CellCenter); chk_error(ierr);
-        
-        write_variables_struct( index_file, index_base, index_zone, index_sol, var_cells, iphysdim);
-    end
+    zone.icelldim = iphysdim;
+    zone.iphysdim = iphysdim;
+    zone.isize = [ni, nj, nk, ni-1, nj-1, nk-1, 0, 0, 0];
     
 else % Unstructured
     
@@ -216,77 +203,64 @@ else % Unstructured
         end
     end
     
-    % Set file type to HDF5 or ADF
-    if strcmp(file_name(end-2:end),'.adf')
-        ierr = cg_set_file_type(CG_FILE_ADF); chk_error(ierr);
-    else
-        ierr = cg_set_file_type(CG_FILE_HDF5); chk_error(ierr);
-    end
-    
-    % Open the CGNS file.
-    [index_file,ierr] = cg_open(file_name,CG_MODE_WRITE); chk_error(ierr);
-    
-    % Create base.
-    iphysdim = size(ps,2);
-    
-    [index_base,ierr] = cg_base_write(index_file,'Base',icelldim,iphysdim); chk_error(ierr);
-    
+    zone.icelldim = icelldim;
+    zone.iphysdim = size(ps,2);
     % Number of vertices and elements
-    isize = [size(ps,1), nelems, zeros(1,7)];
-    % Create zone
-    [index_zone,ierr] = cg_zone_write(index_file,index_base,'Zone1',isize,...
-        Unstructured); chk_error(ierr);
-    
-    % Write grid coordinates (must use SIDS-standard names here)
-    [index_coor, ierr] = cg_coord_write(index_file,index_base,index_zone,...
-        RealDouble,'CoordinateX',ps(:,1)); chk_error(ierr); %#ok<*ASGLU>
-    [index_coor, ierr] = cg_coord_write(index_file,index_base,index_zone,...
-        RealDouble,'CoordinateY',ps(:,2)); chk_error(ierr);
-    
-    if iphysdim==3
-        [index_coor, ierr] = cg_coord_write(index_file,index_base,index_zone,...
-            RealDouble,'CoordinateZ',ps(:,3)); chk_error(ierr);
-    end
-    
+    zone.isize = [size(ps,1), nelems, zeros(1,7)];
+    zone.type = type;
+    zone.elems = elems;
+    zone.nelems = nelems;
+end
+end
+
+function write_zone( index_file, index_base, index_zone, zone, var_nodes, var_cells)
+% Write element connectivity and node/cell-centered variables of a zone
+
+if ~zone.structured
     % Write element connectivity. We must permute elems, but we don't need to
     % cast the data type to integer explicitly (MEX function does it for us).
     [index_sec, ierr] = cg_section_write(index_file,index_base,index_zone,'Elements', ...
-        type, 1, nelems, 0, elems'); chk_error(ierr);
-    
-    % get number of variables
-    if isempty(var_nodes)
-        n_vn = 0;
-    else
-        n_vn = length(fieldnames(var_nodes));
-    end
-    
-    if isempty(var_cells)
-        n_vf = 0;
+        zone.type, 1, zone.nelems, 0, zone.elems'); chk_error(ierr); %#ok<*ASGLU>
+end
+
+% get number of variables
+if isempty(var_nodes)
+    n_vn = 0;
+else
+    n_vn = length(fieldnames(var_nodes));
+end
+
+if isempty(var_cells)
+    n_vf = 0;
+else
+    n_vf = length(fieldnames(var_cells));
+end
+
+% Write node-centered variables
+if (n_vn ~= 0)
+    solname = 'NodeCenteredSolutions';
+    [index_sol,ierr] = cg_sol_write(index_file, index_base, index_zone, ...
+        solname, Vertex); chk_error(ierr);
+    
+    if zone.structured
+        write_variables_struct( index_file, index_base, index_zone, index_sol, var_nodes, zone.iphysdim);
     else
-        n_vf = length(fieldnames(var_cells));
-    end
-    
-    % Write node-centered variables
-    if (n_vn ~= 0)
-        solname = 'NodeCenteredSolutions';
-        [index_sol,ierr] = cg_sol_write(index_file, index_base, index_zone, ...
-            solname, Vertex); chk_error(ierr);
-        
         write_variables( index_file, index_base, index_zone, index_sol, var_nodes);
     end
-    
-    % Write cell-centered variables
-    if(n_vf ~= 0)
-        solname = 'CellCenteredSolutions';
-        [index_sol,ierr] = cg_sol_write(index_file, index_base, index_zone, ...
-            solname, CellCenter); chk_error(ierr);
-        
+end
+
+% Write cell-centered variables
+if(n_vf ~= 0)
+    solname = 'CellCenteredSolutions';
+    [index_sol,ierr] = cg_sol_write(index_file, index_base, index_zone, ...
+        solname, CellCenter); chk_error(ierr);
+    
+    if zone.structured
+        write_variables_struct( index_file, index_base, index_zone, index_sol, var_cells, zone.iphysdim);
+    else
         write_variables( index_file, index_base, index_zone, index_sol, var_cells);
     end
 end
-
-% Close the CGNS file.
-ierr = cg_close(index_file); chk_error(ierr);
 end
 
 function type = get_cgns_datatype( arr)
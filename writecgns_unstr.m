@@ -35,6 +35,11 @@ function writecgns_unstr( file_name, ps, elems, typestr, var_nodes, var_cells)
 %
 %   VAR_CELLS is a MATLAB structure containing elemental values to be
 %       written. Its usage is similar to VAR_NODES.
+%   To write several zones into a single base, pass XS and ELEMS as 1xn
+%       cell arrays with one entry per zone. TYPESTR, VAR_NODES and
+%       VAR_CELLS may then be cell arrays as well, or a single value that
+%       is used for every zone. The dimensions of the base are taken from
+%       the first zone.
 %
 % Example usage
 %     var_nodes.vdisp = disp;   % Define two nodal variables
@@ -46,6 +51,8 @@ function writecgns_unstr( file_name, ps, elems, typestr, var_nodes, var_cells)
 %     writecgns_unstr( 'test.cgns', xs, elems, '', var_nodes);
 %     % Write out only elemental variables
 %     writecgns_unstr( 'test.cgns', xs, elems, '', [], var_cells);
+%     % Write out two zones in one file
+%     writecgns_unstr( 'blocks.cgns', {xs1, xs2}, {elems1, elems2});
 %
 % Note that a field in VAR_NODES (and similarly in VAR_CELLS) is
 % an nxd matrix with d>=1. If d>1, each column of the field will
@@ -77,13 +84,20 @@ if nargin<4; typestr = []; end
 if nargin<5; var_nodes = []; end
 if nargin<6; var_cells = []; end
 
-% elems is nxd, where d is 3 for triangle etc.
-if isempty(elems)
-    type = NODE;
-    icelldim = 1;
-else
-    % get elems_type from elems
-    [type, icelldim] = get_elemtype( size(elems,2), typestr);
+% A single zone is written as a one-entry multi-zone file
+if ~iscell(ps)
+    ps = {ps};
+    elems = {elems};
+end
+nz = length(ps);
+if ~iscell(typestr); typestr = repmat({typestr},1,nz); end
+if ~iscell(var_nodes); var_nodes = repmat({var_nodes},1,nz); end
+if ~iscell(var_cells); var_cells = repmat({var_cells},1,nz); end
+
+% Determine the zone sizes and element types up front
+zones = cell(1,nz);
+for z=1:nz
+    zones{z} = get_zone_info( ps{z}, elems{z}, typestr{z});
 end
 
 % Set file type to HDF5 or ADF
@@ -97,33 +111,64 @@ end
 [index_file,ierr] = cg_open(file_name,CG_MODE_WRITE); chk_error(ierr);
 
 % Create base.
-iphysdim = size(ps,2);
-[index_base,ierr] = cg_base_write(index_file,'Base',icelldim,iphysdim); chk_error(ierr);
+[index_base,ierr] = cg_base_write(index_file,'Base',zones{1}.icelldim,...
+    zones{1}.iphysdim); chk_error(ierr);
+
+% Create zones. The library sorts zones by name, so the numbers are
+% zero-padded to keep them in the order given
+index_zones = zeros(1,nz);
+ndigits = length(sprintf('%d',nz));
+for z=1:nz
+    [index_zones(z),ierr] = cg_zone_write(index_file,index_base,...
+        sprintf('Zone%0*d',ndigits,z),zones{z}.isize,Unstructured); chk_error(ierr);
+    ps{z} = double(ps{z});
+end
 
-% Number of vertices and elements
-isize = [size(ps,1), number_of_elements(elems), zeros(1,7)];
-% Create zone
-[index_zone,ierr] = cg_zone_write(index_file,index_base,'Zone1',isize,...
-    Unstructured); chk_error(ierr);
-
-% Write grid coordinates (must use SIDS-standard names here)
-[index_coor, ierr] = cg_coord_write(index_file,index_base,index_zone,...
-    RealDouble,'CoordinateX',ps(:,1)); chk_error(ierr); %#ok<*ASGLU>
-[index_coor, ierr] = cg_coord_write(index_file,index_base,index_zone,...
-    RealDouble,'CoordinateY',ps(:,2)); chk_error(ierr);
-
-if iphysdim==3
-    [index_coor, ierr] = cg_coord_write(index_file,index_base,index_zone,...
-        RealDouble,'CoordinateZ',ps(:,3)); chk_error(ierr);
+% Write grid coordinates of all zones in one call (SIDS-standard names)
+ierr = cg_zones_coord_write(index_file,index_base,index_zones,ps);
+chk_error(ierr);
+
+% Write element connectivity and variables
+for z=1:nz
+    write_zone( index_file, index_base, index_zones(z), zones{z}, ...
+        var_nodes{z}, var_cells{z});
 end
 
-% Write element connectivity. We must permute elems, but we don't need to
-% cast the data type to integer explicitly (MEX function does it for us).
+% Close the CGNS file.
+ierr = cg_close(index_file); chk_error(ierr);
+end
+
+function zone = get_zone_info( ps, elems, typestr)
+% Obtain the dimensions, the zone size and the element type of a zone
+
+% elems is nxd, where d is 3 for triangle etc.
+if isempty(elems)
+    type = NODE;
+    icelldim = 1;
+else
+    % get elems_type from elems
+    [type, icelldim] = get_elemtype( size(elems,2), typestr);
+end
+
+zone.icelldim = icelldim;
+zone.iphysdim = size(ps,2);
+% Number of vertices and elements
+zone.nelems = number_of_elements(elems);
+zone.isize = [size(ps,1), zone.nelems, zeros(1,7)];
 if type == MIXED
     elems = convert_mixed_elements( elems, str2double(typestr(end)));
 end
+zone.type = type;
+zone.elems = elems;
+end
+
+function write_zone( index_file, index_base, index_zone, zone, var_nodes, var_cells)
+% Write element connectivity and node/cell-centered variables of a zone
+
+% Write element connectivity. We must permute elems, but we don't need to
+% cast the data type to integer explicitly (MEX function does it for us).
 [index_sec, ierr] = cg_section_write(index_file,index_base,index_zone,'Elements', ...
-    type, 1, number_of_elements( elems), 0, elems'); chk_error(ierr);
+    zone.type, 1, zone.nelems, 0, zone.elems'); chk_error(ierr); %#ok<*ASGLU>
 
 % get number of variables
 if isempty(var_nodes)
@@ -155,9 +200,6 @@ if(n_vf ~= 0)
 
     write_variables( index_file, index_base, index_zone, index_sol, var_cells);
 end
-
-% Close the CGNS file.
-ierr = cg_close(index_file); chk_error(ierr);
 end
 
 function type = get_cgns_datatype( arr)
@@ -470,3 +512,9 @@ end
 %! writecgns_unstr( 'test1_mixed.cgns', xs, elems, 'MIXED2', nodal_vars, eleml_vars);
 %! delete test1_tri.cgns;
 %! delete test1_mixed.cgns;
+
+%!test
+%! writecgns_unstr( 'test1_zones.cgns', {xs, xs}, {tris, elems}, {[], 'MIXED2'});
+%! writecgns_unstr( 'test1_zones.adf', {xs, xs}, {tris, tris});
+%! delete test1_zones.cgns;
+%! delete test1_zones.adf;